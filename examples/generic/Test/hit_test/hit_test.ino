@@ -0,0 +1,194 @@
+/*
+
+--- English ---
+
+Benchmark of the touch hit test. The sketch creates 240 RectButtons (a 20 x 12 grid covering a
+480 x 320 screen), registers them on screen 0 and measures, over random touch points, how long it
+takes to find the button under the finger:
+
+- linear: tests the touch area of every widget of the screen, like DisplayFK did before the grid;
+- grid: asks the HitGrid for the candidates of the touched cell and tests only those.
+
+Both methods must find the same button; the sketch counts the mismatches. The results are printed
+on the Serial monitor in microseconds per touch, together with the time to build the grid and the
+memory it uses. Change BTN_COLS and BTN_ROWS to try other densities (at most 255 buttons, the limit
+of setRectButton).
+
+--- Português ---
+
+Benchmark do teste de toque. O sketch cria 240 RectButtons (uma grade de 20 x 12 cobrindo uma tela
+de 480 x 320), registra todos na tela 0 e mede, para pontos de toque aleatórios, quanto tempo leva
+para achar o botão sob o dedo:
+
+- linear: testa a área de toque de todos os widgets da tela, como o DisplayFK fazia antes da grade;
+- grid: pede ao HitGrid os candidatos da célula tocada e testa apenas eles.
+
+Os dois métodos devem achar o mesmo botão; o sketch conta as divergências. Os resultados aparecem
+no monitor Serial em microssegundos por toque, junto com o tempo para montar a grade e a memória
+usada. Altere BTN_COLS e BTN_ROWS para testar outras densidades (no máximo 255 botões, limite do
+setRectButton).
+
+*/
+
+#if CONFIG_IDF_TARGET_ESP32S2 || CONFIG_IDF_TARGET_ESP32S3
+#define VSPI FSPI
+#endif
+#include <SPI.h>
+#include <Arduino_GFX_Library.h>
+#include <displayfk.h>
+
+    /* Project setup:
+    * MCU: ESP32S3
+    * Display: ST7796
+    */
+const int DISPLAY_W = 480;
+const int DISPLAY_H = 320;
+const int DISP_FREQUENCY = 27000000;
+const int DISP_MOSI = 11;
+const int DISP_MISO = -1;
+const int DISP_SCLK = 12;
+const int DISP_CS = 10;
+const int DISP_DC = 8;
+const int DISP_RST = 9;
+const uint8_t rotationScreen = 1;
+const bool isIPS = true;
+
+const uint8_t BTN_COLS = 20;
+const uint8_t BTN_ROWS = 12;
+const uint8_t qtdRectBtn = BTN_COLS * BTN_ROWS;
+const uint16_t BTN_W = DISPLAY_W / BTN_COLS;
+const uint16_t BTN_H = DISPLAY_H / BTN_ROWS;
+const uint32_t TOUCHES = 10000;
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+SPIClass spi_shared(FSPI);
+#else
+SPIClass spi_shared(HSPI);
+#endif
+Arduino_DataBus *bus = nullptr;
+Arduino_GFX *tft = nullptr;
+DisplayFK myDisplay;
+RectButton *arrayRectbtn[qtdRectBtn];
+WidgetRegistry registry;
+HitGrid grid;
+uint16_t touchX[TOUCHES];
+uint16_t touchY[TOUCHES];
+
+void screen0();
+void loadWidgets();
+void runBenchmark();
+int linearHit(const WidgetSpan_t &span, uint16_t x, uint16_t y);
+int gridHit(const WidgetSpan_t &span, uint16_t x, uint16_t y);
+bool inTouchBounds(WidgetBase *widget, uint16_t x, uint16_t y);
+
+void setup(){
+    Serial.begin(115200);
+    spi_shared.begin(DISP_SCLK, DISP_MISO, DISP_MOSI);
+    bus = new Arduino_HWSPI(DISP_DC, DISP_CS, DISP_SCLK, DISP_MOSI, DISP_MISO, &spi_shared);
+    tft = new Arduino_ST7796(bus, DISP_RST, rotationScreen, isIPS, 320, 480);
+    tft->begin(DISP_FREQUENCY);
+    myDisplay.setDrawObject(tft);
+    loadWidgets();
+    myDisplay.loadScreen(screen0);
+    runBenchmark();
+}
+
+void loop(){
+    delay(1000);
+}
+
+void screen0(){
+    tft->fillScreen(CFK_WHITE);
+    WidgetBase::backgroundColor = CFK_WHITE;
+    myDisplay.drawWidgetsOnScreen(0);
+}
+
+void loadWidgets(){
+    RectButtonConfig configRectButton = {
+            .callback = nullptr,
+            .width = static_cast<uint16_t>(BTN_W - 2),
+            .height = static_cast<uint16_t>(BTN_H - 2),
+            .pressedColor = CFK_COLOR20
+        };
+    for (uint8_t i = 0; i < qtdRectBtn; i++) {
+        arrayRectbtn[i] = new RectButton((i % BTN_COLS) * BTN_W, (i / BTN_COLS) * BTN_H, 0);
+        arrayRectbtn[i]->setup(configRectButton);
+    }
+    myDisplay.setRectButton(arrayRectbtn, qtdRectBtn);
+}
+
+void runBenchmark(){
+    for (uint8_t i = 0; i < qtdRectBtn; i++) {
+        registry.add(arrayRectbtn[i], WidgetType::RECTBUTTON);
+    }
+    WidgetSpan_t span = registry.onScreen(0);
+
+    uint32_t start = micros();
+    bool built = grid.build(span, DISPLAY_W, DISPLAY_H);
+    uint32_t buildUs = micros() - start;
+
+    for (uint32_t i = 0; i < TOUCHES; i++) {
+        touchX[i] = random(DISPLAY_W);
+        touchY[i] = random(DISPLAY_H);
+    }
+
+    volatile int sink = 0;
+    start = micros();
+    for (uint32_t i = 0; i < TOUCHES; i++) {
+        sink += linearHit(span, touchX[i], touchY[i]);
+    }
+    uint32_t linearUs = micros() - start;
+
+    start = micros();
+    for (uint32_t i = 0; i < TOUCHES; i++) {
+        sink += gridHit(span, touchX[i], touchY[i]);
+    }
+    uint32_t gridUs = micros() - start;
+
+    uint32_t mismatches = 0;
+    uint32_t maxCandidates = 0;
+    for (uint32_t i = 0; i < TOUCHES; i++) {
+        if (linearHit(span, touchX[i], touchY[i]) != gridHit(span, touchX[i], touchY[i])) {
+            mismatches++;
+        }
+        HitCandidates_t candidates;
+        if (grid.query(touchX[i], touchY[i], candidates) && candidates.count > maxCandidates) {
+            maxCandidates = candidates.count;
+        }
+    }
+
+    Serial.printf("Widgets on screen: %u\n", span.count);
+    Serial.printf("Grid built: %s in %lu us, %lu bytes\n", built ? "yes" : "no", buildUs, grid.memoryUsage());
+    Serial.printf("Linear: %.3f us/touch\n", (float)linearUs / TOUCHES);
+    Serial.printf("Grid:   %.3f us/touch (max %lu candidates)\n", (float)gridUs / TOUCHES, maxCandidates);
+    Serial.printf("Mismatches: %lu\n", mismatches);
+}
+
+// Topmost widget under the point, testing every widget (-1 if none)
+int linearHit(const WidgetSpan_t &span, uint16_t x, uint16_t y){
+    for (int i = span.count - 1; i >= 0; i--) {
+        if (span.widgets[i]->isTouchable() && inTouchBounds(span.widgets[i], x, y)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Topmost widget under the point, testing only the candidates of the grid (-1 if none)
+int gridHit(const WidgetSpan_t &span, uint16_t x, uint16_t y){
+    HitCandidates_t candidates;
+    if (!grid.query(x, y, candidates)) {
+        return linearHit(span, x, y);
+    }
+    for (int i = candidates.count - 1; i >= 0; i--) {
+        if (inTouchBounds(span.widgets[candidates.index[i]], x, y)) {
+            return candidates.index[i];
+        }
+    }
+    return -1;
+}
+
+bool inTouchBounds(WidgetBase *widget, uint16_t x, uint16_t y){
+    Rect_t r = widget->getTouchBounds();
+    return POINT_IN_RECT(x, y, r.x, r.y, r.width, r.height);
+}
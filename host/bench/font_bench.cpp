@@ -0,0 +1,178 @@
+// font_bench.cpp
+// Flash size and decode speed of compressed fonts against the bundled 1-bit GFXfonts. The
+// compressed headers are generated at build time by src/fonts/fontcompress.py.
+//
+// For each font one CSV row is written with:
+//   bitmap_bytes / compressed_bytes - size of the glyph bitmap array before and after
+//   bitmap_ns / compressed_ns       - time to decode one glyph into runs (what the glyph cache
+//                                     does on a miss), mean over every glyph of the font
+//   gfx_us                          - Arduino_GFX print() of the sample text, 1-bit font
+//   compressed_us                   - CompressedFont::print() of the same text (no cache)
+//   cached_us                       - GlyphCache::print() with the compressed font, warm cache
+//   match                           - 1 if both decoders produce the same runs for every glyph
+//
+//   ./font_bench [-n runs] [-o file.csv]
+#include <Arduino_GFX_Library.h>
+#include <displayfk.h>
+#include <dfk_host.h>
+
+#include <chrono>
+#include <vector>
+
+#include "RobotoBold10pt7bZ.h"
+#include "RobotoBold20pt7bZ.h"
+#include "RobotoBold50pt7bZ.h"
+#include "MUSICNET50pt7bZ.h"
+#include "G7_Segment7_S550pt7bZ.h"
+#include "Nokian30pt7bZ.h"
+
+namespace {
+
+struct FontCase {
+    const char *name;
+    const GFXfont *bitmap;
+    const GFXfont *compressed;
+    size_t bitmapBytes;
+    size_t compressedBytes;
+};
+
+#define FONT_CASE(font) {#font, &font, &font##Z, sizeof(font##Bitmaps), sizeof(font##ZBitmaps)}
+
+const FontCase FONTS[] = {
+    FONT_CASE(RobotoBold10pt7b),
+    FONT_CASE(RobotoBold20pt7b),
+    FONT_CASE(RobotoBold50pt7b),
+    FONT_CASE(MUSICNET50pt7b),
+    FONT_CASE(G7_Segment7_S550pt7b),
+    FONT_CASE(Nokian30pt7b),
+};
+
+const char SAMPLE[] = "0123 ABCabc";
+
+struct Run {
+    uint8_t row, x, length;
+    bool operator==(const Run &o) const { return row == o.row && x == o.x && length == o.length; }
+};
+
+/// @brief Same bit walk as the glyph cache does for a 1-bit glyph.
+template <typename Fn>
+void bitmapRuns(const GFXfont *font, const GFXglyph *glyph, Fn onRun) {
+    uint32_t offset = glyph->bitmapOffset;
+    uint8_t bits = 0, bit = 0;
+    for (uint8_t row = 0; row < glyph->height; row++) {
+        int16_t start = -1;
+        for (uint8_t x = 0; x < glyph->width; x++) {
+            if (!(bit++ & 7)) {
+                bits = font->bitmap[offset++];
+            }
+            if (bits & 0x80) {
+                if (start < 0) {
+                    start = x;
+                }
+            } else if (start >= 0) {
+                onRun(row, static_cast<uint8_t>(start), static_cast<uint8_t>(x - start));
+                start = -1;
+            }
+            bits <<= 1;
+        }
+        if (start >= 0) {
+            onRun(row, static_cast<uint8_t>(start), static_cast<uint8_t>(glyph->width - start));
+        }
+    }
+}
+
+template <typename Fn>
+double timeUs(int runs, Fn fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        fn();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / runs;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int runs = 200;
+    const char *outPath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            runs = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [-n runs] [-o file.csv]\n", argv[0]);
+            return 1;
+        }
+    }
+    FILE *out = outPath ? fopen(outPath, "w") : stdout;
+    if (!out) {
+        perror(outPath);
+        return 1;
+    }
+
+    HostDisplay tft(800, 480);
+    tft.begin();
+    tft.setTextWrap(false);
+    GlyphCache cache(256 * 1024, 512);
+    cache.begin();
+
+    fprintf(out, "font,bitmap_bytes,compressed_bytes,ratio,bitmap_ns,compressed_ns,gfx_us,compressed_us,cached_us,match\n");
+    for (const FontCase &f : FONTS) {
+        CompressedFont::add(f.compressed);
+        const uint16_t glyphCount = f.bitmap->last - f.bitmap->first + 1;
+
+        bool match = true;
+        std::vector<Run> a, b;
+        for (uint16_t g = 0; g < glyphCount; g++) {
+            a.clear();
+            b.clear();
+            bitmapRuns(f.bitmap, &f.bitmap->glyph[g], [&](uint8_t r, uint8_t x, uint8_t l) { a.push_back({r, x, l}); });
+            CompressedFont::forEachRun(f.compressed, &f.compressed->glyph[g],
+                                       [&](uint8_t r, uint8_t x, uint8_t l) { b.push_back({r, x, l}); });
+            match = match && a == b;
+        }
+
+        volatile uint32_t sink = 0;
+        const double bitmapNs = timeUs(runs, [&] {
+            for (uint16_t g = 0; g < glyphCount; g++) {
+                bitmapRuns(f.bitmap, &f.bitmap->glyph[g], [&](uint8_t, uint8_t, uint8_t l) { sink = sink + l; });
+            }
+        }) * 1000.0 / glyphCount;
+        const double compressedNs = timeUs(runs, [&] {
+            for (uint16_t g = 0; g < glyphCount; g++) {
+                CompressedFont::forEachRun(f.compressed, &f.compressed->glyph[g],
+                                           [&](uint8_t, uint8_t, uint8_t l) { sink = sink + l; });
+            }
+        }) * 1000.0 / glyphCount;
+
+        const int16_t baseline = f.bitmap->yAdvance;
+        auto printWith = [&](const GFXfont *font, int mode) {
+            tft.setFont(font);
+            tft.setTextColor(CFK_BLACK);
+            tft.setCursor(0, baseline);
+            if (mode == 0) {
+                tft.print(SAMPLE);
+            } else if (mode == 1) {
+                CompressedFont::print(&tft, SAMPLE);
+            } else {
+                cache.print(&tft, SAMPLE);
+            }
+        };
+        const double gfxUs = timeUs(runs, [&] { printWith(f.bitmap, 0); });
+        const double compressedUs = timeUs(runs, [&] { printWith(f.compressed, 1); });
+        printWith(f.compressed, 2); // warm up
+        const double cachedUs = timeUs(runs, [&] { printWith(f.compressed, 2); });
+
+        fprintf(out, "%s,%zu,%zu,%.2f,%.1f,%.1f,%.2f,%.2f,%.2f,%d\n", f.name, f.bitmapBytes, f.compressedBytes,
+                static_cast<double>(f.bitmapBytes) / f.compressedBytes, bitmapNs, compressedNs, gfxUs, compressedUs,
+                cachedUs, match ? 1 : 0);
+    }
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    hostStopTasks();
+    return 0;
+}
@@ -0,0 +1,243 @@
+// image_bench.cpp
+// Size and decode speed of compressed images (.fkz) against the raw .fki format. The test
+// images are drawn here, written as .fki to a temporary folder and compressed with
+// src/widgets/image/imagecompress.py.
+//
+// For each image one CSV row is written with:
+//   fki_bytes / fkz_bytes - file sizes
+//   decode_mpx_s          - FkzDecoder::readRow() throughput from a file, megapixels per second
+//   raw_mpx_s             - plain read of the .fki pixels and mask, megapixels per second
+//   stream_fki_us         - Image widget in streaming mode, full draw from the .fki file
+//   stream_fkz_us         - the same from the .fkz file
+//   match                 - 1 if the decoded pixels and mask are those of the .fki file
+//
+//   ./image_bench [-n runs] [-o file.csv]
+#include <Arduino_GFX_Library.h>
+#include <displayfk.h>
+#include <dfk_host.h>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Picture {
+    const char *name;
+    uint16_t width;
+    uint16_t height;
+    std::vector<uint16_t> pixels;
+    std::vector<bool> visible;
+};
+
+uint16_t rgb(int r, int g, int b) {
+    return static_cast<uint16_t>(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+/// @brief Button with a vertical gradient, a border and rounded (transparent) corners.
+Picture button() {
+    Picture p = {"button", 240, 80, {}, {}};
+    for (int y = 0; y < p.height; y++) {
+        for (int x = 0; x < p.width; x++) {
+            const int dx = std::max(0, std::max(16 - x, x - (p.width - 17)));
+            const int dy = std::max(0, std::max(16 - y, y - (p.height - 17)));
+            const bool inside = dx * dx + dy * dy <= 16 * 16;
+            const bool border = inside && (dx * dx + dy * dy > 13 * 13 || x < 3 || y < 3 ||
+                                           x >= p.width - 3 || y >= p.height - 3);
+            p.pixels.push_back(border ? rgb(20, 40, 90) : rgb(60 + y, 120 + y, 220));
+            p.visible.push_back(inside);
+        }
+    }
+    return p;
+}
+
+/// @brief Flat icon: a few solid shapes over a transparent background.
+Picture icon() {
+    Picture p = {"icon", 96, 96, {}, {}};
+    for (int y = 0; y < p.height; y++) {
+        for (int x = 0; x < p.width; x++) {
+            const int dx = x - 48, dy = y - 48;
+            const bool disc = dx * dx + dy * dy < 44 * 44;
+            const bool mark = std::abs(dx + dy / 2) < 6 && dy > -20 && dy < 24;
+            p.pixels.push_back(mark ? rgb(255, 255, 255) : rgb(30, 170, 80));
+            p.visible.push_back(disc);
+        }
+    }
+    return p;
+}
+
+/// @brief Background with soft noise, the worst case for the codec.
+Picture photo() {
+    Picture p = {"photo", 320, 240, {}, {}};
+    uint32_t seed = 1;
+    for (int y = 0; y < p.height; y++) {
+        for (int x = 0; x < p.width; x++) {
+            seed = seed * 1103515245 + 12345;
+            const int noise = static_cast<int>((seed >> 16) & 15) - 8;
+            const int v = static_cast<int>(128 + 60 * std::sin(x / 23.0) * std::cos(y / 17.0)) + noise;
+            p.pixels.push_back(rgb(std::min(255, std::max(0, v + 40)), std::min(255, std::max(0, v)), 90));
+            p.visible.push_back(true);
+        }
+    }
+    return p;
+}
+
+void writeFki(const Picture &p, const std::string &path) {
+    FILE *f = fopen(path.c_str(), "wb");
+    const uint16_t byteWidth = (p.width + 7) / 8;
+    std::vector<uint8_t> mask(byteWidth * p.height, 0);
+    fputc(p.width >> 8, f);
+    fputc(p.width & 0xFF, f);
+    fputc(p.height >> 8, f);
+    fputc(p.height & 0xFF, f);
+    for (size_t i = 0; i < p.pixels.size(); i++) {
+        fputc(p.pixels[i] >> 8, f);
+        fputc(p.pixels[i] & 0xFF, f);
+        const int x = i % p.width, y = i / p.width;
+        if (p.visible[i]) {
+            mask[y * byteWidth + x / 8] |= 0x80 >> (x & 7);
+        }
+    }
+    fputc(mask.size() >> 8, f);
+    fputc(mask.size() & 0xFF, f);
+    fwrite(mask.data(), 1, mask.size(), f);
+    fclose(f);
+}
+
+long fileSize(const std::string &path) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) {
+        return 0;
+    }
+    fseek(f, 0, SEEK_END);
+    const long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+template <typename Fn>
+double timeUs(int runs, Fn fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        fn();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / runs;
+}
+
+void noCallback() {}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int runs = 50;
+    const char *outPath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            runs = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [-n runs] [-o file.csv]\n", argv[0]);
+            return 1;
+        }
+    }
+    FILE *out = outPath ? fopen(outPath, "w") : stdout;
+    if (!out) {
+        perror(outPath);
+        return 1;
+    }
+
+    char folder[] = "/tmp/image_bench_XXXXXX";
+    if (!mkdtemp(folder)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    SPIFFS.setHostRoot(folder);
+
+    HostDisplay tft(480, 320);
+    tft.begin();
+    WidgetBase::objTFT = &tft;
+    WidgetBase::currentScreen = 0;
+
+    fprintf(out, "image,fki_bytes,fkz_bytes,ratio,decode_mpx_s,raw_mpx_s,stream_fki_us,stream_fkz_us,match\n");
+    for (const Picture &p : {button(), icon(), photo()}) {
+        const std::string fki = std::string(folder) + "/" + p.name + ".fki";
+        const std::string fkz = std::string(folder) + "/" + p.name + ".fkz";
+        writeFki(p, fki);
+        const std::string command = std::string(DFK_PYTHON) + " " + DFK_IMAGE_ENCODER + " " + fki + " " + fkz;
+        if (system(command.c_str()) != 0) {
+            fprintf(stderr, "encoder failed: %s\n", command.c_str());
+            return 1;
+        }
+        const std::string fkiName = std::string("/") + p.name + ".fki";
+        const std::string fkzName = std::string("/") + p.name + ".fkz";
+        const double pixelCount = static_cast<double>(p.width) * p.height;
+        const uint16_t byteWidth = (p.width + 7) / 8;
+        std::vector<uint8_t> row(p.width * 2), mask(byteWidth);
+
+        bool match = true;
+        File file = SPIFFS.open(fkzName.c_str());
+        FkzDecoder decoder;
+        match = decoder.begin(file) && decoder.width() == p.width && decoder.height() == p.height;
+        for (uint16_t y = 0; match && y < p.height; y++) {
+            match = decoder.readRow(row.data(), mask.data());
+            for (uint16_t x = 0; match && x < p.width; x++) {
+                const bool visible = mask[x >> 3] & (0x80 >> (x & 7));
+                const uint16_t color = (row[x * 2] << 8) | row[x * 2 + 1];
+                match = visible == p.visible[y * p.width + x] && (!visible || color == p.pixels[y * p.width + x]);
+            }
+        }
+        file.close();
+
+        const double decodeUs = timeUs(runs, [&] {
+            File f = SPIFFS.open(fkzName.c_str());
+            FkzDecoder d;
+            d.begin(f);
+            for (uint16_t y = 0; y < p.height; y++) {
+                d.readRow(row.data(), mask.data());
+            }
+            f.close();
+        });
+        std::vector<uint8_t> raw(p.width * 2 * p.height + byteWidth * p.height + 2);
+        const double rawUs = timeUs(runs, [&] {
+            File f = SPIFFS.open(fkiName.c_str());
+            f.seek(4);
+            f.read(raw.data(), raw.size());
+            f.close();
+        });
+
+        auto streamUs = [&](const std::string &name) {
+            Image image(10, 10, 0);
+            ImageFromFileConfig config = {};
+            config.path = name.c_str();
+            config.cb = noCallback;
+            config.source = SourceFile::SPIFFS;
+            config.streaming = true;
+            image.setupFromFile(config);
+            return timeUs(runs, [&] {
+                image.forceUpdate();
+                image.draw();
+            });
+        };
+        const double streamFki = streamUs(fkiName);
+        const double streamFkz = streamUs(fkzName);
+
+        const long fkiBytes = fileSize(fki), fkzBytes = fileSize(fkz);
+        fprintf(out, "%s,%ld,%ld,%.2f,%.1f,%.1f,%.1f,%.1f,%d\n", p.name, fkiBytes, fkzBytes,
+                static_cast<double>(fkiBytes) / fkzBytes, pixelCount / decodeUs, pixelCount / rawUs,
+                streamFki, streamFkz, match ? 1 : 0);
+        remove(fki.c_str());
+        remove(fkz.c_str());
+    }
+    rmdir(folder);
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    hostStopTasks();
+    return 0;
+}
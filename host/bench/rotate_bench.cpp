@@ -0,0 +1,202 @@
+// rotate_bench.cpp
+// Speed of rotated image drawing: ImageRotator against the per-pixel rotation Image used before.
+// Each test image is drawn around its centre, in the middle of the screen, at a few angles:
+//
+//   legacy - float inverse mapping of every pixel of the box and one drawPixel() per pixel
+//   direct - ImageRotator without the cache (row spans in Q16, runs sent as bitmaps)
+//   cached - ImageRotator redrawing the same rotation from its cache
+//   sweep  - ImageRotator with the cache enabled and the angle changing on every draw (a
+//            moving needle); it must cost the same as direct
+//
+// One CSV row is written per image and angle with the time and the draw calls of each method,
+// whether the image fit in the cache, and match = 1 if the cached frame is the direct frame.
+//
+//   ./rotate_bench [-n runs] [-o file.csv]
+#include <Arduino_GFX_Library.h>
+#include <displayfk.h>
+#include <dfk_host.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct Picture {
+    const char *name;
+    uint16_t width;
+    uint16_t height;
+    std::vector<uint16_t> pixels;
+    std::vector<uint8_t> mask; ///< Empty when every pixel is visible.
+};
+
+uint16_t rgb(int r, int g, int b) {
+    return static_cast<uint16_t>(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+/// @brief Needle of a gauge: a thin masked shape, the usual rotated image.
+Picture needle() {
+    Picture p = {"needle", 120, 12, {}, {}};
+    const uint16_t byteWidth = (p.width + 7) / 8;
+    p.mask.assign(byteWidth * p.height, 0);
+    for (int y = 0; y < p.height; y++) {
+        for (int x = 0; x < p.width; x++) {
+            const bool inside = std::abs(y - 6) * p.width < (p.width - x) * 6;
+            p.pixels.push_back(rgb(220, 40 + x, 40));
+            if (inside) {
+                p.mask[y * byteWidth + x / 8] |= 0x80 >> (x & 7);
+            }
+        }
+    }
+    return p;
+}
+
+/// @brief Round icon with a transparent background.
+Picture icon() {
+    Picture p = {"icon", 96, 96, {}, {}};
+    const uint16_t byteWidth = (p.width + 7) / 8;
+    p.mask.assign(byteWidth * p.height, 0);
+    for (int y = 0; y < p.height; y++) {
+        for (int x = 0; x < p.width; x++) {
+            const int dx = x - 48, dy = y - 48;
+            p.pixels.push_back(std::abs(dx + dy / 2) < 6 ? rgb(255, 255, 255) : rgb(30, 170, 80));
+            if (dx * dx + dy * dy < 44 * 44) {
+                p.mask[y * byteWidth + x / 8] |= 0x80 >> (x & 7);
+            }
+        }
+    }
+    return p;
+}
+
+/// @brief Opaque picture; its runs fit the PSRAM cache.
+Picture photo() {
+    Picture p = {"photo", 240, 180, {}, {}};
+    for (int y = 0; y < p.height; y++) {
+        for (int x = 0; x < p.width; x++) {
+            const int v = static_cast<int>(128 + 60 * std::sin(x / 23.0) * std::cos(y / 17.0));
+            p.pixels.push_back(rgb(v + 40, v, 90));
+        }
+    }
+    return p;
+}
+
+/// @brief The rotation Image::drawRotatedImage() did before ImageRotator (mask read as bits).
+void legacyRotate(Arduino_GFX *gfx, const Picture &p, float angle, int16_t xPos, int16_t yPos) {
+    const float angleRad = angle * PI / 180.0f;
+    const float cosAngle = cos(angleRad);
+    const float sinAngle = sin(angleRad);
+    const float centerX = p.width / 2.0f;
+    const float centerY = p.height / 2.0f;
+    const int rotatedWidth = (int)(p.width * fabs(cosAngle) + p.height * fabs(sinAngle));
+    const int rotatedHeight = (int)(p.width * fabs(sinAngle) + p.height * fabs(cosAngle));
+    const uint16_t byteWidth = (p.width + 7) / 8;
+    for (int y = 0; y < rotatedHeight; y++) {
+        for (int x = 0; x < rotatedWidth; x++) {
+            const float relX = x - rotatedWidth / 2.0f;
+            const float relY = y - rotatedHeight / 2.0f;
+            const float origX = relX * cosAngle + relY * sinAngle + centerX;
+            const float origY = -relX * sinAngle + relY * cosAngle + centerY;
+            if (origX >= 0 && origX < p.width && origY >= 0 && origY < p.height) {
+                const int ox = (int)origX, oy = (int)origY;
+                if (!p.mask.empty() && !(p.mask[oy * byteWidth + ox / 8] & (0x80 >> (ox & 7)))) {
+                    continue;
+                }
+                gfx->drawPixel(xPos + x - rotatedWidth / 2 + p.width / 2, yPos + y - rotatedHeight / 2 + p.height / 2,
+                               p.pixels[oy * p.width + ox]);
+            }
+        }
+    }
+}
+
+template <typename Fn>
+double timeUs(int runs, Fn fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        fn();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / runs;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int runs = 50;
+    const char *outPath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            runs = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [-n runs] [-o file.csv]\n", argv[0]);
+            return 1;
+        }
+    }
+    FILE *out = outPath ? fopen(outPath, "w") : stdout;
+    if (!out) {
+        perror(outPath);
+        return 1;
+    }
+
+    HostDisplay tft(480, 320);
+    tft.begin();
+    const size_t frameBytes = static_cast<size_t>(tft.width()) * tft.height() * sizeof(uint16_t);
+    std::vector<uint16_t> directFrame(tft.width() * tft.height());
+
+    fprintf(out, "image,angle,legacy_us,legacy_calls,direct_us,direct_calls,cached_us,cached_calls,sweep_us,cached,match\n");
+    for (const Picture &p : {needle(), icon(), photo()}) {
+        const uint8_t *mask = p.mask.empty() ? nullptr : p.mask.data();
+        const int16_t xPos = (tft.width() - p.width) / 2;
+        const int16_t yPos = (tft.height() - p.height) / 2;
+        const float centerX = xPos + p.width / 2.0f;
+        const float centerY = yPos + p.height / 2.0f;
+        for (float angle : {15.0f, 45.0f, 90.0f, 200.0f}) {
+            tft.resetStats();
+            const double legacyUs = timeUs(runs, [&] { legacyRotate(&tft, p, angle, xPos, yPos); });
+            const uint32_t legacyCalls = tft.getStats().transactions / runs;
+
+            ImageRotator direct(false);
+            tft.fillScreen(0);
+            tft.resetStats();
+            const double directUs = timeUs(runs, [&] {
+                direct.draw(&tft, p.pixels.data(), mask, p.width, p.height, angle, p.width / 2.0f, p.height / 2.0f,
+                            centerX, centerY);
+            });
+            const uint32_t directCalls = tft.getStats().transactions / runs;
+            memcpy(directFrame.data(), tft.getFramebuffer(), frameBytes);
+
+            // The rotation is cached on its second draw
+            ImageRotator cached;
+            tft.fillScreen(0);
+            for (int i = 0; i < 2; i++) {
+                cached.draw(&tft, p.pixels.data(), mask, p.width, p.height, angle, p.width / 2.0f, p.height / 2.0f,
+                            centerX, centerY);
+            }
+            tft.resetStats();
+            const double cachedUs = timeUs(runs, [&] {
+                cached.draw(&tft, p.pixels.data(), mask, p.width, p.height, angle, p.width / 2.0f, p.height / 2.0f,
+                            centerX, centerY);
+            });
+            const uint32_t cachedCalls = tft.getStats().transactions / runs;
+            const bool match = memcmp(directFrame.data(), tft.getFramebuffer(), frameBytes) == 0;
+
+            ImageRotator sweep;
+            int step = 0;
+            const double sweepUs = timeUs(runs, [&] {
+                sweep.draw(&tft, p.pixels.data(), mask, p.width, p.height, angle + 0.5f * (step++ % 20),
+                           p.width / 2.0f, p.height / 2.0f, centerX, centerY);
+            });
+
+            fprintf(out, "%s,%.0f,%.1f,%u,%.1f,%u,%.1f,%u,%.1f,%d,%d\n", p.name, angle, legacyUs, (unsigned)legacyCalls,
+                    directUs, (unsigned)directCalls, cachedUs, (unsigned)cachedCalls, sweepUs, cached.isCached() ? 1 : 0,
+                    match ? 1 : 0);
+        }
+    }
+    if (out != stdout) {
+        fclose(out);
+    }
+    hostStopTasks();
+    return 0;
+}
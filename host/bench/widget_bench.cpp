@@ -0,0 +1,424 @@
+// widget_bench.cpp
+// Rendering benchmark of every widget type on the host display. Each widget is measured at
+// three sizes (screen and widget scaled together) in three phases:
+//
+//   setup  - construction and setup(config), once
+//   full   - fullRedraw() (the screen load path), averaged over N runs
+//   update - a typical value change followed by refresh(), averaged over N runs
+//
+// One CSV row is written per widget, size and phase with the time, the pixels written to the
+// panel and the draw calls (outermost write transactions and bitmap blits) it took.
+//
+//   ./widget_bench [-n runs] [-o file.csv] [--stripe] [--glyph-cache] [--text-metrics]
+//
+// --stripe enables DisplayFK's stripe buffer, so text and needles are composed off-screen and
+// counted as the blits that reach the panel. --glyph-cache prints text from the glyph cache and
+// --text-metrics measures it through the text metrics cache.
+#include <Arduino_GFX_Library.h>
+#include <displayfk.h>
+#include <dfk_host.h>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct SizeClass {
+    const char *name;
+    int16_t screenW;
+    int16_t screenH;
+    float scale;
+};
+
+const SizeClass SIZES[] = {
+    {"S", 320, 240, 1.0f},
+    {"M", 480, 320, 1.5f},
+    {"L", 800, 480, 2.5f},
+};
+
+struct BenchCase {
+    const char *widget;
+    std::function<WidgetBase *(const SizeClass &)> setup;       ///< Creates and configures the widget.
+    std::function<void(WidgetBase *)> full;                    ///< Draws it whole (default fullRedraw()).
+    std::function<void(WidgetBase *, int)> update;             ///< Changes its value for run i.
+    std::function<void(WidgetBase *)> reset;                   ///< Untimed, every RESET_EVERY updates.
+};
+
+/// Input fields hold 64 characters; keyboards are reset before they fill up.
+const int RESET_EVERY = 32;
+
+struct Sample {
+    double totalUs;
+    double minUs;
+    uint64_t pixels;
+    uint64_t calls;
+    int runs;
+};
+
+HostDisplay *tft = nullptr;
+DisplayFK myDisplay;
+
+uint16_t px(const SizeClass &s, int v) {
+    return static_cast<uint16_t>(v * s.scale);
+}
+
+void noop_cb() {}
+void noop_screen() {}
+
+const int gaugeIntervals[] = {0, 40, 70};
+const uint16_t gaugeColors[] = {CFK_COLOR16, CFK_COLOR08, CFK_COLOR01};
+uint16_t chartColors[] = {CFK_COLOR01, CFK_COLOR24};
+std::vector<pixel_t> imagePixels;
+SevenSegmentStyle_t segmentStyle = {};
+NumberBox *numpadField = nullptr;
+
+/// @brief Runs fn the given number of times and accumulates time and panel work.
+/// @param prepare Optional, called before run i outside of the measurement.
+template <typename Fn>
+Sample measure(int runs, Fn fn, std::function<void(int)> prepare = nullptr) {
+    Sample s = {0, 1e12, 0, 0, runs};
+    for (int i = 0; i < runs; i++) {
+        if (prepare) {
+            prepare(i);
+        }
+        tft->resetStats();
+        auto t0 = std::chrono::steady_clock::now();
+        fn(i);
+        auto t1 = std::chrono::steady_clock::now();
+        double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        s.totalUs += us;
+        s.minUs = std::min(s.minUs, us);
+        s.pixels += tft->getStats().pixels;
+        s.calls += tft->getStats().transactions;
+    }
+    return s;
+}
+
+void writeRow(FILE *out, const char *mode, const char *widget, const SizeClass &size, const char *phase,
+              const Sample &s) {
+    fprintf(out, "%s,%s,%s,%dx%d,%s,%d,%.2f,%.2f,%llu,%llu\n", mode, widget, size.name, size.screenW,
+            size.screenH, phase, s.runs, s.totalUs / s.runs, s.minUs,
+            static_cast<unsigned long long>(s.pixels / s.runs), static_cast<unsigned long long>(s.calls / s.runs));
+}
+
+std::vector<BenchCase> buildCases() {
+    std::vector<BenchCase> cases;
+
+    cases.push_back({"Label", [](const SizeClass &s) -> WidgetBase * {
+        Label *w = new Label(px(s, 10), px(s, 10), 0);
+        LabelConfig c = {"Temperature", "T: ", " C", &RobotoRegular10pt7b, TL_DATUM, CFK_BLACK, CFK_WHITE};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<Label *>(w)->setTextInt(1000 + i * 37); }});
+
+    // Seven-segment readout: the update repaints the segments that changed; the "full" case
+    // forces the whole string each time, as before the segment diff
+    for (bool diff : {true, false}) {
+        cases.push_back({diff ? "SevenSegment" : "SevenSegmentFull", [](const SizeClass &s) -> WidgetBase * {
+            segmentStyle = {px(s, 20), px(s, 36), 0, 0, static_cast<uint8_t>(px(s, 4)), CFK_GREY11};
+            Label *w = new Label(px(s, 10), px(s, 10), 0);
+            LabelConfig c = {"1000", nullptr, nullptr, nullptr, TL_DATUM, CFK_COLOR01, CFK_BLACK};
+            w->setup(c);
+            w->setSevenSegment(&segmentStyle);
+            return w;
+        }, nullptr, [diff](WidgetBase *w, int i) {
+            if (!diff) {
+                w->forceUpdate();
+            }
+            static_cast<Label *>(w)->setTextInt(1000 + i * 37);
+        }});
+    }
+
+    cases.push_back({"TextButton", [](const SizeClass &s) -> WidgetBase * {
+        TextButton *w = new TextButton(px(s, 10), px(s, 10), 0);
+        TextButtonConfig c = {"Start", noop_cb, &RobotoRegular10pt7b, px(s, 100), px(s, 40), px(s, 8),
+                              CFK_COLOR24, CFK_WHITE};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int) { w->forceUpdate(); }});
+
+    cases.push_back({"RectButton", [](const SizeClass &s) -> WidgetBase * {
+        RectButton *w = new RectButton(px(s, 10), px(s, 10), 0);
+        RectButtonConfig c = {noop_cb, px(s, 80), px(s, 40), CFK_COLOR31};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<RectButton *>(w)->setStatus(i % 2 == 0); }});
+
+    cases.push_back({"CircleButton", [](const SizeClass &s) -> WidgetBase * {
+        CircleButton *w = new CircleButton(px(s, 50), px(s, 50), 0);
+        CircleButtonConfig c = {noop_cb, px(s, 30), CFK_COLOR16};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<CircleButton *>(w)->setStatus(i % 2 == 0); }});
+
+    cases.push_back({"ToggleButton", [](const SizeClass &s) -> WidgetBase * {
+        ToggleButton *w = new ToggleButton(px(s, 10), px(s, 10), 0);
+        ToggleButtonConfig c = {noop_cb, px(s, 70), px(s, 35), CFK_COLOR16};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<ToggleButton *>(w)->setStatus(i % 2 == 0); }});
+
+    cases.push_back({"CheckBox", [](const SizeClass &s) -> WidgetBase * {
+        CheckBox *w = new CheckBox(px(s, 10), px(s, 10), 0);
+        CheckBoxConfig c = {noop_cb, CheckBoxWeight::MEDIUM, px(s, 24), CFK_COLOR16, 0};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<CheckBox *>(w)->setStatus(i % 2 == 0); }});
+
+    cases.push_back({"RadioGroup", [](const SizeClass &s) -> WidgetBase * {
+        static radio_t buttons[3];
+        for (uint8_t b = 0; b < 3; b++) {
+            buttons[b] = {px(s, 30), static_cast<uint16_t>(px(s, 30) + b * px(s, 30)), CFK_COLOR24,
+                          static_cast<uint8_t>(b + 1)};
+        }
+        RadioGroup *w = new RadioGroup(0);
+        RadioGroupConfig c = {buttons, noop_cb, px(s, 10), 1, 3, 1};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<RadioGroup *>(w)->setSelected(1 + i % 3); }});
+
+    cases.push_back({"Led", [](const SizeClass &s) -> WidgetBase * {
+        Led *w = new Led(px(s, 40), px(s, 40), 0);
+        LedConfig c = {px(s, 16), CFK_COLOR18, 0, false};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<Led *>(w)->setState(i % 2 == 0); }});
+
+    cases.push_back({"HSlider", [](const SizeClass &s) -> WidgetBase * {
+        HSlider *w = new HSlider(px(s, 20), px(s, 20), 0);
+        HSliderConfig c = {noop_cb, nullptr, 0, 100, px(s, 12), px(s, 200), CFK_COLOR25, CFK_WHITE};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<HSlider *>(w)->setValue((i * 7) % 101); }});
+
+    cases.push_back({"SpinBox", [](const SizeClass &s) -> WidgetBase * {
+        SpinBox *w = new SpinBox(px(s, 10), px(s, 10), 0);
+        SpinBoxConfig c = {noop_cb, 0, 1000, 50, px(s, 120), px(s, 40), 1, CFK_COLOR25, CFK_BLACK};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<SpinBox *>(w)->setValue(i % 1000); }});
+
+    cases.push_back({"NumberBox", [](const SizeClass &s) -> WidgetBase * {
+        NumberBox *w = new NumberBox(px(s, 10), px(s, 10), 0);
+        NumberBoxConfig c = {noop_screen, noop_cb, &RobotoRegular10pt7b, 12.5f, px(s, 100), px(s, 24),
+                             CFK_BLACK, CFK_WHITE, 2};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<NumberBox *>(w)->setValue(12.5 + i * 0.25); }});
+
+    cases.push_back({"TextBox", [](const SizeClass &s) -> WidgetBase * {
+        TextBox *w = new TextBox(px(s, 10), px(s, 10), 0);
+        TextBoxConfig c = {"Hello", noop_screen, noop_cb, &RobotoRegular10pt7b, px(s, 120), px(s, 24),
+                           CFK_BLACK, CFK_WHITE};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<TextBox *>(w)->setValue(i % 2 ? "Hello" : "World"); }});
+
+    cases.push_back({"CircularBar", [](const SizeClass &s) -> WidgetBase * {
+        CircularBar *w = new CircularBar(px(s, 60), px(s, 60), 0);
+        CircularBarConfig c = {0, 100, px(s, 50), 0, 360, CFK_COLOR08, CFK_GREY11, CFK_BLACK, CFK_WHITE,
+                               static_cast<uint8_t>(px(s, 10)), true, false};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<CircularBar *>(w)->setValue((i * 7) % 101); }});
+
+    cases.push_back({"GaugeSuper", [](const SizeClass &s) -> WidgetBase * {
+        GaugeSuper *w = new GaugeSuper(px(s, 110), px(s, 90), 0);
+        GaugeConfig c = {"Pressure", gaugeIntervals, gaugeColors, &RobotoRegular10pt7b, 0, 100, px(s, 200),
+                         px(s, 120), CFK_BLACK, CFK_BLACK, CFK_WHITE, CFK_BLACK, CFK_COLOR01, CFK_BLACK, 3, true};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<GaugeSuper *>(w)->setValue((i * 7) % 101); }});
+
+    cases.push_back({"Thermometer", [](const SizeClass &s) -> WidgetBase * {
+        Thermometer *w = new Thermometer(px(s, 20), px(s, 10), 0);
+        ThermometerConfig c = {nullptr, "C", 0, 100, px(s, 30), px(s, 120), CFK_COLOR01, CFK_WHITE, CFK_BLACK, 1};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<Thermometer *>(w)->setValue((i * 7) % 101); }});
+
+    cases.push_back({"VBar", [](const SizeClass &s) -> WidgetBase * {
+        VBar *w = new VBar(px(s, 20), px(s, 10), 0);
+        VerticalBarConfig c = {nullptr, 0, 100, px(s, 4), Orientation::VERTICAL, px(s, 30), px(s, 120), CFK_COLOR16};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<VBar *>(w)->setValue((i * 7) % 101); }});
+
+    cases.push_back({"VAnalog", [](const SizeClass &s) -> WidgetBase * {
+        VAnalog *w = new VAnalog(px(s, 20), px(s, 10), 0);
+        VerticalAnalogConfig c = {0, 100, px(s, 40), px(s, 140), CFK_COLOR01, CFK_BLACK, CFK_WHITE, CFK_BLACK, 10};
+        w->setup(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) { static_cast<VAnalog *>(w)->setValue((i * 7) % 101, true); }});
+
+    cases.push_back({"LineChart", [](const SizeClass &s) -> WidgetBase * {
+        LineChart *w = new LineChart(px(s, 10), px(s, 10), 0);
+        LineChartConfig c = {chartColors, nullptr, &RobotoRegular10pt7b, 0, 100, px(s, 240), px(s, 140),
+                             CFK_GREY11, CFK_BLACK, CFK_WHITE, CFK_BLACK, 10, 60, 2, false, true, false, false};
+        w->setup(c);
+        for (int p = 0; p < 60; p++) {
+            w->push(0, (p * 13) % 100);
+            w->push(1, (p * 29) % 100);
+        }
+        return w;
+    }, nullptr, [](WidgetBase *w, int i) {
+        LineChart *chart = static_cast<LineChart *>(w);
+        chart->push(0, (i * 13) % 100);
+        chart->push(1, (i * 29) % 100);
+    }});
+
+    cases.push_back({"Image", [](const SizeClass &s) -> WidgetBase * {
+        uint16_t side = px(s, 64);
+        imagePixels.resize(static_cast<size_t>(side) * side);
+        for (uint16_t y = 0; y < side; y++) {
+            for (uint16_t x = 0; x < side; x++) {
+                imagePixels[y * side + x] = RGB565(x * 255 / side, y * 255 / side, 128);
+            }
+        }
+        Image *w = new Image(px(s, 10), px(s, 10), 0);
+        ImageFromPixelsConfig c = {imagePixels.data(), nullptr, nullptr, 0.0f, side, side, CFK_WHITE};
+        w->setupFromPixels(c);
+        return w;
+    }, nullptr, [](WidgetBase *w, int) { w->forceUpdate(); }});
+
+    cases.push_back({"WKeyboard", [](const SizeClass &s) -> WidgetBase * {
+        static TextBox *field = nullptr;
+        delete field;
+        field = new TextBox(0, 0, 0);
+        TextBoxConfig c = {"abc", noop_screen, noop_cb, &RobotoRegular10pt7b, px(s, 120), px(s, 24),
+                           CFK_BLACK, CFK_WHITE};
+        field->setup(c);
+        WKeyboard *w = new WKeyboard();
+        w->setup();
+        w->open(field);
+        return w;
+    }, [](WidgetBase *w) { static_cast<WKeyboard *>(w)->drawKeys(true, false); },
+    [](WidgetBase *w, int i) { static_cast<WKeyboard *>(w)->insertChar(static_cast<char>('a' + i % 26)); },
+    [](WidgetBase *w) { static_cast<WKeyboard *>(w)->clear(); }});
+
+    cases.push_back({"Numpad", [](const SizeClass &s) -> WidgetBase * {
+        delete numpadField;
+        numpadField = new NumberBox(0, 0, 0);
+        NumberBoxConfig c = {noop_screen, noop_cb, &RobotoRegular10pt7b, 1.0f, px(s, 100), px(s, 24),
+                             CFK_BLACK, CFK_WHITE, 2};
+        numpadField->setup(c);
+        Numpad *w = new Numpad();
+        w->setup();
+        w->open(numpadField);
+        return w;
+    }, [](WidgetBase *w) { static_cast<Numpad *>(w)->drawKeys(true, false); },
+    [](WidgetBase *w, int i) { static_cast<Numpad *>(w)->insertChar(static_cast<char>('0' + i % 10)); },
+    [](WidgetBase *w) {
+        // Numpad has no public clear(); reopening loads the (short) value of the field again
+        static_cast<Numpad *>(w)->close();
+        static_cast<Numpad *>(w)->open(numpadField);
+    }});
+
+    return cases;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int runs = 20;
+    const char *outPath = nullptr;
+    bool stripe = false;
+    bool glyphs = false;
+    bool metrics = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            runs = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (strcmp(argv[i], "--stripe") == 0) {
+            stripe = true;
+        } else if (strcmp(argv[i], "--glyph-cache") == 0) {
+            glyphs = true;
+        } else if (strcmp(argv[i], "--text-metrics") == 0) {
+            metrics = true;
+        } else {
+            fprintf(stderr, "usage: %s [-n runs] [-o file.csv] [--stripe] [--glyph-cache] [--text-metrics]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    FILE *out = outPath ? fopen(outPath, "w") : stdout;
+    if (!out) {
+        perror(outPath);
+        return 1;
+    }
+    std::string modeName = stripe ? "stripe" : "direct";
+    if (glyphs) {
+        modeName += "+glyphs";
+    }
+    if (metrics) {
+        modeName += "+metrics";
+    }
+    const char *mode = modeName.c_str();
+
+    fprintf(out, "mode,widget,size,screen,phase,runs,mean_us,min_us,pixels,draw_calls\n");
+    std::vector<BenchCase> cases = buildCases();
+    myDisplay.setup(); // callback queue used by setStatus() & co; drained after every update
+    delay(TIMEOUT_REDRAW); // widgets skip redraws this soon after boot (debounce from m_myTime = 0)
+    for (const SizeClass &size : SIZES) {
+        tft = new HostDisplay(size.screenW, size.screenH);
+        tft->begin();
+        myDisplay.setDrawObject(tft);
+        if (stripe) {
+            myDisplay.enableStripeRendering();
+        }
+        if (glyphs) {
+            myDisplay.enableGlyphCache();
+        }
+        if (metrics) {
+            myDisplay.enableTextMetricsCache();
+        }
+        WidgetBase::currentScreen = 0;
+        WidgetBase::backgroundColor = CFK_WHITE;
+
+        for (const BenchCase &bc : cases) {
+            tft->fillScreen(CFK_WHITE);
+            WidgetBase::usingKeyboard = false;
+
+            WidgetBase *widget = nullptr;
+            Sample setup = measure(1, [&](int) { widget = bc.setup(size); });
+            writeRow(out, mode, bc.widget, size, "setup", setup);
+
+            Sample full = measure(runs, [&](int) {
+                if (bc.full) {
+                    bc.full(widget);
+                } else {
+                    widget->fullRedraw();
+                }
+            });
+            writeRow(out, mode, bc.widget, size, "full", full);
+
+            Sample update = measure(runs, [&](int i) {
+                bc.update(widget, i);
+                widget->refresh();
+                xQueueReset(WidgetBase::xFilaCallback);
+            }, [&](int i) {
+                if (bc.reset && i > 0 && i % RESET_EVERY == 0) {
+                    bc.reset(widget);
+                    xQueueReset(WidgetBase::xFilaCallback);
+                }
+            });
+            writeRow(out, mode, bc.widget, size, "update", update);
+
+            delete widget;
+        }
+
+        myDisplay.setDrawObject(nullptr);
+        delete tft;
+        tft = nullptr;
+    }
+    WidgetBase::usingKeyboard = false;
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    hostStopTasks();
+    return 0;
+}
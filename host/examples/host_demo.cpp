@@ -0,0 +1,175 @@
+// host_demo.cpp
+// Runs a DisplayFK screen in a Linux process: the library task draws into a HostDisplay,
+// touches are injected through the emulated GT911 and frames are written as PNG files.
+//
+//   ./host_demo [output_dir]
+#include <Arduino_GFX_Library.h>
+#include <displayfk.h>
+#include <dfk_host.h>
+
+const int DISPLAY_W = 480;
+const int DISPLAY_H = 320;
+
+HostDisplay *tft = nullptr;
+DisplayFK myDisplay;
+
+Label title(20, 20, 0);
+TextButton okButton(20, 70, 0);
+ToggleButton wifi(200, 75, 0);
+CircularBar load(380, 110, 0);
+RectButton rectButton(20, 160, 0);
+HSlider slider(200, 180, 0);
+
+Label *arrayLabel[] = {&title};
+TextButton *arrayTextButton[] = {&okButton};
+ToggleButton *arrayToggle[] = {&wifi};
+CircularBar *arrayCircularbar[] = {&load};
+RectButton *arrayRectbtn[] = {&rectButton};
+HSlider *arrayHslider[] = {&slider};
+
+volatile int okClicks = 0;
+
+void okButton_cb() {
+    okClicks++;
+}
+
+void widget_cb() {
+}
+
+void screen0() {
+    tft->fillScreen(CFK_WHITE);
+    WidgetBase::backgroundColor = CFK_WHITE;
+    tft->drawRoundRect(5, 5, DISPLAY_W - 10, DISPLAY_H - 10, 8, CFK_BLACK);
+    myDisplay.drawWidgetsOnScreen(0);
+}
+
+void loadWidgets() {
+    LabelConfig configLabel = {
+        .text = "DisplayFK on host",
+        .prefix = "",
+        .suffix = "",
+        .fontFamily = &RobotoRegular10pt7b,
+        .datum = TL_DATUM,
+        .fontColor = CFK_BLACK,
+        .backgroundColor = CFK_WHITE
+    };
+    title.setup(configLabel);
+    myDisplay.setLabel(arrayLabel, 1);
+
+    TextButtonConfig configButton = {
+        .text = "OK",
+        .callback = okButton_cb,
+        .fontFamily = &RobotoRegular10pt7b,
+        .width = 120,
+        .height = 45,
+        .radius = 10,
+        .backgroundColor = CFK_COLOR24,
+        .textColor = CFK_WHITE
+    };
+    okButton.setup(configButton);
+    myDisplay.setTextButton(arrayTextButton, 1);
+
+    ToggleButtonConfig configToggle = {
+        .callback = widget_cb,
+        .width = 90,
+        .height = 45,
+        .pressedColor = CFK_COLOR16
+    };
+    wifi.setup(configToggle);
+    myDisplay.setToggle(arrayToggle, 1);
+
+    CircularBarConfig configBar = {
+        .minValue = 0,
+        .maxValue = 100,
+        .radius = 60,
+        .startAngle = 0,
+        .endAngle = 360,
+        .color = CFK_COLOR08,
+        .backgroundColor = CFK_GREY11,
+        .textColor = CFK_BLACK,
+        .backgroundText = CFK_WHITE,
+        .thickness = 12,
+        .showValue = true,
+        .inverted = false
+    };
+    load.setup(configBar);
+    myDisplay.setCircularBar(arrayCircularbar, 1);
+
+    RectButtonConfig configRect = {
+        .callback = widget_cb,
+        .width = 120,
+        .height = 60,
+        .pressedColor = CFK_COLOR31
+    };
+    rectButton.setup(configRect);
+    myDisplay.setRectButton(arrayRectbtn, 1);
+
+    HSliderConfig configSlider = {
+        .callback = widget_cb,
+        .subtitle = nullptr,
+        .minValue = 0,
+        .maxValue = 100,
+        .radius = 14,
+        .width = 250,
+        .pressedColor = CFK_COLOR25,
+        .backgroundColor = CFK_WHITE
+    };
+    slider.setup(configSlider);
+    myDisplay.setHSlider(arrayHslider, 1);
+}
+
+/// @brief Holds the finger down long enough for the touch task to see it, then lifts it.
+void tap(uint16_t x, uint16_t y) {
+    hostTouchPress(x, y);
+    delay(150);
+    hostTouchRelease();
+    delay(150);
+}
+
+/// @brief Saves the screen while the library task is not drawing.
+void saveFrame(const String &dir, const char *name) {
+    myDisplay.startCustomDraw();
+    String path = dir + "/" + name;
+    bool ok = tft->savePNG(path.c_str());
+    myDisplay.finishCustomDraw();
+    Serial.printf("%s %s\n", ok ? "saved" : "failed", path.c_str());
+}
+
+int main(int argc, char **argv) {
+    String outDir = argc > 1 ? argv[1] : ".";
+    Serial.begin(115200);
+
+    tft = new HostDisplay(DISPLAY_W, DISPLAY_H);
+    tft->begin();
+    myDisplay.setDrawObject(tft);
+
+    hostTouchBegin(DISPLAY_W, DISPLAY_H);
+    myDisplay.setTouchCorners(0, DISPLAY_W - 1, 0, DISPLAY_H - 1);
+    myDisplay.startTouchGT911(DISPLAY_W, DISPLAY_H, 0, -1, -1, -1, -1);
+
+    loadWidgets();
+    WidgetBase::loadScreen = screen0;
+    myDisplay.createTask(false, 3);
+
+    delay(500);
+    saveFrame(outDir, "frame0_start.png");
+
+    for (int v = 0; v <= 100; v += 25) {
+        load.setValue(v);
+        delay(100);
+    }
+    title.setText("Values updated");
+    delay(200);
+    saveFrame(outDir, "frame1_values.png");
+
+    tap(80, 92);   // OK button
+    tap(245, 97);  // toggle
+    tap(80, 190);  // rect button
+    tap(300, 195); // slider
+    delay(200);
+    saveFrame(outDir, "frame2_touched.png");
+
+    Serial.printf("OK clicks: %d, toggle: %s\n", okClicks, wifi.getStatus() ? "on" : "off");
+    hostStopTasks();
+    return 0;
+}
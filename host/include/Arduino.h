@@ -0,0 +1,237 @@
+// Arduino.h (host)
+// Subset of the Arduino-ESP32 core used by DisplayFK, implemented for a Linux process.
+#ifndef DFK_HOST_ARDUINO_H
+#define DFK_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+#include "esp32-hal.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/timers.h"
+
+using std::min;
+using std::max;
+
+#define ARDUINO_ARCH_ESP32 1
+#define DFK_HOST 1
+
+#define PROGMEM
+#define IRAM_ATTR
+#define ARDUINO_ISR_ATTR
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_float(addr) (*(const float *)(addr))
+#define pgm_read_ptr(addr) (*(void *const *)(addr))
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define PULLUP 0x04
+#define INPUT_PULLUP 0x05
+#define PULLDOWN 0x08
+#define INPUT_PULLDOWN 0x09
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define sq(x) ((x) * (x))
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bit(b) (1UL << (b))
+#define digitalPinToInterrupt(p) (p)
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef uint16_t word;
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void attachInterruptArg(uint8_t pin, void (*handler)(void *), void *arg, int mode);
+void detachInterrupt(uint8_t pin);
+bool ledcAttach(uint8_t pin, uint32_t freq, uint8_t resolution);
+bool ledcWrite(uint8_t pin, uint32_t duty);
+
+bool psramFound();
+void *ps_malloc(size_t size);
+
+inline bool isDigit(int c) { return isdigit(c) != 0; }
+inline bool isAlpha(int c) { return isalpha(c) != 0; }
+inline bool isAlphaNumeric(int c) { return isalnum(c) != 0; }
+inline bool isSpace(int c) { return isspace(c) != 0; }
+inline bool isPrintable(int c) { return isprint(c) != 0; }
+
+char *dtostrf(double val, signed char width, unsigned char prec, char *sout);
+char *itoa(int value, char *str, int base);
+char *ltoa(long value, char *str, int base);
+char *utoa(unsigned value, char *str, int base);
+
+/// @brief Arduino String backed by std::string.
+class String {
+public:
+    String(const char *s = "") : m_s(s ? s : "") {}
+    String(const std::string &s) : m_s(s) {}
+    String(char c) : m_s(1, c) {}
+    String(int v, unsigned char base = 10);
+    String(unsigned int v, unsigned char base = 10);
+    String(long v, unsigned char base = 10);
+    String(unsigned long v, unsigned char base = 10);
+    String(float v, unsigned int decimals = 2);
+    String(double v, unsigned int decimals = 2);
+
+    const char *c_str() const { return m_s.c_str(); }
+    unsigned int length() const { return m_s.size(); }
+    bool isEmpty() const { return m_s.empty(); }
+    char charAt(unsigned int i) const { return i < m_s.size() ? m_s[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+    char &operator[](unsigned int i) { return m_s[i]; }
+    void setCharAt(unsigned int i, char c) { if (i < m_s.size()) m_s[i] = c; }
+
+    String &operator=(const char *s) { m_s = s ? s : ""; return *this; }
+    String &operator+=(const String &s) { m_s += s.m_s; return *this; }
+    String &operator+=(const char *s) { if (s) m_s += s; return *this; }
+    String &operator+=(char c) { m_s += c; return *this; }
+    String &operator+=(int v) { return *this += String(v); }
+    String &operator+=(unsigned int v) { return *this += String(v); }
+    String &operator+=(long v) { return *this += String(v); }
+    String &operator+=(unsigned long v) { return *this += String(v); }
+    String &operator+=(float v) { return *this += String(v); }
+    String &operator+=(double v) { return *this += String(v); }
+    bool concat(const String &s) { m_s += s.m_s; return true; }
+
+    friend String operator+(const String &a, const String &b) { return String(a.m_s + b.m_s); }
+    friend String operator+(const String &a, const char *b) { return String(a.m_s + (b ? b : "")); }
+    friend String operator+(const char *a, const String &b) { return String(std::string(a ? a : "") + b.m_s); }
+    bool operator==(const String &o) const { return m_s == o.m_s; }
+    bool operator==(const char *o) const { return m_s == (o ? o : ""); }
+    bool operator!=(const String &o) const { return m_s != o.m_s; }
+    bool operator!=(const char *o) const { return !(*this == o); }
+    bool operator<(const String &o) const { return m_s < o.m_s; }
+    bool equals(const String &o) const { return m_s == o.m_s; }
+    bool equalsIgnoreCase(const String &o) const;
+
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String &s, unsigned int from = 0) const;
+    int lastIndexOf(char c) const;
+    String substring(unsigned int from) const;
+    String substring(unsigned int from, unsigned int to) const;
+    bool startsWith(const String &s) const;
+    bool endsWith(const String &s) const;
+    void replace(const String &from, const String &to);
+    void remove(unsigned int index, unsigned int count = (unsigned int)-1);
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+    long toInt() const { return atol(m_s.c_str()); }
+    float toFloat() const { return (float)atof(m_s.c_str()); }
+    double toDouble() const { return atof(m_s.c_str()); }
+    void toCharArray(char *buf, unsigned int size, unsigned int index = 0) const;
+    void getBytes(unsigned char *buf, unsigned int size, unsigned int index = 0) const;
+    bool reserve(unsigned int size) { m_s.reserve(size); return true; }
+
+private:
+    std::string m_s;
+};
+
+/// @brief Text output base class (Serial, displays).
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+
+    size_t print(const char *s) { return write(s); }
+    size_t print(const String &s) { return write(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char v, int base = 10) { return print((unsigned long)v, base); }
+    size_t print(int v, int base = 10) { return print((long)v, base); }
+    size_t print(unsigned int v, int base = 10) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = 10);
+    size_t print(unsigned long v, int base = 10);
+    size_t print(long long v, int base = 10) { return print((long)v, base); }
+    size_t print(unsigned long long v, int base = 10) { return print((unsigned long)v, base); }
+    size_t print(double v, int digits = 2);
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T &v) { size_t n = print(v); return n + println(); }
+    template <typename T>
+    size_t println(const T &v, int format) { size_t n = print(v, format); return n + println(); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    virtual void flush() {}
+};
+
+/// @brief Serial port mapped to the standard output of the process.
+class HardwareSerial : public Print {
+public:
+    using Print::write;
+    void begin(unsigned long baud = 115200, uint32_t config = 0, int8_t rxPin = -1, int8_t txPin = -1);
+    void end() {}
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    int available();
+    int read();
+    int peek();
+    void flush() override;
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+/// @brief Chip information and control.
+class EspClass {
+public:
+    void restart();
+    uint32_t getFreeHeap();
+    uint32_t getHeapSize();
+    uint32_t getFreePsram();
+    uint32_t getPsramSize();
+    uint32_t getCpuFreqMHz() { return 240; }
+    const char *getChipModel() { return "host"; }
+};
+
+extern EspClass ESP;
+
+#endif // DFK_HOST_ARDUINO_H
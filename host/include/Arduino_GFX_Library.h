@@ -0,0 +1,144 @@
+// Arduino_GFX_Library.h (host)
+// Software implementation of the Arduino_GFX drawing API. Every primitive is clipped and
+// reduced to writePixelPreclipped() / writeFillRectPreclipped(), the same extension points
+// the real library offers, so subclasses written for the ESP32 (StripeCanvas,
+// FrameBufferCanvas) run unchanged. HostDisplay (dfk_host.h) is the in-memory panel.
+#ifndef DFK_HOST_ARDUINO_GFX_LIBRARY_H
+#define DFK_HOST_ARDUINO_GFX_LIBRARY_H
+
+#include "Arduino.h"
+
+#define GFX_NOT_DEFINED -1
+#define GFX_SKIP_OUTPUT_BEGIN -2
+
+/// @brief Glyph of an Adafruit GFX font.
+typedef struct {
+    uint16_t bitmapOffset; ///< Offset of the glyph in the font bitmap.
+    uint8_t width;         ///< Bitmap width in pixels.
+    uint8_t height;        ///< Bitmap height in pixels.
+    uint8_t xAdvance;      ///< Distance to the next cursor position.
+    int8_t xOffset;        ///< X distance from the cursor to the upper-left corner.
+    int8_t yOffset;        ///< Y distance from the cursor (baseline) to the upper-left corner.
+} GFXglyph;
+
+/// @brief Adafruit GFX font.
+typedef struct {
+    uint8_t *bitmap;  ///< Concatenated glyph bitmaps.
+    GFXglyph *glyph;  ///< Glyph array.
+    uint16_t first;   ///< First character code.
+    uint16_t last;    ///< Last character code.
+    uint8_t yAdvance; ///< Line height.
+} GFXfont;
+
+#define RGB565(r, g, b) ((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3))
+#define RGB565_BLACK RGB565(0, 0, 0)
+#define RGB565_WHITE RGB565(255, 255, 255)
+#define RGB565_RED RGB565(255, 0, 0)
+#define RGB565_GREEN RGB565(0, 255, 0)
+#define RGB565_BLUE RGB565(0, 0, 255)
+#define BLACK RGB565_BLACK
+#define WHITE RGB565_WHITE
+
+class Arduino_GFX : public Print {
+public:
+    Arduino_GFX(int16_t w, int16_t h);
+    virtual ~Arduino_GFX() {}
+
+    // Hooks implemented by every display or canvas
+    virtual bool begin(int32_t speed = GFX_NOT_DEFINED) = 0;
+    virtual void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) = 0;
+
+    // Low level writes (inside startWrite / endWrite)
+    virtual void startWrite() {}
+    virtual void endWrite() {}
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color);
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+
+    // Primitives
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color);
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void fillScreen(uint16_t color);
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    virtual void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawCircle(int16_t x, int16_t y, int16_t r, uint16_t color);
+    void drawCircleHelper(int16_t x, int16_t y, int16_t r, uint8_t cornername, uint16_t color);
+    void fillCircle(int16_t x, int16_t y, int16_t r, uint16_t color);
+    void fillCircleHelper(int16_t x, int16_t y, int16_t r, uint8_t corners, int16_t delta, uint16_t color);
+    void drawEllipse(int16_t x, int16_t y, int16_t rx, int16_t ry, uint16_t color);
+    void fillEllipse(int16_t x, int16_t y, int16_t rx, int16_t ry, uint16_t color);
+    void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+    void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+    void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+    void drawArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float end, uint16_t color);
+    void fillArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float end, uint16_t color);
+
+    // Bitmaps
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg);
+    void drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color);
+    void drawGrayscaleBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h);
+    virtual void draw16bitRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w, int16_t h);
+    virtual void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h);
+    void draw16bitRGBBitmapWithMask(int16_t x, int16_t y, const uint16_t bitmap[], const uint8_t mask[], int16_t w, int16_t h);
+    void draw16bitRGBBitmapWithMask(int16_t x, int16_t y, uint16_t *bitmap, uint8_t *mask, int16_t w, int16_t h);
+    void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h);
+    void draw24bitRGBBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h);
+
+    // Text
+    using Print::write;
+    size_t write(uint8_t c) override;
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg);
+    void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+    void setTextSize(uint8_t s) { setTextSize(s, s, 0); }
+    void setTextSize(uint8_t sx, uint8_t sy, uint8_t pixelMargin = 0);
+    void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+    void setTextWrap(bool w) { wrap = w; }
+    void setFont(const GFXfont *f);
+    void setUTF8Print(bool) {}
+    void getTextBounds(const char *string, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
+    void getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
+
+    // Display control
+    virtual void setRotation(uint8_t r);
+    uint8_t getRotation() const { return _rotation; }
+    virtual void invertDisplay(bool) {}
+    virtual void displayOn() {}
+    virtual void displayOff() {}
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+    static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) { return RGB565(r, g, b); }
+
+protected:
+    void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy);
+    void fillArcPixels(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float end, uint16_t color, bool outline);
+
+    int16_t WIDTH;          ///< Width in rotation 0.
+    int16_t HEIGHT;         ///< Height in rotation 0.
+    int16_t _width;         ///< Width in the current rotation.
+    int16_t _height;        ///< Height in the current rotation.
+    int16_t _max_x;         ///< _width - 1.
+    int16_t _max_y;         ///< _height - 1.
+    uint8_t _rotation;      ///< Current rotation (0-3).
+    int16_t cursor_x;       ///< Text cursor X.
+    int16_t cursor_y;       ///< Text cursor Y.
+    uint16_t textcolor;     ///< Text color.
+    uint16_t textbgcolor;   ///< Text background (same as textcolor = transparent).
+    uint8_t textsize_x;     ///< Horizontal text magnification.
+    uint8_t textsize_y;     ///< Vertical text magnification.
+    uint8_t text_pixel_margin; ///< Gap between magnified text pixels.
+    bool wrap;              ///< Wrap text at the right edge.
+    const GFXfont *gfxFont; ///< Current font (nullptr = built-in 6x8 font).
+};
+
+#endif // DFK_HOST_ARDUINO_GFX_LIBRARY_H
@@ -0,0 +1,23 @@
+// FFat.h (host)
+#ifndef DFK_HOST_FFAT_H
+#define DFK_HOST_FFAT_H
+
+#include "FS.h"
+
+namespace fs {
+class F_Fat : public FS {
+public:
+    F_Fat() : FS(".") {}
+    bool begin(bool formatOnFail = false, const char *basePath = "/ffat", uint8_t maxOpenFiles = 10,
+               const char *partitionLabel = nullptr) { return true; }
+    bool format(bool fullWipe = false, char *partitionLabel = nullptr) { return true; }
+    size_t totalBytes() { return 1 << 20; }
+    size_t usedBytes() { return 0; }
+    size_t freeBytes() { return 1 << 20; }
+    void end() {}
+};
+} // namespace fs
+
+extern fs::F_Fat FFat;
+
+#endif // DFK_HOST_FFAT_H
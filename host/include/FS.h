@@ -0,0 +1,78 @@
+// FS.h (host)
+// Arduino file system API on top of a directory of the host. Every FS object maps its
+// paths into a root directory chosen with setHostRoot() (default: the working directory).
+#ifndef DFK_HOST_FS_H
+#define DFK_HOST_FS_H
+
+#include <memory>
+#include "Arduino.h"
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+class FileImpl;
+typedef std::shared_ptr<FileImpl> FileImplPtr;
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class File : public Print {
+public:
+    File(FileImplPtr impl = FileImplPtr()) : m_impl(impl) {}
+
+    using Print::write;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    int available();
+    int read();
+    int peek();
+    size_t read(uint8_t *buffer, size_t size);
+    size_t readBytes(char *buffer, size_t length) { return read(reinterpret_cast<uint8_t *>(buffer), length); }
+    void flush() override;
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void close();
+    operator bool() const;
+    const char *path() const;
+    const char *name() const;
+    bool isDirectory();
+    File openNextFile(const char *mode = FILE_READ);
+    void rewindDirectory();
+
+private:
+    FileImplPtr m_impl;
+};
+
+class FS {
+public:
+    explicit FS(const char *hostRoot = ".");
+    virtual ~FS() {}
+
+    void setHostRoot(const char *hostRoot);
+    const char *hostRoot() const { return m_root.c_str(); }
+
+    File open(const char *path, const char *mode = FILE_READ, const bool create = false);
+    File open(const String &path, const char *mode = FILE_READ, const bool create = false) { return open(path.c_str(), mode, create); }
+    bool exists(const char *path);
+    bool exists(const String &path) { return exists(path.c_str()); }
+    bool remove(const char *path);
+    bool remove(const String &path) { return remove(path.c_str()); }
+    bool rename(const char *pathFrom, const char *pathTo);
+    bool mkdir(const char *path);
+    bool mkdir(const String &path) { return mkdir(path.c_str()); }
+    bool rmdir(const char *path);
+
+protected:
+    std::string hostPath(const char *path) const;
+    std::string m_root;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+
+#endif // DFK_HOST_FS_H
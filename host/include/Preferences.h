@@ -0,0 +1,45 @@
+// Preferences.h (host)
+// Non-volatile storage kept in memory for the life of the process.
+#ifndef DFK_HOST_PREFERENCES_H
+#define DFK_HOST_PREFERENCES_H
+
+#include "Arduino.h"
+
+class Preferences {
+public:
+    bool begin(const char *name, bool readOnly = false, const char *partitionLabel = nullptr);
+    void end();
+    bool clear();
+    bool remove(const char *key);
+    bool isKey(const char *key);
+
+    size_t putBool(const char *key, bool value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putInt(const char *key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putUInt(const char *key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putShort(const char *key, int16_t value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putUShort(const char *key, uint16_t value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putFloat(const char *key, float value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putString(const char *key, const char *value) { return putBytes(key, value, strlen(value) + 1); }
+    size_t putBytes(const char *key, const void *value, size_t length);
+
+    bool getBool(const char *key, bool defaultValue = false) { return get(key, defaultValue); }
+    int32_t getInt(const char *key, int32_t defaultValue = 0) { return get(key, defaultValue); }
+    uint32_t getUInt(const char *key, uint32_t defaultValue = 0) { return get(key, defaultValue); }
+    int16_t getShort(const char *key, int16_t defaultValue = 0) { return get(key, defaultValue); }
+    uint16_t getUShort(const char *key, uint16_t defaultValue = 0) { return get(key, defaultValue); }
+    float getFloat(const char *key, float defaultValue = 0) { return get(key, defaultValue); }
+    String getString(const char *key, const String &defaultValue = String());
+    size_t getBytesLength(const char *key);
+    size_t getBytes(const char *key, void *buffer, size_t maxLength);
+
+private:
+    template <typename T>
+    T get(const char *key, T defaultValue) {
+        T value;
+        return getBytes(key, &value, sizeof(value)) == sizeof(value) ? value : defaultValue;
+    }
+    std::string m_namespace;
+    bool m_open = false;
+};
+
+#endif // DFK_HOST_PREFERENCES_H
@@ -0,0 +1,31 @@
+// SD.h (host)
+#ifndef DFK_HOST_SD_H
+#define DFK_HOST_SD_H
+
+#include "FS.h"
+#include "SPI.h"
+
+typedef enum { CARD_NONE, CARD_MMC, CARD_SD, CARD_SDHC, CARD_UNKNOWN } sdcard_type_t;
+
+namespace fs {
+/// @brief SD card; reports a card of the size set with setHostCardSize() (default 1 GiB).
+class SDFS : public FS {
+public:
+    SDFS() : FS(".") {}
+    bool begin(uint8_t ssPin = 0, SPIClass &spi = SPI, uint32_t frequency = 4000000, const char *mountpoint = "/sd",
+               uint8_t maxFiles = 5, bool formatIfEmpty = false) { return true; }
+    void end() {}
+    sdcard_type_t cardType() { return CARD_SDHC; }
+    uint64_t cardSize() { return m_cardSize; }
+    uint64_t totalBytes() { return m_cardSize; }
+    uint64_t usedBytes() { return 0; }
+    void setHostCardSize(uint64_t bytes) { m_cardSize = bytes; }
+
+private:
+    uint64_t m_cardSize = 1ULL << 30;
+};
+} // namespace fs
+
+extern fs::SDFS SD;
+
+#endif // DFK_HOST_SD_H
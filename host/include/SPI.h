@@ -0,0 +1,48 @@
+// SPI.h (host)
+// SPI bus with no device attached: transfers complete and read back 0xFF.
+#ifndef DFK_HOST_SPI_H
+#define DFK_HOST_SPI_H
+
+#include "Arduino.h"
+
+#define FSPI 0
+#define HSPI 1
+#define VSPI 2
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+#define SPI_MSBFIRST 1
+#define SPI_LSBFIRST 0
+#define MSBFIRST SPI_MSBFIRST
+#define LSBFIRST SPI_LSBFIRST
+
+class SPISettings {
+public:
+    SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = SPI_MSBFIRST, uint8_t dataMode = SPI_MODE0)
+        : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+};
+
+class SPIClass {
+public:
+    explicit SPIClass(uint8_t bus = HSPI) : m_bus(bus) {}
+    bool begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1) { return true; }
+    void end() {}
+    void beginTransaction(SPISettings) {}
+    void endTransaction() {}
+    void setFrequency(uint32_t) {}
+    uint8_t transfer(uint8_t) { return 0xFF; }
+    uint16_t transfer16(uint16_t) { return 0xFFFF; }
+    void transfer(void *data, uint32_t size) { memset(data, 0xFF, size); }
+    void writeBytes(const uint8_t *, uint32_t) {}
+
+private:
+    uint8_t m_bus;
+};
+
+extern SPIClass SPI;
+
+#endif // DFK_HOST_SPI_H
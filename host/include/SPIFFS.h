@@ -0,0 +1,22 @@
+// SPIFFS.h (host)
+#ifndef DFK_HOST_SPIFFS_H
+#define DFK_HOST_SPIFFS_H
+
+#include "FS.h"
+
+namespace fs {
+class SPIFFSFS : public FS {
+public:
+    SPIFFSFS() : FS(".") {}
+    bool begin(bool formatOnFail = false, const char *basePath = "/spiffs", uint8_t maxOpenFiles = 10,
+               const char *partitionLabel = nullptr) { return true; }
+    bool format() { return true; }
+    size_t totalBytes() { return 1 << 20; }
+    size_t usedBytes() { return 0; }
+    void end() {}
+};
+} // namespace fs
+
+extern fs::SPIFFSFS SPIFFS;
+
+#endif // DFK_HOST_SPIFFS_H
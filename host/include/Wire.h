@@ -0,0 +1,64 @@
+// Wire.h (host)
+// I2C bus with emulated devices. A device registers itself with TwoWire::attach() and
+// receives every write and read addressed to it. dfk_host.h attaches a GT911 touch
+// controller so the library's own driver reads touches injected by the host program.
+#ifndef DFK_HOST_WIRE_H
+#define DFK_HOST_WIRE_H
+
+#include "Arduino.h"
+
+/// @brief Device on the emulated I2C bus.
+class HostI2CDevice {
+public:
+    virtual ~HostI2CDevice() {}
+    /// @brief Receives the bytes of one write transaction.
+    virtual void onWrite(const uint8_t *data, size_t length) = 0;
+    /// @brief Fills the bytes of one read transaction.
+    virtual void onRead(uint8_t *data, size_t length) = 0;
+};
+
+class TwoWire {
+public:
+    explicit TwoWire(uint8_t bus = 0) : m_bus(bus) {}
+
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) { return true; }
+    bool begin(uint8_t address, int sda, int scl, uint32_t frequency) { return true; }
+    bool end() { return true; }
+    bool setPins(int sda, int scl) { return true; }
+    bool setSDA(int) { return true; }
+    bool setSCL(int) { return true; }
+    bool setClock(uint32_t) { return true; }
+    void setTimeOut(uint16_t) {}
+
+    void beginTransmission(uint8_t address);
+    void beginTransmission(int address) { beginTransmission(static_cast<uint8_t>(address)); }
+    uint8_t endTransmission(bool sendStop = true);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t *data, size_t length);
+    size_t requestFrom(uint8_t address, size_t length, bool sendStop = true);
+    size_t requestFrom(int address, int length, int sendStop = 1) {
+        return requestFrom(static_cast<uint8_t>(address), static_cast<size_t>(length), sendStop != 0);
+    }
+    int available();
+    int read();
+    int peek();
+
+    void attach(uint8_t address, HostI2CDevice *device);
+    void detach(uint8_t address);
+
+private:
+    static const size_t BUFFER_SIZE = 256;
+    uint8_t m_bus;
+    HostI2CDevice *m_devices[128] = {};
+    uint8_t m_txAddress = 0;
+    uint8_t m_txBuffer[BUFFER_SIZE];
+    size_t m_txLength = 0;
+    uint8_t m_rxBuffer[BUFFER_SIZE];
+    size_t m_rxLength = 0;
+    size_t m_rxIndex = 0;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif // DFK_HOST_WIRE_H
@@ -0,0 +1,58 @@
+// dfk_host.h
+// Host-only API: the in-memory display, touch injection and shutdown of the emulated tasks.
+#ifndef DFK_HOST_H
+#define DFK_HOST_H
+
+#include "Arduino_GFX_Library.h"
+
+/// @brief Work done on a HostDisplay since the last resetStats().
+struct HostDisplayStats {
+    uint64_t pixels;       ///< Pixels written to the framebuffer (overdraw included).
+    uint32_t transactions; ///< Outermost startWrite()/endWrite() pairs and bitmap blits; one per draw call.
+};
+
+/// @brief RGB565 panel kept in memory. Frames can be saved as PPM or PNG.
+class HostDisplay : public Arduino_GFX {
+public:
+    HostDisplay(int16_t w, int16_t h);
+    ~HostDisplay() override;
+
+    bool begin(int32_t speed = GFX_NOT_DEFINED) override;
+    void startWrite() override;
+    void endWrite() override;
+    void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
+    void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void draw16bitRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w, int16_t h) override;
+    void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+    void setRotation(uint8_t r) override;
+
+    /// @brief Pixels of the current rotation, row by row (width() x height()).
+    const uint16_t *getFramebuffer() const { return m_framebuffer; }
+    uint16_t getPixel(int16_t x, int16_t y) const;
+
+    bool savePPM(const char *path) const;
+    bool savePNG(const char *path) const;
+
+    const HostDisplayStats &getStats() const { return m_stats; }
+    void resetStats();
+
+private:
+    void toRGB888(uint8_t *out) const;
+    uint16_t *m_framebuffer;
+    HostDisplayStats m_stats;
+    uint16_t m_writeDepth;
+};
+
+/// @brief Configures the emulated GT911 for a panel of the given size. Touch coordinates
+///        are then reported 1:1 with screen pixels.
+void hostTouchBegin(uint16_t width, uint16_t height);
+/// @brief Presses (or drags) one finger at a screen position.
+void hostTouchPress(uint16_t x, uint16_t y);
+/// @brief Lifts the finger.
+void hostTouchRelease();
+
+/// @brief Ends every task created with xTaskCreate* and the timer service. Tasks leave at
+///        their next blocking call. Call once before returning from main().
+void hostStopTasks();
+
+#endif // DFK_HOST_H
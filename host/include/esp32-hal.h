@@ -0,0 +1,25 @@
+// esp32-hal.h (host)
+#ifndef DFK_HOST_ESP32_HAL_H
+#define DFK_HOST_ESP32_HAL_H
+
+#ifndef ARDUINO
+#define ARDUINO 10819
+#endif
+
+#define ESP_ARDUINO_VERSION_MAJOR 3
+#define ESP_ARDUINO_VERSION_MINOR 0
+#define ESP_ARDUINO_VERSION_PATCH 0
+#ifndef ESP_ARDUINO_VERSION_VAL
+#define ESP_ARDUINO_VERSION_VAL(major, minor, patch) (((major) << 16) | ((minor) << 8) | (patch))
+#endif
+#define ESP_ARDUINO_VERSION ESP_ARDUINO_VERSION_VAL(ESP_ARDUINO_VERSION_MAJOR, ESP_ARDUINO_VERSION_MINOR, ESP_ARDUINO_VERSION_PATCH)
+
+#define log_e(format, ...) ESP_LOGE("ARDUINO", format, ##__VA_ARGS__)
+#define log_w(format, ...) ESP_LOGW("ARDUINO", format, ##__VA_ARGS__)
+#define log_i(format, ...) ESP_LOGI("ARDUINO", format, ##__VA_ARGS__)
+#define log_d(format, ...) ESP_LOGD("ARDUINO", format, ##__VA_ARGS__)
+#define log_v(format, ...) ESP_LOGV("ARDUINO", format, ##__VA_ARGS__)
+
+#include "esp_log.h"
+
+#endif // DFK_HOST_ESP32_HAL_H
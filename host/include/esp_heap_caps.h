@@ -0,0 +1,25 @@
+// esp_heap_caps.h (host)
+// Capability-based allocation maps to malloc; PSRAM and internal RAM are the same heap.
+#ifndef DFK_HOST_ESP_HEAP_CAPS_H
+#define DFK_HOST_ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_EXEC (1 << 0)
+#define MALLOC_CAP_32BIT (1 << 1)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+inline void *heap_caps_malloc(size_t size, uint32_t) { return malloc(size); }
+inline void *heap_caps_calloc(size_t n, size_t size, uint32_t) { return calloc(n, size); }
+inline void *heap_caps_realloc(void *ptr, size_t size, uint32_t) { return realloc(ptr, size); }
+inline void heap_caps_free(void *ptr) { free(ptr); }
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+
+#endif // DFK_HOST_ESP_HEAP_CAPS_H
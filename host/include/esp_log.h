@@ -0,0 +1,51 @@
+// esp_log.h (host)
+// ESP-IDF logging macros written to stderr. The level is set at run time with
+// esp_log_level_set("*", level) and defaults to ESP_LOG_ERROR.
+#ifndef DFK_HOST_ESP_LOG_H
+#define DFK_HOST_ESP_LOG_H
+
+#include <stdint.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_TIMEOUT 0x107
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void esp_log_level_set(const char *tag, esp_log_level_t level);
+esp_log_level_t esp_log_level_get(const char *tag);
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...) __attribute__((format(printf, 3, 4)));
+const char *esp_err_to_name(esp_err_t code);
+#ifdef __cplusplus
+}
+#endif
+
+#define DFK_HOST_LOG(level, letter, tag, format, ...)                                   \
+    do {                                                                                \
+        if (esp_log_level_get(tag) >= (level)) {                                        \
+            esp_log_write(level, tag, letter " (%s) " format "\n", tag, ##__VA_ARGS__); \
+        }                                                                               \
+    } while (0)
+
+#define ESP_LOGE(tag, format, ...) DFK_HOST_LOG(ESP_LOG_ERROR, "E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) DFK_HOST_LOG(ESP_LOG_WARN, "W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) DFK_HOST_LOG(ESP_LOG_INFO, "I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) DFK_HOST_LOG(ESP_LOG_DEBUG, "D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) DFK_HOST_LOG(ESP_LOG_VERBOSE, "V", tag, format, ##__VA_ARGS__)
+
+#endif // DFK_HOST_ESP_LOG_H
@@ -0,0 +1,54 @@
+// FreeRTOS.h (host)
+// FreeRTOS API subset implemented with std::thread, mutexes and condition variables.
+// One tick is one millisecond. Tasks run as threads of the process; priorities and core
+// affinity are accepted and ignored.
+#ifndef DFK_HOST_FREERTOS_H
+#define DFK_HOST_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t StackType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+#define errQUEUE_EMPTY ((BaseType_t)0)
+#define errQUEUE_FULL ((BaseType_t)0)
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define pdTICKS_TO_MS(ticks) ((uint32_t)(ticks))
+#define configMINIMAL_STACK_SIZE 768
+#define configMAX_PRIORITIES 25
+#define portNUM_PROCESSORS 2
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define tskIDLE_PRIORITY 0
+
+/// @brief Critical section lock (a process-wide recursive mutex on the host).
+typedef struct {
+    int unused;
+} portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+
+void dfkHostEnterCritical(portMUX_TYPE *mux);
+void dfkHostExitCritical(portMUX_TYPE *mux);
+
+#define portENTER_CRITICAL(mux) dfkHostEnterCritical(mux)
+#define portEXIT_CRITICAL(mux) dfkHostExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux) dfkHostEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux) dfkHostExitCritical(mux)
+#define taskENTER_CRITICAL(mux) dfkHostEnterCritical(mux)
+#define taskEXIT_CRITICAL(mux) dfkHostExitCritical(mux)
+#define portYIELD_FROM_ISR(...) ((void)0)
+#define portYIELD() ((void)0)
+
+#include "task.h"
+
+#endif // DFK_HOST_FREERTOS_H
@@ -0,0 +1,483 @@
+// arduino.cpp (host)
+// Arduino core functions, String, Print, Serial, ESP, logging and Preferences.
+#include "Arduino.h"
+#include "esp_heap_caps.h"
+#include "Preferences.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+static const std::chrono::steady_clock::time_point g_boot = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+    return static_cast<unsigned long>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - g_boot).count());
+}
+
+unsigned long micros() {
+    return static_cast<unsigned long>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - g_boot).count());
+}
+
+void delay(uint32_t ms) {
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    const long run = in_max - in_min;
+    if (run == 0) {
+        return out_min;
+    }
+    return (x - in_min) * (out_max - out_min) / run + out_min;
+}
+
+static std::mt19937 g_random(1);
+static std::mutex g_randomLock;
+
+long random(long howbig) {
+    if (howbig <= 0) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(g_randomLock);
+    return static_cast<long>(g_random() % static_cast<unsigned long>(howbig));
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) {
+        return howsmall;
+    }
+    return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+    std::lock_guard<std::mutex> lock(g_randomLock);
+    g_random.seed(static_cast<uint32_t>(seed));
+}
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return HIGH; }
+uint16_t analogRead(uint8_t) { return 0; }
+void attachInterrupt(uint8_t, void (*)(void), int) {}
+void attachInterruptArg(uint8_t, void (*)(void *), void *, int) {}
+void detachInterrupt(uint8_t) {}
+bool ledcAttach(uint8_t, uint32_t, uint8_t) { return true; }
+bool ledcWrite(uint8_t, uint32_t) { return true; }
+
+bool psramFound() {
+    return true;
+}
+
+void *ps_malloc(size_t size) {
+    return malloc(size);
+}
+
+size_t heap_caps_get_free_size(uint32_t) {
+    return 8u * 1024u * 1024u;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t) {
+    return 4u * 1024u * 1024u;
+}
+
+char *dtostrf(double val, signed char width, unsigned char prec, char *sout) {
+    sprintf(sout, "%*.*f", width, prec, val);
+    return sout;
+}
+
+static char *toBase(unsigned long value, bool negative, char *str, int base) {
+    if (base < 2 || base > 36) {
+        *str = '\0';
+        return str;
+    }
+    char tmp[sizeof(unsigned long) * 8 + 1];
+    int n = 0;
+    do {
+        int d = static_cast<int>(value % base);
+        tmp[n++] = static_cast<char>(d < 10 ? '0' + d : 'a' + d - 10);
+        value /= base;
+    } while (value);
+    char *p = str;
+    if (negative) {
+        *p++ = '-';
+    }
+    while (n) {
+        *p++ = tmp[--n];
+    }
+    *p = '\0';
+    return str;
+}
+
+char *ltoa(long value, char *str, int base) {
+    bool negative = value < 0 && base == 10;
+    unsigned long magnitude = negative ? 0UL - static_cast<unsigned long>(value) : static_cast<unsigned long>(value);
+    return toBase(magnitude, negative, str, base);
+}
+
+char *itoa(int value, char *str, int base) {
+    if (base != 10) {
+        return toBase(static_cast<unsigned>(value), false, str, base);
+    }
+    return ltoa(value, str, base);
+}
+
+char *utoa(unsigned value, char *str, int base) {
+    return toBase(value, false, str, base);
+}
+
+// ---------------------------------------------------------------------------------------
+// String
+
+String::String(int v, unsigned char base) {
+    char buf[40];
+    m_s = itoa(v, buf, base);
+}
+
+String::String(unsigned int v, unsigned char base) {
+    char buf[40];
+    m_s = utoa(v, buf, base);
+}
+
+String::String(long v, unsigned char base) {
+    char buf[72];
+    m_s = ltoa(v, buf, base);
+}
+
+String::String(unsigned long v, unsigned char base) {
+    char buf[72];
+    m_s = toBase(v, false, buf, base);
+}
+
+String::String(float v, unsigned int decimals) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, static_cast<double>(v));
+    m_s = buf;
+}
+
+String::String(double v, unsigned int decimals) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    m_s = buf;
+}
+
+bool String::equalsIgnoreCase(const String &o) const {
+    if (m_s.size() != o.m_s.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < m_s.size(); i++) {
+        if (tolower(static_cast<unsigned char>(m_s[i])) != tolower(static_cast<unsigned char>(o.m_s[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    size_t p = m_s.find(c, from);
+    return p == std::string::npos ? -1 : static_cast<int>(p);
+}
+
+int String::indexOf(const String &s, unsigned int from) const {
+    size_t p = m_s.find(s.m_s, from);
+    return p == std::string::npos ? -1 : static_cast<int>(p);
+}
+
+int String::lastIndexOf(char c) const {
+    size_t p = m_s.rfind(c);
+    return p == std::string::npos ? -1 : static_cast<int>(p);
+}
+
+String String::substring(unsigned int from) const {
+    return from >= m_s.size() ? String() : String(m_s.substr(from));
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) {
+        std::swap(from, to);
+    }
+    if (from >= m_s.size()) {
+        return String();
+    }
+    return String(m_s.substr(from, to - from));
+}
+
+bool String::startsWith(const String &s) const {
+    return m_s.compare(0, s.m_s.size(), s.m_s) == 0;
+}
+
+bool String::endsWith(const String &s) const {
+    return m_s.size() >= s.m_s.size() && m_s.compare(m_s.size() - s.m_s.size(), s.m_s.size(), s.m_s) == 0;
+}
+
+void String::replace(const String &from, const String &to) {
+    if (from.m_s.empty()) {
+        return;
+    }
+    size_t pos = 0;
+    while ((pos = m_s.find(from.m_s, pos)) != std::string::npos) {
+        m_s.replace(pos, from.m_s.size(), to.m_s);
+        pos += to.m_s.size();
+    }
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index < m_s.size()) {
+        m_s.erase(index, count);
+    }
+}
+
+void String::trim() {
+    size_t b = 0;
+    size_t e = m_s.size();
+    while (b < e && isspace(static_cast<unsigned char>(m_s[b]))) b++;
+    while (e > b && isspace(static_cast<unsigned char>(m_s[e - 1]))) e--;
+    m_s = m_s.substr(b, e - b);
+}
+
+void String::toLowerCase() {
+    for (char &c : m_s) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+}
+
+void String::toUpperCase() {
+    for (char &c : m_s) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+}
+
+void String::toCharArray(char *buf, unsigned int size, unsigned int index) const {
+    getBytes(reinterpret_cast<unsigned char *>(buf), size, index);
+}
+
+void String::getBytes(unsigned char *buf, unsigned int size, unsigned int index) const {
+    if (!buf || size == 0) {
+        return;
+    }
+    if (index >= m_s.size()) {
+        buf[0] = 0;
+        return;
+    }
+    unsigned int n = std::min<unsigned int>(size - 1, m_s.size() - index);
+    memcpy(buf, m_s.data() + index, n);
+    buf[n] = 0;
+}
+
+// ---------------------------------------------------------------------------------------
+// Print
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        if (!write(*buffer++)) break;
+        n++;
+    }
+    return n;
+}
+
+size_t Print::print(long v, int base) {
+    char buf[72];
+    if (base == 0) {
+        return write(static_cast<uint8_t>(v));
+    }
+    return write(ltoa(v, buf, base));
+}
+
+size_t Print::print(unsigned long v, int base) {
+    char buf[72];
+    if (base == 0) {
+        return write(static_cast<uint8_t>(v));
+    }
+    return write(toBase(v, false, buf, base));
+}
+
+size_t Print::print(double v, int digits) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", digits, v);
+    return write(buf);
+}
+
+size_t Print::printf(const char *format, ...) {
+    char small[128];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (len < 0) {
+        return 0;
+    }
+    if (static_cast<size_t>(len) < sizeof(small)) {
+        return write(reinterpret_cast<const uint8_t *>(small), len);
+    }
+    std::vector<char> big(len + 1);
+    va_start(args, format);
+    vsnprintf(big.data(), big.size(), format, args);
+    va_end(args);
+    return write(reinterpret_cast<const uint8_t *>(big.data()), len);
+}
+
+// ---------------------------------------------------------------------------------------
+// Serial
+
+HardwareSerial Serial;
+
+void HardwareSerial::begin(unsigned long, uint32_t, int8_t, int8_t) {}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+}
+
+int HardwareSerial::available() {
+    return 0;
+}
+
+int HardwareSerial::read() {
+    return -1;
+}
+
+int HardwareSerial::peek() {
+    return -1;
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+// ---------------------------------------------------------------------------------------
+// ESP
+
+EspClass ESP;
+
+void EspClass::restart() {
+    fprintf(stderr, "ESP.restart() called, exiting\n");
+    fflush(stdout);
+    exit(0);
+}
+
+uint32_t EspClass::getFreeHeap() { return 256u * 1024u; }
+uint32_t EspClass::getHeapSize() { return 320u * 1024u; }
+uint32_t EspClass::getFreePsram() { return 8u * 1024u * 1024u; }
+uint32_t EspClass::getPsramSize() { return 8u * 1024u * 1024u; }
+
+// ---------------------------------------------------------------------------------------
+// Logging
+
+static esp_log_level_t g_logLevel = ESP_LOG_ERROR;
+static std::mutex g_logLock;
+
+extern "C" void esp_log_level_set(const char *tag, esp_log_level_t level) {
+    if (tag && strcmp(tag, "*") == 0) {
+        g_logLevel = level;
+    }
+}
+
+extern "C" esp_log_level_t esp_log_level_get(const char *) {
+    return g_logLevel;
+}
+
+extern "C" void esp_log_write(esp_log_level_t, const char *, const char *format, ...) {
+    std::lock_guard<std::mutex> lock(g_logLock);
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+extern "C" const char *esp_err_to_name(esp_err_t code) {
+    switch (code) {
+    case ESP_OK: return "ESP_OK";
+    case ESP_FAIL: return "ESP_FAIL";
+    case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+    default: return "UNKNOWN_ERROR";
+    }
+}
+
+// ---------------------------------------------------------------------------------------
+// Preferences
+
+static std::map<std::string, std::vector<uint8_t>> g_nvs;
+static std::mutex g_nvsLock;
+
+bool Preferences::begin(const char *name, bool, const char *) {
+    m_namespace = name ? name : "";
+    m_open = true;
+    return true;
+}
+
+void Preferences::end() {
+    m_open = false;
+}
+
+bool Preferences::clear() {
+    std::lock_guard<std::mutex> lock(g_nvsLock);
+    const std::string prefix = m_namespace + "/";
+    for (auto it = g_nvs.begin(); it != g_nvs.end();) {
+        if (it->first.compare(0, prefix.size(), prefix) == 0) {
+            it = g_nvs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return m_open;
+}
+
+bool Preferences::remove(const char *key) {
+    std::lock_guard<std::mutex> lock(g_nvsLock);
+    return g_nvs.erase(m_namespace + "/" + key) > 0;
+}
+
+bool Preferences::isKey(const char *key) {
+    std::lock_guard<std::mutex> lock(g_nvsLock);
+    return g_nvs.count(m_namespace + "/" + key) > 0;
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t length) {
+    if (!m_open || !key) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(g_nvsLock);
+    const uint8_t *p = static_cast<const uint8_t *>(value);
+    g_nvs[m_namespace + "/" + key].assign(p, p + length);
+    return length;
+}
+
+String Preferences::getString(const char *key, const String &defaultValue) {
+    std::lock_guard<std::mutex> lock(g_nvsLock);
+    auto it = g_nvs.find(m_namespace + "/" + key);
+    if (it == g_nvs.end() || it->second.empty()) {
+        return defaultValue;
+    }
+    return String(reinterpret_cast<const char *>(it->second.data()));
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+    std::lock_guard<std::mutex> lock(g_nvsLock);
+    auto it = g_nvs.find(m_namespace + "/" + key);
+    return it == g_nvs.end() ? 0 : it->second.size();
+}
+
+size_t Preferences::getBytes(const char *key, void *buffer, size_t maxLength) {
+    std::lock_guard<std::mutex> lock(g_nvsLock);
+    auto it = g_nvs.find(m_namespace + "/" + key);
+    if (it == g_nvs.end() || it->second.size() > maxLength) {
+        return 0;
+    }
+    memcpy(buffer, it->second.data(), it->second.size());
+    return it->second.size();
+}
@@ -0,0 +1,665 @@
+// freertos.cpp (host)
+// Tasks are std::threads. Every blocking call waits in short slices so hostStopTasks() can
+// unwind the tasks: once stopping, a task that blocks leaves through HostTaskExit, which
+// the thread entry catches.
+#include "Arduino.h"
+#include "dfk_host.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// @brief Thrown inside a task to end it (vTaskDelete(NULL) or shutdown).
+struct HostTaskExit {};
+
+const std::chrono::milliseconds WAIT_SLICE(10);
+
+std::atomic<bool> g_stopping(false);
+std::recursive_mutex g_critical;
+
+} // namespace
+
+struct HostTask {
+    std::string name;
+    TaskFunction_t code = nullptr;
+    void *parameters = nullptr;
+    std::thread thread;
+    std::mutex lock;
+    std::condition_variable wake;
+    uint32_t notifyCount = 0;
+    bool suspended = false;
+    std::atomic<bool> deleted{false};
+};
+
+namespace {
+
+std::mutex g_tasksLock;
+std::vector<HostTask *> g_tasks;
+thread_local HostTask *t_currentTask = nullptr;
+
+/// @brief Ends the calling task if it was deleted or the process is stopping.
+void checkExit() {
+    if (t_currentTask && (g_stopping || t_currentTask->deleted)) {
+        throw HostTaskExit();
+    }
+}
+
+/// @brief Waits on a condition variable until pred() holds or the ticks run out.
+/// @return pred() at the end of the wait.
+template <typename Pred>
+bool waitTicks(std::unique_lock<std::mutex> &lock, std::condition_variable &cv, TickType_t ticks, Pred pred) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ticks);
+    while (!pred()) {
+        checkExit();
+        if (g_stopping) {
+            return false;
+        }
+        if (ticks == portMAX_DELAY) {
+            cv.wait_for(lock, WAIT_SLICE);
+            continue;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return pred();
+        }
+        cv.wait_for(lock, std::min<std::chrono::steady_clock::duration>(deadline - now, WAIT_SLICE));
+    }
+    return true;
+}
+
+void taskEntry(HostTask *task) {
+    t_currentTask = task;
+    try {
+        task->code(task->parameters);
+        ESP_LOGW("HostTask", "Task %s returned without deleting itself", task->name.c_str());
+    } catch (const HostTaskExit &) {
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------
+// Tasks
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char *name, uint32_t, void *parameters, UBaseType_t,
+                                   TaskHandle_t *createdTask, BaseType_t) {
+    if (!code || g_stopping) {
+        return pdFAIL;
+    }
+    HostTask *task = new HostTask();
+    task->name = name ? name : "";
+    task->code = code;
+    task->parameters = parameters;
+    {
+        std::lock_guard<std::mutex> guard(g_tasksLock);
+        g_tasks.push_back(task);
+    }
+    if (createdTask) {
+        *createdTask = task;
+    }
+    task->thread = std::thread(taskEntry, task);
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name, uint32_t stackDepth, void *parameters,
+                       UBaseType_t priority, TaskHandle_t *createdTask) {
+    return xTaskCreatePinnedToCore(code, name, stackDepth, parameters, priority, createdTask, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (!task) {
+        task = t_currentTask;
+    }
+    if (!task) {
+        return;
+    }
+    task->deleted = true;
+    task->wake.notify_all();
+    if (task == t_currentTask) {
+        throw HostTaskExit();
+    }
+}
+
+void vTaskSuspend(TaskHandle_t task) {
+    if (!task) {
+        task = t_currentTask;
+    }
+    if (!task) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(task->lock);
+    task->suspended = true;
+    if (task == t_currentTask) {
+        waitTicks(lock, task->wake, portMAX_DELAY, [task] { return !task->suspended; });
+    }
+}
+
+void vTaskResume(TaskHandle_t task) {
+    if (!task) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(task->lock);
+    task->suspended = false;
+    task->wake.notify_all();
+}
+
+void vTaskDelay(TickType_t ticks) {
+    if (!t_currentTask) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+        return;
+    }
+    std::unique_lock<std::mutex> lock(t_currentTask->lock);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ticks);
+    waitTicks(lock, t_currentTask->wake, ticks, [deadline] { return std::chrono::steady_clock::now() >= deadline; });
+}
+
+BaseType_t xTaskDelayUntil(TickType_t *previousWakeTime, TickType_t increment) {
+    const TickType_t target = *previousWakeTime + increment;
+    const TickType_t now = xTaskGetTickCount();
+    *previousWakeTime = target;
+    if (static_cast<int32_t>(target - now) <= 0) {
+        checkExit();
+        return pdFALSE;
+    }
+    vTaskDelay(target - now);
+    return pdTRUE;
+}
+
+void vTaskDelayUntil(TickType_t *previousWakeTime, TickType_t increment) {
+    xTaskDelayUntil(previousWakeTime, increment);
+}
+
+TickType_t xTaskGetTickCount() {
+    return static_cast<TickType_t>(millis());
+}
+
+TickType_t xTaskGetTickCountFromISR() {
+    return xTaskGetTickCount();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return t_currentTask;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) {
+    return 4096;
+}
+
+const char *pcTaskGetName(TaskHandle_t task) {
+    if (!task) {
+        task = t_currentTask;
+    }
+    return task ? task->name.c_str() : "main";
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    if (!task) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(task->lock);
+    task->notifyCount++;
+    task->wake.notify_all();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higherPriorityTaskWoken) {
+    xTaskNotifyGive(task);
+    if (higherPriorityTaskWoken) {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait) {
+    HostTask *task = t_currentTask;
+    if (!task) {
+        return 0;
+    }
+    std::unique_lock<std::mutex> lock(task->lock);
+    waitTicks(lock, task->wake, ticksToWait, [task] { return task->notifyCount > 0; });
+    const uint32_t value = task->notifyCount;
+    if (value) {
+        task->notifyCount = clearCountOnExit ? 0 : value - 1;
+    }
+    return value;
+}
+
+// ---------------------------------------------------------------------------------------
+// Critical sections
+
+void dfkHostEnterCritical(portMUX_TYPE *) {
+    g_critical.lock();
+}
+
+void dfkHostExitCritical(portMUX_TYPE *) {
+    g_critical.unlock();
+}
+
+// ---------------------------------------------------------------------------------------
+// Queues
+
+struct HostQueue {
+    std::mutex lock;
+    std::condition_variable changed;
+    std::vector<uint8_t> storage;
+    UBaseType_t length = 0;
+    UBaseType_t itemSize = 0;
+    UBaseType_t head = 0;
+    UBaseType_t count = 0;
+
+    uint8_t *slot(UBaseType_t index) { return storage.data() + ((head + index) % length) * itemSize; }
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    if (length == 0) {
+        return nullptr;
+    }
+    HostQueue *queue = new HostQueue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    queue->storage.resize(static_cast<size_t>(length) * (itemSize ? itemSize : 1));
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+static BaseType_t queueSend(QueueHandle_t queue, const void *item, TickType_t ticksToWait, bool front) {
+    if (!queue) {
+        return errQUEUE_FULL;
+    }
+    std::unique_lock<std::mutex> lock(queue->lock);
+    if (!waitTicks(lock, queue->changed, ticksToWait, [queue] { return queue->count < queue->length; })) {
+        return errQUEUE_FULL;
+    }
+    if (front) {
+        queue->head = (queue->head + queue->length - 1) % queue->length;
+        memcpy(queue->slot(0), item, queue->itemSize);
+    } else {
+        memcpy(queue->slot(queue->count), item, queue->itemSize);
+    }
+    queue->count++;
+    queue->changed.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticksToWait) {
+    return queueSend(queue, item, ticksToWait, false);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t ticksToWait) {
+    return queueSend(queue, item, ticksToWait, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void *item, TickType_t ticksToWait) {
+    return queueSend(queue, item, ticksToWait, true);
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *higherPriorityTaskWoken) {
+    if (higherPriorityTaskWoken) {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+    return queueSend(queue, item, 0, false);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item) {
+    if (!queue) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(queue->lock);
+    if (queue->count == 0) {
+        queue->count = 1;
+    }
+    memcpy(queue->slot(0), item, queue->itemSize);
+    queue->changed.notify_all();
+    return pdPASS;
+}
+
+static BaseType_t queueReceive(QueueHandle_t queue, void *buffer, TickType_t ticksToWait, bool remove) {
+    if (!queue) {
+        return errQUEUE_EMPTY;
+    }
+    std::unique_lock<std::mutex> lock(queue->lock);
+    if (!waitTicks(lock, queue->changed, ticksToWait, [queue] { return queue->count > 0; })) {
+        return errQUEUE_EMPTY;
+    }
+    memcpy(buffer, queue->slot(0), queue->itemSize);
+    if (remove) {
+        queue->head = (queue->head + 1) % queue->length;
+        queue->count--;
+        queue->changed.notify_all();
+    }
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *buffer, TickType_t ticksToWait) {
+    return queueReceive(queue, buffer, ticksToWait, true);
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t queue, void *buffer, BaseType_t *higherPriorityTaskWoken) {
+    if (higherPriorityTaskWoken) {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+    return queueReceive(queue, buffer, 0, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void *buffer, TickType_t ticksToWait) {
+    return queueReceive(queue, buffer, ticksToWait, false);
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+    if (!queue) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(queue->lock);
+    queue->head = 0;
+    queue->count = 0;
+    queue->changed.notify_all();
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    if (!queue) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(queue->lock);
+    return queue->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue) {
+    if (!queue) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(queue->lock);
+    return queue->length - queue->count;
+}
+
+// ---------------------------------------------------------------------------------------
+// Semaphores
+
+struct HostSemaphore {
+    std::mutex lock;
+    std::condition_variable changed;
+    UBaseType_t count = 0;
+    UBaseType_t maxCount = 1;
+    bool recursive = false;
+    std::thread::id owner;
+    UBaseType_t depth = 0;
+};
+
+static HostSemaphore *createSemaphore(UBaseType_t maxCount, UBaseType_t initialCount, bool recursive) {
+    HostSemaphore *semaphore = new HostSemaphore();
+    semaphore->maxCount = maxCount;
+    semaphore->count = initialCount;
+    semaphore->recursive = recursive;
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return createSemaphore(1, 1, false);
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+    return createSemaphore(1, 1, true);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return createSemaphore(1, 0, false);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+    return createSemaphore(maxCount, initialCount, false);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait) {
+    if (!semaphore) {
+        return pdFAIL;
+    }
+    std::unique_lock<std::mutex> lock(semaphore->lock);
+    if (!waitTicks(lock, semaphore->changed, ticksToWait, [semaphore] { return semaphore->count > 0; })) {
+        return pdFAIL;
+    }
+    semaphore->count--;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    if (!semaphore) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(semaphore->lock);
+    if (semaphore->count >= semaphore->maxCount) {
+        return pdFAIL;
+    }
+    semaphore->count++;
+    semaphore->changed.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore, TickType_t ticksToWait) {
+    if (!semaphore) {
+        return pdFAIL;
+    }
+    const std::thread::id self = std::this_thread::get_id();
+    std::unique_lock<std::mutex> lock(semaphore->lock);
+    if (semaphore->depth > 0 && semaphore->owner == self) {
+        semaphore->depth++;
+        return pdPASS;
+    }
+    if (!waitTicks(lock, semaphore->changed, ticksToWait, [semaphore] { return semaphore->depth == 0; })) {
+        return pdFAIL;
+    }
+    semaphore->owner = self;
+    semaphore->depth = 1;
+    semaphore->count = 0;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore) {
+    if (!semaphore) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(semaphore->lock);
+    if (semaphore->depth == 0 || semaphore->owner != std::this_thread::get_id()) {
+        return pdFAIL;
+    }
+    if (--semaphore->depth == 0) {
+        semaphore->count = 1;
+        semaphore->changed.notify_all();
+    }
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t *higherPriorityTaskWoken) {
+    if (higherPriorityTaskWoken) {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+    return xSemaphoreGive(semaphore);
+}
+
+BaseType_t xSemaphoreTakeFromISR(SemaphoreHandle_t semaphore, BaseType_t *higherPriorityTaskWoken) {
+    if (higherPriorityTaskWoken) {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+    return xSemaphoreTake(semaphore, 0);
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaphore) {
+    if (!semaphore) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(semaphore->lock);
+    return semaphore->count;
+}
+
+// ---------------------------------------------------------------------------------------
+// Software timers
+
+struct HostTimer {
+    std::string name;
+    TickType_t period = 1;
+    bool autoReload = false;
+    void *timerId = nullptr;
+    TimerCallbackFunction_t callback = nullptr;
+    bool active = false;
+    std::chrono::steady_clock::time_point expiry;
+};
+
+namespace {
+
+std::mutex g_timersLock;
+std::condition_variable g_timersChanged;
+std::list<HostTimer *> g_timers;
+std::thread g_timerService;
+bool g_timerServiceStarted = false;
+
+void timerService() {
+    std::unique_lock<std::mutex> lock(g_timersLock);
+    while (!g_stopping) {
+        const auto now = std::chrono::steady_clock::now();
+        HostTimer *due = nullptr;
+        auto next = now + WAIT_SLICE;
+        for (HostTimer *timer : g_timers) {
+            if (!timer->active) continue;
+            if (timer->expiry <= now) {
+                due = timer;
+                break;
+            }
+            next = std::min(next, timer->expiry);
+        }
+        if (!due) {
+            g_timersChanged.wait_until(lock, next);
+            continue;
+        }
+        if (due->autoReload) {
+            due->expiry += std::chrono::milliseconds(due->period);
+        } else {
+            due->active = false;
+        }
+        TimerCallbackFunction_t callback = due->callback;
+        lock.unlock();
+        callback(due);
+        lock.lock();
+    }
+}
+
+void startTimerService() {
+    if (!g_timerServiceStarted) {
+        g_timerServiceStarted = true;
+        g_timerService = std::thread(timerService);
+    }
+}
+
+} // namespace
+
+TimerHandle_t xTimerCreate(const char *name, TickType_t period, UBaseType_t autoReload, void *timerId,
+                           TimerCallbackFunction_t callback) {
+    if (period == 0 || !callback) {
+        return nullptr;
+    }
+    HostTimer *timer = new HostTimer();
+    timer->name = name ? name : "";
+    timer->period = period;
+    timer->autoReload = autoReload != 0;
+    timer->timerId = timerId;
+    timer->callback = callback;
+    std::lock_guard<std::mutex> lock(g_timersLock);
+    g_timers.push_back(timer);
+    startTimerService();
+    return timer;
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t) {
+    if (!timer) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(g_timersLock);
+    timer->active = true;
+    timer->expiry = std::chrono::steady_clock::now() + std::chrono::milliseconds(timer->period);
+    g_timersChanged.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t ticksToWait) {
+    return xTimerStart(timer, ticksToWait);
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t) {
+    if (!timer) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(g_timersLock);
+    timer->active = false;
+    return pdPASS;
+}
+
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t) {
+    if (!timer) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(g_timersLock);
+    g_timers.remove(timer);
+    delete timer;
+    return pdPASS;
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t newPeriod, TickType_t ticksToWait) {
+    if (!timer || newPeriod == 0) {
+        return pdFAIL;
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_timersLock);
+        timer->period = newPeriod;
+    }
+    return xTimerStart(timer, ticksToWait);
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer) {
+    if (!timer) {
+        return pdFALSE;
+    }
+    std::lock_guard<std::mutex> lock(g_timersLock);
+    return timer->active ? pdTRUE : pdFALSE;
+}
+
+void *pvTimerGetTimerID(TimerHandle_t timer) {
+    return timer ? timer->timerId : nullptr;
+}
+
+// ---------------------------------------------------------------------------------------
+// Shutdown
+
+void hostStopTasks() {
+    g_stopping = true;
+    {
+        std::lock_guard<std::mutex> lock(g_timersLock);
+        g_timersChanged.notify_all();
+    }
+    if (g_timerService.joinable()) {
+        g_timerService.join();
+    }
+
+    std::vector<HostTask *> tasks;
+    {
+        std::lock_guard<std::mutex> guard(g_tasksLock);
+        tasks.swap(g_tasks);
+    }
+    for (HostTask *task : tasks) {
+        task->wake.notify_all();
+        if (task->thread.joinable()) {
+            task->thread.join();
+        }
+        delete task;
+    }
+}
@@ -0,0 +1,231 @@
+// fs.cpp (host)
+// Arduino FS/File over stdio and POSIX directories.
+#include "FS.h"
+#include "SD.h"
+#include "SPIFFS.h"
+#include "FFat.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SPIClass SPI(HSPI);
+fs::SDFS SD;
+fs::SPIFFSFS SPIFFS;
+fs::F_Fat FFat;
+
+namespace fs {
+
+class FileImpl {
+public:
+    FileImpl(const std::string &virtualPath, const std::string &hostPath, FILE *file, DIR *dir)
+        : m_path(virtualPath), m_hostPath(hostPath), m_file(file), m_dir(dir) {
+        size_t slash = m_path.find_last_of('/');
+        m_name = slash == std::string::npos ? m_path : m_path.substr(slash + 1);
+    }
+    ~FileImpl() { close(); }
+
+    void close() {
+        if (m_file) {
+            fclose(m_file);
+            m_file = nullptr;
+        }
+        if (m_dir) {
+            closedir(m_dir);
+            m_dir = nullptr;
+        }
+    }
+
+    std::string m_path;
+    std::string m_hostPath;
+    std::string m_name;
+    FILE *m_file;
+    DIR *m_dir;
+};
+
+size_t File::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t *buffer, size_t size) {
+    if (!m_impl || !m_impl->m_file) {
+        return 0;
+    }
+    return fwrite(buffer, 1, size, m_impl->m_file);
+}
+
+int File::available() {
+    if (!m_impl || !m_impl->m_file) {
+        return 0;
+    }
+    size_t pos = position();
+    size_t total = size();
+    return total > pos ? static_cast<int>(total - pos) : 0;
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::peek() {
+    if (!m_impl || !m_impl->m_file) {
+        return -1;
+    }
+    int c = fgetc(m_impl->m_file);
+    if (c != EOF) {
+        ungetc(c, m_impl->m_file);
+    }
+    return c == EOF ? -1 : c;
+}
+
+size_t File::read(uint8_t *buffer, size_t size) {
+    if (!m_impl || !m_impl->m_file) {
+        return 0;
+    }
+    return fread(buffer, 1, size, m_impl->m_file);
+}
+
+void File::flush() {
+    if (m_impl && m_impl->m_file) {
+        fflush(m_impl->m_file);
+    }
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if (!m_impl || !m_impl->m_file) {
+        return false;
+    }
+    int whence = mode == SeekCur ? SEEK_CUR : (mode == SeekEnd ? SEEK_END : SEEK_SET);
+    return fseek(m_impl->m_file, pos, whence) == 0;
+}
+
+size_t File::position() const {
+    if (!m_impl || !m_impl->m_file) {
+        return 0;
+    }
+    long pos = ftell(m_impl->m_file);
+    return pos < 0 ? 0 : static_cast<size_t>(pos);
+}
+
+size_t File::size() const {
+    if (!m_impl) {
+        return 0;
+    }
+    if (m_impl->m_file) {
+        fflush(m_impl->m_file);
+    }
+    struct stat st;
+    return stat(m_impl->m_hostPath.c_str(), &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+}
+
+void File::close() {
+    if (m_impl) {
+        m_impl->close();
+        m_impl.reset();
+    }
+}
+
+File::operator bool() const {
+    return m_impl && (m_impl->m_file || m_impl->m_dir);
+}
+
+const char *File::path() const {
+    return m_impl ? m_impl->m_path.c_str() : nullptr;
+}
+
+const char *File::name() const {
+    return m_impl ? m_impl->m_name.c_str() : nullptr;
+}
+
+bool File::isDirectory() {
+    return m_impl && m_impl->m_dir;
+}
+
+File File::openNextFile(const char *mode) {
+    if (!m_impl || !m_impl->m_dir) {
+        return File();
+    }
+    struct dirent *entry;
+    while ((entry = readdir(m_impl->m_dir)) != nullptr) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        std::string virtualPath = m_impl->m_path;
+        if (virtualPath.empty() || virtualPath.back() != '/') {
+            virtualPath += '/';
+        }
+        virtualPath += entry->d_name;
+        std::string hostPath = m_impl->m_hostPath + "/" + entry->d_name;
+        struct stat st;
+        if (stat(hostPath.c_str(), &st) != 0) {
+            continue;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            return File(std::make_shared<FileImpl>(virtualPath, hostPath, nullptr, opendir(hostPath.c_str())));
+        }
+        FILE *f = fopen(hostPath.c_str(), mode[0] == 'w' ? "wb" : (mode[0] == 'a' ? "ab" : "rb"));
+        return File(std::make_shared<FileImpl>(virtualPath, hostPath, f, nullptr));
+    }
+    return File();
+}
+
+void File::rewindDirectory() {
+    if (m_impl && m_impl->m_dir) {
+        rewinddir(m_impl->m_dir);
+    }
+}
+
+FS::FS(const char *hostRoot) : m_root(hostRoot ? hostRoot : ".") {}
+
+void FS::setHostRoot(const char *hostRoot) {
+    m_root = hostRoot ? hostRoot : ".";
+}
+
+std::string FS::hostPath(const char *path) const {
+    std::string p = path ? path : "";
+    if (!p.empty() && p[0] != '/') {
+        p = "/" + p;
+    }
+    return m_root + p;
+}
+
+File FS::open(const char *path, const char *mode, const bool) {
+    std::string host = hostPath(path);
+    struct stat st;
+    if (stat(host.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        DIR *dir = opendir(host.c_str());
+        return dir ? File(std::make_shared<FileImpl>(path, host, nullptr, dir)) : File();
+    }
+    const char *hostMode = "rb";
+    if (mode && mode[0] == 'w') {
+        hostMode = "wb";
+    } else if (mode && mode[0] == 'a') {
+        hostMode = "ab";
+    }
+    FILE *f = fopen(host.c_str(), hostMode);
+    return f ? File(std::make_shared<FileImpl>(path, host, f, nullptr)) : File();
+}
+
+bool FS::exists(const char *path) {
+    struct stat st;
+    return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char *path) {
+    return ::remove(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char *pathFrom, const char *pathTo) {
+    return ::rename(hostPath(pathFrom).c_str(), hostPath(pathTo).c_str()) == 0;
+}
+
+bool FS::mkdir(const char *path) {
+    return ::mkdir(hostPath(path).c_str(), 0755) == 0;
+}
+
+bool FS::rmdir(const char *path) {
+    return ::rmdir(hostPath(path).c_str()) == 0;
+}
+
+} // namespace fs
@@ -0,0 +1,778 @@
+// gfx.cpp (host)
+// Drawing primitives of Arduino_GFX, following the Adafruit GFX algorithms so the output
+// matches the panels pixel for pixel where it matters (circles, round rects, fonts).
+#include "Arduino_GFX_Library.h"
+
+namespace {
+
+/// Classic 5x7 font, one byte per column, LSB at the top. Covers ASCII 32-126.
+const uint8_t FONT5X7[95][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x08, 0x2A, 0x1C, 0x2A, 0x08}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00},
+    {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+    {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00},
+    {0x00, 0x56, 0x36, 0x00, 0x00}, {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, {0x32, 0x49, 0x79, 0x41, 0x3E},
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x01, 0x01},
+    {0x3E, 0x41, 0x41, 0x51, 0x32}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+    {0x7F, 0x02, 0x04, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+    {0x46, 0x49, 0x49, 0x49, 0x31}, {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x7F, 0x20, 0x18, 0x20, 0x7F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+    {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04},
+    {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, {0x38, 0x44, 0x44, 0x48, 0x7F},
+    {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x08, 0x14, 0x54, 0x54, 0x3C},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00},
+    {0x00, 0x7F, 0x10, 0x28, 0x44}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0x7C, 0x14, 0x14, 0x14, 0x08},
+    {0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x7F, 0x00, 0x00},
+    {0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08},
+};
+
+inline void swapInt16(int16_t &a, int16_t &b) {
+    int16_t t = a;
+    a = b;
+    b = t;
+}
+
+} // namespace
+
+Arduino_GFX::Arduino_GFX(int16_t w, int16_t h)
+    : WIDTH(w), HEIGHT(h), _width(w), _height(h), _max_x(w - 1), _max_y(h - 1), _rotation(0),
+      cursor_x(0), cursor_y(0), textcolor(0xFFFF), textbgcolor(0xFFFF), textsize_x(1), textsize_y(1),
+      text_pixel_margin(0), wrap(true), gfxFont(nullptr)
+{
+}
+
+// ---------------------------------------------------------------------------------------
+// Clipped writes
+
+void Arduino_GFX::writePixel(int16_t x, int16_t y, uint16_t color) {
+    if (x >= 0 && y >= 0 && x < _width && y < _height) {
+        writePixelPreclipped(x, y, color);
+    }
+}
+
+void Arduino_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w < 0) {
+        x += w + 1;
+        w = -w;
+    }
+    if (h < 0) {
+        y += h + 1;
+        h = -h;
+    }
+    int32_t x0 = x < 0 ? 0 : x;
+    int32_t y0 = y < 0 ? 0 : y;
+    int32_t x1 = static_cast<int32_t>(x) + w;
+    int32_t y1 = static_cast<int32_t>(y) + h;
+    if (x1 > _width) x1 = _width;
+    if (y1 > _height) y1 = _height;
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    writeFillRectPreclipped(x0, y0, x1 - x0, y1 - y0, color);
+}
+
+void Arduino_GFX::writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            writePixelPreclipped(x + i, y + j, color);
+        }
+    }
+}
+
+void Arduino_GFX::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    writeFillRect(x, y, 1, h, color);
+}
+
+void Arduino_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    writeFillRect(x, y, w, 1, color);
+}
+
+void Arduino_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (x0 == x1) {
+        if (y0 > y1) swapInt16(y0, y1);
+        writeFastVLine(x0, y0, y1 - y0 + 1, color);
+        return;
+    }
+    if (y0 == y1) {
+        if (x0 > x1) swapInt16(x0, x1);
+        writeFastHLine(x0, y0, x1 - x0 + 1, color);
+        return;
+    }
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+        swapInt16(x0, y0);
+        swapInt16(x1, y1);
+    }
+    if (x0 > x1) {
+        swapInt16(x0, x1);
+        swapInt16(y0, y1);
+    }
+    int16_t dx = x1 - x0;
+    int16_t dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = y0 < y1 ? 1 : -1;
+    for (; x0 <= x1; x0++) {
+        if (steep) {
+            writePixel(y0, x0, color);
+        } else {
+            writePixel(x0, y0, color);
+        }
+        err -= dy;
+        if (err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------
+// Primitives
+
+void Arduino_GFX::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    startWrite();
+    writePixel(x, y, color);
+    endWrite();
+}
+
+void Arduino_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    startWrite();
+    writeFastVLine(x, y, h, color);
+    endWrite();
+}
+
+void Arduino_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    startWrite();
+    writeFastHLine(x, y, w, color);
+    endWrite();
+}
+
+void Arduino_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    startWrite();
+    writeFillRect(x, y, w, h, color);
+    endWrite();
+}
+
+void Arduino_GFX::fillScreen(uint16_t color) {
+    fillRect(0, 0, _width, _height, color);
+}
+
+void Arduino_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    startWrite();
+    writeLine(x0, y0, x1, y1, color);
+    endWrite();
+}
+
+void Arduino_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    startWrite();
+    writeFastHLine(x, y, w, color);
+    writeFastHLine(x, y + h - 1, w, color);
+    writeFastVLine(x, y, h, color);
+    writeFastVLine(x + w - 1, y, h, color);
+    endWrite();
+}
+
+void Arduino_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    startWrite();
+    writePixel(x0, y0 + r, color);
+    writePixel(x0, y0 - r, color);
+    writePixel(x0 + r, y0, color);
+    writePixel(x0 - r, y0, color);
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        writePixel(x0 + x, y0 + y, color);
+        writePixel(x0 - x, y0 + y, color);
+        writePixel(x0 + x, y0 - y, color);
+        writePixel(x0 - x, y0 - y, color);
+        writePixel(x0 + y, y0 + x, color);
+        writePixel(x0 - y, y0 + x, color);
+        writePixel(x0 + y, y0 - x, color);
+        writePixel(x0 - y, y0 - x, color);
+    }
+    endWrite();
+}
+
+void Arduino_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint16_t color) {
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        if (cornername & 0x4) {
+            writePixel(x0 + x, y0 + y, color);
+            writePixel(x0 + y, y0 + x, color);
+        }
+        if (cornername & 0x2) {
+            writePixel(x0 + x, y0 - y, color);
+            writePixel(x0 + y, y0 - x, color);
+        }
+        if (cornername & 0x8) {
+            writePixel(x0 - y, y0 + x, color);
+            writePixel(x0 - x, y0 + y, color);
+        }
+        if (cornername & 0x1) {
+            writePixel(x0 - y, y0 - x, color);
+            writePixel(x0 - x, y0 - y, color);
+        }
+    }
+}
+
+void Arduino_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    startWrite();
+    writeFastVLine(x0, y0 - r, 2 * r + 1, color);
+    fillCircleHelper(x0, y0, r, 3, 0, color);
+    endWrite();
+}
+
+void Arduino_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta,
+                                   uint16_t color) {
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    int16_t px = x;
+    int16_t py = y;
+    delta++;
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        if (x < (y + 1)) {
+            if (corners & 1) writeFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+            if (corners & 2) writeFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+        }
+        if (y != py) {
+            if (corners & 1) writeFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+            if (corners & 2) writeFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+            py = y;
+        }
+        px = x;
+    }
+}
+
+void Arduino_GFX::drawEllipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color) {
+    if (rx <= 0 || ry <= 0) {
+        drawFastHLine(x0 - rx, y0, 2 * rx + 1, color);
+        return;
+    }
+    startWrite();
+    int16_t prev = rx;
+    for (int16_t dy = 0; dy <= ry; dy++) {
+        float t = 1.0f - static_cast<float>(dy * dy) / (static_cast<float>(ry) * ry);
+        int16_t dx = static_cast<int16_t>(lroundf(rx * sqrtf(t > 0 ? t : 0)));
+        int16_t from = dx;
+        int16_t to = dy == 0 ? dx : prev;
+        if (to < from) to = from;
+        for (int16_t xx = from; xx <= to; xx++) {
+            writePixel(x0 + xx, y0 + dy, color);
+            writePixel(x0 - xx, y0 + dy, color);
+            writePixel(x0 + xx, y0 - dy, color);
+            writePixel(x0 - xx, y0 - dy, color);
+        }
+        prev = dx > 0 ? dx - 1 : 0;
+    }
+    endWrite();
+}
+
+void Arduino_GFX::fillEllipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color) {
+    startWrite();
+    for (int16_t dy = -ry; dy <= ry; dy++) {
+        float t = ry ? 1.0f - static_cast<float>(dy * dy) / (static_cast<float>(ry) * ry) : 1.0f;
+        int16_t dx = static_cast<int16_t>(lroundf(rx * sqrtf(t > 0 ? t : 0)));
+        writeFastHLine(x0 - dx, y0 + dy, 2 * dx + 1, color);
+    }
+    endWrite();
+}
+
+void Arduino_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    int16_t maxRadius = ((w < h) ? w : h) / 2;
+    if (r > maxRadius) r = maxRadius;
+    startWrite();
+    writeFastHLine(x + r, y, w - 2 * r, color);
+    writeFastHLine(x + r, y + h - 1, w - 2 * r, color);
+    writeFastVLine(x, y + r, h - 2 * r, color);
+    writeFastVLine(x + w - 1, y + r, h - 2 * r, color);
+    drawCircleHelper(x + r, y + r, r, 1, color);
+    drawCircleHelper(x + w - r - 1, y + r, r, 2, color);
+    drawCircleHelper(x + w - r - 1, y + h - r - 1, r, 4, color);
+    drawCircleHelper(x + r, y + h - r - 1, r, 8, color);
+    endWrite();
+}
+
+void Arduino_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    int16_t maxRadius = ((w < h) ? w : h) / 2;
+    if (r > maxRadius) r = maxRadius;
+    startWrite();
+    writeFillRect(x + r, y, w - 2 * r, h, color);
+    fillCircleHelper(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
+    fillCircleHelper(x + r, y + r, r, 2, h - 2 * r - 1, color);
+    endWrite();
+}
+
+void Arduino_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                               uint16_t color) {
+    startWrite();
+    writeLine(x0, y0, x1, y1, color);
+    writeLine(x1, y1, x2, y2, color);
+    writeLine(x2, y2, x0, y0, color);
+    endWrite();
+}
+
+void Arduino_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                               uint16_t color) {
+    int16_t a, b, y, last;
+    if (y0 > y1) {
+        swapInt16(y0, y1);
+        swapInt16(x0, x1);
+    }
+    if (y1 > y2) {
+        swapInt16(y2, y1);
+        swapInt16(x2, x1);
+    }
+    if (y0 > y1) {
+        swapInt16(y0, y1);
+        swapInt16(x0, x1);
+    }
+
+    startWrite();
+    if (y0 == y2) {
+        a = b = x0;
+        if (x1 < a) a = x1;
+        else if (x1 > b) b = x1;
+        if (x2 < a) a = x2;
+        else if (x2 > b) b = x2;
+        writeFastHLine(a, y0, b - a + 1, color);
+        endWrite();
+        return;
+    }
+
+    int32_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0, dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+
+    // Upper part: rows y0..y1 (y1 included only when the lower part is flat)
+    last = (y1 == y2) ? y1 : y1 - 1;
+    for (y = y0; y <= last; y++) {
+        a = x0 + sa / dy01;
+        b = x0 + sb / dy02;
+        sa += dx01;
+        sb += dx02;
+        if (a > b) swapInt16(a, b);
+        writeFastHLine(a, y, b - a + 1, color);
+    }
+
+    // Lower part: rows y1..y2
+    sa = dx12 * (y - y1);
+    sb = dx02 * (y - y0);
+    for (; y <= y2; y++) {
+        a = x1 + sa / dy12;
+        b = x0 + sb / dy02;
+        sa += dx12;
+        sb += dx02;
+        if (a > b) swapInt16(a, b);
+        writeFastHLine(a, y, b - a + 1, color);
+    }
+    endWrite();
+}
+
+void Arduino_GFX::fillArcPixels(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float end,
+                                uint16_t color, bool outline) {
+    if (r1 > r2) swapInt16(r1, r2);
+    if (r2 < 0) return;
+    if (r1 < 0) r1 = 0;
+
+    // Angles in degrees, 0 at 3 o'clock, growing clockwise (screen Y points down)
+    float span = end - start;
+    bool full = span >= 360.0f || span <= -360.0f;
+    start = fmodf(start, 360.0f);
+    if (start < 0) start += 360.0f;
+    span = fmodf(span, 360.0f);
+    if (span < 0) span += 360.0f;
+
+    const int32_t inner2 = static_cast<int32_t>(r1) * r1;
+    const int32_t outer2 = static_cast<int32_t>(r2) * r2 + r2;
+    auto inside = [&](int32_t dx, int32_t dy) {
+        int32_t d2 = dx * dx + dy * dy;
+        if (d2 > outer2 || d2 < inner2) return false;
+        if (full) return true;
+        float a = atan2f(static_cast<float>(dy), static_cast<float>(dx)) * 57.2957795f;
+        if (a < 0) a += 360.0f;
+        float rel = a - start;
+        if (rel < 0) rel += 360.0f;
+        return rel <= span;
+    };
+
+    startWrite();
+    for (int32_t dy = -r2; dy <= r2; dy++) {
+        for (int32_t dx = -r2; dx <= r2; dx++) {
+            if (!inside(dx, dy)) continue;
+            if (outline && inside(dx - 1, dy) && inside(dx + 1, dy) && inside(dx, dy - 1) && inside(dx, dy + 1)) {
+                continue;
+            }
+            writePixel(x + dx, y + dy, color);
+        }
+    }
+    endWrite();
+}
+
+void Arduino_GFX::drawArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float end, uint16_t color) {
+    fillArcPixels(x, y, r1, r2, start, end, color, true);
+}
+
+void Arduino_GFX::fillArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float end, uint16_t color) {
+    fillArcPixels(x, y, r1, r2, start, end, color, false);
+}
+
+// ---------------------------------------------------------------------------------------
+// Bitmaps
+
+void Arduino_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) {
+    int16_t byteWidth = (w + 7) / 8;
+    startWrite();
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (bitmap[j * byteWidth + i / 8] & (0x80 >> (i & 7))) {
+                writePixel(x + i, y + j, color);
+            }
+        }
+    }
+    endWrite();
+}
+
+void Arduino_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color,
+                             uint16_t bg) {
+    int16_t byteWidth = (w + 7) / 8;
+    startWrite();
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            bool on = bitmap[j * byteWidth + i / 8] & (0x80 >> (i & 7));
+            writePixel(x + i, y + j, on ? color : bg);
+        }
+    }
+    endWrite();
+}
+
+void Arduino_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) {
+    int16_t byteWidth = (w + 7) / 8;
+    startWrite();
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (bitmap[j * byteWidth + i / 8] & (1 << (i & 7))) {
+                writePixel(x + i, y + j, color);
+            }
+        }
+    }
+    endWrite();
+}
+
+void Arduino_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h) {
+    startWrite();
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            uint8_t v = bitmap[j * w + i];
+            writePixel(x + i, y + j, RGB565(v, v, v));
+        }
+    }
+    endWrite();
+}
+
+void Arduino_GFX::draw16bitRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w, int16_t h) {
+    startWrite();
+    for (int16_t j = 0; j < h; j++) {
+        int16_t py = y + j;
+        if (py < 0 || py >= _height) continue;
+        for (int16_t i = 0; i < w; i++) {
+            writePixel(x + i, py, bitmap[j * w + i]);
+        }
+    }
+    endWrite();
+}
+
+void Arduino_GFX::draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) {
+    draw16bitRGBBitmap(x, y, const_cast<const uint16_t *>(bitmap), w, h);
+}
+
+void Arduino_GFX::draw16bitRGBBitmapWithMask(int16_t x, int16_t y, const uint16_t bitmap[], const uint8_t mask[],
+                                             int16_t w, int16_t h) {
+    int16_t byteWidth = (w + 7) / 8;
+    startWrite();
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (mask[j * byteWidth + i / 8] & (0x80 >> (i & 7))) {
+                writePixel(x + i, y + j, bitmap[j * w + i]);
+            }
+        }
+    }
+    endWrite();
+}
+
+void Arduino_GFX::draw16bitRGBBitmapWithMask(int16_t x, int16_t y, uint16_t *bitmap, uint8_t *mask, int16_t w,
+                                             int16_t h) {
+    draw16bitRGBBitmapWithMask(x, y, const_cast<const uint16_t *>(bitmap), const_cast<const uint8_t *>(mask), w, h);
+}
+
+void Arduino_GFX::draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) {
+    startWrite();
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            uint16_t c = bitmap[j * w + i];
+            writePixel(x + i, y + j, static_cast<uint16_t>((c << 8) | (c >> 8)));
+        }
+    }
+    endWrite();
+}
+
+void Arduino_GFX::draw24bitRGBBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h) {
+    startWrite();
+    int32_t offset = 0;
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++, offset += 3) {
+            writePixel(x + i, y + j, RGB565(bitmap[offset], bitmap[offset + 1], bitmap[offset + 2]));
+        }
+    }
+    endWrite();
+}
+
+// ---------------------------------------------------------------------------------------
+// Text
+
+void Arduino_GFX::setTextSize(uint8_t sx, uint8_t sy, uint8_t pixelMargin) {
+    textsize_x = sx > 0 ? sx : 1;
+    textsize_y = sy > 0 ? sy : 1;
+    text_pixel_margin = (pixelMargin < textsize_x && pixelMargin < textsize_y) ? pixelMargin : 0;
+}
+
+void Arduino_GFX::setFont(const GFXfont *f) {
+    // Custom fonts draw from the baseline, the built-in one from the top left corner
+    if (f) {
+        if (!gfxFont) cursor_y += 6;
+    } else if (gfxFont) {
+        cursor_y -= 6;
+    }
+    gfxFont = f;
+}
+
+void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg) {
+    const int16_t blockW = textsize_x - text_pixel_margin;
+    const int16_t blockH = textsize_y - text_pixel_margin;
+
+    if (!gfxFont) {
+        if (x >= _width || y >= _height || (x + 6 * textsize_x - 1) < 0 || (y + 8 * textsize_y - 1) < 0) {
+            return;
+        }
+        const uint8_t *glyph = (c >= 32 && c <= 126) ? FONT5X7[c - 32] : nullptr;
+        startWrite();
+        for (int8_t i = 0; i < 6; i++) {
+            uint8_t line = (glyph && i < 5) ? glyph[i] : 0;
+            for (int8_t j = 0; j < 8; j++, line >>= 1) {
+                bool on = line & 1;
+                if (!on && bg == color) continue;
+                uint16_t pc = on ? color : bg;
+                if (textsize_x == 1 && textsize_y == 1) {
+                    writePixel(x + i, y + j, pc);
+                } else {
+                    writeFillRect(x + i * textsize_x, y + j * textsize_y, blockW, blockH, pc);
+                }
+            }
+        }
+        endWrite();
+        return;
+    }
+
+    if (c < gfxFont->first || c > gfxFont->last) {
+        return;
+    }
+    const GFXglyph *glyph = &gfxFont->glyph[c - gfxFont->first];
+    const uint8_t *bitmap = gfxFont->bitmap;
+    uint16_t bo = glyph->bitmapOffset;
+    uint8_t w = glyph->width;
+    uint8_t h = glyph->height;
+    int8_t xo = glyph->xOffset;
+    int8_t yo = glyph->yOffset;
+    uint8_t bits = 0;
+    uint8_t bit = 0;
+
+    startWrite();
+    for (uint8_t yy = 0; yy < h; yy++) {
+        for (uint8_t xx = 0; xx < w; xx++) {
+            if (!(bit++ & 7)) {
+                bits = bitmap[bo++];
+            }
+            if (bits & 0x80) {
+                if (textsize_x == 1 && textsize_y == 1) {
+                    writePixel(x + xo + xx, y + yo + yy, color);
+                } else {
+                    writeFillRect(x + (xo + xx) * textsize_x, y + (yo + yy) * textsize_y, blockW, blockH, color);
+                }
+            }
+            bits <<= 1;
+        }
+    }
+    endWrite();
+}
+
+size_t Arduino_GFX::write(uint8_t c) {
+    if (!gfxFont) {
+        if (c == '\n') {
+            cursor_x = 0;
+            cursor_y += textsize_y * 8;
+        } else if (c != '\r') {
+            if (wrap && (cursor_x + textsize_x * 6) > _width) {
+                cursor_x = 0;
+                cursor_y += textsize_y * 8;
+            }
+            drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor);
+            cursor_x += textsize_x * 6;
+        }
+        return 1;
+    }
+
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += textsize_y * gfxFont->yAdvance;
+    } else if (c != '\r' && c >= gfxFont->first && c <= gfxFont->last) {
+        const GFXglyph *glyph = &gfxFont->glyph[c - gfxFont->first];
+        if (glyph->width > 0 && glyph->height > 0) {
+            if (wrap && (cursor_x + textsize_x * (glyph->xOffset + glyph->width)) > _width) {
+                cursor_x = 0;
+                cursor_y += textsize_y * gfxFont->yAdvance;
+            }
+            drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor);
+        }
+        cursor_x += glyph->xAdvance * textsize_x;
+    }
+    return 1;
+}
+
+void Arduino_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny,
+                             int16_t *maxx, int16_t *maxy) {
+    if (!gfxFont) {
+        if (c == '\n') {
+            *x = 0;
+            *y += textsize_y * 8;
+        } else if (c != '\r') {
+            if (wrap && (*x + textsize_x * 6) > _width) {
+                *x = 0;
+                *y += textsize_y * 8;
+            }
+            int16_t x2 = *x + textsize_x * 6 - 1;
+            int16_t y2 = *y + textsize_y * 8 - 1;
+            if (x2 > *maxx) *maxx = x2;
+            if (y2 > *maxy) *maxy = y2;
+            if (*x < *minx) *minx = *x;
+            if (*y < *miny) *miny = *y;
+            *x += textsize_x * 6;
+        }
+        return;
+    }
+
+    if (c == '\n') {
+        *x = 0;
+        *y += textsize_y * gfxFont->yAdvance;
+    } else if (c != '\r' && c >= gfxFont->first && c <= gfxFont->last) {
+        const GFXglyph *glyph = &gfxFont->glyph[c - gfxFont->first];
+        uint8_t gw = glyph->width;
+        uint8_t gh = glyph->height;
+        int8_t xo = glyph->xOffset;
+        int8_t yo = glyph->yOffset;
+        if (wrap && (*x + ((int16_t)xo + gw) * textsize_x) > _width) {
+            *x = 0;
+            *y += textsize_y * gfxFont->yAdvance;
+        }
+        int16_t x1 = *x + xo * textsize_x;
+        int16_t y1 = *y + yo * textsize_y;
+        int16_t x2 = x1 + gw * textsize_x - 1;
+        int16_t y2 = y1 + gh * textsize_y - 1;
+        if (x1 < *minx) *minx = x1;
+        if (y1 < *miny) *miny = y1;
+        if (x2 > *maxx) *maxx = x2;
+        if (y2 > *maxy) *maxy = y2;
+        *x += glyph->xAdvance * textsize_x;
+    }
+}
+
+void Arduino_GFX::getTextBounds(const char *str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w,
+                                uint16_t *h) {
+    *x1 = x;
+    *y1 = y;
+    *w = *h = 0;
+    if (!str) {
+        return;
+    }
+    // Inverted box as in Arduino_GFX: the maximum starts at -1, so a box that ends above or left
+    // of the origin is stretched to it.
+    int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+    unsigned char c;
+    while ((c = static_cast<unsigned char>(*str++))) {
+        charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+    }
+    if (maxx >= minx) {
+        *x1 = minx;
+        *w = maxx - minx + 1;
+    }
+    if (maxy >= miny) {
+        *y1 = miny;
+        *h = maxy - miny + 1;
+    }
+}
+
+void Arduino_GFX::getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w,
+                                uint16_t *h) {
+    getTextBounds(str.c_str(), x, y, x1, y1, w, h);
+}
+
+// ---------------------------------------------------------------------------------------
+// Display control
+
+void Arduino_GFX::setRotation(uint8_t r) {
+    _rotation = r & 3;
+    if (_rotation & 1) {
+        _width = HEIGHT;
+        _height = WIDTH;
+    } else {
+        _width = WIDTH;
+        _height = HEIGHT;
+    }
+    _max_x = _width - 1;
+    _max_y = _height - 1;
+}
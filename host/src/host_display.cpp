@@ -0,0 +1,223 @@
+// host_display.cpp (host)
+#include "dfk_host.h"
+
+#include <vector>
+
+HostDisplay::HostDisplay(int16_t w, int16_t h)
+    : Arduino_GFX(w, h), m_framebuffer(nullptr), m_stats{0, 0}, m_writeDepth(0) {}
+
+HostDisplay::~HostDisplay() {
+    delete[] m_framebuffer;
+}
+
+bool HostDisplay::begin(int32_t) {
+    if (!m_framebuffer) {
+        m_framebuffer = new (std::nothrow) uint16_t[static_cast<size_t>(WIDTH) * HEIGHT];
+        if (!m_framebuffer) {
+            return false;
+        }
+    }
+    memset(m_framebuffer, 0, static_cast<size_t>(WIDTH) * HEIGHT * sizeof(uint16_t));
+    return true;
+}
+
+void HostDisplay::startWrite() {
+    if (m_writeDepth++ == 0) {
+        m_stats.transactions++;
+    }
+}
+
+void HostDisplay::endWrite() {
+    if (m_writeDepth > 0) {
+        m_writeDepth--;
+    }
+}
+
+void HostDisplay::resetStats() {
+    m_stats.pixels = 0;
+    m_stats.transactions = 0;
+}
+
+void HostDisplay::writePixelPreclipped(int16_t x, int16_t y, uint16_t color) {
+    m_stats.pixels++;
+    m_framebuffer[static_cast<int32_t>(y) * _width + x] = color;
+}
+
+void HostDisplay::writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    m_stats.pixels += static_cast<uint32_t>(w) * h;
+    uint16_t *row = m_framebuffer + static_cast<int32_t>(y) * _width + x;
+    for (int16_t j = 0; j < h; j++, row += _width) {
+        std::fill(row, row + w, color);
+    }
+}
+
+void HostDisplay::draw16bitRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w, int16_t h) {
+    if (m_writeDepth == 0) {
+        m_stats.transactions++;
+    }
+    int16_t x0 = std::max<int16_t>(x, 0);
+    int16_t y0 = std::max<int16_t>(y, 0);
+    int32_t x1 = std::min<int32_t>(static_cast<int32_t>(x) + w, _width);
+    int32_t y1 = std::min<int32_t>(static_cast<int32_t>(y) + h, _height);
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    m_stats.pixels += static_cast<uint32_t>(x1 - x0) * (y1 - y0);
+    for (int32_t py = y0; py < y1; py++) {
+        const uint16_t *src = bitmap + (py - y) * w + (x0 - x);
+        memcpy(m_framebuffer + py * _width + x0, src, (x1 - x0) * sizeof(uint16_t));
+    }
+}
+
+void HostDisplay::draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) {
+    draw16bitRGBBitmap(x, y, const_cast<const uint16_t *>(bitmap), w, h);
+}
+
+void HostDisplay::setRotation(uint8_t r) {
+    // The framebuffer always holds the logical orientation; its size does not change
+    Arduino_GFX::setRotation(r);
+}
+
+uint16_t HostDisplay::getPixel(int16_t x, int16_t y) const {
+    if (!m_framebuffer || x < 0 || y < 0 || x >= _width || y >= _height) {
+        return 0;
+    }
+    return m_framebuffer[static_cast<int32_t>(y) * _width + x];
+}
+
+void HostDisplay::toRGB888(uint8_t *out) const {
+    const size_t count = static_cast<size_t>(_width) * _height;
+    for (size_t i = 0; i < count; i++) {
+        uint16_t c = m_framebuffer[i];
+        uint8_t r = (c >> 11) & 0x1F;
+        uint8_t g = (c >> 5) & 0x3F;
+        uint8_t b = c & 0x1F;
+        *out++ = static_cast<uint8_t>((r << 3) | (r >> 2));
+        *out++ = static_cast<uint8_t>((g << 2) | (g >> 4));
+        *out++ = static_cast<uint8_t>((b << 3) | (b >> 2));
+    }
+}
+
+/**
+ * @brief Saves the framebuffer as a binary PPM (P6) image.
+ */
+bool HostDisplay::savePPM(const char *path) const {
+    if (!m_framebuffer) {
+        return false;
+    }
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    std::vector<uint8_t> rgb(static_cast<size_t>(_width) * _height * 3);
+    toRGB888(rgb.data());
+    fprintf(f, "P6\n%d %d\n255\n", _width, _height);
+    bool ok = fwrite(rgb.data(), 1, rgb.size(), f) == rgb.size();
+    return fclose(f) == 0 && ok;
+}
+
+namespace {
+
+uint32_t crc32(uint32_t crc, const uint8_t *data, size_t length) {
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        ready = true;
+    }
+    crc = ~crc;
+    while (length--) {
+        crc = table[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void put32(std::vector<uint8_t> &out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v >> 24));
+    out.push_back(static_cast<uint8_t>(v >> 16));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+void putChunk(FILE *f, const char *type, const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> chunk;
+    put32(chunk, static_cast<uint32_t>(data.size()));
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    put32(chunk, crc32(0, chunk.data() + 4, chunk.size() - 4));
+    fwrite(chunk.data(), 1, chunk.size(), f);
+}
+
+} // namespace
+
+/**
+ * @brief Saves the framebuffer as a PNG image.
+ * @details The image data is stored with uncompressed deflate blocks, so no zlib is needed;
+ *          files are about the size of the PPM.
+ */
+bool HostDisplay::savePNG(const char *path) const {
+    if (!m_framebuffer) {
+        return false;
+    }
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+
+    const size_t stride = static_cast<size_t>(_width) * 3;
+    std::vector<uint8_t> rgb(stride * _height);
+    toRGB888(rgb.data());
+
+    // Scanlines with filter type 0
+    std::vector<uint8_t> raw;
+    raw.reserve((stride + 1) * _height);
+    for (int16_t y = 0; y < _height; y++) {
+        raw.push_back(0);
+        raw.insert(raw.end(), rgb.begin() + y * stride, rgb.begin() + (y + 1) * stride);
+    }
+
+    // zlib stream made of stored blocks
+    std::vector<uint8_t> z;
+    z.push_back(0x78);
+    z.push_back(0x01);
+    size_t pos = 0;
+    do {
+        size_t n = std::min<size_t>(raw.size() - pos, 65535);
+        bool last = pos + n == raw.size();
+        z.push_back(last ? 1 : 0);
+        z.push_back(static_cast<uint8_t>(n));
+        z.push_back(static_cast<uint8_t>(n >> 8));
+        z.push_back(static_cast<uint8_t>(~n));
+        z.push_back(static_cast<uint8_t>(~n >> 8));
+        z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + n);
+        pos += n;
+    } while (pos < raw.size());
+    uint32_t a = 1, b = 0;
+    for (uint8_t v : raw) {
+        a = (a + v) % 65521;
+        b = (b + a) % 65521;
+    }
+    put32(z, (b << 16) | a);
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    fwrite(signature, 1, sizeof(signature), f);
+    std::vector<uint8_t> ihdr;
+    put32(ihdr, _width);
+    put32(ihdr, _height);
+    ihdr.push_back(8); // bit depth
+    ihdr.push_back(2); // truecolor
+    ihdr.push_back(0);
+    ihdr.push_back(0);
+    ihdr.push_back(0);
+    putChunk(f, "IHDR", ihdr);
+    putChunk(f, "IDAT", z);
+    putChunk(f, "IEND", std::vector<uint8_t>());
+    bool ok = !ferror(f);
+    return fclose(f) == 0 && ok;
+}
@@ -0,0 +1,180 @@
+// wire.cpp (host)
+// Emulated I2C bus and the GT911 touch controller attached to it.
+#include "Wire.h"
+#include "dfk_host.h"
+
+#include <mutex>
+
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+void TwoWire::beginTransmission(uint8_t address) {
+    m_txAddress = address & 0x7F;
+    m_txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (m_txLength >= BUFFER_SIZE) {
+        return 0;
+    }
+    m_txBuffer[m_txLength++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t length) {
+    size_t n = 0;
+    while (n < length && write(data[n])) {
+        n++;
+    }
+    return n;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+    HostI2CDevice *device = m_devices[m_txAddress];
+    if (!device) {
+        return 2; // address NACK
+    }
+    device->onWrite(m_txBuffer, m_txLength);
+    m_txLength = 0;
+    return 0;
+}
+
+size_t TwoWire::requestFrom(uint8_t address, size_t length, bool) {
+    m_rxIndex = 0;
+    m_rxLength = 0;
+    HostI2CDevice *device = m_devices[address & 0x7F];
+    if (!device) {
+        return 0;
+    }
+    m_rxLength = std::min(length, BUFFER_SIZE);
+    device->onRead(m_rxBuffer, m_rxLength);
+    return m_rxLength;
+}
+
+int TwoWire::available() {
+    return static_cast<int>(m_rxLength - m_rxIndex);
+}
+
+int TwoWire::read() {
+    return m_rxIndex < m_rxLength ? m_rxBuffer[m_rxIndex++] : -1;
+}
+
+int TwoWire::peek() {
+    return m_rxIndex < m_rxLength ? m_rxBuffer[m_rxIndex] : -1;
+}
+
+void TwoWire::attach(uint8_t address, HostI2CDevice *device) {
+    m_devices[address & 0x7F] = device;
+}
+
+void TwoWire::detach(uint8_t address) {
+    m_devices[address & 0x7F] = nullptr;
+}
+
+// ---------------------------------------------------------------------------------------
+// GT911
+
+namespace {
+
+/// @brief Register file of a GT911 with 16-bit auto-incrementing addresses.
+class HostGT911 : public HostI2CDevice {
+public:
+    static const uint16_t BASE = 0x8040;
+    static const uint16_t CONFIG_X_MAX = 0x8048;
+    static const uint16_t CONFIG_Y_MAX = 0x804A;
+    static const uint16_t POINT_INFO = 0x814E;
+    static const uint16_t POINT_1 = 0x814F;
+
+    HostGT911() : m_pointer(0), m_pressed(false), m_x(0), m_y(0) {
+        memset(m_regs, 0, sizeof(m_regs));
+        memcpy(&m_regs[0x8140 - BASE], "911", 3);
+    }
+
+    void setResolution(uint16_t w, uint16_t h) {
+        std::lock_guard<std::mutex> lock(m_lock);
+        put16(CONFIG_X_MAX, w);
+        put16(CONFIG_Y_MAX, h);
+    }
+
+    void setTouch(bool pressed, uint16_t x, uint16_t y) {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_pressed = pressed;
+        m_x = x;
+        m_y = y;
+        latch();
+    }
+
+    void onWrite(const uint8_t *data, size_t length) override {
+        if (length < 2) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_pointer = static_cast<uint16_t>((data[0] << 8) | data[1]);
+        for (size_t i = 2; i < length; i++) {
+            uint16_t reg = m_pointer + (i - 2);
+            // Clearing the status register acknowledges the sample; the panel reports the
+            // finger again on the next scan while it stays down
+            if (reg == POINT_INFO) {
+                latch();
+                continue;
+            }
+            if (contains(reg)) {
+                m_regs[reg - BASE] = data[i];
+            }
+        }
+    }
+
+    void onRead(uint8_t *data, size_t length) override {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (size_t i = 0; i < length; i++) {
+            uint16_t reg = m_pointer + i;
+            data[i] = contains(reg) ? m_regs[reg - BASE] : 0;
+        }
+    }
+
+private:
+    static bool contains(uint16_t reg) { return reg >= BASE && reg < BASE + sizeof(m_regs); }
+
+    void put16(uint16_t reg, uint16_t value) {
+        m_regs[reg - BASE] = lowByte(value);
+        m_regs[reg - BASE + 1] = highByte(value);
+    }
+
+    void latch() {
+        if (m_pressed) {
+            m_regs[POINT_INFO - BASE] = 0x80 | 1;
+            m_regs[POINT_1 - BASE] = 0;
+            put16(POINT_1 + 1, m_x);
+            put16(POINT_1 + 3, m_y);
+            put16(POINT_1 + 5, 20);
+        } else {
+            m_regs[POINT_INFO - BASE] = 0x80;
+        }
+    }
+
+    std::mutex m_lock;
+    uint8_t m_regs[0x180];
+    uint16_t m_pointer;
+    bool m_pressed;
+    uint16_t m_x;
+    uint16_t m_y;
+};
+
+HostGT911 g_gt911;
+
+} // namespace
+
+void hostTouchBegin(uint16_t width, uint16_t height) {
+    g_gt911.setResolution(width, height);
+    g_gt911.setTouch(false, 0, 0);
+    Wire.attach(0x5D, &g_gt911);
+    Wire.attach(0x14, &g_gt911);
+}
+
+void hostTouchPress(uint16_t x, uint16_t y) {
+    g_gt911.setTouch(true, x, y);
+}
+
+void hostTouchRelease() {
+    g_gt911.setTouch(false, 0, 0);
+}
@@ -0,0 +1,64 @@
+// dirtyregion_test.cpp
+// DirtyRegion must keep its rectangles apart (area() adds them up) and cover every rectangle
+// added, also once the list is full and pairs are merged to make room.
+#include <Arduino.h>
+#include <extras/dirtyregion.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+int main() {
+    const int W = 800;
+    const int H = 480;
+    int failures = 0;
+    srand(1);
+    for (int round = 0; round < 200 && failures == 0; round++) {
+        DirtyRegion region;
+        std::vector<uint8_t> added(W * H, 0);
+        const int rects = 1 + rand() % (3 * DIRTY_REGION_MAX_RECTS);
+        for (int n = 0; n < rects; n++) {
+            const int x = rand() % (W - 10), y = rand() % (H - 10);
+            const int w = 1 + rand() % std::min(60, W - x), h = 1 + rand() % std::min(40, H - y);
+            region.add(x, y, w, h);
+            for (int yy = y; yy < y + h; yy++) {
+                for (int xx = x; xx < x + w; xx++) {
+                    added[yy * W + xx] = 1;
+                }
+            }
+        }
+        for (uint8_t i = 0; i < region.count(); i++) {
+            for (uint8_t j = i + 1; j < region.count(); j++) {
+                if (DirtyRegion::overlaps(region.rect(i), region.rect(j))) {
+                    printf("FAIL: round %d, rectangles %u and %u overlap\n", round, i, j);
+                    failures++;
+                }
+            }
+        }
+        std::vector<uint8_t> covered(W * H, 0);
+        uint32_t pixels = 0;
+        for (uint8_t i = 0; i < region.count(); i++) {
+            const Rect_t &r = region.rect(i);
+            for (int yy = r.y; yy < r.y + r.height; yy++) {
+                for (int xx = r.x; xx < r.x + r.width; xx++) {
+                    pixels += covered[yy * W + xx] ? 0 : 1;
+                    covered[yy * W + xx] = 1;
+                }
+            }
+        }
+        for (int p = 0; p < W * H; p++) {
+            if (added[p] && !covered[p]) {
+                printf("FAIL: round %d, pixel (%d, %d) was added but is not covered\n", round, p % W, p / W);
+                failures++;
+                break;
+            }
+        }
+        if (pixels != region.area()) {
+            printf("FAIL: round %d, area() is %u, the rectangles cover %u pixels\n", round,
+                   (unsigned)region.area(), (unsigned)pixels);
+            failures++;
+        }
+    }
+    printf("%s\n", failures ? "dirtyregion_test FAILED" : "dirtyregion_test passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+// fontmetrics_test.cpp
+// FontMetrics::bestFit() must return the first font of the list where the text fits, also when
+// fitting is not monotonic. The fonts below share their line height and advance, so the list
+// looks sorted, but the glyph boxes alternate wide / narrow: fits = [no, yes, no, yes].
+#include <Arduino_GFX_Library.h>
+#include <extras/fontmetrics.h>
+
+#include <cstdio>
+
+namespace {
+
+const uint8_t bitmap[1] = {0};
+
+// bitmapOffset, width, height, xAdvance, xOffset, yOffset
+GFXglyph wideGlyph[1] = {{0, 30, 12, 32, 0, -12}};
+GFXglyph narrowGlyph[1] = {{0, 10, 12, 32, 0, -12}};
+
+GFXfont wideFont = {const_cast<uint8_t *>(bitmap), wideGlyph, 'A', 'A', 16};
+GFXfont narrowFont = {const_cast<uint8_t *>(bitmap), narrowGlyph, 'A', 'A', 16};
+GFXfont wideFont2 = {const_cast<uint8_t *>(bitmap), wideGlyph, 'A', 'A', 16};
+GFXfont narrowFont2 = {const_cast<uint8_t *>(bitmap), narrowGlyph, 'A', 'A', 16};
+
+} // namespace
+
+int main() {
+    int failures = 0;
+    const GFXfont *const fonts[] = {&wideFont, &narrowFont, &wideFont2, &narrowFont2};
+
+    const GFXfont *fit = FontMetrics::bestFit("A", 20, 20, fonts, 4);
+    if (fit != &narrowFont) {
+        printf("FAIL: non-monotonic list, expected font 1\n");
+        failures++;
+    }
+    if (FontMetrics::bestFit("A", 40, 20, fonts, 4) != &wideFont) {
+        printf("FAIL: every font fits, expected font 0\n");
+        failures++;
+    }
+    if (FontMetrics::bestFit("A", 5, 20, fonts, 4) != nullptr) {
+        printf("FAIL: no font fits, expected nullptr\n");
+        failures++;
+    }
+    const GFXfont *const tail[] = {&wideFont, &wideFont2, &wideFont, &narrowFont};
+    if (FontMetrics::bestFit("A", 20, 20, tail, 4) != &narrowFont) {
+        printf("FAIL: only the last font fits, expected font 3\n");
+        failures++;
+    }
+
+    printf("%s\n", failures ? "fontmetrics_test FAILED" : "fontmetrics_test passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+// framebuffercanvas_test.cpp
+// FrameBufferCanvas after markStale(): only the bands drawn again are read back from the panel
+// framebuffer, in the orientation of the panel display, and present() sends them unchanged
+// around what was drawn.
+#include <Arduino_GFX_Library.h>
+#include <extras/framebuffercanvas.h>
+#include <dfk_host.h>
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+const int16_t PANEL_W = 64; ///< Panel size in its rotation 0 layout.
+const int16_t PANEL_H = 40;
+
+uint16_t pattern(int32_t px, int32_t py) {
+    return static_cast<uint16_t>(1 + py * PANEL_W + px);
+}
+
+/// @brief Panel pixel shown at logical (x, y) for each rotation, from the corners of the panel.
+uint16_t expected(uint8_t rotation, int32_t x, int32_t y) {
+    switch (rotation) {
+        case 1: return pattern(PANEL_W - 1 - y, x);               // (0, 0) is the top right corner
+        case 2: return pattern(PANEL_W - 1 - x, PANEL_H - 1 - y); // (0, 0) is the bottom right corner
+        case 3: return pattern(y, PANEL_H - 1 - x);               // (0, 0) is the bottom left corner
+        default: return pattern(x, y);
+    }
+}
+
+int checkReadBack(uint8_t rotation) {
+    std::vector<uint16_t> panel(PANEL_W * PANEL_H);
+    for (int32_t py = 0; py < PANEL_H; py++) {
+        for (int32_t px = 0; px < PANEL_W; px++) {
+            panel[py * PANEL_W + px] = pattern(px, py);
+        }
+    }
+    const int16_t w = (rotation & 1) ? PANEL_H : PANEL_W;
+    const int16_t h = (rotation & 1) ? PANEL_W : PANEL_H;
+    FrameBufferCanvas canvas(w, h);
+    if (!canvas.begin()) {
+        printf("FAIL: rotation %u, begin()\n", rotation);
+        return 1;
+    }
+    canvas.markStale(panel.data(), rotation);
+
+    // One pixel in the second band; the other bands stay as they were (zero)
+    const int16_t dotX = 3, dotY = DFK_FB_BAND_HEIGHT + 2;
+    canvas.drawPixel(dotX, dotY, 0);
+    const uint16_t *buffer = canvas.getBuffer();
+    int failures = 0;
+    for (int32_t y = 0; y < h && failures < 5; y++) {
+        const bool drawnBand = y / DFK_FB_BAND_HEIGHT == 1;
+        for (int32_t x = 0; x < w && failures < 5; x++) {
+            uint16_t want = drawnBand ? expected(rotation, x, y) : 0;
+            if (x == dotX && y == dotY) {
+                want = 0;
+            }
+            if (buffer[y * w + x] != want) {
+                printf("FAIL: rotation %u, pixel (%d, %d) is %u, expected %u\n", rotation, x, y,
+                       buffer[y * w + x], want);
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+int checkPresent() {
+    HostDisplay panel(PANEL_W, PANEL_H);
+    panel.begin();
+    for (int16_t y = 0; y < PANEL_H; y++) {
+        for (int16_t x = 0; x < PANEL_W; x++) {
+            panel.drawPixel(x, y, pattern(x, y));
+        }
+    }
+    FrameBufferCanvas canvas(PANEL_W, PANEL_H);
+    if (!canvas.begin()) {
+        printf("FAIL: present, begin()\n");
+        return 1;
+    }
+    canvas.markStale(panel.getFramebuffer(), 0);
+    canvas.fillRect(10, 12, 20, 8, 0xFFFF);
+    canvas.present(&panel);
+
+    int failures = 0;
+    for (int16_t y = 0; y < PANEL_H && failures < 5; y++) {
+        for (int16_t x = 0; x < PANEL_W && failures < 5; x++) {
+            const bool inside = x >= 10 && x < 30 && y >= 12 && y < 20;
+            const uint16_t want = inside ? 0xFFFF : pattern(x, y);
+            if (panel.getPixel(x, y) != want) {
+                printf("FAIL: present, pixel (%d, %d) is %u, expected %u\n", x, y, panel.getPixel(x, y), want);
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+} // namespace
+
+int main() {
+    int failures = 0;
+    for (uint8_t rotation = 0; rotation < 4; rotation++) {
+        failures += checkReadBack(rotation);
+    }
+    failures += checkPresent();
+    printf("%s\n", failures ? "framebuffercanvas_test FAILED" : "framebuffercanvas_test passed");
+    return failures ? 1 : 0;
+}
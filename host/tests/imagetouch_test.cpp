@@ -0,0 +1,94 @@
+// imagetouch_test.cpp
+// A rotated image must answer touches on the whole area it covers. A 100 x 20 image at
+// (60, 50) rotated 90 degrees covers x 100..120, y 10..110 on the panel; taps inside that box
+// and inside the unrotated rectangle must both reach the callback, taps elsewhere must not.
+#include <Arduino_GFX_Library.h>
+#include <displayfk.h>
+#include <dfk_host.h>
+
+#include <vector>
+
+namespace {
+
+const int DISPLAY_W = 240;
+const int DISPLAY_H = 160;
+const uint16_t IMAGE_W = 100;
+const uint16_t IMAGE_H = 20;
+
+HostDisplay *tft = nullptr;
+DisplayFK myDisplay;
+
+Image needle(60, 50, 0);
+Image *arrayImage[] = {&needle};
+
+std::vector<uint16_t> pixels(IMAGE_W * IMAGE_H, CFK_RED);
+volatile int clicks = 0;
+
+void needle_cb() {
+    clicks++;
+}
+
+void screen0() {
+    tft->fillScreen(CFK_BLACK);
+    myDisplay.drawWidgetsOnScreen(0);
+}
+
+/// @brief Taps a point and returns the callbacks it produced.
+int tap(uint16_t x, uint16_t y) {
+    const int before = clicks;
+    hostTouchPress(x, y);
+    delay(150);
+    hostTouchRelease();
+    delay(600);
+    return clicks - before;
+}
+
+} // namespace
+
+int main() {
+    tft = new HostDisplay(DISPLAY_W, DISPLAY_H);
+    tft->begin();
+    myDisplay.setDrawObject(tft);
+
+    hostTouchBegin(DISPLAY_W, DISPLAY_H);
+    myDisplay.setTouchCorners(0, DISPLAY_W - 1, 0, DISPLAY_H - 1);
+    myDisplay.startTouchGT911(DISPLAY_W, DISPLAY_H, 0, -1, -1, -1, -1);
+
+    ImageFromPixelsConfig config = {};
+    config.pixels = pixels.data();
+    config.width = IMAGE_W;
+    config.height = IMAGE_H;
+    config.angle = 90.0f;
+    config.cb = needle_cb;
+    config.backgroundColor = CFK_BLACK;
+    needle.setupFromPixels(config);
+    myDisplay.setImage(arrayImage, 1);
+    WidgetBase::loadScreen = screen0;
+    myDisplay.createTask(false, 3);
+    delay(500);
+
+    struct Tap {
+        uint16_t x, y;
+        int expected;
+        const char *where;
+    };
+    const Tap taps[] = {
+        {110, 20, 1, "rotated box, outside the unrotated rectangle"},
+        {110, 60, 1, "rotated box and unrotated rectangle"},
+        {65, 60, 1, "unrotated rectangle, outside the rotated box"},
+        {30, 130, 0, "outside both"},
+    };
+
+    int failures = 0;
+    for (const Tap &t : taps) {
+        const int got = tap(t.x, t.y);
+        if (got != t.expected) {
+            printf("FAIL: tap at (%u, %u), %s: %d callbacks, expected %d\n", t.x, t.y, t.where, got, t.expected);
+            failures++;
+        }
+    }
+
+    printf("%s\n", failures ? "imagetouch_test FAILED" : "imagetouch_test passed");
+    hostStopTasks();
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,83 @@
+// sevensegment_test.cpp
+// A seven-segment Label repaints only the segments that changed, but only while the style on
+// the panel is the style in use. Each step edits the style in place (ghost color, then digit
+// size), changes the text and compares the panel with a full redraw of the same text.
+#include <Arduino_GFX_Library.h>
+#include <displayfk.h>
+#include <dfk_host.h>
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const int DISPLAY_W = 200;
+const int DISPLAY_H = 80;
+
+HostDisplay *tft = nullptr;
+DisplayFK myDisplay;
+
+Label readout(10, 10, 0);
+Label *arrayLabel[] = {&readout};
+
+SevenSegmentStyle_t style = {20, 36, 4, 1, 4, CFK_BLACK};
+
+void screen0() {
+    tft->fillScreen(CFK_BLACK);
+    myDisplay.drawWidgetsOnScreen(0);
+}
+
+/// @brief Copies the panel while the library task is not drawing.
+std::vector<uint16_t> capture() {
+    myDisplay.startCustomDraw();
+    std::vector<uint16_t> frame(tft->getFramebuffer(), tft->getFramebuffer() + DISPLAY_W * DISPLAY_H);
+    myDisplay.finishCustomDraw();
+    return frame;
+}
+
+} // namespace
+
+int main() {
+    tft = new HostDisplay(DISPLAY_W, DISPLAY_H);
+    tft->begin();
+    myDisplay.setDrawObject(tft);
+
+    LabelConfig config = {"12.5", nullptr, nullptr, nullptr, TL_DATUM, CFK_RED, CFK_BLACK};
+    readout.setup(config);
+    readout.setSevenSegment(&style);
+    myDisplay.setLabel(arrayLabel, 1);
+    WidgetBase::loadScreen = screen0;
+    myDisplay.createTask(false, 3);
+    delay(300);
+
+    struct Step {
+        const char *text;
+        void (*edit)();
+        const char *what;
+    };
+    const Step steps[] = {
+        {"13.5", [] {}, "same style"},
+        {"14.5", [] { style.offColor = CFK_GREY11; }, "ghost color edited in place"},
+        {"15.5", [] { style.digitWidth = 24; }, "digit width edited in place"},
+    };
+
+    int failures = 0;
+    for (const Step &step : steps) {
+        myDisplay.startCustomDraw();
+        step.edit();
+        myDisplay.finishCustomDraw();
+        readout.setText(step.text);
+        delay(100);
+        const std::vector<uint16_t> updated = capture();
+        readout.forceUpdate();
+        delay(100);
+        if (updated != capture()) {
+            printf("FAIL: %s, the update differs from a full redraw\n", step.what);
+            failures++;
+        }
+    }
+
+    printf("%s\n", failures ? "sevensegment_test FAILED" : "sevensegment_test passed");
+    hostStopTasks();
+    return failures ? 1 : 0;
+}
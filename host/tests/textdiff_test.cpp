@@ -0,0 +1,94 @@
+// textdiff_test.cpp
+// Labels update only the glyphs (or segments) that changed, which is right only while nothing
+// painted over the rest of the text. Here an image under two labels repaints in the same frame
+// as the labels change their text; the panel must match a full redraw of the labels.
+#include <Arduino_GFX_Library.h>
+#include <displayfk.h>
+#include <dfk_host.h>
+
+#include <vector>
+
+namespace {
+
+const int DISPLAY_W = 200;
+const int DISPLAY_H = 120;
+const uint16_t IMAGE_W = 180;
+const uint16_t IMAGE_H = 100;
+
+HostDisplay *tft = nullptr;
+DisplayFK myDisplay;
+
+Image background(10, 10, 0);
+Image *arrayImage[] = {&background};
+Label text(20, 20, 0);
+Label segments(20, 60, 0);
+Label *arrayLabel[] = {&text, &segments};
+
+std::vector<uint16_t> redPixels(IMAGE_W * IMAGE_H, CFK_RED);
+SevenSegmentStyle_t style = {16, 28, 3, 1, 3, CFK_GREY11};
+
+void screen0() {
+    tft->fillScreen(CFK_BLACK);
+    myDisplay.drawWidgetsOnScreen(0);
+}
+
+/// @brief Copies the panel while the library task is not drawing.
+std::vector<uint16_t> capture() {
+    myDisplay.startCustomDraw();
+    std::vector<uint16_t> frame(tft->getFramebuffer(), tft->getFramebuffer() + DISPLAY_W * DISPLAY_H);
+    myDisplay.finishCustomDraw();
+    return frame;
+}
+
+} // namespace
+
+int main() {
+    tft = new HostDisplay(DISPLAY_W, DISPLAY_H);
+    tft->begin();
+    myDisplay.setDrawObject(tft);
+
+    ImageFromPixelsConfig imageConfig = {};
+    imageConfig.pixels = redPixels.data();
+    imageConfig.width = IMAGE_W;
+    imageConfig.height = IMAGE_H;
+    imageConfig.backgroundColor = CFK_BLACK;
+    background.setupFromPixels(imageConfig);
+
+    LabelConfig textConfig = {"1235", nullptr, nullptr, &RobotoRegular10pt7b, TL_DATUM, CFK_WHITE, CFK_BLUE};
+    text.setup(textConfig);
+    text.setZOrder(1);
+    LabelConfig segmentConfig = {"1235", nullptr, nullptr, nullptr, TL_DATUM, CFK_WHITE, CFK_BLUE};
+    segments.setup(segmentConfig);
+    segments.setSevenSegment(&style);
+    segments.setZOrder(1);
+
+    myDisplay.setImage(arrayImage, 1);
+    myDisplay.setLabel(arrayLabel, 2);
+    WidgetBase::loadScreen = screen0;
+    myDisplay.createTask(false, 3);
+    delay(300);
+
+    int failures = 0;
+    const char *values[] = {"1236", "1237", "1238"};
+    for (const char *value : values) {
+        // The image and the labels change in the same frame
+        myDisplay.startCustomDraw();
+        background.forceUpdate();
+        text.setText(value);
+        segments.setText(value);
+        myDisplay.finishCustomDraw();
+        delay(100);
+        const std::vector<uint16_t> updated = capture();
+        text.forceUpdate();
+        segments.forceUpdate();
+        delay(100);
+        if (updated != capture()) {
+            printf("FAIL: \"%s\" with the image repainted below differs from a full redraw\n", value);
+            failures++;
+        }
+    }
+
+    printf("%s\n", failures ? "textdiff_test FAILED" : "textdiff_test passed");
+    hostStopTasks();
+    return failures ? 1 : 0;
+}
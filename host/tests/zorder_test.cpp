@@ -0,0 +1,88 @@
+// zorder_test.cpp
+// A widget that repaints under an overlapping widget on a higher layer must make that widget
+// repaint too, even when the widget below is not opaque. Two solid images are stacked: a red
+// one (layer 0, transparent) partly under a blue one (layer 1, opaque). The red one is redrawn
+// and the shared area must still show the blue image.
+#include <Arduino_GFX_Library.h>
+#include <displayfk.h>
+#include <dfk_host.h>
+
+#include <vector>
+
+namespace {
+
+const int DISPLAY_W = 160;
+const int DISPLAY_H = 120;
+const uint16_t SIZE = 60;
+
+HostDisplay *tft = nullptr;
+DisplayFK myDisplay;
+
+Image below(10, 10, 0);
+Image above(40, 40, 0);
+Image *arrayImage[] = {&below, &above};
+
+std::vector<uint16_t> redPixels(SIZE * SIZE, CFK_RED);
+std::vector<uint16_t> bluePixels(SIZE * SIZE, CFK_BLUE);
+
+void screen0() {
+    tft->fillScreen(CFK_BLACK);
+    myDisplay.drawWidgetsOnScreen(0);
+}
+
+void setupImage(Image &image, const std::vector<uint16_t> &pixels) {
+    ImageFromPixelsConfig config = {};
+    config.pixels = pixels.data();
+    config.width = SIZE;
+    config.height = SIZE;
+    config.backgroundColor = CFK_BLACK;
+    image.setupFromPixels(config);
+}
+
+/// @brief Reads a pixel while the library task is not drawing.
+uint16_t pixelAt(int16_t x, int16_t y) {
+    myDisplay.startCustomDraw();
+    uint16_t color = tft->getPixel(x, y);
+    myDisplay.finishCustomDraw();
+    return color;
+}
+
+} // namespace
+
+int main() {
+    tft = new HostDisplay(DISPLAY_W, DISPLAY_H);
+    tft->begin();
+    myDisplay.setDrawObject(tft);
+
+    setupImage(below, redPixels);
+    setupImage(above, bluePixels);
+    above.setZOrder(1);
+    above.setOpaque(true);
+    myDisplay.setImage(arrayImage, 2);
+    WidgetBase::loadScreen = screen0;
+    myDisplay.createTask(false, 3);
+    delay(300);
+
+    int failures = 0;
+    if (pixelAt(50, 50) != CFK_BLUE) {
+        printf("FAIL: blue image is not on top after the screen load\n");
+        failures++;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        below.forceUpdate();
+        delay(100);
+        if (pixelAt(50, 50) != CFK_BLUE || pixelAt(95, 95) != CFK_BLUE) {
+            printf("FAIL: redraw %d of the transparent widget left it over the opaque one\n", i);
+            failures++;
+        }
+        if (pixelAt(20, 20) != CFK_RED) {
+            printf("FAIL: redraw %d lost the uncovered part of the widget below\n", i);
+            failures++;
+        }
+    }
+
+    printf("%s\n", failures ? "zorder_test FAILED" : "zorder_test passed");
+    hostStopTasks();
+    return failures ? 1 : 0;
+}
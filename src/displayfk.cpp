@@ -131,8 +131,7 @@ void DisplayFK::setCheckbox(CheckBox *array[], uint8_t amount)
     
     
     m_checkboxConfigured = true;
-    arrayCheckbox = array;
-    qtdCheckbox = amount;
+    registerWidgets(WidgetType::CHECKBOX, array, amount);
     ESP_LOGD(TAG, "Checkbox array configured with %d elements", amount);
 }
 
@@ -159,8 +158,7 @@ void DisplayFK::setCircleButton(CircleButton *array[], uint8_t amount)
     }
     
     m_circleButtonConfigured = true;
-    arrayCircleBtn = array;
-    qtdCircleBtn = amount;
+    registerWidgets(WidgetType::CIRCLEBUTTON, array, amount);
     ESP_LOGD(TAG, "Circle button array configured with %d elements", amount);
 }
 
@@ -189,8 +187,7 @@ void DisplayFK::setGauge(GaugeSuper *array[], uint8_t amount)
 
 
     m_gaugeConfigured = (amount > 0 && array != nullptr);
-    arrayGauge = array;
-    qtdGauge = amount;
+    registerWidgets(WidgetType::GAUGE, array, amount);
 }
 
 #endif
@@ -217,8 +214,7 @@ void DisplayFK::setCircularBar(CircularBar *array[], uint8_t amount)
     }
 
     m_circularBarConfigured = (amount > 0 && array != nullptr);
-    arrayCircularBar = array;
-    qtdCircularBar = amount;
+    registerWidgets(WidgetType::CIRCULARBAR, array, amount);
 }
 
 #endif
@@ -245,8 +241,7 @@ void DisplayFK::setHSlider(HSlider *array[], uint8_t amount)
     }
 
     m_hSliderConfigured = (amount > 0 && array != nullptr);
-    arrayHSlider = array;
-    qtdHSlider = amount;
+    registerWidgets(WidgetType::HSLIDER, array, amount);
 }
 
 #endif
@@ -273,8 +268,7 @@ void DisplayFK::setLabel(Label *array[], uint8_t amount)
 
 
     m_labelConfigured = (amount > 0 && array != nullptr);
-    arrayLabel = array;
-    qtdLabel = amount;
+    registerWidgets(WidgetType::LABEL, array, amount);
 }
 #endif
 
@@ -302,8 +296,7 @@ void DisplayFK::setLed(Led *array[], uint8_t amount)
 
 
     m_ledConfigured = (amount > 0 && array != nullptr);
-    arrayLed = array;
-    qtdLed = amount;
+    registerWidgets(WidgetType::LED, array, amount);
 }
 
 #endif
@@ -328,8 +321,7 @@ void DisplayFK::setLineChart(LineChart *array[], uint8_t amount)
         return;
     }
     m_lineChartConfigured = (amount > 0 && array != nullptr);
-    arrayLineChart = array;
-    qtdLineChart = amount;
+    registerWidgets(WidgetType::LINECHART, array, amount);
 }
 
 #endif
@@ -353,8 +345,7 @@ void DisplayFK::setNumberbox(NumberBox *array[], uint8_t amount)
         return;
     }
     m_numberboxConfigured = (amount > 0 && array != nullptr);
-    arrayNumberbox = array;
-    qtdNumberBox = amount;
+    registerWidgets(WidgetType::NUMBERBOX, array, amount);
 
     setupNumpad();
 }
@@ -402,8 +393,7 @@ void DisplayFK::setRadioGroup(RadioGroup *array[], uint8_t amount)
         return;
     }
     m_radioGroupConfigured = (amount > 0 && array != nullptr);
-    arrayRadioGroup = array;
-    qtdRadioGroup = amount;
+    registerWidgets(WidgetType::RADIOGROUP, array, amount);
 }
 #endif
 
@@ -427,8 +417,7 @@ void DisplayFK::setRectButton(RectButton *array[], uint8_t amount)
         return;
     }
     m_rectButtonConfigured = (amount > 0 && array != nullptr);
-    arrayRectBtn = array;
-    qtdRectBtn = amount;
+    registerWidgets(WidgetType::RECTBUTTON, array, amount);
 }
 #endif
 
@@ -452,8 +441,7 @@ void DisplayFK::setTextButton(TextButton *array[], uint8_t amount)
         return;
     }
     m_textButtonConfigured = (amount > 0 && array != nullptr);
-    arrayTextButton = array;
-    qtdTextButton = amount;
+    registerWidgets(WidgetType::TEXTBUTTON, array, amount);
 }
 #endif
 
@@ -477,8 +465,7 @@ void DisplayFK::setSpinbox(SpinBox *array[], uint8_t amount)
         return;
     }
     m_spinboxConfigured = (amount > 0 && array != nullptr);
-    arraySpinbox = array;
-    qtdSpinbox = amount;
+    registerWidgets(WidgetType::SPINBOX, array, amount);
 }
 #endif
 
@@ -502,8 +489,7 @@ void DisplayFK::setTextbox(TextBox *array[], uint8_t amount)
         return;
     }
     m_textboxConfigured = (amount > 0 && array != nullptr);
-    arrayTextBox = array;
-    qtdTextBox = amount;
+    registerWidgets(WidgetType::TEXTBOX, array, amount);
 
     setupKeyboard();
 }
@@ -551,8 +537,7 @@ void DisplayFK::setThermometer(Thermometer *array[], uint8_t amount)
         return;
     }
     m_thermometerConfigured = (amount > 0 && array != nullptr);
-    arrayThermometer = array;
-    qtdThermometer = amount;
+    registerWidgets(WidgetType::THERMOMETER, array, amount);
 }
 #endif
 
@@ -576,8 +561,7 @@ void DisplayFK::setToggle(ToggleButton *array[], uint8_t amount)
         return;
     }
     m_toggleConfigured = (amount > 0 && array != nullptr);
-    arrayToggleBtn = array;
-    qtdToggle = amount;
+    registerWidgets(WidgetType::TOGGLE, array, amount);
 }
 #endif
 
@@ -601,8 +585,7 @@ void DisplayFK::setTouchArea(TouchArea *array[], uint8_t amount)
         return;
     }
     m_touchAreaConfigured = (amount > 0 && array != nullptr);
-    arrayTouchArea = array;
-    qtdTouchArea = amount;
+    registerWidgets(WidgetType::TOUCHAREA, array, amount);
 }
 #endif
 
@@ -626,8 +609,7 @@ void DisplayFK::setVAnalog(VAnalog *array[], uint8_t amount)
         return;
     }
     m_vAnalogConfigured = (amount > 0 && array != nullptr);
-    arrayVAnalog = array;
-    qtdVAnalog = amount;
+    registerWidgets(WidgetType::VANALOG, array, amount);
 }
 #endif
 
@@ -651,8 +633,7 @@ void DisplayFK::setVBar(VBar *array[], uint8_t amount)
         return;
     }
     m_vBarConfigured = (amount > 0 && array != nullptr);
-    arrayVBar = array;
-    qtdVBar = amount;
+    registerWidgets(WidgetType::VBAR, array, amount);
 }
 #endif
 
@@ -676,8 +657,7 @@ void DisplayFK::setImage(Image *array[], uint8_t amount)
         return;
     }
     m_imageConfigured = (amount > 0 && array != nullptr);
-    arrayImage = array;
-    qtdImage = amount;
+    registerWidgets(WidgetType::IMAGE, array, amount);
     ESP_LOGD(TAG, "Configuring image: %i", amount);
 }
 #endif
@@ -1028,6 +1008,7 @@ void DisplayFK::addLog(const char *data)
     BaseType_t ret = xQueueSend(DisplayFK::xFilaLog, &message, 0);
     if (ret == pdTRUE) {
         ESP_LOGD(TAG, "Log message queued: %s", message.line);
+        WidgetBase::requestFrame();
     } else if (ret == errQUEUE_FULL) {
         ESP_LOGE(TAG, "Unable to send log data into the Queue");
     } else {
@@ -1107,127 +1088,89 @@ void DisplayFK::initializeWidgetFlags()
     // Initialize widget configuration flags based on compile-time defines
     #if defined(DFK_TOUCHAREA)
     m_touchAreaConfigured = false;
-    arrayTouchArea = nullptr;
-    qtdTouchArea = 0;
     #endif
 
     #ifdef DFK_CHECKBOX
     m_checkboxConfigured = false;
-    arrayCheckbox = nullptr;
-    qtdCheckbox = 0;
     #endif
 
     #ifdef DFK_CIRCLEBTN
     m_circleButtonConfigured = false;
-    arrayCircleBtn = nullptr;
-    qtdCircleBtn = 0;
     #endif
 
     #ifdef DFK_GAUGE
     m_gaugeConfigured = false;
-    arrayGauge = nullptr;
-    qtdGauge = 0;
     #endif
 
     #ifdef DFK_CIRCULARBAR
     m_circularBarConfigured = false;
-    arrayCircularBar = nullptr;
-    qtdCircularBar = 0;
     #endif
 
     #ifdef DFK_HSLIDER
     m_hSliderConfigured = false;
-    arrayHSlider = nullptr;
-    qtdHSlider = 0;
     #endif
 
     #ifdef DFK_LABEL
     m_labelConfigured = false;
-    arrayLabel = nullptr;
-    qtdLabel = 0;
     #endif
 
     #ifdef DFK_LED
     m_ledConfigured = false;
-    arrayLed = nullptr;
-    qtdLed = 0;
     #endif
 
     #ifdef DFK_LINECHART
     m_lineChartConfigured = false;
-    arrayLineChart = nullptr;
-    qtdLineChart = 0;
     #endif
 
     #ifdef DFK_RADIO
     m_radioGroupConfigured = false;
-    arrayRadioGroup = nullptr;
-    qtdRadioGroup = 0;
     #endif
 
     #ifdef DFK_RECTBTN
     m_rectButtonConfigured = false;
-    arrayRectBtn = nullptr;
-    qtdRectBtn = 0;
     #endif
 
     #ifdef DFK_TOGGLE
     m_toggleConfigured = false;
-    arrayToggleBtn = nullptr;
-    qtdToggle = 0;
     #endif
 
     #ifdef DFK_VBAR
     m_vBarConfigured = false;
-    arrayVBar = nullptr;
-    qtdVBar = 0;
     #endif
 
     #ifdef DFK_VANALOG
     m_vAnalogConfigured = false;
-    arrayVAnalog = nullptr;
-    qtdVAnalog = 0;
     #endif
 
     #ifdef DFK_TEXTBOX
     m_textboxConfigured = false;
-    arrayTextBox = nullptr;
-    qtdTextBox = 0;
     #endif
 
     #ifdef DFK_NUMBERBOX
     m_numberboxConfigured = false;
-    arrayNumberbox = nullptr;
-    qtdNumberBox = 0;
     #endif
 
     #ifdef DFK_IMAGE
     m_imageConfigured = false;
-    arrayImage = nullptr;
-    qtdImage = 0;
     #endif
 
     #ifdef DFK_TEXTBUTTON
     m_textButtonConfigured = false;
-    arrayTextButton = nullptr;
-    qtdTextButton = 0;
     #endif
 
     #ifdef DFK_SPINBOX
     m_spinboxConfigured = false;
-    arraySpinbox = nullptr;
-    qtdSpinbox = 0;
     #endif
 
     #ifdef DFK_THERMOMETER
     m_thermometerConfigured = false;
-    arrayThermometer = nullptr;
-    qtdThermometer = 0;
     #endif
 
     #ifdef DFK_EXTERNALINPUT
     m_inputExternalConfigured = false;
     #endif
+
+    m_registry.clear();
     
     ESP_LOGD(TAG, "Widget flags initialized");
 }
@@ -1331,6 +1274,14 @@ void DisplayFK::cleanupDynamicMemory()
         ESP_LOGD(TAG, "External keyboard memory freed");
     }
     #endif
+
+    #if defined(DISP_DEFAULT)
+    disableStripeRendering();
+    disableGlyphCache();
+    disableTextMetricsCache();
+    disableShadowBuffer();
+    #endif
+    disableImageCache();
     
     ESP_LOGD(TAG, "Dynamic memory cleanup completed");
 }
@@ -1592,8 +1543,15 @@ void DisplayFK::finishCustomDraw(){
     // Wait until semaphore is available (may take time if loopTask is using it)
     if (xSemaphoreTake(m_transactionSemaphore, portMAX_DELAY) == pdTRUE) {
         m_runningTransaction = false;
+        #if defined(DISP_DEFAULT)
+        // The custom drawing went straight to the panel
+        if (m_shadowBuffer) {
+            m_panelChanged = true;
+        }
+        #endif
         // Release semaphore immediately - we only needed it to safely set the flag
         xSemaphoreGive(m_transactionSemaphore);
+        WidgetBase::requestFrame();
     } else {
         ESP_LOGE(TAG, "Failed to acquire transaction semaphore");
     }
@@ -1840,6 +1798,8 @@ void DisplayFK::startTouchCST820(uint16_t w, uint16_t h, uint8_t _rotation, int8
 /**
  * @brief Draws widgets on the current screen
  * @param currentScreenIndex Current screen index
+ * @details Only the widgets registered for this screen are visited, in paint order. Widgets
+ *          completely covered by an opaque widget on top are skipped.
  */
 void DisplayFK::drawWidgetsOnScreen(const uint8_t currentScreenIndex)
 {
@@ -1849,300 +1809,61 @@ void DisplayFK::drawWidgetsOnScreen(const uint8_t currentScreenIndex)
     WidgetBase::currentScreen = currentScreenIndex;
     ESP_LOGD(TAG, "Drawing widgets of screen:%i", WidgetBase::currentScreen);
 
-#if defined(DFK_TOUCHAREA)
-    if (m_touchAreaConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdTouchArea); indice++)
-        {
-            arrayTouchArea[indice]->redraw();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of TouchArea not configured");
-    }
-#endif
-
-#ifdef DFK_CHECKBOX
-    if (m_checkboxConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdCheckbox); indice++)
-        {
-            arrayCheckbox[indice]->forceUpdate();
-            arrayCheckbox[indice]->redraw();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of Checkbox not configured");
-    }
-#endif
-#ifdef DFK_CIRCLEBTN
-    if (m_circleButtonConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdCircleBtn); indice++)
-        {
-            arrayCircleBtn[indice]->forceUpdate();
-            arrayCircleBtn[indice]->redraw();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of CircleButton not configured");
-    }
-#endif
-#ifdef DFK_SPINBOX
-    if (m_spinboxConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdSpinbox); indice++)
-        {
-            arraySpinbox[indice]->drawBackground();
-            arraySpinbox[indice]->redraw();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of Spinbox not configured");
-    }
-#endif
-#ifdef DFK_GAUGE
-    if (m_gaugeConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdGauge); indice++)
-        {
-            arrayGauge[indice]->forceUpdate();
-            arrayGauge[indice]->drawBackground();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of Gauge not configured");
-    }
-
-#endif
-
-#ifdef DFK_CIRCULARBAR
-    if (m_circularBarConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdCircularBar); indice++)
-        {
-            arrayCircularBar[indice]->forceUpdate();
-            arrayCircularBar[indice]->drawBackground();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of CircularBar not configured");
-    }
-#endif
-
-#ifdef DFK_HSLIDER
-    if (m_hSliderConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdHSlider); indice++)
-        {
-            arrayHSlider[indice]->forceUpdate();
-            arrayHSlider[indice]->drawBackground();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of HSlider not configured");
-    }
-#endif
-#ifdef DFK_LABEL
-    if (m_labelConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdLabel); indice++)
-        {
-            arrayLabel[indice]->forceUpdate();
-            arrayLabel[indice]->redraw();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of Label not configured");
-    }
-#endif
-#ifdef DFK_LED
-    if (m_ledConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdLed); indice++)
-        {
-            arrayLed[indice]->forceUpdate();
-            arrayLed[indice]->drawBackground();
-            arrayLed[indice]->redraw();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of Led not configured");
-    }
-#endif
-#ifdef DFK_LINECHART
-    if (m_lineChartConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdLineChart); indice++)
-        {
-            arrayLineChart[indice]->forceUpdate();
-            arrayLineChart[indice]->drawBackground();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of LineChart not configured");
-    }
-#endif
-#ifdef DFK_RADIO
-    if (m_radioGroupConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdRadioGroup); indice++)
-        {
-            arrayRadioGroup[indice]->forceUpdate();
-            arrayRadioGroup[indice]->redraw();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of RadioGroup not configured");
-    }
-#endif
-#ifdef DFK_RECTBTN
-    if (m_rectButtonConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdRectBtn); indice++)
-        {
-            arrayRectBtn[indice]->forceUpdate();
-            arrayRectBtn[indice]->redraw();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of RectButton not configured");
-    }
-#endif
-#ifdef DFK_TOGGLE
-    if (m_toggleConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdToggle); indice++)
-        {
-            arrayToggleBtn[indice]->forceUpdate();
-            arrayToggleBtn[indice]->redraw();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of Toggle not configured");
-    }
-#endif
-
-#ifdef DFK_TEXTBUTTON
-    if (m_textButtonConfigured)
+    syncStackOrder();
+    WidgetSpan_t span = m_registry.onScreen(currentScreenIndex);
+    for (uint32_t indice = 0; indice < span.count; indice++)
     {
-        for ( uint32_t indice = 0; indice < (qtdTextButton); indice++)
-        {
-            arrayTextButton[indice]->forceUpdate();
-            arrayTextButton[indice]->redraw();
+        WidgetBase *widget = span.widgets[indice];
+        if (isOccluded(span, indice)) {
+            // Painted in full by updateWidgets() once it is uncovered
+            widget->requestFullRedraw();
+            continue;
         }
+        widget->takeFullRedraw();
+        widget->fullRedraw();
     }
-    else
-    {
-        ESP_LOGW(TAG, "Array of TextButton not configured");
-    }
-#endif
+    rebuildHitGrid();
 
-#ifdef DFK_VBAR
-    if (m_vBarConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdVBar); indice++)
-        {
-            arrayVBar[indice]->forceUpdate();
-            arrayVBar[indice]->drawBackground();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of VBar not configured");
-    }
-#endif
+ startMillis = millis() - startMillis;
+ Serial.printf("drawWidgetsOnScreen: %lu ms\n", startMillis);
+}
 
-#ifdef DFK_THERMOMETER
-    if (m_thermometerConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdThermometer); indice++)
-        {
-            arrayThermometer[indice]->forceUpdate();
-            arrayThermometer[indice]->drawBackground();
-        }
+/**
+ * @brief Registers a single widget
+ * @param widget Widget to add. It may be any WidgetBase subclass, including widgets written
+ *               outside the library.
+ * @return true if the widget was registered
+ * @details The widget is drawn with fullRedraw(), updated with refresh() and, if isTouchable()
+ *          returns true, hit-tested through detectTouch() and getCallbackFunc(). Widgets added
+ *          here are painted after the built-in widgets of the same screen.
+ *          Like the set*() functions, it must be called before createTask().
+ */
+bool DisplayFK::addWidget(WidgetBase *widget)
+{
+    if (!canRegisterWidgets()) {
+        return false;
     }
-    else
-    {
-        ESP_LOGW(TAG, "Array of Thermometer not configured");
+    if (!m_registry.add(widget, WidgetType::CUSTOM)) {
+        ESP_LOGE(TAG, "Can't register widget");
+        return false;
     }
-#endif
-
+    return true;
+}
 
-#ifdef DFK_VANALOG
-    if (m_vAnalogConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdVAnalog); indice++)
-        {
-            arrayVAnalog[indice]->forceUpdate();
-            arrayVAnalog[indice]->drawBackground();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of VAnalog not configured");
-    }
-#endif
-#ifdef DFK_TEXTBOX
-    if (m_textboxConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdTextBox); indice++)
-        {
-            arrayTextBox[indice]->forceUpdate();
-            arrayTextBox[indice]->redraw();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of Textbox not configured");
-    }
-#endif
-#ifdef DFK_NUMBERBOX
-    if (m_numberboxConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdNumberBox); indice++)
-        {
-            arrayNumberbox[indice]->forceUpdate();
-            arrayNumberbox[indice]->redraw();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of Numberbox not configured");
-    }
-#endif
-#ifdef DFK_IMAGE
-    if (m_imageConfigured)
-    {
-        for ( uint32_t indice = 0; indice < (qtdImage); indice++)
-        {
-            arrayImage[indice]->forceUpdate();
-			arrayImage[indice]->drawBackground();
-            arrayImage[indice]->draw();
-            //arrayImage[indice].redraw();
-        }
-    }
-    else
-    {
-        ESP_LOGW(TAG, "Array of Image not configured");
+/**
+ * @brief Checks that widgets are still being registered before the UI task starts
+ * @return false (and logs an error) once createTask() was called
+ * @details The UI task walks the registry arrays on every frame without a lock; growing them
+ *          from another task would free the arrays it is reading. Every widget of every screen
+ *          is registered up front, and screens only choose which of them are shown.
+ */
+bool DisplayFK::canRegisterWidgets() const
+{
+    if (m_hndTaskEventoTouch != nullptr) {
+        ESP_LOGE(TAG, "Widgets must be registered before createTask()");
+        return false;
     }
-#endif
-
- startMillis = millis() - startMillis;
- Serial.printf("drawWidgetsOnScreen: %lu ms\n", startMillis);
+    return true;
 }
 
 /**
@@ -2456,64 +2177,128 @@ void DisplayFK::processTouchStatus(bool hasTouch, uint16_t xTouch, uint16_t yTou
  * @param xTouch Touch X position
  * @param yTouch Touch Y position
  * @param collectMode If true, collects all widgets without early return
+ * @details Only the widgets of the current screen are tested, from the last painted to the
+ *          first, so the widget on top receives the touch. TouchArea widgets are painted first
+ *          and therefore work as handlers for the empty area. The hit-test grid narrows the
+ *          test to the widgets whose touch area covers the point.
  */
 void DisplayFK::processTouchableWidgets(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
     ESP_LOGD(TAG, "Processing touchable widgets (collectMode: %s)", collectMode ? "true" : "false");
-    // Process each type of touchable widget
-    processCheckboxTouch(xTouch, yTouch, collectMode);
-    processCircleButtonTouch(xTouch, yTouch, collectMode);
-    processHSliderTouch(xTouch, yTouch, collectMode);
-    processRadioGroupTouch(xTouch, yTouch, collectMode);
-    processRectButtonTouch(xTouch, yTouch, collectMode);
-    processImageTouch(xTouch, yTouch, collectMode);
-    processSpinboxTouch(xTouch, yTouch, collectMode);
-    processToggleTouch(xTouch, yTouch, collectMode);
-    processTextButtonTouch(xTouch, yTouch, collectMode);
-    processTextBoxTouch(xTouch, yTouch, collectMode);
-    processNumberBoxTouch(xTouch, yTouch, collectMode);
-    processEmptyAreaTouch(xTouch, yTouch, collectMode);
-}
+    syncStackOrder();
+    WidgetSpan_t span = m_registry.onScreen(WidgetBase::currentScreen);
+    if (!hitGridIsCurrent()) {
+        rebuildHitGrid();
+    }
 
-/**
- * @brief Processes touch in empty area
- * @param xTouch Touch X position
- * @param yTouch Touch Y position
- * @param collectMode If true, collects all widgets without early return
- */
-void DisplayFK::processEmptyAreaTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
-#if defined(DFK_TOUCHAREA)
-    if(!m_touchAreaConfigured || !arrayTouchArea){
+    HitCandidates_t candidates;
+    if (m_hitGrid.query(xTouch, yTouch, candidates)) {
+        for (uint32_t indice = candidates.count; indice > 0; indice--) {
+            uint16_t pos = candidates.index[indice - 1];
+            if (processWidgetTouch(span.widgets[pos], span.types[pos], xTouch, yTouch, collectMode) && !collectMode) {
+                return;
+            }
+        }
         return;
     }
-    
-        for (uint32_t indice = 0; indice < qtdTouchArea; indice++) {
-            if (arrayTouchArea[indice]->detectTouch(&xTouch, &yTouch)) {
-                functionCB_t cb = arrayTouchArea[indice]->getCallbackFunc();
-                WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
-                
-#ifdef ENABLE_ON_RELEASE
-                if (collectMode) {
-                    addTouchedWidget(arrayTouchArea[indice]);
-                }
-#endif
-                
-                if (!collectMode) {
-                    return;
-                }
+
+    // No grid (or a crowded cell): test every widget of the screen
+    for (uint32_t indice = span.count; indice > 0; indice--) {
+        WidgetBase *widget = span.widgets[indice - 1];
+        if (!widget->isTouchable()) continue;
+
+        if (processWidgetTouch(widget, span.types[indice - 1], xTouch, yTouch, collectMode)) {
+            // Return early only if not in collect mode
+            if (!collectMode) {
+                return;
             }
+            // In collect mode, continue to find other widgets
         }
-#endif
+    }
 }
 
-#ifdef ENABLE_ON_RELEASE
 /**
- * @brief Adds a widget to the touched widgets array
- * @param widget Pointer to the widget to add
- * @details Only adds if widget is not already in array and array has space
+ * @brief Rebuilds the hit-test grid for the current screen
+ * @details Called when a screen is loaded and whenever hitGridIsCurrent() reports that the
+ *          widgets or their touch areas changed. If the grid can't be built the touch falls
+ *          back to testing every widget of the screen.
  */
-void DisplayFK::addTouchedWidget(WidgetBase* widget) {
-    if (!widget) return;
-    
+void DisplayFK::rebuildHitGrid() {
+    m_hitGridScreen = WidgetBase::currentScreen;
+    m_hitGridRegistryRev = m_registry.revision();
+    m_hitGridLayoutRev = WidgetBase::layoutRevision;
+    if (!WidgetBase::objTFT) {
+        m_hitGrid.clear();
+        return;
+    }
+    WidgetSpan_t span = m_registry.onScreen(m_hitGridScreen);
+    if (!m_hitGrid.build(span, WidgetBase::objTFT->width(), WidgetBase::objTFT->height())) {
+        ESP_LOGW(TAG, "Hit-test grid not built, using linear touch scan");
+    }
+}
+
+/**
+ * @brief Checks if the hit-test grid still matches the current screen
+ * @return false if the screen, the registered widgets or any touch area changed since the
+ *         last rebuildHitGrid()
+ */
+bool DisplayFK::hitGridIsCurrent() const {
+    return m_hitGridScreen == WidgetBase::currentScreen &&
+           m_hitGridRegistryRev == m_registry.revision() &&
+           m_hitGridLayoutRev == WidgetBase::layoutRevision;
+}
+
+/**
+ * @brief Hit-tests a single widget and queues its callback
+ * @param widget Widget to test
+ * @param type Kind of the widget
+ * @param xTouch Touch X position
+ * @param yTouch Touch Y position
+ * @param collectMode If true, the widget is tracked for onRelease
+ * @return true if the widget was touched
+ * @details TextBox and NumberBox open their keyboard and only queue the callback when the
+ *          user confirms the value.
+ */
+bool DisplayFK::processWidgetTouch(WidgetBase *widget, WidgetType type, uint16_t xTouch, uint16_t yTouch, bool collectMode) {
+#ifdef DFK_TEXTBOX
+    if (type == WidgetType::TEXTBOX) {
+        if (!keyboard || !touchExterno) return false;
+        if (!widget->detectTouch(&xTouch, &yTouch)) return false;
+        processTextBoxTouch(static_cast<TextBox *>(widget), collectMode);
+        return true;
+    }
+#endif
+#ifdef DFK_NUMBERBOX
+    if (type == WidgetType::NUMBERBOX) {
+        if (!numpad || !touchExterno) return false;
+        if (!widget->detectTouch(&xTouch, &yTouch)) return false;
+        processNumberBoxTouch(static_cast<NumberBox *>(widget), collectMode);
+        return true;
+    }
+#endif
+
+    if (!widget->detectTouch(&xTouch, &yTouch)) return false;
+
+    functionCB_t cb = widget->getCallbackFunc();
+    WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
+
+#ifdef ENABLE_ON_RELEASE
+    // Add to touched widgets array if in collect mode
+    if (collectMode) {
+        addTouchedWidget(widget);
+    }
+#endif
+    return true;
+}
+
+#ifdef ENABLE_ON_RELEASE
+/**
+ * @brief Adds a widget to the touched widgets array
+ * @param widget Pointer to the widget to add
+ * @details Only adds if widget is not already in array and array has space
+ */
+void DisplayFK::addTouchedWidget(WidgetBase* widget) {
+    if (!widget) return;
+    
     // Check if widget is already in array
     if (isWidgetInTouchedArray(widget)) return;
     
@@ -2644,495 +2429,591 @@ void DisplayFK::clearTouchedWidgets(bool callOnRelease) {
 }
 #endif
 
+#ifdef DFK_TEXTBOX
 /**
- * @brief Processes touch in checkbox (optimized for current screen)
- * @param xTouch Touch X position
- * @param yTouch Touch Y position
- * @param collectMode If true, collects all widgets without early return
+ * @brief Opens the keyboard for a touched text box and runs it until it is closed
+ * @param textbox Text box that was touched
+ * @param collectMode If true, the text box is tracked for onRelease
  */
-void DisplayFK::processCheckboxTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
-#ifdef DFK_CHECKBOX
-    if(!m_checkboxConfigured || !arrayCheckbox){
-        return;
-    }
-    
-    for (uint32_t indice = 0; indice < qtdCheckbox; indice++) {
-        // Skip widgets not on current screen
-        if (!arrayCheckbox[indice]->showingMyScreen()) continue;
-        
-        if (arrayCheckbox[indice]->detectTouch(&xTouch, &yTouch)) {
-            functionCB_t cb = arrayCheckbox[indice]->getCallbackFunc();
-            WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
-            
+void DisplayFK::processTextBoxTouch(TextBox *textbox, bool collectMode) {
 #ifdef ENABLE_ON_RELEASE
-            // Add to touched widgets array if in collect mode
-            if (collectMode) {
-                addTouchedWidget(arrayCheckbox[indice]);
-            }
+    if (collectMode) {
+        addTouchedWidget(textbox);
+    }
 #endif
-            
-            // Return early only if not in collect mode
-            if (!collectMode) {
+    keyboard->open(textbox);
+    PressedKeyType pressedKey = PressedKeyType::NONE;
+
+    while (WidgetBase::usingKeyboard) {
+        uint16_t internal_xTouch = 0;
+        uint16_t internal_yTouch = 0;
+        int internal_zPressure = 0;
+        
+        bool hasTouch = touchExterno && (touchExterno->getTouch(&internal_xTouch, &internal_yTouch, &internal_zPressure));
+        if (hasTouch && keyboard->detectTouch(&internal_xTouch, &internal_yTouch, &pressedKey)) {
+            if (pressedKey == PressedKeyType::RETURN || pressedKey == PressedKeyType::ESC) {
+                WidgetBase::loadScreen = keyboard->m_field->parentScreen;
+                keyboard->close();
+                
+                if(pressedKey == PressedKeyType::RETURN){
+                    functionCB_t cb = textbox->getCallbackFunc();
+                    WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
+                }
                 return;
             }
-            // In collect mode, continue to find other widgets
         }
+		RESET_WDT
+        vTaskDelay(pdMS_TO_TICKS(10));
     }
-#endif
 }
+#endif
 
+#ifdef DFK_NUMBERBOX
 /**
- * @brief Processes touch in circle button
- * @param xTouch Touch X position
- * @param yTouch Touch Y position
- * @param collectMode If true, collects all widgets without early return
+ * @brief Opens the numpad for a touched number box and runs it until it is closed
+ * @param numberbox Number box that was touched
+ * @param collectMode If true, the number box is tracked for onRelease
  */
-void DisplayFK::processCircleButtonTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
-#ifdef DFK_CIRCLEBTN
-    if(!m_circleButtonConfigured || !arrayCircleBtn){
-        return;
-    }
-    
-        for (uint32_t indice = 0; indice < qtdCircleBtn; indice++) {
-            if (!arrayCircleBtn[indice]->showingMyScreen()) continue;
-            
-            if (arrayCircleBtn[indice]->detectTouch(&xTouch, &yTouch)) {
-                functionCB_t cb = arrayCircleBtn[indice]->getCallbackFunc();
-                WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
-                
+void DisplayFK::processNumberBoxTouch(NumberBox *numberbox, bool collectMode) {
 #ifdef ENABLE_ON_RELEASE
-                if (collectMode) {
-                    addTouchedWidget(arrayCircleBtn[indice]);
-                }
+    if (collectMode) {
+        addTouchedWidget(numberbox);
+    }
 #endif
-                
-                if (!collectMode) {
+    numpad->open(numberbox);
+    PressedKeyType pressedKey = PressedKeyType::NONE;
+    bool lastTouchState = false;  // Track previous touch state
+
+    while (WidgetBase::usingKeyboard) {
+        uint16_t internal_xTouch = 0;
+        uint16_t internal_yTouch = 0;
+        int internal_zPressure = 0;
+        bool hasTouch = touchExterno && (touchExterno->getTouch(&internal_xTouch, &internal_yTouch, &internal_zPressure));
+        
+        // Check if touch was released (was touching, now not)
+        if (lastTouchState && !hasTouch) {
+            // Touch was released - call internal onRelease
+            numpad->releaseKey();
+        }
+        
+        if (hasTouch) {
+            // Check if touch moved outside current pressed key
+            if (numpad->isKeyPressed()) {
+                const Numpad::KeyState& pressedKey = numpad->getPressedKey();
+                if (!numpad->isPointInKey(internal_xTouch, internal_yTouch, pressedKey)) {
+                    // Touch moved outside pressed key - release it
+                    numpad->releaseKey();
+                }
+            }
+            
+            // Detect new key press
+            if (numpad->detectTouch(&internal_xTouch, &internal_yTouch, &pressedKey)) {
+                if (pressedKey == PressedKeyType::RETURN || pressedKey == PressedKeyType::ESC) {
+                    if (numpad->m_field && numpad->m_field->parentScreen) {
+                        WidgetBase::loadScreen = numpad->m_field->parentScreen;
+                    }
+                    numpad->close();
+                    
+                    if(pressedKey == PressedKeyType::RETURN){
+                        functionCB_t cb = numberbox->getCallbackFunc();
+                        WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
+                    }
                     return;
                 }
             }
         }
-#endif
+        
+        lastTouchState = hasTouch;  // Update touch state
+		RESET_WDT
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
 }
+#endif
 
 /**
- * @brief Processes touch in horizontal slider (optimized for current screen)
- * @param xTouch Touch X position
- * @param yTouch Touch Y position
- * @param collectMode If true, collects all widgets without early return
+ * @brief Updates screen widgets (optimized for current screen only)
+ * @details The widgets of the current screen are visited once, bottom-up in paint order.
+ *          Every widget that paints adds the area it covered before and after painting to
+ *          the frame damage list (a label may grow or shrink). A widget that overlaps the
+ *          damage painted below it is repainted in full, even if it was already dirty for a
+ *          partial update, so whatever was drawn over it is covered again, whether the widget
+ *          below is opaque or not. Each widget is painted at most once per frame. If no
+ *          widget is dirty the damage list stays empty.
+ *          Widgets still draw straight to the display in their redraw(); the damage list only
+ *          records what they painted, so the bytes sent to the panel are not reduced by it.
  */
-void DisplayFK::processHSliderTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
-#ifdef DFK_HSLIDER
-    if(!m_hSliderConfigured || !arrayHSlider){
-        return;
-    }
+void DisplayFK::updateWidgets() {
+    if (m_runningTransaction) return;
 
-    //Serial.println("processHSliderTouch");
+    m_damage.clear();
+    m_pendingRedraws = 0;
+    syncStackOrder();
     
-    for (uint32_t indice = 0; indice < qtdHSlider; indice++) {
-        // Skip widgets not on current screen
-        if (!arrayHSlider[indice]->showingMyScreen()) continue;
-        
-        if (arrayHSlider[indice]->detectTouch(&xTouch, &yTouch)) {
-            functionCB_t cb = arrayHSlider[indice]->getCallbackFunc();
-            WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
-            
-#ifdef ENABLE_ON_RELEASE
-            if (collectMode) {
-                addTouchedWidget(arrayHSlider[indice]);
-            }
-#endif
-            
-            if (!collectMode) {
-                return;
-            }
+    // Only process widgets from current screen
+    WidgetSpan_t span = m_registry.onScreen(WidgetBase::currentScreen);
+    for (uint32_t indice = 0; indice < span.count; indice++) {
+        WidgetBase *widget = span.widgets[indice];
+        if (m_damage.intersects(widget->getBounds())) {
+            // Something painted below reaches this widget: a partial update (text diff,
+            // changed segments) would leave the rest of it erased
+            widget->requestFullRedraw();
+        } else if (!widget->needsRedraw()) {
+            continue;
         }
+        // Covered widgets stay dirty, uncounted, until they show again
+        if (isOccluded(span, indice)) continue;
+        if (deferRedraw(widget)) {
+            m_pendingRedraws++;
+            continue;
+        }
+        Rect_t before = widget->getBounds();
+        if (widget->takeFullRedraw()) {
+            widget->fullRedraw();
+        } else {
+            widget->refresh();
+        }
+        if (widget->needsRedraw()) {
+            // Debounce or keyboard open: the widget did not touch the screen
+            m_pendingRedraws++;
+            continue;
+        }
+        m_damage.add(before);
+        m_damage.add(widget->getBounds());
     }
-#endif
 }
 
 /**
- * @brief Processes touch in radio button group
- * @param xTouch Touch X position
- * @param yTouch Touch Y position
- * @param collectMode If true, collects all widgets without early return
+ * @brief Sorts the registry again if a widget changed its layer
  */
-void DisplayFK::processRadioGroupTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
-#ifdef DFK_RADIO
-    if(!m_radioGroupConfigured || !arrayRadioGroup){
-        return;
-    }
-    
-        for (uint32_t indice = 0; indice < qtdRadioGroup; indice++) {
-            if (arrayRadioGroup[indice]->detectTouch(&xTouch, &yTouch)) {
-                functionCB_t cb = arrayRadioGroup[indice]->getCallbackFunc();
-                WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
-                
-#ifdef ENABLE_ON_RELEASE
-                if (collectMode) {
-                    addTouchedWidget(arrayRadioGroup[indice]);
-                }
-#endif
-                
-                if (!collectMode) {
-                    return;
-                }
-            }
+void DisplayFK::syncStackOrder() {
+    if (m_stackRevision == WidgetBase::stackRevision) return;
+    m_stackRevision = WidgetBase::stackRevision;
+    m_registry.sort();
+}
+
+/**
+ * @brief Checks if a widget is hidden under an opaque widget
+ * @param span Widgets of the current screen
+ * @param index Position of the widget in the span
+ * @return true if a visible opaque widget painted later covers the whole widget
+ * @details Only complete coverage by a single widget is detected; partially covered widgets
+ *          are painted normally and the widgets above them are painted afterwards.
+ */
+bool DisplayFK::isOccluded(const WidgetSpan_t &span, uint16_t index) const {
+    Rect_t bounds = span.widgets[index]->getBounds();
+    if (bounds.width == 0 || bounds.height == 0) return false;
+    for (uint16_t above = index + 1; above < span.count; above++) {
+        WidgetBase *widget = span.widgets[above];
+        if (widget->isOpaque() && DirtyRegion::contains(widget->getBounds(), bounds)) {
+            return true;
         }
-#endif
+    }
+    return false;
 }
 
 /**
- * @brief Processes touch in rectangular button
- * @param xTouch Touch X position
- * @param yTouch Touch Y position
- * @param collectMode If true, collects all widgets without early return
+ * @brief Makes the UI task sleep while there is nothing to do
+ * @param touchIntPin Touch controller INT pin. When set, a touch wakes the task through an
+ *                    interrupt; use -1 if the touch driver already owns the pin interrupt (FT6X36)
+ *                    or the board has no INT line.
+ * @param touchPollMs Interval to poll the touch while idle when touchIntPin is -1.
+ * @details The task is woken by widget invalidation (setValue, setText...), callbacks and logs
+ *          being queued, screen loads, the auto click timer and the touch. While a touch is
+ *          held or a widget is still dirty, frames keep running at the scheduler rate.
  */
-void DisplayFK::processRectButtonTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
-#ifdef DFK_RECTBTN
-    if(!m_rectButtonConfigured || !arrayRectBtn){
-        return;
+void DisplayFK::enableEventDrivenIdle(int8_t touchIntPin, uint16_t touchPollMs) {
+    disableEventDrivenIdle();
+    m_touchIntPin = touchIntPin;
+    m_touchPollMs = touchPollMs > 0 ? touchPollMs : DFK_TOUCH_POLL_MS;
+    if (m_touchIntPin >= 0) {
+        attachInterrupt(digitalPinToInterrupt(m_touchIntPin), WidgetBase::requestFrameFromISR, CHANGE);
     }
-    
-        for (uint32_t indice = 0; indice < qtdRectBtn; indice++) {
-            if (!arrayRectBtn[indice]->showingMyScreen()) continue;
-            
-            if (arrayRectBtn[indice]->detectTouch(&xTouch, &yTouch)) {
-                functionCB_t cb = arrayRectBtn[indice]->getCallbackFunc();
-                WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
-                
-#ifdef ENABLE_ON_RELEASE
-                if (collectMode) {
-                    addTouchedWidget(arrayRectBtn[indice]);
-                }
-#endif
-                
-                if (!collectMode) {
-                    return;
-                }
-            }
-        }
+    m_idleEnabled = true;
+    WidgetBase::requestFrame();
+    ESP_LOGI(TAG, "Event-driven idle enabled (touch INT %d, poll %u ms)", m_touchIntPin, m_touchPollMs);
+}
+
+/**
+ * @brief Restores the continuous loop of the UI task
+ */
+void DisplayFK::disableEventDrivenIdle() {
+    if (m_touchIntPin >= 0) {
+        detachInterrupt(digitalPinToInterrupt(m_touchIntPin));
+        m_touchIntPin = -1;
+    }
+    m_idleEnabled = false;
+    WidgetBase::requestFrame();
+}
+
+/**
+ * @brief Checks if the next loop iteration has something to do
+ */
+bool DisplayFK::hasPendingWork() const {
+    if (WidgetBase::loadScreen) return true;
+    if (m_pendingRedraws > 0) return true;
+#if defined(HAS_TOUCH)
+    if (m_lastTouchState != TouchEventType::NONE) return true;
+    if (m_simulateAutoClick) return true;
 #endif
+    if (WidgetBase::xFilaCallback && uxQueueMessagesWaiting(WidgetBase::xFilaCallback) > 0) return true;
+    if (DisplayFK::xFilaLog && uxQueueMessagesWaiting(DisplayFK::xFilaLog) > 0) return true;
+    return false;
 }
 
 /**
- * @brief Processes touch in image
- * @param xTouch Touch X position
- * @param yTouch Touch Y position
- * @param collectMode If true, collects all widgets without early return
+ * @brief Waits before the next loop iteration
+ * @details With the event-driven idle enabled and nothing pending, the task blocks on its
+ *          notification until an event arrives (or the touch poll interval / watchdog limit
+ *          expires). Otherwise it waits for the next frame slot.
  */
-void DisplayFK::processImageTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
-#ifdef DFK_IMAGE
-    if(!m_imageConfigured || !arrayImage){
+void DisplayFK::waitNextIteration() {
+    if (!m_idleEnabled || hasPendingWork()) {
+        m_scheduler.waitNextFrame();
         return;
     }
-    
-        for (uint32_t indice = 0; indice < qtdImage; indice++) {
-            if (arrayImage[indice] == nullptr) {
-                ESP_LOGE(TAG, "Image pointer is null");
-                continue;
-            }
 
-            if (!arrayImage[indice]->showingMyScreen()) continue;
+    uint32_t timeoutMs = (m_touchIntPin >= 0) ? DFK_IDLE_MAX_SLEEP_MS : m_touchPollMs;
+    if (m_enableWTD && m_timeoutWTD > 0) {
+        // Half of the watchdog timeout, so the task is always fed in time
+        uint32_t wdtMs = static_cast<uint32_t>(m_timeoutWTD) * 500;
+        if (wdtMs < timeoutMs) timeoutMs = wdtMs;
+    }
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs));
+}
 
-            if (arrayImage[indice]->detectTouch(&xTouch, &yTouch)) {
-                functionCB_t cb = arrayImage[indice]->getCallbackFunc();
-                WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
-                
-#ifdef ENABLE_ON_RELEASE
-                if (collectMode) {
-                    addTouchedWidget(arrayImage[indice]);
-                }
-#endif
-                
-                if (!collectMode) {
-                    return;
-                }
-            }
-        }
-#endif
+/**
+ * @brief Sets the frame rate of the UI task
+ * @param fps Target frames per second (e.g. 30 or 60). 0 restores the unpaced loop.
+ * @param budgetUs Time each frame may spend drawing, in microseconds. 0 uses the frame period.
+ * @details When the budget is spent, widgets with RedrawPriority::DEFERRABLE keep their
+ *          redraw flag and are painted in a later frame.
+ */
+void DisplayFK::setTargetFps(uint8_t fps, uint32_t budgetUs) {
+    m_scheduler.setTargetFps(fps);
+    m_scheduler.setBudget(budgetUs);
+    ESP_LOGI(TAG, "Target FPS %u, budget %lu us", fps, (unsigned long)budgetUs);
 }
 
 /**
- * @brief Processes touch in spin box
- * @param xTouch Touch X position
- * @param yTouch Touch Y position
- * @param collectMode If true, collects all widgets without early return
+ * @brief Gets the frame statistics (frames, dropped frames, budget overruns, deferred redraws)
  */
-void DisplayFK::processSpinboxTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
-#ifdef DFK_SPINBOX
-    if(!m_spinboxConfigured || !arraySpinbox){
-        return;
+const FrameStats_t &DisplayFK::getFrameStats() const {
+    return m_scheduler.getStats();
+}
+
+/**
+ * @brief Clears the frame statistics
+ */
+void DisplayFK::resetFrameStats() {
+    m_scheduler.resetStats();
+}
+
+/**
+ * @brief Enables the cache of decoded images shared by all Image widgets
+ * @param maxBytes Memory cap for images nobody is drawing (PSRAM preferred).
+ * @param maxEntries Number of images that can be cached at the same time.
+ * @return true if the cache is ready
+ * @details Images loaded with setupFromFile() (not streaming) are read and decoded once per
+ *          (source, path); other widgets showing the same file, and the same screen built
+ *          again, draw from the cached buffers. Calling it again only changes the memory cap.
+ */
+bool DisplayFK::enableImageCache(uint32_t maxBytes, uint16_t maxEntries)
+{
+    if (WidgetBase::imageCache) {
+        WidgetBase::imageCache->setMaxBytes(maxBytes);
+        ESP_LOGI(TAG, "Image cache cap set to %u bytes", (unsigned)maxBytes);
+        return true;
     }
-    
-        for (uint32_t indice = 0; indice < qtdSpinbox; indice++) {
-            if (!arraySpinbox[indice]->showingMyScreen()) continue;
 
-            if (arraySpinbox[indice]->detectTouch(&xTouch, &yTouch)) {
-                functionCB_t cb = arraySpinbox[indice]->getCallbackFunc();
-                WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
-                
-#ifdef ENABLE_ON_RELEASE
-                if (collectMode) {
-                    addTouchedWidget(arraySpinbox[indice]);
-                }
-#endif
-                
-                if (!collectMode) {
-                    return;
-                }
-            }
-        }
-    
-#endif
+    ImageCache *cache = new(std::nothrow) ImageCache(maxBytes, maxEntries);
+    if (!cache) {
+        ESP_LOGE(TAG, "Failed to create image cache");
+        return false;
+    }
+    if (!cache->begin()) {
+        delete cache;
+        return false;
+    }
+    WidgetBase::imageCache = cache;
+    ESP_LOGI(TAG, "Image cache enabled (%u bytes, %u images)", (unsigned)maxBytes, maxEntries);
+    return true;
 }
 
 /**
- * @brief Processes touch in toggle button (optimized for current screen)
- * @param xTouch Touch X position
- * @param yTouch Touch Y position
- * @param collectMode If true, collects all widgets without early return
+ * @brief Stops caching images and frees every cached image no widget is using.
+ * @details The cache object is kept because Image widgets may still hold images from it;
+ *          they are freed when those widgets are destroyed.
  */
-void DisplayFK::processToggleTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
-#ifdef DFK_TOGGLE
-    if(!m_toggleConfigured || !arrayToggleBtn){
-        return;
+void DisplayFK::disableImageCache()
+{
+    if (WidgetBase::imageCache) {
+        WidgetBase::imageCache->setMaxBytes(0);
+        ESP_LOGD(TAG, "Image cache disabled");
     }
+}
 
-    for (uint32_t indice = 0; indice < qtdToggle; indice++) {
-        // Skip widgets not on current screen
-        if (!arrayToggleBtn[indice]->showingMyScreen()) continue;
-        
-        if (arrayToggleBtn[indice]->detectTouch(&xTouch, &yTouch)) {
-            functionCB_t cb = arrayToggleBtn[indice]->getCallbackFunc();
-            WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
-            
-#ifdef ENABLE_ON_RELEASE
-            if (collectMode) {
-                addTouchedWidget(arrayToggleBtn[indice]);
-            }
-#endif
-            
-            if (!collectMode) {
-                return;
-            }
-        }
+/**
+ * @brief Decides if a widget redraw is postponed to a later frame
+ * @param widget Widget about to be painted.
+ * @return true if the widget is deferrable, needs a redraw and the frame budget is spent.
+ */
+bool DisplayFK::deferRedraw(WidgetBase *widget) {
+    if (widget->getRedrawPriority() != RedrawPriority::DEFERRABLE) return false;
+    if (!widget->needsRedraw()) return false;
+    if (m_scheduler.hasBudget()) return false;
+    m_scheduler.countDeferred();
+    return true;
+}
+
+/**
+ * @brief Gets the screen areas painted in the last frame
+ * @return Coalesced list of damaged rectangles. Empty if nothing was painted.
+ * @details The same list decided, during the frame, which widgets above a painted widget had
+ *          to be repainted. It describes what the widgets drew; it does not merge or clip
+ *          their drawing.
+ */
+const DirtyRegion &DisplayFK::getFrameDamage() const {
+    return m_damage;
+}
+
+
+void DisplayFK::refreshScreen() {
+    if(m_lastScreen) {
+        Serial.println("Reloading screen");
+        WidgetBase::loadScreen = m_lastScreen;
+        WidgetBase::requestFrame();
+    }
+}
+
+void DisplayFK::loadScreen(functionLoadScreen_t screen) {
+    WidgetBase::loadScreen = screen;
+    WidgetBase::requestFrame();
+}
+
+#if defined(DISP_DEFAULT)
+void DisplayFK::setDrawObject(Arduino_GFX *objTFT){
+    disableShadowBuffer();
+    WidgetBase::objTFT = objTFT;
+    if (objTFT) {
+        WidgetBase::screenWidth = objTFT->width();
+        WidgetBase::screenHeight = objTFT->height();
     }
-#endif
 }
 
 /**
- * @brief Processes touch in text button
- * @param xTouch Touch X position
- * @param yTouch Touch Y position
- * @param collectMode If true, collects all widgets without early return
+ * @brief Enables off-screen composition of text and needles through a stripe buffer
+ * @param width Width used to size the buffer (pixels).
+ * @param height Height used to size the buffer (pixels).
+ * @return true if the buffer was allocated
+ * @details The buffer holds width x height RGB565 pixels (internal DMA RAM, PSRAM as fallback).
+ *          Labels and gauge needles are composed in it and sent to the display with a single
+ *          draw16bitRGBBitmap() per stripe, removing the erase-then-draw flicker.
+ *          Call after setDrawObject() and before createTask().
  */
-void DisplayFK::processTextButtonTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
-#ifdef DFK_TEXTBUTTON
-    if(!m_textButtonConfigured || !arrayTextButton){
-        return;
+bool DisplayFK::enableStripeRendering(uint16_t width, uint16_t height)
+{
+    if (!WidgetBase::objTFT) {
+        ESP_LOGE(TAG, "Call setDrawObject() before enableStripeRendering()");
+        return false;
     }
-    
-    for (uint32_t indice = 0; indice < qtdTextButton; indice++) {
-        if (!arrayTextButton[indice]->showingMyScreen()) continue;
+    disableStripeRendering();
 
-        if (arrayTextButton[indice]->detectTouch(&xTouch, &yTouch)) {
-            functionCB_t cb = arrayTextButton[indice]->getCallbackFunc();
-            WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
-            
-#ifdef ENABLE_ON_RELEASE
-            if (collectMode) {
-                addTouchedWidget(arrayTextButton[indice]);
-            }
-#endif
-            
-            // Note: This function doesn't return early by design
-            // Continue processing even if not in collect mode
-        }
+    StripeCanvas *canvas = new(std::nothrow) StripeCanvas(WidgetBase::objTFT->width(), WidgetBase::objTFT->height(), width, height);
+    if (!canvas) {
+        ESP_LOGE(TAG, "Failed to create stripe canvas");
+        return false;
+    }
+    if (!canvas->begin()) {
+        delete canvas;
+        return false;
+    }
+    WidgetBase::stripeCanvas = canvas;
+    ESP_LOGI(TAG, "Stripe rendering enabled (%u x %u)", width, height);
+    return true;
+}
+
+/**
+ * @brief Disables the stripe buffer and frees its memory. Widgets draw directly again.
+ */
+void DisplayFK::disableStripeRendering()
+{
+    if (WidgetBase::stripeCanvas) {
+        delete WidgetBase::stripeCanvas;
+        WidgetBase::stripeCanvas = nullptr;
+        ESP_LOGD(TAG, "Stripe canvas freed");
+    }
+}
+
+/**
+ * @brief Enables the cache of rasterized glyphs used to print text
+ * @param maxBytes Memory cap for the rasterized glyphs (PSRAM preferred).
+ * @param maxEntries Number of glyphs that can be cached at the same time.
+ * @return true if the cache was created
+ * @details Each (font, character) pair is decoded once into horizontal runs and then drawn
+ *          with one line per run instead of one call per pixel. The least recently used
+ *          glyphs are dropped when a limit is reached.
+ */
+bool DisplayFK::enableGlyphCache(uint32_t maxBytes, uint16_t maxEntries)
+{
+    disableGlyphCache();
+
+    GlyphCache *cache = new(std::nothrow) GlyphCache(maxBytes, maxEntries);
+    if (!cache) {
+        ESP_LOGE(TAG, "Failed to create glyph cache");
+        return false;
+    }
+    if (!cache->begin()) {
+        delete cache;
+        return false;
+    }
+    WidgetBase::glyphCache = cache;
+    ESP_LOGI(TAG, "Glyph cache enabled (%u bytes, %u glyphs)", (unsigned)maxBytes, maxEntries);
+    return true;
+}
+
+/**
+ * @brief Disables the glyph cache and frees its memory. Text is printed by Arduino_GFX again.
+ */
+void DisplayFK::disableGlyphCache()
+{
+    if (WidgetBase::glyphCache) {
+        delete WidgetBase::glyphCache;
+        WidgetBase::glyphCache = nullptr;
+        ESP_LOGD(TAG, "Glyph cache freed");
+    }
+}
+
+/**
+ * @brief Enables the cache of text measurements shared by all widgets
+ * @param slots Number of strings kept.
+ * @return true if the cache was created
+ * @details printText() measures each string twice (datum and erase area) and Arduino_GFX walks
+ *          it glyph by glyph each time. With the cache a string printed again with the same
+ *          font and size is measured once; positions are derived from the stored box.
+ */
+bool DisplayFK::enableTextMetricsCache(uint16_t slots)
+{
+    disableTextMetricsCache();
+
+    TextMetricsCache *cache = new(std::nothrow) TextMetricsCache(slots);
+    if (!cache) {
+        ESP_LOGE(TAG, "Failed to create text metrics cache");
+        return false;
+    }
+    if (!cache->begin()) {
+        delete cache;
+        return false;
+    }
+    WidgetBase::textMetrics = cache;
+    ESP_LOGI(TAG, "Text metrics cache enabled (%u strings)", slots);
+    return true;
+}
+
+/**
+ * @brief Disables the text metrics cache and frees its memory.
+ */
+void DisplayFK::disableTextMetricsCache()
+{
+    if (WidgetBase::textMetrics) {
+        delete WidgetBase::textMetrics;
+        WidgetBase::textMetrics = nullptr;
+        ESP_LOGD(TAG, "Text metrics cache freed");
     }
-#endif
 }
 
 /**
- * @brief Processes touch in text box
- * @param xTouch Touch X position
- * @param yTouch Touch Y position
- * @param collectMode If true, collects all widgets without early return
+ * @brief Enables the shadow buffer for panels with a framebuffer in memory (RGB/DSI)
+ * @param panelBuffer Framebuffer scanned by the panel (e.g. Arduino_RGB_Display::getFramebuffer()).
+ * @return true if the shadow buffer was allocated
+ * @details Widgets, keyboards and the log draw into a full screen shadow buffer in PSRAM. At
+ *          the end of each loopTask() only the damaged areas are copied to the panel, so the
+ *          panel never shows a widget being erased. This is not double buffering: the copy
+ *          goes into the framebuffer being scanned, without a vsync swap, so it can tear.
+ *          Screen functions run while loading a screen and custom draws
+ *          (startCustomDraw()/finishCustomDraw()) still draw directly on the panel; afterwards
+ *          the shadow buffer reads back from panelBuffer only the bands it draws again.
+ *          Call after setDrawObject() and setRotation(), before createTask(). The rotation
+ *          must not change while the shadow buffer is enabled.
  */
-void DisplayFK::processTextBoxTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
-#ifdef DFK_TEXTBOX
-    if(!m_textboxConfigured || !arrayTextBox || !keyboard){
-        return;
+bool DisplayFK::enableShadowBuffer(uint16_t *panelBuffer)
+{
+    if (m_shadowBuffer) {
+        return true;
     }
-    if(!touchExterno){
-        return;
+    if (!WidgetBase::objTFT) {
+        ESP_LOGE(TAG, "Call setDrawObject() before enableShadowBuffer()");
+        return false;
+    }
+    if (!panelBuffer) {
+        ESP_LOGE(TAG, "Shadow buffer needs the panel framebuffer");
+        return false;
     }
-        for (uint32_t indice = 0; indice < qtdTextBox; indice++) {
-            if (arrayTextBox[indice] == nullptr) {
-                ESP_LOGE(TAG, "TextBox pointer is null");
-                continue;
-            }
-
-            if (!arrayTextBox[indice]->showingMyScreen()) continue;
 
-            if (arrayTextBox[indice]->detectTouch(&xTouch, &yTouch)) {
-#ifdef ENABLE_ON_RELEASE
-                if (collectMode) {
-                    addTouchedWidget(arrayTextBox[indice]);
-                }
-#endif
-                keyboard->open(arrayTextBox[indice]);
-                PressedKeyType pressedKey = PressedKeyType::NONE;
+    FrameBufferCanvas *canvas = new(std::nothrow) FrameBufferCanvas(WidgetBase::objTFT->width(), WidgetBase::objTFT->height());
+    if (!canvas) {
+        ESP_LOGE(TAG, "Failed to create shadow buffer");
+        return false;
+    }
+    if (!canvas->begin()) {
+        delete canvas;
+        return false;
+    }
+    canvas->markStale(panelBuffer, WidgetBase::objTFT->getRotation());
 
-                while (WidgetBase::usingKeyboard) {
-                    uint16_t internal_xTouch = 0;
-                    uint16_t internal_yTouch = 0;
-                    int internal_zPressure = 0;
-                    
-                    bool hasTouch = touchExterno && (touchExterno->getTouch(&internal_xTouch, &internal_yTouch, &internal_zPressure));
-                    if (hasTouch && keyboard->detectTouch(&internal_xTouch, &internal_yTouch, &pressedKey)) {
-                        if (pressedKey == PressedKeyType::RETURN || pressedKey == PressedKeyType::ESC) {
-                            WidgetBase::loadScreen = keyboard->m_field->parentScreen;
-                            keyboard->close();
-                            
-                            if(pressedKey == PressedKeyType::RETURN){
-                                functionCB_t cb = arrayTextBox[indice]->getCallbackFunc();
-                                WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
-                            }
-                            return;
-                        }
-                    }
-					RESET_WDT
-                    vTaskDelay(pdMS_TO_TICKS(10));
-                }
-            }
-        }
-#endif
+    m_panelDisplay = WidgetBase::objTFT;
+    m_panelBuffer = panelBuffer;
+    m_panelChanged = false;
+    m_shadowBuffer = canvas;
+    WidgetBase::objTFT = canvas;
+    ESP_LOGI(TAG, "Shadow buffer enabled");
+    return true;
 }
 
 /**
- * @brief Processes touch in number box
- * @param xTouch Touch X position
- * @param yTouch Touch Y position
- * @param collectMode If true, collects all widgets without early return
+ * @brief Presents the pending damage, frees the shadow buffer and draws directly again
  */
-void DisplayFK::processNumberBoxTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode) {
-#ifdef DFK_NUMBERBOX
-        if(!m_numberboxConfigured || !arrayNumberbox || !numpad){
-            return;
-        }
-        if(!touchExterno){
-            return;
-        }
-
-        for (uint32_t indice = 0; indice < qtdNumberBox; indice++) {
-            if (arrayNumberbox[indice] == nullptr) {
-                ESP_LOGE(TAG, "NumberBox pointer is null");
-                continue;
-            }
-
-            if (!arrayNumberbox[indice]->showingMyScreen()) continue;
-
-            if (arrayNumberbox[indice]->detectTouch(&xTouch, &yTouch)) {
-#ifdef ENABLE_ON_RELEASE
-                if (collectMode) {
-                    addTouchedWidget(arrayNumberbox[indice]);
-                }
-#endif
-                numpad->open(arrayNumberbox[indice]);
-                PressedKeyType pressedKey = PressedKeyType::NONE;
-                bool lastTouchState = false;  // Track previous touch state
-
-                while (WidgetBase::usingKeyboard) {
-                    uint16_t internal_xTouch = 0;
-                    uint16_t internal_yTouch = 0;
-                    int internal_zPressure = 0;
-                    bool hasTouch = touchExterno && (touchExterno->getTouch(&internal_xTouch, &internal_yTouch, &internal_zPressure));
-                    
-                    // Check if touch was released (was touching, now not)
-                    if (lastTouchState && !hasTouch) {
-                        // Touch was released - call internal onRelease
-                        numpad->releaseKey();
-                    }
-                    
-                    if (hasTouch) {
-                        // Check if touch moved outside current pressed key
-                        if (numpad->isKeyPressed()) {
-                            const Numpad::KeyState& pressedKey = numpad->getPressedKey();
-                            if (!numpad->isPointInKey(internal_xTouch, internal_yTouch, pressedKey)) {
-                                // Touch moved outside pressed key - release it
-                                numpad->releaseKey();
-                            }
-                        }
-                        
-                        // Detect new key press
-                        if (numpad->detectTouch(&internal_xTouch, &internal_yTouch, &pressedKey)) {
-                            if (pressedKey == PressedKeyType::RETURN || pressedKey == PressedKeyType::ESC) {
-                                if (numpad->m_field && numpad->m_field->parentScreen) {
-                                    WidgetBase::loadScreen = numpad->m_field->parentScreen;
-                                }
-                                numpad->close();
-                                
-                                if(pressedKey == PressedKeyType::RETURN){
-                                    functionCB_t cb = arrayNumberbox[indice]->getCallbackFunc();
-                                    WidgetBase::addCallback(cb, WidgetBase::CallbackOrigin::TOUCH);
-                                }
-                                return;
-                            }
-                        }
-                    }
-                    
-                    lastTouchState = hasTouch;  // Update touch state
-					RESET_WDT
-                    vTaskDelay(pdMS_TO_TICKS(10));
-                }
-            }
-        }
-#endif
+void DisplayFK::disableShadowBuffer()
+{
+    if (!m_shadowBuffer) {
+        return;
+    }
+    presentFrame();
+    WidgetBase::objTFT = m_panelDisplay;
+    delete m_shadowBuffer;
+    m_shadowBuffer = nullptr;
+    m_panelDisplay = nullptr;
+    m_panelBuffer = nullptr;
+    ESP_LOGD(TAG, "Shadow buffer freed");
 }
 
 /**
- * @brief Updates screen widgets (optimized for current screen only)
+ * @brief Checks if the shadow buffer is active
  */
-void DisplayFK::updateWidgets() {
-    if (m_runningTransaction) return;
-    
-    // Only process widgets from current screen
-    updateCircularBar();
-    updateGauge();
-    updateLabel();
-    updateLed();
-    updateLineChart();
-    updateVBar();
-    updateVAnalog();
-    updateCheckbox();
-    updateCircleButton();
-    updateHSlider();
-    updateRadioGroup();
-    updateRectButton();
-    updateToggle();
-    updateImage();
-    updateTextButton();
-    updateSpinbox();
-    updateNumberBox();
-    updateTextBox();
-    updateThermometer();
+bool DisplayFK::isShadowBuffered() const
+{
+    return m_shadowBuffer != nullptr;
 }
 
-
-void DisplayFK::refreshScreen() {
-    if(m_lastScreen) {
-        Serial.println("Reloading screen");
-        WidgetBase::loadScreen = m_lastScreen;
+/**
+ * @brief Copies the areas drawn in this frame from the shadow buffer to the panel
+ */
+void DisplayFK::presentFrame()
+{
+    if (!m_shadowBuffer || !m_shadowBuffer->hasDamage()) {
+        return;
     }
+    m_shadowBuffer->present(m_panelDisplay);
 }
 
-void DisplayFK::loadScreen(functionLoadScreen_t screen) {
-    WidgetBase::loadScreen = screen;
-}
-
-#if defined(DISP_DEFAULT)
-void DisplayFK::setDrawObject(Arduino_GFX *objTFT){
-    WidgetBase::objTFT = objTFT;
+/**
+ * @brief Marks the shadow buffer stale after something was drawn directly on the panel
+ */
+void DisplayFK::syncShadowBuffer()
+{
+    m_panelChanged = false;
+    if (m_shadowBuffer) {
+        m_shadowBuffer->markStale(m_panelBuffer, m_panelDisplay->getRotation());
+    }
 }
 #elif defined(DISP_PCD8544)
 void DisplayFK::setDrawObject(Adafruit_PCD8544 *objTFT){
@@ -3183,17 +3064,38 @@ void DisplayFK::loopTask() {
     // Release the semaphore after checking - don't hold it during screen loading
     xSemaphoreGive(m_transactionSemaphore);
     //semaphoreAcquired = false;
+
+    m_scheduler.beginFrame();
     
     
     // Process screen loading
     if (WidgetBase::loadScreen) {
         m_lastScreen = WidgetBase::loadScreen;
         ESP_LOGD(TAG, "Loading screen on taskloop");
+        #if defined(DISP_DEFAULT)
+        // Screen functions draw with the user's display object, so the whole screen goes to the panel
+        if (m_shadowBuffer) {
+            presentFrame();
+            WidgetBase::objTFT = m_panelDisplay;
+        }
+        #endif
         WidgetBase::loadScreen();
         WidgetBase::loadScreen = nullptr;
+        #if defined(DISP_DEFAULT)
+        if (m_shadowBuffer) {
+            WidgetBase::objTFT = m_shadowBuffer;
+            m_panelChanged = true;
+        }
+        #endif
         vTaskDelay(pdMS_TO_TICKS(5));
     }
 
+    #if defined(DISP_DEFAULT)
+    if (m_panelChanged) {
+        syncShadowBuffer();
+    }
+    #endif
+
     // Process log queue
     processLogQueue();
 
@@ -3242,8 +3144,12 @@ if(touchExterno){
     #if defined(DISP_PCD8544)
     CHECK_TFT_VOID
     WidgetBase::objTFT->display();
+    #elif defined(DISP_DEFAULT)
+    presentFrame();
     #endif
 
+    m_scheduler.endFrame();
+
     // Calculate and log execution time
     startTime = millis() - startTime;
     
@@ -3269,6 +3175,7 @@ void DisplayFK::TaskEventoTouch(void *pvParameters)
 
     //vTaskDelay(pdMS_TO_TICKS(3000));
     ESP_LOGD(TAG, "TaskEventoTouch created");
+    WidgetBase::uiTask = xTaskGetCurrentTaskHandle();
     // const TickType_t xDelay = 10 / portTICK_PERIOD_MS;
 
     for (;;)
@@ -3282,7 +3189,11 @@ void DisplayFK::TaskEventoTouch(void *pvParameters)
         //}
         RESET_WDT
         //if(DisplayFK::instance->m_enableWTD){esp_task_wdt_reset();}
-        vTaskDelay(pdMS_TO_TICKS(1));
+        if(DisplayFK::instance){
+            DisplayFK::instance->waitNextIteration();
+        }else{
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
     }
 }
 
@@ -3471,292 +3382,10 @@ void DisplayFK::printText(const char* _texto, uint16_t _x, uint16_t _y, uint8_t
     WidgetBase::objTFT->setTextColor(_colorText, _colorPadding);
     WidgetBase::recalculateTextPosition(_texto, &_x, &_y, _datum);
     WidgetBase::objTFT->setCursor(_x, _y);
-    WidgetBase::objTFT->print(_texto);
+    WidgetBase::writeText(_texto);
     WidgetBase::setFontNull();
 }
 #endif
-/**
- * @brief Updates circular bars (optimized for current screen)
- */
-void DisplayFK::updateCircularBar() {
-#ifdef DFK_CIRCULARBAR
-    if (!m_circularBarConfigured) return;
-    
-    for (uint32_t indice = 0; indice < qtdCircularBar; indice++) {
-        // Skip widgets not on current screen
-        if (!arrayCircularBar[indice]->showingMyScreen()) continue;
-        
-        arrayCircularBar[indice]->redraw();
-    }
-#endif
-}
-
-/**
- * @brief Updates gauges (optimized for current screen)
- */
-void DisplayFK::updateGauge() {
-#ifdef DFK_GAUGE
-    if (!m_gaugeConfigured) return;
-    
-    for (uint32_t indice = 0; indice < qtdGauge; indice++) {
-        // Skip widgets not on current screen
-        if (!arrayGauge[indice]->showingMyScreen()) continue;
-        
-        arrayGauge[indice]->redraw();
-    }
-#endif
-}
-
-/**
- * @brief Updates labels (optimized for current screen)
- */
-void DisplayFK::updateLabel() {
-#ifdef DFK_LABEL
-    if (!m_labelConfigured) return;
-    
-    for (uint32_t indice = 0; indice < qtdLabel; indice++) {
-        // Skip widgets not on current screen
-        if (!arrayLabel[indice]->showingMyScreen()) continue;
-        
-        arrayLabel[indice]->redraw();
-    }
-#endif
-}
-
-/**
- * @brief Updates LEDs (optimized for current screen)
- */
-void DisplayFK::updateLed() {
-#ifdef DFK_LED
-    if (!m_ledConfigured) return;
-    
-    for (uint32_t indice = 0; indice < qtdLed; indice++) {
-        // Skip widgets not on current screen
-        if (!arrayLed[indice]->showingMyScreen()) continue;
-        
-        arrayLed[indice]->redraw();
-    }
-#endif
-}
-
-/**
- * @brief Updates line charts
- */
-void DisplayFK::updateLineChart() {
-#ifdef DFK_LINECHART
-    if (m_lineChartConfigured) {
-        for (uint32_t indice = 0; indice < qtdLineChart; indice++) {
-            if (!arrayLineChart[indice]->showingMyScreen()) continue;
-            arrayLineChart[indice]->redraw();
-        }
-    }
-#endif
-}
-
-/**
- * @brief Updates vertical bars
- */
-void DisplayFK::updateVBar() {
-#ifdef DFK_VBAR
-    if (m_vBarConfigured) {
-        for (uint32_t indice = 0; indice < qtdVBar; indice++) {
-            if (!arrayVBar[indice]->showingMyScreen()) continue;
-            arrayVBar[indice]->redraw();
-        }
-    }
-#endif
-}
-
-
-/**
- * @brief Updates vertical bars
- */
-void DisplayFK::updateThermometer() {
-#ifdef DFK_THERMOMETER
-    if (m_thermometerConfigured) {
-        for (uint32_t indice = 0; indice < qtdThermometer; indice++) {
-            if (!arrayThermometer[indice]->showingMyScreen()) continue;
-            arrayThermometer[indice]->redraw();
-        }
-    }
-#endif
-}
-
-/**
- * @brief Updates analog viewers
- */
-void DisplayFK::updateVAnalog() {
-#ifdef DFK_VANALOG
-    if (m_vAnalogConfigured) {
-        for (uint32_t indice = 0; indice < qtdVAnalog; indice++) {
-            if (!arrayVAnalog[indice]->showingMyScreen()) continue;
-            arrayVAnalog[indice]->redraw();
-        }
-    }
-#endif
-}
-
-/**
- * @brief Updates checkboxes (optimized for current screen)
- */
-void DisplayFK::updateCheckbox() {
-#ifdef DFK_CHECKBOX
-    if (!m_checkboxConfigured) return;
-    
-    for (uint32_t indice = 0; indice < qtdCheckbox; indice++) {
-        // Skip widgets not on current screen
-        if (!arrayCheckbox[indice]->showingMyScreen()) continue;
-        
-        arrayCheckbox[indice]->redraw();
-    }
-#endif
-}
-
-/**
- * @brief Updates circle buttons
- */
-void DisplayFK::updateCircleButton() {
-#ifdef DFK_CIRCLEBTN
-    if (m_circleButtonConfigured) {
-        for (uint32_t indice = 0; indice < qtdCircleBtn; indice++) {
-            if (!arrayCircleBtn[indice]->showingMyScreen()) continue;
-            arrayCircleBtn[indice]->redraw();
-        }
-    }
-#endif
-}
-
-/**
- * @brief Updates horizontal sliders (optimized for current screen)
- */
-void DisplayFK::updateHSlider() {
-#ifdef DFK_HSLIDER
-    if (!m_hSliderConfigured) return;
-    
-    for (uint32_t indice = 0; indice < qtdHSlider; indice++) {
-        // Skip widgets not on current screen
-        if (!arrayHSlider[indice]->showingMyScreen()) continue;
-        
-        arrayHSlider[indice]->redraw();
-    }
-#endif
-}
-
-/**
- * @brief Updates radio groups
- */
-void DisplayFK::updateRadioGroup() {
-#ifdef DFK_RADIO
-    if (m_radioGroupConfigured) {
-        for (uint32_t indice = 0; indice < qtdRadioGroup; indice++) {
-            if (!arrayRadioGroup[indice]->showingMyScreen()) continue;
-            arrayRadioGroup[indice]->redraw();
-        }
-    }
-#endif
-}
-
-/**
- * @brief Updates rect buttons
- */
-void DisplayFK::updateRectButton() {
-#ifdef DFK_RECTBTN
-    if (m_rectButtonConfigured) {
-        for (uint32_t indice = 0; indice < qtdRectBtn; indice++) {
-            if (!arrayRectBtn[indice]->showingMyScreen()) continue;
-            arrayRectBtn[indice]->redraw();
-        }
-    }
-#endif
-}
-
-/**
- * @brief Updates toggles (optimized for current screen)
- */
-void DisplayFK::updateToggle() {
-#ifdef DFK_TOGGLE
-    if (!m_toggleConfigured) return;
-    
-    for (uint32_t indice = 0; indice < qtdToggle; indice++) {
-        // Skip widgets not on current screen
-        if (!arrayToggleBtn[indice]->showingMyScreen()) continue;
-        
-        arrayToggleBtn[indice]->redraw();
-    }
-#endif
-}
-
-
-/**
- * @brief Updates images
- */
-void DisplayFK::updateImage() {
-#ifdef DFK_IMAGE
-    if (m_imageConfigured) {
-		for (uint32_t indice = 0; indice < qtdImage; indice++) {
-            if (!arrayImage[indice]->showingMyScreen()) continue;
-            arrayImage[indice]->drawBackground();
-        }
-        for (uint32_t indice = 0; indice < qtdImage; indice++) {
-            if (!arrayImage[indice]->showingMyScreen()) continue;
-            arrayImage[indice]->draw();
-        }
-    }
-#endif
-}
-
-/**
- * @brief Updates text buttons
- */
-void DisplayFK::updateTextButton() {
-#ifdef DFK_TEXTBUTTON
-    if (m_textButtonConfigured) {
-        for (uint32_t indice = 0; indice < qtdTextButton; indice++) {
-            if (!arrayTextButton[indice]->showingMyScreen()) continue;
-            arrayTextButton[indice]->redraw();
-        }
-    }
-#endif
-}
-
-/**
- * @brief Updates spinboxes
- */
-void DisplayFK::updateSpinbox() {
-#ifdef DFK_SPINBOX
-    if (m_spinboxConfigured) {
-        for (uint32_t indice = 0; indice < qtdSpinbox; indice++) {
-            if (!arraySpinbox[indice]->showingMyScreen()) continue;
-            arraySpinbox[indice]->redraw();
-        }
-    }
-#endif
-}
-
-/**
- * @brief Updates text boxes
- */
-void DisplayFK::updateTextBox() {
-#ifdef DFK_TEXTBOX
-    if (m_textboxConfigured) {
-        for (uint32_t indice = 0; indice < qtdTextBox; indice++) {
-            if (!arrayTextBox[indice]->showingMyScreen()) continue;
-            arrayTextBox[indice]->redraw();
-        }
-    }
-#endif
-}
-
-void DisplayFK::updateNumberBox(){
-    #ifdef DFK_NUMBERBOX
-    if (m_numberboxConfigured) {
-        for (uint32_t indice = 0; indice < qtdNumberBox; indice++) {
-            if (!arrayNumberbox[indice]->showingMyScreen()) continue;
-            arrayNumberbox[indice]->redraw();
-        }
-    }
-#endif
-}
 
 void DisplayFK::setupAutoClick(uint32_t intervalMs, uint16_t x, uint16_t y) {
     // Robust input validation
@@ -3812,6 +3441,7 @@ void DisplayFK::timerCallback(TimerHandle_t xTimer) {
     DisplayFK *instance = reinterpret_cast<DisplayFK *>(pvTimerGetTimerID(xTimer));
     if (instance) {
         instance->m_simulateAutoClick = true;
+        WidgetBase::requestFrame();
     }
 }
 
@@ -4023,26 +3653,17 @@ bool DisplayFK::setCheckboxSafe(CheckBox *array[], uint8_t amount) {
         return false;
     }
     
-    // Store original state for rollback
-    bool originalConfigured = m_checkboxConfigured;
-    CheckBox** originalArray = arrayCheckbox;
-    uint8_t originalAmount = qtdCheckbox;
-    
     // Configure with validation
     m_checkboxConfigured = true;
-    arrayCheckbox = array;
-    qtdCheckbox = amount;
+    uint8_t registered = registerWidgets(WidgetType::CHECKBOX, array, amount);
     
     // Validate configuration was successful
-    if (m_checkboxConfigured && arrayCheckbox == array && qtdCheckbox == amount) {
+    if (registered == amount) {
         ESP_LOGD(TAG, "Checkbox array configured safely with %d elements", amount);
         return true;
     } else {
-        ESP_LOGE(TAG, "Checkbox configuration failed, rolling back");
-        // Rollback on failure
-        m_checkboxConfigured = originalConfigured;
-        arrayCheckbox = originalArray;
-        qtdCheckbox = originalAmount;
+        // Widgets already registered stay usable, only the missing ones are reported
+        ESP_LOGE(TAG, "Checkbox configuration incomplete: %d of %d registered", registered, amount);
         return false;
     }
 }
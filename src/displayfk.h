@@ -76,8 +76,13 @@
 #include <esp_task_wdt.h>
 #endif
 #include "extras/check_version.h"
+#include "extras/dirtyregion.h"
+#include "extras/framebuffercanvas.h"
+#include "extras/framescheduler.h"
 
 #include "widgets/widgetbase.h"
+#include "widgets/widgetregistry.h"
+#include "widgets/hitgrid.h"
 
 #include "touch_widgets.h"
 #include "output_widgets.h"
@@ -135,6 +140,14 @@ static const lcd_init_cmd_t st7701_init_operations[] = {
  */
 #define MAX_LINE_LENGTH (64)
 
+#ifndef DFK_TOUCH_POLL_MS
+#define DFK_TOUCH_POLL_MS (20) ///< Touch polling interval while idle when the touch INT pin is not used.
+#endif
+
+#ifndef DFK_IDLE_MAX_SLEEP_MS
+#define DFK_IDLE_MAX_SLEEP_MS (1000) ///< Longest time the UI task sleeps without any event.
+#endif
+
 /**
  * @brief Length of the log queue buffer
  */
@@ -360,6 +373,7 @@ public:
     void startCustomDraw();
     void finishCustomDraw();
     void drawWidgetsOnScreen(const uint8_t currentScreenIndex);
+    bool addWidget(WidgetBase *widget);
 #if defined(USING_GRAPHIC_LIB)
     void setFontNormal(const GFXfont *_font);
     void setFontBold(const GFXfont *_font);
@@ -378,6 +392,25 @@ public:
     bool isRunningAutoClick() const;
     void blockLoopTask();
     void freeLoopTask();
+    const DirtyRegion &getFrameDamage() const;
+    void enableEventDrivenIdle(int8_t touchIntPin = -1, uint16_t touchPollMs = DFK_TOUCH_POLL_MS);
+    void disableEventDrivenIdle();
+    void setTargetFps(uint8_t fps, uint32_t budgetUs = 0);
+    const FrameStats_t &getFrameStats() const;
+    void resetFrameStats();
+    bool enableImageCache(uint32_t maxBytes = DFK_IMAGE_CACHE_BYTES, uint16_t maxEntries = DFK_IMAGE_CACHE_ENTRIES);
+    void disableImageCache();
+#if defined(DISP_DEFAULT)
+    bool enableStripeRendering(uint16_t width = DFK_STRIPE_WIDTH, uint16_t height = DFK_STRIPE_HEIGHT);
+    void disableStripeRendering();
+    bool enableGlyphCache(uint32_t maxBytes = DFK_GLYPH_CACHE_BYTES, uint16_t maxEntries = DFK_GLYPH_CACHE_ENTRIES);
+    void disableGlyphCache();
+    bool enableTextMetricsCache(uint16_t slots = DFK_TEXT_METRICS_SLOTS);
+    void disableTextMetricsCache();
+    bool enableShadowBuffer(uint16_t *panelBuffer);
+    void disableShadowBuffer();
+    bool isShadowBuffered() const;
+#endif
 
     // Memory management utilities
     void freeStringFromPool(const char *str);
@@ -593,114 +626,78 @@ private:
 #endif
 
 #if defined(DFK_TOUCHAREA)
-    uint8_t qtdTouchArea = 0;             ///< Number of TouchArea widgets.
-    TouchArea **arrayTouchArea = nullptr; ///< Array of TouchArea widgets.
     bool m_touchAreaConfigured = false;   ///< Flag indicating if TouchArea is configured.
 #endif
 
 #ifdef DFK_CHECKBOX
-    uint8_t qtdCheckbox = 0;            ///< Number of CheckBox widgets.
-    CheckBox **arrayCheckbox = nullptr; ///< Array of CheckBox widgets.
     bool m_checkboxConfigured = false;  ///< Flag indicating if CheckBox is configured.
 #endif
 
 #ifdef DFK_CIRCLEBTN
-    uint8_t qtdCircleBtn = 0;                ///< Number of CircleButton widgets.
-    CircleButton **arrayCircleBtn = nullptr; ///< Array of CircleButton widgets.
     bool m_circleButtonConfigured = false;   ///< Flag indicating if CircleButton is configured.
 #endif
 
 #ifdef DFK_GAUGE
-    uint8_t qtdGauge = 0;              ///< Number of GaugeSuper widgets.
-    GaugeSuper **arrayGauge = nullptr; ///< Array of GaugeSuper widgets.
     bool m_gaugeConfigured = false;    ///< Flag indicating if GaugeSuper is configured.
 #endif
 
 #ifdef DFK_CIRCULARBAR
-    uint8_t qtdCircularBar = 0;               ///< Number of CircularBar widgets.
-    CircularBar **arrayCircularBar = nullptr; ///< Array of CircularBar widgets.
     bool m_circularBarConfigured = false;     ///< Flag indicating if CircularBar is configured.
 #endif
 
 #ifdef DFK_HSLIDER
-    uint8_t qtdHSlider = 0;           ///< Number of HSlider widgets.
-    HSlider **arrayHSlider = nullptr; ///< Array of HSlider widgets.
     bool m_hSliderConfigured = false; ///< Flag indicating if HSlider is configured.
 #endif
 
 #ifdef DFK_LABEL
-    uint8_t qtdLabel = 0;           ///< Number of Label widgets.
-    Label **arrayLabel = nullptr;   ///< Array of Label widgets.
     bool m_labelConfigured = false; ///< Flag indicating if Label is configured.
 #endif
 
 #ifdef DFK_LED
-    uint8_t qtdLed = 0;           ///< Number of Led widgets.
-    Led **arrayLed = nullptr;     ///< Array of Led widgets.
     bool m_ledConfigured = false; ///< Flag indicating if Led is configured.
 #endif
 
 #ifdef DFK_LINECHART
-    uint8_t qtdLineChart = 0;             ///< Number of LineChart widgets.
-    LineChart **arrayLineChart = nullptr; ///< Array of LineChart widgets.
     bool m_lineChartConfigured = false;   ///< Flag indicating if LineChart is configured.
 #endif
 
 #ifdef DFK_RADIO
-    uint8_t qtdRadioGroup = 0;              ///< Number of RadioGroup widgets.
-    RadioGroup **arrayRadioGroup = nullptr; ///< Array of RadioGroup widgets.
     bool m_radioGroupConfigured = false;    ///< Flag indicating if RadioGroup is configured.
 #endif
 
 #ifdef DFK_RECTBTN
-    uint8_t qtdRectBtn = 0;              ///< Number of RectButton widgets.
-    RectButton **arrayRectBtn = nullptr; ///< Array of RectButton widgets.
     bool m_rectButtonConfigured = false; ///< Flag indicating if RectButton is configured.
 #endif
 
 #ifdef DFK_TOGGLE
-    uint8_t qtdToggle = 0;                   ///< Number of ToggleButton widgets.
-    ToggleButton **arrayToggleBtn = nullptr; ///< Array of ToggleButton widgets.
     bool m_toggleConfigured = false;         ///< Flag indicating if ToggleButton is configured.
 #endif
 
 #ifdef DFK_VBAR
-    uint8_t qtdVBar = 0;           ///< Number of VBar widgets.
-    VBar **arrayVBar = nullptr;    ///< Array of VBar widgets.
     bool m_vBarConfigured = false; ///< Flag indicating if VBar is configured.
 #endif
 
 #ifdef DFK_VANALOG
-    uint8_t qtdVAnalog = 0;           ///< Number of VAnalog widgets.
-    VAnalog **arrayVAnalog = nullptr; ///< Array of VAnalog widgets.
     bool m_vAnalogConfigured = false; ///< Flag indicating if VAnalog is configured.
 #endif
 
 #ifdef DFK_TEXTBOX
-    uint8_t qtdTextBox = 0;              ///< Number of TextBox widgets.
-    TextBox **arrayTextBox = nullptr;    ///< Array of TextBox widgets.
     bool m_textboxConfigured = false;    ///< Flag indicating if TextBox is configured.
     std::unique_ptr<WKeyboard> keyboard; ///< Pointer to the WKeyboard instance for text input.
     // WKeyboard m_pKeyboard;            ///< Internal keyboard instance for TextBox.
 #endif
 
 #ifdef DFK_NUMBERBOX
-    uint8_t qtdNumberBox = 0;             ///< Number of NumberBox widgets.
-    NumberBox **arrayNumberbox = nullptr; ///< Array of NumberBox widgets.
     bool m_numberboxConfigured = false;   ///< Flag indicating if NumberBox is configured.
     std::unique_ptr<Numpad> numpad;       ///< Pointer to the Numpad instance for number input.
     // Numpad m_pNumpad;                   ///< Internal numpad instance for NumberBox.
 #endif
 
 #ifdef DFK_IMAGE
-    uint8_t qtdImage = 0;           ///< Number of Image widgets.
-    Image **arrayImage = nullptr;   ///< Array of Image widgets.
     bool m_imageConfigured = false; ///< Flag indicating if Image is configured.
 #endif
 
 #ifdef DFK_TEXTBUTTON
-    uint8_t qtdTextButton = 0;              ///< Number of TextButton widgets.
-    TextButton **arrayTextButton = nullptr; ///< Array of TextButton widgets.
     bool m_textButtonConfigured = false;    ///< Flag indicating if TextButton is configured.
 #endif
 
@@ -710,14 +707,10 @@ private:
 #endif
 
 #ifdef DFK_SPINBOX
-    uint8_t qtdSpinbox = 0;           ///< Number of SpinBox widgets.
-    SpinBox **arraySpinbox = nullptr; ///< Array of SpinBox widgets.
     bool m_spinboxConfigured = false; ///< Flag indicating if SpinBox is configured.
 #endif
 
 #ifdef DFK_THERMOMETER
-    uint8_t qtdThermometer = 0;               ///< Number of Thermometer widgets.
-    Thermometer **arrayThermometer = nullptr; ///< Array of Thermometer widgets.
     bool m_thermometerConfigured = false;     ///< Flag indicating if Thermometer is configured.
 #endif
 
@@ -728,6 +721,34 @@ private:
 
     functionLoadScreen_t m_lastScreen = nullptr;
 
+    // Damage tracking
+    DirtyRegion m_damage;                                 ///< Screen areas painted so far in the frame; decides which widgets above repaint.
+
+    // Frame pacing
+    FrameScheduler m_scheduler;                           ///< Target FPS, frame budget and frame statistics.
+
+    bool deferRedraw(WidgetBase *widget);
+
+    // Event-driven idle
+    bool m_idleEnabled = false;                           ///< True if the UI task sleeps until there is work.
+    int8_t m_touchIntPin = -1;                            ///< Touch INT pin used to wake the UI task (-1 = poll).
+    uint16_t m_touchPollMs = DFK_TOUCH_POLL_MS;           ///< Touch polling interval while idle without INT pin.
+    uint8_t m_pendingRedraws = 0;                         ///< Widgets still dirty after the last frame (debounce, deferral).
+
+    bool hasPendingWork() const;
+    void waitNextIteration();
+
+#if defined(DISP_DEFAULT)
+    // Shadow buffer
+    FrameBufferCanvas *m_shadowBuffer = nullptr; ///< Shadow buffer used as draw object while enabled.
+    Arduino_GFX *m_panelDisplay = nullptr;       ///< Real display that receives the presented frames.
+    uint16_t *m_panelBuffer = nullptr;           ///< Panel framebuffer, read back after direct drawing.
+    volatile bool m_panelChanged = false;        ///< True if the panel was drawn directly and the shadow buffer is stale.
+
+    void presentFrame();
+    void syncShadowBuffer();
+#endif
+
     // Métodos privados estáticos
     static void timerCallback(TimerHandle_t xTimer);
 
@@ -743,19 +764,54 @@ private:
     void updateWidgets();
     void processCallback();
 
+    // Widget registry
+    WidgetRegistry m_registry;                            ///< Widgets of every screen, grouped per screen in paint order.
+
+    // Touch hit-test index
+    HitGrid m_hitGrid;                                    ///< Touch areas of the current screen, bucketed in cells.
+    uint8_t m_hitGridScreen = 0;                          ///< Screen the grid was built for.
+    uint32_t m_hitGridRegistryRev = 0;                    ///< Registry revision the grid was built for.
+    uint32_t m_hitGridLayoutRev = 0;                      ///< WidgetBase::layoutRevision the grid was built for.
+    void rebuildHitGrid();
+    bool hitGridIsCurrent() const;
+
+    bool canRegisterWidgets() const;
+
+    // Stacking
+    uint32_t m_stackRevision = 0;                         ///< WidgetBase::stackRevision the registry was sorted for.
+    void syncStackOrder();
+    bool isOccluded(const WidgetSpan_t &span, uint16_t index) const;
+
+    /**
+     * @brief Adds every widget of a typed array to the registry
+     * @param type Kind of the widgets
+     * @param array Array of widgets of a single type
+     * @param amount Number of widgets in the array
+     * @return Number of widgets actually registered (0 once the UI task is running)
+     */
+    template <typename T>
+    uint8_t registerWidgets(WidgetType type, T **array, uint8_t amount)
+    {
+        if (!canRegisterWidgets()) {
+            return 0;
+        }
+        uint8_t registered = 0;
+        for (uint32_t indice = 0; indice < amount; indice++) {
+            if (m_registry.add(array[indice], type)) {
+                registered++;
+            }
+        }
+        return registered;
+    }
+
     // Touch processing functions
-    void processCheckboxTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode = false);
-    void processCircleButtonTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode = false);
-    void processHSliderTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode = false);
-    void processRadioGroupTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode = false);
-    void processRectButtonTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode = false);
-    void processImageTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode = false);
-    void processSpinboxTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode = false);
-    void processToggleTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode = false);
-    void processTextButtonTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode = false);
-    void processTextBoxTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode = false);
-    void processNumberBoxTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode = false);
-    void processEmptyAreaTouch(uint16_t xTouch, uint16_t yTouch, bool collectMode = false);
+    bool processWidgetTouch(WidgetBase *widget, WidgetType type, uint16_t xTouch, uint16_t yTouch, bool collectMode);
+#ifdef DFK_TEXTBOX
+    void processTextBoxTouch(TextBox *textbox, bool collectMode);
+#endif
+#ifdef DFK_NUMBERBOX
+    void processNumberBoxTouch(NumberBox *numberbox, bool collectMode);
+#endif
 
 #ifdef ENABLE_ON_RELEASE
     // Touch tracking helper methods
@@ -765,27 +821,6 @@ private:
     void checkWidgetsStillTouched(uint16_t xTouch, uint16_t yTouch);
     void clearTouchedWidgets(bool callOnRelease = true);
 #endif
-
-    // Widget update functions
-    void updateCircularBar();
-    void updateGauge();
-    void updateLabel();
-    void updateLed();
-    void updateLineChart();
-    void updateVBar();
-    void updateVAnalog();
-    void updateCheckbox();
-    void updateCircleButton();
-    void updateHSlider();
-    void updateRadioGroup();
-    void updateRectButton();
-    void updateToggle();
-    void updateImage();
-    void updateTextButton();
-    void updateSpinbox();
-    void updateTextBox();
-    void updateNumberBox();
-    void updateThermometer();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,140 @@
+// aafont.cpp
+#include "aafont.h"
+
+#if defined(DISP_DEFAULT)
+
+uint16_t AAFontRenderer::m_lut[16];
+uint16_t AAFontRenderer::m_lutColor = 0;
+uint16_t AAFontRenderer::m_lutBg = 0;
+bool AAFontRenderer::m_lutValid = false;
+
+/**
+ * @brief Gets the 16 colors between a background and a text color.
+ * @param color Text color (RGB565), used for coverage 15.
+ * @param bgColor Background color (RGB565), used for coverage 0.
+ * @return Table indexed by coverage. It stays valid until the next call with other colors.
+ */
+const uint16_t *AAFontRenderer::blendTable(uint16_t color, uint16_t bgColor) {
+    if (m_lutValid && m_lutColor == color && m_lutBg == bgColor) {
+        return m_lut;
+    }
+    const int16_t fr = (color >> 11) & 0x1F, fg = (color >> 5) & 0x3F, fb = color & 0x1F;
+    const int16_t br = (bgColor >> 11) & 0x1F, bg = (bgColor >> 5) & 0x3F, bb = bgColor & 0x1F;
+    for (int16_t level = 0; level < 16; level++) {
+        const int16_t r = (fr * level + br * (15 - level) + 7) / 15;
+        const int16_t g = (fg * level + bg * (15 - level) + 7) / 15;
+        const int16_t b = (fb * level + bb * (15 - level) + 7) / 15;
+        m_lut[level] = static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+    m_lutColor = color;
+    m_lutBg = bgColor;
+    m_lutValid = true;
+    return m_lut;
+}
+
+/**
+ * @brief Draws a string.
+ * @param gfx Display (or canvas) to draw on.
+ * @param font Anti-aliased font.
+ * @param x Cursor X of the first character.
+ * @param y Baseline of the first line.
+ * @param text String to draw. '\n' starts a new line at x.
+ * @param color Text color.
+ * @param bgColor Color already painted behind the text.
+ * @return Cursor X after the last character.
+ */
+int16_t AAFontRenderer::drawText(Arduino_GFX *gfx, const AAFont *font, int16_t x, int16_t y,
+                                 const char *text, uint16_t color, uint16_t bgColor) {
+    if (!gfx || !font || !text) {
+        return x;
+    }
+    const uint16_t *lut = blendTable(color, bgColor);
+    const int16_t startX = x;
+
+    gfx->startWrite();
+    for (const char *p = text; *p; p++) {
+        uint8_t c = static_cast<uint8_t>(*p);
+        if (c == '\n') {
+            x = startX;
+            y += font->yAdvance;
+            continue;
+        }
+        if (c == '\r' || c < font->first || c > font->last) {
+            continue;
+        }
+        const GFXglyph *glyph = &font->glyph[c - font->first];
+        const uint8_t *bits = font->bitmap + glyph->bitmapOffset;
+        const int16_t gx = x + glyph->xOffset;
+        int16_t gy = y + glyph->yOffset;
+        uint32_t pixel = 0;
+
+        for (uint8_t row = 0; row < glyph->height; row++, gy++) {
+            uint8_t spanLevel = 0;
+            uint8_t spanStart = 0;
+            for (uint8_t col = 0; col < glyph->width; col++, pixel++) {
+                const uint8_t packed = bits[pixel >> 1];
+                const uint8_t level = (pixel & 1) ? (packed & 0x0F) : (packed >> 4);
+                if (level != spanLevel) {
+                    if (spanLevel) {
+                        gfx->writeFastHLine(gx + spanStart, gy, col - spanStart, lut[spanLevel]);
+                    }
+                    spanLevel = level;
+                    spanStart = col;
+                }
+            }
+            if (spanLevel) {
+                gfx->writeFastHLine(gx + spanStart, gy, glyph->width - spanStart, lut[spanLevel]);
+            }
+        }
+        x += glyph->xAdvance;
+    }
+    gfx->endWrite();
+    return x;
+}
+
+/**
+ * @brief Gets the box covered by a string.
+ * @param font Anti-aliased font.
+ * @param text String to measure.
+ * @param x Cursor X of the first character.
+ * @param y Baseline of the first line.
+ * @return Box of all glyph bitmaps (width and height are 0 if nothing is drawn).
+ */
+TextBound_t AAFontRenderer::getTextBounds(const AAFont *font, const char *text, int16_t x, int16_t y) {
+    TextBound_t result = {x, y, 0, 0};
+    if (!font || !text) {
+        return result;
+    }
+    const int16_t startX = x;
+    int16_t minX = 0x7FFF, minY = 0x7FFF, maxX = -0x7FFF, maxY = -0x7FFF;
+    for (const char *p = text; *p; p++) {
+        uint8_t c = static_cast<uint8_t>(*p);
+        if (c == '\n') {
+            x = startX;
+            y += font->yAdvance;
+            continue;
+        }
+        if (c == '\r' || c < font->first || c > font->last) {
+            continue;
+        }
+        const GFXglyph *glyph = &font->glyph[c - font->first];
+        if (glyph->width > 0 && glyph->height > 0) {
+            const int16_t x1 = x + glyph->xOffset;
+            const int16_t y1 = y + glyph->yOffset;
+            if (x1 < minX) minX = x1;
+            if (y1 < minY) minY = y1;
+            if (x1 + glyph->width - 1 > maxX) maxX = x1 + glyph->width - 1;
+            if (y1 + glyph->height - 1 > maxY) maxY = y1 + glyph->height - 1;
+        }
+        x += glyph->xAdvance;
+    }
+    if (maxX >= minX && maxY >= minY) {
+        result.x = minX;
+        result.y = minY;
+        result.width = static_cast<uint16_t>(maxX - minX + 1);
+        result.height = static_cast<uint16_t>(maxY - minY + 1);
+    }
+    return result;
+}
+
+#endif // DISP_DEFAULT
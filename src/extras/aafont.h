@@ -0,0 +1,46 @@
+// aafont.h
+#ifndef AAFONT_H
+#define AAFONT_H
+
+#include <stdint.h>
+#include "../widgets/widgetsetup.h"
+#include "baseTypes.h"
+
+#if defined(DISP_DEFAULT)
+#include <Arduino_GFX_Library.h>
+
+/// @brief Anti-aliased font with 4 bits of coverage per pixel.
+/// @details Same layout as GFXfont, generated by src/fonts/aafontconvert.py. Glyph records are
+///          GFXglyph; the bitmap of each glyph starts on a byte boundary and stores its pixels
+///          row by row, two per byte (high nibble first). A nibble is the coverage of the pixel,
+///          0 = background and 15 = text color.
+typedef struct {
+    const uint8_t *bitmap;  ///< Coverage of all glyphs, 4 bits per pixel.
+    const GFXglyph *glyph;  ///< Glyph records, from first to last.
+    uint16_t first;         ///< First character code.
+    uint16_t last;          ///< Last character code.
+    uint8_t yAdvance;       ///< Distance between baselines.
+} AAFont;
+
+/// @brief Draws AAFont text blended against a known background color.
+/// @details Widgets know the color behind their text, so the 16 coverage levels are turned into
+///          16 RGB565 colors once per (text, background) pair and no pixel is read back from the
+///          display. Each glyph row is sent as spans of equal coverage with writeFastHLine();
+///          pixels with coverage 0 are left untouched, so the background must be painted first.
+class AAFontRenderer {
+public:
+    static int16_t drawText(Arduino_GFX *gfx, const AAFont *font, int16_t x, int16_t y,
+                            const char *text, uint16_t color, uint16_t bgColor);
+    static TextBound_t getTextBounds(const AAFont *font, const char *text, int16_t x, int16_t y);
+    static const uint16_t *blendTable(uint16_t color, uint16_t bgColor);
+
+private:
+    static uint16_t m_lut[16];    ///< Colors of the 16 coverage levels for m_lutColor over m_lutBg.
+    static uint16_t m_lutColor;   ///< Text color of m_lut.
+    static uint16_t m_lutBg;      ///< Background color of m_lut.
+    static bool m_lutValid;       ///< m_lut was built at least once.
+};
+
+#endif // DISP_DEFAULT
+
+#endif // AAFONT_H
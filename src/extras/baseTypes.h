@@ -79,5 +79,12 @@ enum class Orientation
   HORIZONTAL = 2 ///< Horizontal orientation.
 };
 
+/// @brief Redraw priority used by the frame scheduler.
+enum class RedrawPriority
+{
+  DEFERRABLE = 0, ///< May be postponed to the next frame when the frame budget is spent.
+  NORMAL = 1      ///< Always redrawn in the frame it was invalidated.
+};
+
 #endif
 
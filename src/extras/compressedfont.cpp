@@ -0,0 +1,116 @@
+// compressedfont.cpp
+#include "compressedfont.h"
+
+#if defined(DISP_DEFAULT)
+#include <esp_log.h>
+#include "gfxtextstate.h"
+
+const char *CompressedFont::TAG = "CompressedFont";
+
+const GFXfont *CompressedFont::m_fonts[DFK_COMPRESSED_FONTS_MAX] = {};
+
+/**
+ * @brief Registers a font generated by fontcompress.py.
+ * @param font Compressed font.
+ * @return false if the table is full.
+ */
+bool CompressedFont::add(const GFXfont *font) {
+    if (!font || contains(font)) {
+        return font != nullptr;
+    }
+    for (uint8_t i = 0; i < DFK_COMPRESSED_FONTS_MAX; i++) {
+        if (!m_fonts[i]) {
+            m_fonts[i] = font;
+            return true;
+        }
+    }
+    ESP_LOGE(TAG, "Too many compressed fonts (DFK_COMPRESSED_FONTS_MAX = %d)", DFK_COMPRESSED_FONTS_MAX);
+    return false;
+}
+
+/**
+ * @brief Unregisters a font.
+ */
+void CompressedFont::remove(const GFXfont *font) {
+    for (uint8_t i = 0; i < DFK_COMPRESSED_FONTS_MAX; i++) {
+        if (m_fonts[i] == font) {
+            m_fonts[i] = nullptr;
+        }
+    }
+}
+
+/**
+ * @brief Checks if a font was registered as compressed.
+ */
+bool CompressedFont::contains(const GFXfont *font) {
+    if (!font) {
+        return false;
+    }
+    for (uint8_t i = 0; i < DFK_COMPRESSED_FONTS_MAX; i++) {
+        if (m_fonts[i] == font) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Prints a string at the cursor of a display, decoding every glyph.
+ * @param gfx Display (or canvas) whose font must be a registered compressed font.
+ * @param text Text to print.
+ * @return false if the current font is not compressed (nothing is drawn).
+ * @details Follows Arduino_GFX for the cursor, text size and wrap. The background color is
+ *          not painted: compressed text is always transparent.
+ */
+bool CompressedFont::print(Arduino_GFX *gfx, const char *text) {
+    if (!gfx || !text) {
+        return false;
+    }
+    const GFXfont *font = GfxTextState::font(gfx);
+    if (!contains(font)) {
+        return false;
+    }
+    const uint16_t color = GfxTextState::color(gfx);
+    const int16_t sizeX = GfxTextState::sizeX(gfx);
+    const int16_t sizeY = GfxTextState::sizeY(gfx);
+    const bool wrap = GfxTextState::wraps(gfx);
+    const int16_t width = gfx->width();
+    int16_t x = GfxTextState::cursorX(gfx);
+    int16_t y = GfxTextState::cursorY(gfx);
+
+    gfx->startWrite();
+    for (const char *p = text; *p; p++) {
+        uint8_t c = static_cast<uint8_t>(*p);
+        if (c == '\n') {
+            x = 0;
+            y += font->yAdvance * sizeY;
+            continue;
+        }
+        if (c == '\r' || c < font->first || c > font->last) {
+            continue;
+        }
+        const GFXglyph *glyph = &font->glyph[c - font->first];
+        if (glyph->width > 0 && glyph->height > 0) {
+            if (wrap && (x + sizeX * (glyph->xOffset + glyph->width)) > width) {
+                x = 0;
+                y += font->yAdvance * sizeY;
+            }
+            const int16_t gx = x + glyph->xOffset * sizeX;
+            const int16_t gy = y + glyph->yOffset * sizeY;
+            forEachRun(font, glyph, [&](uint8_t row, uint8_t runX, uint8_t length) {
+                if (sizeX == 1 && sizeY == 1) {
+                    gfx->writeFastHLine(gx + runX, gy + row, length, color);
+                } else {
+                    gfx->writeFillRect(gx + runX * sizeX, gy + row * sizeY, length * sizeX, sizeY, color);
+                }
+            });
+        }
+        x += glyph->xAdvance * sizeX;
+    }
+    gfx->endWrite();
+
+    gfx->setCursor(x, y);
+    return true;
+}
+
+#endif // DISP_DEFAULT
@@ -0,0 +1,89 @@
+// compressedfont.h
+#ifndef COMPRESSEDFONT_H
+#define COMPRESSEDFONT_H
+
+#include <stdint.h>
+#include "../widgets/widgetsetup.h"
+
+#if defined(DISP_DEFAULT)
+#include <Arduino_GFX_Library.h>
+
+#ifndef DFK_COMPRESSED_FONTS_MAX
+#define DFK_COMPRESSED_FONTS_MAX 16 ///< Number of compressed fonts that can be registered.
+#endif
+
+/// @brief GFXfont whose glyph bitmaps are stored as row runs instead of raw bits.
+/// @details Fonts are converted by src/fonts/fontcompress.py and keep the GFXfont type, so
+///          glyph metrics (getTextBounds(), datum alignment) work unchanged. Only the bitmap
+///          stream differs, so Arduino_GFX can't draw them: register each one with add() and
+///          text printed through WidgetBase::writeText() is decoded here, or by the glyph cache
+///          when it is enabled (decoded once, then drawn from RAM).
+///
+///          Stream of a glyph (starting at GFXglyph::bitmapOffset), one token per row:
+///          - 0x00-0x7F: n = number of runs in the row, followed by n pairs (gap, length) in
+///            bytes; gap counts the clear pixels before the run (from the end of the previous
+///            run, or from the row start).
+///          - 0x80-0xBF: the previous row is repeated (token - 0x7F) times.
+///          - 0xC0: same runs as the previous row, each moved by a nibble (two high bits: start
+///            delta + 2, two low bits: end delta + 2, so -2..+1), two runs per byte.
+///          Vertical strokes become repeats and curves become deltas, which is where a 1-bit
+///          bitmap of a large font spends its flash.
+class CompressedFont {
+public:
+    static bool add(const GFXfont *font);
+    static void remove(const GFXfont *font);
+    static bool contains(const GFXfont *font);
+    static bool print(Arduino_GFX *gfx, const char *text);
+
+    /**
+     * @brief Decodes a glyph into horizontal runs.
+     * @param font Compressed font.
+     * @param glyph Glyph record of the font.
+     * @param onRun Called with (row, x, length) for every run, row by row.
+     */
+    template <typename Fn>
+    static void forEachRun(const GFXfont *font, const GFXglyph *glyph, Fn onRun) {
+        const uint8_t *p = font->bitmap + glyph->bitmapOffset;
+        uint8_t starts[0x80];
+        uint8_t ends[0x80];
+        uint8_t count = 0;
+        uint8_t row = 0;
+        while (row < glyph->height) {
+            const uint8_t token = *p++;
+            uint8_t repeat = 1;
+            if (token < 0x80) {
+                count = token;
+                uint8_t x = 0;
+                for (uint8_t i = 0; i < count; i++) {
+                    x += *p++;
+                    starts[i] = x;
+                    x += *p++;
+                    ends[i] = x;
+                }
+            } else if (token < 0xC0) {
+                repeat = static_cast<uint8_t>(token - 0x7F);
+            } else {
+                for (uint8_t i = 0; i < count; i++) {
+                    const uint8_t nibble = (i & 1) ? (p[i >> 1] & 0x0F) : (p[i >> 1] >> 4);
+                    starts[i] += (nibble >> 2) - 2;
+                    ends[i] += (nibble & 0x03) - 2;
+                }
+                p += (count + 1) >> 1;
+            }
+            for (; repeat > 0 && row < glyph->height; repeat--, row++) {
+                for (uint8_t i = 0; i < count; i++) {
+                    onRun(row, starts[i], static_cast<uint8_t>(ends[i] - starts[i]));
+                }
+            }
+        }
+    }
+
+private:
+    static const char *TAG; ///< Tag estática para identificação em logs.
+
+    static const GFXfont *m_fonts[DFK_COMPRESSED_FONTS_MAX]; ///< Registered fonts (nullptr = free).
+};
+
+#endif // DISP_DEFAULT
+
+#endif // COMPRESSEDFONT_H
@@ -0,0 +1,234 @@
+// dirtyregion.cpp
+#include "dirtyregion.h"
+
+/**
+ * @brief Default constructor. Initializes an empty region.
+ */
+DirtyRegion::DirtyRegion() : m_rects{}, m_count(0) {}
+
+/**
+ * @brief Removes every rectangle from the region.
+ */
+void DirtyRegion::clear() {
+    m_count = 0;
+}
+
+/**
+ * @brief Adds a rectangle given by signed coordinates.
+ * @param x X coordinate (may be negative; the part outside the screen is dropped).
+ * @param y Y coordinate (may be negative; the part outside the screen is dropped).
+ * @param width Width of the rectangle.
+ * @param height Height of the rectangle.
+ */
+void DirtyRegion::add(int32_t x, int32_t y, int32_t width, int32_t height) {
+    if (x < 0) { width += x; x = 0; }
+    if (y < 0) { height += y; y = 0; }
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    if (x > 0xFFFF || y > 0xFFFF) {
+        return;
+    }
+    if (x + width > 0xFFFF) { width = 0xFFFF - x; }
+    if (y + height > 0xFFFF) { height = 0xFFFF - y; }
+
+    Rect_t r = {static_cast<uint16_t>(x), static_cast<uint16_t>(y),
+                static_cast<uint16_t>(width), static_cast<uint16_t>(height)};
+    add(r);
+}
+
+/**
+ * @brief Adds a rectangle to the region, coalescing it with the existing ones.
+ * @param rect Rectangle to add. Empty rectangles are ignored.
+ */
+void DirtyRegion::add(const Rect_t &rect) {
+    if (rect.width == 0 || rect.height == 0) {
+        return;
+    }
+
+    Rect_t pending = rect;
+
+    for (;;) {
+        // Merge until the pending rectangle no longer touches anything in the list.
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (uint8_t i = 0; i < m_count; i++) {
+                if (contains(m_rects[i], pending)) {
+                    return;
+                }
+                if (touches(m_rects[i], pending)) {
+                    pending = unite(m_rects[i], pending);
+                    removeAt(i);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+        if (m_count < DIRTY_REGION_MAX_RECTS) {
+            break;
+        }
+        // The merged pair may now reach the pending rectangle, check it again
+        mergeCheapestPair();
+    }
+    m_rects[m_count++] = pending;
+}
+
+/**
+ * @brief Checks if the region has no rectangles.
+ * @return true if nothing was damaged.
+ */
+bool DirtyRegion::isEmpty() const {
+    return m_count == 0;
+}
+
+/**
+ * @brief Checks if a rectangle overlaps any damaged area.
+ * @param rect Rectangle to test.
+ * @return true if at least one rectangle of the region overlaps rect.
+ */
+bool DirtyRegion::intersects(const Rect_t &rect) const {
+    for (uint8_t i = 0; i < m_count; i++) {
+        if (overlaps(m_rects[i], rect)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Gets the number of coalesced rectangles.
+ * @return Number of rectangles in the region.
+ */
+uint8_t DirtyRegion::count() const {
+    return m_count;
+}
+
+/**
+ * @brief Gets a rectangle of the region.
+ * @param index Index between 0 and count() - 1.
+ * @return Reference to the rectangle.
+ */
+const Rect_t &DirtyRegion::rect(uint8_t index) const {
+    return m_rects[index < m_count ? index : 0];
+}
+
+/**
+ * @brief Gets the number of pixels covered by the region.
+ * @return Sum of the areas of all rectangles. Rectangles never overlap (or touch) after
+ *         coalescing, also when the list is full.
+ */
+uint32_t DirtyRegion::area() const {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < m_count; i++) {
+        total += areaOf(m_rects[i]);
+    }
+    return total;
+}
+
+/**
+ * @brief Gets the bounding box of the whole region.
+ * @return Rectangle enclosing every damaged rectangle, or an empty rectangle.
+ */
+Rect_t DirtyRegion::bounds() const {
+    if (m_count == 0) {
+        Rect_t empty = {0, 0, 0, 0};
+        return empty;
+    }
+    Rect_t box = m_rects[0];
+    for (uint8_t i = 1; i < m_count; i++) {
+        box = unite(box, m_rects[i]);
+    }
+    return box;
+}
+
+/**
+ * @brief Checks if two rectangles share at least one pixel.
+ */
+bool DirtyRegion::overlaps(const Rect_t &a, const Rect_t &b) {
+    return (a.x < b.x + b.width) && (b.x < a.x + a.width) &&
+           (a.y < b.y + b.height) && (b.y < a.y + a.height);
+}
+
+/**
+ * @brief Checks if two rectangles overlap or share an edge.
+ */
+bool DirtyRegion::touches(const Rect_t &a, const Rect_t &b) {
+    return (a.x <= b.x + b.width) && (b.x <= a.x + a.width) &&
+           (a.y <= b.y + b.height) && (b.y <= a.y + a.height);
+}
+
+/**
+ * @brief Checks if a rectangle is fully covered by another.
+ */
+bool DirtyRegion::contains(const Rect_t &outer, const Rect_t &inner) {
+    return (inner.x >= outer.x) && (inner.y >= outer.y) &&
+           (inner.x + inner.width <= outer.x + outer.width) &&
+           (inner.y + inner.height <= outer.y + outer.height);
+}
+
+/**
+ * @brief Computes the bounding box of two rectangles.
+ */
+Rect_t DirtyRegion::unite(const Rect_t &a, const Rect_t &b) {
+    uint32_t x0 = a.x < b.x ? a.x : b.x;
+    uint32_t y0 = a.y < b.y ? a.y : b.y;
+    uint32_t x1 = (a.x + a.width) > (b.x + b.width) ? (a.x + a.width) : (b.x + b.width);
+    uint32_t y1 = (a.y + a.height) > (b.y + b.height) ? (a.y + a.height) : (b.y + b.height);
+    Rect_t r = {static_cast<uint16_t>(x0), static_cast<uint16_t>(y0),
+                static_cast<uint16_t>(x1 - x0), static_cast<uint16_t>(y1 - y0)};
+    return r;
+}
+
+/**
+ * @brief Computes the area of a rectangle in pixels.
+ */
+uint32_t DirtyRegion::areaOf(const Rect_t &r) {
+    return static_cast<uint32_t>(r.width) * r.height;
+}
+
+/**
+ * @brief Removes a rectangle keeping the list compact.
+ * @param index Index of the rectangle to remove.
+ */
+void DirtyRegion::removeAt(uint8_t index) {
+    if (index >= m_count) {
+        return;
+    }
+    m_rects[index] = m_rects[m_count - 1];
+    m_count--;
+}
+
+/**
+ * @brief Merges the two rectangles whose union adds the fewest extra pixels.
+ * @details Used when the list is full. The merged rectangle may now touch others,
+ *          so it is re-inserted through add().
+ */
+void DirtyRegion::mergeCheapestPair() {
+    if (m_count < 2) {
+        return;
+    }
+
+    uint8_t bestA = 0;
+    uint8_t bestB = 1;
+    uint32_t bestCost = UINT32_MAX;
+
+    for (uint8_t i = 0; i < m_count; i++) {
+        for (uint8_t j = i + 1; j < m_count; j++) {
+            uint32_t united = areaOf(unite(m_rects[i], m_rects[j]));
+            uint32_t separate = areaOf(m_rects[i]) + areaOf(m_rects[j]);
+            uint32_t cost = united > separate ? united - separate : 0;
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestA = i;
+                bestB = j;
+            }
+        }
+    }
+
+    Rect_t merged = unite(m_rects[bestA], m_rects[bestB]);
+    // Remove the higher index first so the lower one stays valid.
+    removeAt(bestB);
+    removeAt(bestA);
+    add(merged);
+}
@@ -0,0 +1,48 @@
+// dirtyregion.h
+#ifndef DIRTYREGION_H
+#define DIRTYREGION_H
+
+#include <stdint.h>
+#include "baseTypes.h"
+
+#ifndef DIRTY_REGION_MAX_RECTS
+// Ajuste aqui se quiser mais retangulos por frame antes de forcar a fusao
+#define DIRTY_REGION_MAX_RECTS 16
+#endif
+
+/// @brief Per-frame list of damaged screen rectangles.
+/// @details Rectangles added to the region are coalesced on insertion: a rectangle that is
+///          already covered is discarded, overlapping or touching rectangles are merged into
+///          their bounding box and, when the list is full, the pair whose union wastes the
+///          fewest pixels is merged to make room. The list never allocates memory.
+///          It only describes areas; drawing is not clipped or batched to it.
+class DirtyRegion {
+public:
+    DirtyRegion();
+
+    void clear();
+    void add(const Rect_t &rect);
+    void add(int32_t x, int32_t y, int32_t width, int32_t height);
+
+    bool isEmpty() const;
+    bool intersects(const Rect_t &rect) const;
+    uint8_t count() const;
+    const Rect_t &rect(uint8_t index) const;
+    uint32_t area() const;
+    Rect_t bounds() const;
+
+    static bool overlaps(const Rect_t &a, const Rect_t &b);
+    static bool touches(const Rect_t &a, const Rect_t &b);
+    static bool contains(const Rect_t &outer, const Rect_t &inner);
+    static Rect_t unite(const Rect_t &a, const Rect_t &b);
+    static uint32_t areaOf(const Rect_t &r);
+
+private:
+    Rect_t m_rects[DIRTY_REGION_MAX_RECTS]; ///< Coalesced rectangles.
+    uint8_t m_count;                        ///< Number of valid entries in m_rects.
+
+    void removeAt(uint8_t index);
+    void mergeCheapestPair();
+};
+
+#endif // DIRTYREGION_H
@@ -0,0 +1,147 @@
+// fkzimage.cpp
+#include "fkzimage.h"
+
+#if defined(DISP_DEFAULT)
+#include <esp_log.h>
+#include <string.h>
+
+const char *FkzDecoder::TAG = "FkzDecoder";
+
+namespace {
+
+inline uint8_t colorHash(uint16_t color) {
+    return static_cast<uint8_t>(((color >> 11) * 3 + ((color >> 5) & 0x3F) * 5 + (color & 0x1F) * 7) & 63);
+}
+
+/// @brief Adds signed deltas to the channels of an RGB565 color (each channel wraps).
+inline uint16_t addDelta(uint16_t color, int8_t dr, int8_t dg, int8_t db) {
+    const uint16_t r = ((color >> 11) + dr) & 0x1F;
+    const uint16_t g = (((color >> 5) & 0x3F) + dg) & 0x3F;
+    const uint16_t b = ((color & 0x1F) + db) & 0x1F;
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+} // namespace
+
+/**
+ * @brief Checks if the first 4 bytes of a file are the magic of a compressed image.
+ */
+bool FkzDecoder::isFkz(const uint8_t *header) {
+    return header[0] == 'F' && header[1] == 'K' && header[2] == 'Z' && header[3] == '1';
+}
+
+/**
+ * @brief Reads the header and prepares to decode the first row.
+ * @param file File positioned at the start of the image. It must stay open while rows are read.
+ * @return false if the file is not a valid compressed image.
+ */
+bool FkzDecoder::begin(fs::File &file) {
+    m_file = &file;
+    m_inPos = 0;
+    m_inLen = 0;
+    m_previous = 0;
+    m_row = 0;
+    memset(m_index, 0, sizeof(m_index));
+
+    uint8_t header[FKZ_HEADER_SIZE];
+    if (file.read(header, sizeof(header)) != sizeof(header) || !isFkz(header)) {
+        ESP_LOGE(TAG, "Not a compressed image");
+        return false;
+    }
+    m_width = (header[4] << 8) | header[5];
+    m_height = (header[6] << 8) | header[7];
+    m_hasMask = (header[8] & FKZ_FLAG_MASK) != 0;
+    if (m_width == 0 || m_height == 0) {
+        ESP_LOGE(TAG, "Invalid image size");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Next byte of the file, -1 at its end.
+ */
+int16_t FkzDecoder::nextByte() {
+    if (m_inPos == m_inLen) {
+        m_inLen = static_cast<uint16_t>(m_file->read(m_in, sizeof(m_in)));
+        m_inPos = 0;
+        if (m_inLen == 0) {
+            return -1;
+        }
+    }
+    return m_in[m_inPos++];
+}
+
+/**
+ * @brief Decodes the next row.
+ * @param pixels Receives width() pixels, RGB565 big-endian (2 bytes each). Transparent pixels
+ *               are left as they were.
+ * @param mask Receives (width() + 7) / 8 bytes, bit set = visible pixel, first pixel in the most
+ *             significant bit (nullptr if not needed).
+ * @return false at the end of the image or if the data is corrupt.
+ */
+bool FkzDecoder::readRow(uint8_t *pixels, uint8_t *mask) {
+    if (!m_file || m_row >= m_height) {
+        return false;
+    }
+    if (mask) {
+        memset(mask, 0, (m_width + 7) / 8);
+    }
+    uint16_t x = 0;
+    while (x < m_width) {
+        const int16_t op = nextByte();
+        if (op < 0) {
+            ESP_LOGE(TAG, "Data ends at row %d", m_row);
+            return false;
+        }
+        uint16_t count = 1;
+        bool visible = true;
+        if (op < 0x40) {
+            count = op + 1;
+        } else if (op < 0x80) {
+            m_previous = m_index[op & 0x3F];
+        } else if (op < 0xC0) {
+            m_previous = addDelta(m_previous, ((op >> 4) & 3) - 2, ((op >> 2) & 3) - 2, (op & 3) - 2);
+            m_index[colorHash(m_previous)] = m_previous;
+        } else if (op < 0xFE) {
+            count = op - 0xC0 + 1;
+            visible = false;
+        } else if (op == 0xFE) {
+            const int16_t b = nextByte();
+            if (b < 0) {
+                return false;
+            }
+            const int8_t dg = static_cast<int8_t>((b >> 4) & 0x0F) - 8;
+            m_previous = addDelta(m_previous, dg + ((b >> 2) & 3) - 2, dg, dg + (b & 3) - 2);
+            m_index[colorHash(m_previous)] = m_previous;
+        } else {
+            const int16_t hi = nextByte();
+            const int16_t lo = nextByte();
+            if (lo < 0 || hi < 0) {
+                return false;
+            }
+            m_previous = static_cast<uint16_t>((hi << 8) | lo);
+            m_index[colorHash(m_previous)] = m_previous;
+        }
+        if (count > m_width - x) {
+            ESP_LOGE(TAG, "Operation crosses the end of row %d", m_row);
+            return false;
+        }
+        if (!visible) {
+            x += count;
+            continue;
+        }
+        const uint8_t hi = m_previous >> 8, lo = m_previous & 0xFF;
+        for (uint16_t end = x + count; x < end; x++) {
+            pixels[x * 2] = hi;
+            pixels[x * 2 + 1] = lo;
+            if (mask) {
+                mask[x >> 3] |= 0x80 >> (x & 7);
+            }
+        }
+    }
+    m_row++;
+    return true;
+}
+
+#endif // DISP_DEFAULT
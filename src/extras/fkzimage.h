@@ -0,0 +1,61 @@
+// fkzimage.h
+#ifndef FKZIMAGE_H
+#define FKZIMAGE_H
+
+#include <stdint.h>
+#include "../widgets/widgetsetup.h"
+
+#if defined(DISP_DEFAULT)
+#include <FS.h>
+
+#ifndef DFK_FKZ_INPUT_BUFFER
+#define DFK_FKZ_INPUT_BUFFER 512 ///< Bytes read from the file at a time by FkzDecoder.
+#endif
+
+#define FKZ_HEADER_SIZE 10   ///< "FKZ1", width and height (big-endian), flags, reserved.
+#define FKZ_FLAG_MASK 0x01   ///< The image has transparent pixels.
+
+/// @brief Decoder of compressed images (.fkz), one row at a time.
+/// @details Files are written by src/widgets/image/imagecompress.py from .fki images or PNGs.
+///          After the header, pixels are coded as byte operations in the spirit of QOI, using
+///          the previous pixel and a table of 64 recently seen colors (RGB565):
+///          - 0x00-0x3F RUN: the previous pixel 1 to 64 times
+///          - 0x40-0x7F INDEX: color of the table entry
+///          - 0x80-0xBF DIFF: red, green and blue of the previous pixel plus -2..1 each (2 bits)
+///          - 0xC0-0xFD SKIP: 1 to 62 transparent pixels
+///          - 0xFE LUMA + 1 byte: green -8..7 (high nibble), red and blue -2..1 relative to it
+///          - 0xFF RGB + 2 bytes: the color, big-endian
+///          Every color that is not a RUN goes into the table at (r * 3 + g * 5 + b * 7) % 64.
+///          No operation crosses the end of a row, so rows can be decoded straight into a
+///          line buffer and sent to the display. Decoded pixels are big-endian, as in .fki files.
+class FkzDecoder {
+public:
+    static bool isFkz(const uint8_t *header);
+
+    bool begin(fs::File &file);
+    bool readRow(uint8_t *pixels, uint8_t *mask);
+
+    uint16_t width() const { return m_width; }
+    uint16_t height() const { return m_height; }
+    bool hasMask() const { return m_hasMask; }
+
+private:
+    static const char *TAG; ///< Tag estática para identificação em logs.
+
+    fs::File *m_file = nullptr;           ///< File being decoded.
+    uint8_t m_in[DFK_FKZ_INPUT_BUFFER];   ///< Bytes read from the file.
+    uint16_t m_inPos = 0;                 ///< Next byte of m_in.
+    uint16_t m_inLen = 0;                 ///< Valid bytes in m_in.
+    uint16_t m_index[64];                 ///< Recently seen colors.
+    uint16_t m_previous = 0;              ///< Last color decoded.
+    uint16_t m_width = 0;                 ///< Image width.
+    uint16_t m_height = 0;                ///< Image height.
+    uint16_t m_row = 0;                   ///< Rows decoded so far.
+    bool m_hasMask = false;               ///< The image has transparent pixels.
+
+    int16_t nextByte();
+};
+
+#endif // DISP_DEFAULT
+
+#endif // FKZIMAGE_H
@@ -0,0 +1,103 @@
+// fontmetrics.cpp
+#include "fontmetrics.h"
+
+#if defined(USING_GRAPHIC_LIB)
+#if defined(DISP_DEFAULT)
+#include "sparsefont.h"
+#endif
+
+/**
+ * @brief Measures a string printed with a font at text size 1.
+ * @param font Font used.
+ * @param text String to measure.
+ * @return Bounding box relative to a cursor at (0, 0), like getTextBounds(text, 0, 0, ...) with
+ *         wrap disabled. Width and height are 0 for an empty box. UTF-8 text of a registered
+ *         sparse font is decoded.
+ */
+TextBound_t FontMetrics::measure(const GFXfont *font, const char *text) {
+    TextBound_t result = {0, 0, 0, 0};
+    if (!font || !text) {
+        return result;
+    }
+#if defined(DISP_DEFAULT)
+    if (SparseFontRenderer::needsDecoding(text)) {
+        const SparseFont *sparse = SparseFontRenderer::find(font);
+        if (sparse) {
+            return SparseFontRenderer::measure(sparse, text);
+        }
+    }
+#endif
+    int16_t x = 0;
+    int16_t y = 0;
+    // Same inverted start as getTextBounds(): the box always reaches the cursor row/column -1.
+    int16_t minX = 0x7FFF, minY = 0x7FFF, maxX = -1, maxY = -1;
+    for (const char *p = text; *p; p++) {
+        uint8_t c = static_cast<uint8_t>(*p);
+        if (c == '\n') {
+            x = 0;
+            y += font->yAdvance;
+            continue;
+        }
+        if (c == '\r' || c < font->first || c > font->last) {
+            continue;
+        }
+        const GFXglyph *glyph = &font->glyph[c - font->first];
+        const int16_t x1 = x + glyph->xOffset;
+        const int16_t y1 = y + glyph->yOffset;
+        const int16_t x2 = x1 + glyph->width - 1;
+        const int16_t y2 = y1 + glyph->height - 1;
+        if (x1 < minX) minX = x1;
+        if (y1 < minY) minY = y1;
+        if (x2 > maxX) maxX = x2;
+        if (y2 > maxY) maxY = y2;
+        x += glyph->xAdvance;
+    }
+    if (maxX >= minX) {
+        result.x = minX;
+        result.width = static_cast<uint16_t>(maxX - minX + 1);
+    }
+    if (maxY >= minY) {
+        result.y = minY;
+        result.height = static_cast<uint16_t>(maxY - minY + 1);
+    }
+    return result;
+}
+
+/**
+ * @brief Checks if a string printed with a font fits an area.
+ */
+bool FontMetrics::fits(const GFXfont *font, const char *text, uint16_t width, uint16_t height) {
+    const TextBound_t box = measure(font, text);
+    return box.width <= width && box.height <= height;
+}
+
+/**
+ * @brief Gets the first font of a list where a string fits an area.
+ * @param text String to fit (nullptr or empty fits any font).
+ * @param width Available width.
+ * @param height Available height.
+ * @param fonts Fonts to try, usually from the largest to the smallest.
+ * @param fontCount Number of fonts in the list.
+ * @return The first font that fits, or nullptr if none does.
+ * @details Every font is tried in order. Fitting is not monotonic even in a list sorted by
+ *          size (glyph boxes are rounded per font), and a result found any other way would
+ *          have to be confirmed by trying the fonts before it. Each try only adds up glyph
+ *          records, and the lists are short.
+ */
+const GFXfont *FontMetrics::bestFit(const char *text, uint16_t width, uint16_t height,
+                                    const GFXfont *const fonts[], size_t fontCount) {
+    if (!fonts || fontCount == 0) {
+        return nullptr;
+    }
+    if (!text || *text == '\0') {
+        return fonts[0];
+    }
+    for (size_t i = 0; i < fontCount; i++) {
+        if (fonts[i] && fits(fonts[i], text, width, height)) {
+            return fonts[i];
+        }
+    }
+    return nullptr;
+}
+
+#endif // USING_GRAPHIC_LIB
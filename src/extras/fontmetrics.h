@@ -0,0 +1,33 @@
+// fontmetrics.h
+#ifndef FONTMETRICS_H
+#define FONTMETRICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../widgets/widgetsetup.h"
+#include "baseTypes.h"
+
+#if defined(USING_GRAPHIC_LIB)
+#if defined(DISP_DEFAULT)
+#include <Arduino_GFX_Library.h>
+#else
+#include <Adafruit_GFX.h>
+#endif
+
+/// @brief Text measurement done with the glyph table of a GFXfont, without a display.
+/// @details The advance and the box of every glyph are already stored in the font (GFXglyph),
+///          so the size of a string is plain arithmetic over those records, the same one
+///          getTextBounds() does at text size 1 with wrap disabled.
+///          bestFit() picks the first font of a list (usually from the largest to the smallest)
+///          where a string fits an area, trying the fonts in order.
+class FontMetrics {
+public:
+    static TextBound_t measure(const GFXfont *font, const char *text);
+    static bool fits(const GFXfont *font, const char *text, uint16_t width, uint16_t height);
+    static const GFXfont *bestFit(const char *text, uint16_t width, uint16_t height,
+                                  const GFXfont *const fonts[], size_t fontCount);
+};
+
+#endif // USING_GRAPHIC_LIB
+
+#endif // FONTMETRICS_H
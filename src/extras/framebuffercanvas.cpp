@@ -0,0 +1,332 @@
+// framebuffercanvas.cpp
+#include "framebuffercanvas.h"
+
+#if defined(DISP_DEFAULT)
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+#include <string.h>
+#include <new>
+
+const char *FrameBufferCanvas::TAG = "FrameBufferCanvas";
+
+/**
+ * @brief Constructor.
+ * @param width Width of the screen.
+ * @param height Height of the screen.
+ * @details The buffer is only allocated in begin().
+ */
+FrameBufferCanvas::FrameBufferCanvas(int16_t width, int16_t height)
+    : Arduino_GFX(width, height),
+      m_buffer(nullptr),
+      m_bands(nullptr),
+      m_bandCount(0),
+      m_damaged(false),
+      m_stale(nullptr),
+      m_anyStale(false),
+      m_panel(nullptr),
+      m_panelRotation(0)
+{
+}
+
+/**
+ * @brief Destructor. Frees the pixel buffer and the band list.
+ */
+FrameBufferCanvas::~FrameBufferCanvas() {
+    if (m_buffer) {
+        heap_caps_free(m_buffer);
+        m_buffer = nullptr;
+    }
+    delete[] m_bands;
+    m_bands = nullptr;
+    delete[] m_stale;
+    m_stale = nullptr;
+}
+
+/**
+ * @brief Allocates the shadow buffer in PSRAM.
+ * @param speed Unused, kept for the Arduino_GFX interface.
+ * @return true if the buffer is available.
+ */
+bool FrameBufferCanvas::begin(int32_t speed) {
+    (void)speed;
+    if (m_buffer) {
+        return true;
+    }
+    if (_width <= 0 || _height <= 0) {
+        ESP_LOGE(TAG, "Invalid screen size");
+        return false;
+    }
+
+    m_bandCount = (_height + DFK_FB_BAND_HEIGHT - 1) / DFK_FB_BAND_HEIGHT;
+    m_bands = new(std::nothrow) Rect_t[m_bandCount];
+    m_stale = new(std::nothrow) bool[m_bandCount];
+    if (!m_bands || !m_stale) {
+        ESP_LOGE(TAG, "Can't allocate band list");
+        delete[] m_bands;
+        delete[] m_stale;
+        m_bands = nullptr;
+        m_stale = nullptr;
+        return false;
+    }
+
+    size_t bytes = static_cast<size_t>(_width) * _height * sizeof(uint16_t);
+    m_buffer = static_cast<uint16_t *>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM));
+    if (!m_buffer) {
+        ESP_LOGE(TAG, "Can't allocate %u bytes for shadow buffer", (unsigned)bytes);
+        delete[] m_bands;
+        delete[] m_stale;
+        m_bands = nullptr;
+        m_stale = nullptr;
+        return false;
+    }
+    memset(m_buffer, 0, bytes);
+    memset(m_stale, 0, m_bandCount * sizeof(bool));
+    clearDamage();
+    ESP_LOGD(TAG, "Shadow buffer %d x %d allocated", _width, _height);
+    return true;
+}
+
+/**
+ * @brief Checks if the buffer was allocated.
+ */
+bool FrameBufferCanvas::isReady() const {
+    return m_buffer != nullptr;
+}
+
+/**
+ * @brief Checks if something was drawn since the last present().
+ */
+bool FrameBufferCanvas::hasDamage() const {
+    return m_damaged;
+}
+
+/**
+ * @brief Gets the raw pixel buffer (row-major, screen width pixels per row).
+ */
+uint16_t *FrameBufferCanvas::getBuffer() {
+    return m_buffer;
+}
+
+/**
+ * @brief Marks every band as older than the panel framebuffer.
+ * @param panel Framebuffer scanned by the panel, in its rotation 0 layout.
+ * @param rotation Rotation of the display object that draws on the panel (0-3).
+ * @details Used after drawing straight on the panel. Pending damage is dropped because the
+ *          panel holds the newest pixels. Nothing is copied here: a band is read back from
+ *          the panel the first time it is drawn again (see syncRows()), and bands that are
+ *          never drawn again are never copied.
+ */
+void FrameBufferCanvas::markStale(const uint16_t *panel, uint8_t rotation) {
+    if (!m_buffer || !panel) {
+        return;
+    }
+    m_panel = panel;
+    m_panelRotation = rotation & 3;
+    for (uint16_t b = 0; b < m_bandCount; b++) {
+        m_stale[b] = true;
+    }
+    m_anyStale = true;
+    clearDamage();
+}
+
+/**
+ * @brief Sends the damaged areas to the display.
+ * @param output Display that receives the pixels.
+ * @return Number of pixels sent.
+ * @details A band damaged over the full width is sent with one call (its rows are contiguous
+ *          in memory); otherwise the damaged span is sent row by row. The copy is not
+ *          synchronized with the panel scan.
+ */
+uint32_t FrameBufferCanvas::present(Arduino_GFX *output) {
+    if (!output || !m_buffer || !m_damaged) {
+        return 0;
+    }
+
+    uint32_t pixels = 0;
+    for (uint16_t b = 0; b < m_bandCount; b++) {
+        const Rect_t &r = m_bands[b];
+        if (r.width == 0) {
+            continue;
+        }
+        if (r.width == _width) {
+            output->draw16bitRGBBitmap(0, r.y, m_buffer + static_cast<uint32_t>(r.y) * _width, _width, r.height);
+        } else {
+            for (uint16_t row = r.y; row < r.y + r.height; row++) {
+                output->draw16bitRGBBitmap(r.x, row, m_buffer + static_cast<uint32_t>(row) * _width + r.x, r.width, 1);
+            }
+        }
+        pixels += static_cast<uint32_t>(r.width) * r.height;
+    }
+    clearDamage();
+    return pixels;
+}
+
+/**
+ * @brief Stores a pixel.
+ */
+void FrameBufferCanvas::writePixelPreclipped(int16_t x, int16_t y, uint16_t color) {
+    if (!m_buffer || x < 0 || y < 0 || x >= _width || y >= _height) {
+        return;
+    }
+    syncRows(y, y + 1);
+    m_buffer[static_cast<int32_t>(y) * _width + x] = color;
+    markDamage(x, y, x + 1, y + 1);
+}
+
+/**
+ * @brief Draws a vertical line clipped to the screen.
+ */
+void FrameBufferCanvas::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    if (h < 0) {
+        y += h + 1;
+        h = -h;
+    }
+    writeFillRectPreclipped(x, y, 1, h, color);
+}
+
+/**
+ * @brief Draws a horizontal line clipped to the screen.
+ */
+void FrameBufferCanvas::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    if (w < 0) {
+        x += w + 1;
+        w = -w;
+    }
+    writeFillRectPreclipped(x, y, w, 1, color);
+}
+
+/**
+ * @brief Fills a rectangle clipped to the screen.
+ */
+void FrameBufferCanvas::writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (!m_buffer) {
+        return;
+    }
+    int32_t x0 = x < 0 ? 0 : x;
+    int32_t y0 = y < 0 ? 0 : y;
+    int32_t x1 = static_cast<int32_t>(x) + w;
+    int32_t y1 = static_cast<int32_t>(y) + h;
+    if (x1 > _width) { x1 = _width; }
+    if (y1 > _height) { y1 = _height; }
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    syncRows(y0, y1);
+    for (int32_t row = y0; row < y1; row++) {
+        uint16_t *dst = m_buffer + row * _width + x0;
+        for (int32_t col = x0; col < x1; col++) {
+            *dst++ = color;
+        }
+    }
+    markDamage(x0, y0, x1, y1);
+}
+
+/**
+ * @brief Copies an RGB565 bitmap, clipped to the screen.
+ */
+void FrameBufferCanvas::draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) {
+    if (!m_buffer || !bitmap || w <= 0 || h <= 0) {
+        return;
+    }
+    int32_t x0 = x < 0 ? 0 : x;
+    int32_t y0 = y < 0 ? 0 : y;
+    int32_t x1 = static_cast<int32_t>(x) + w;
+    int32_t y1 = static_cast<int32_t>(y) + h;
+    if (x1 > _width) { x1 = _width; }
+    if (y1 > _height) { y1 = _height; }
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    syncRows(y0, y1);
+    size_t rowBytes = static_cast<size_t>(x1 - x0) * sizeof(uint16_t);
+    for (int32_t row = y0; row < y1; row++) {
+        const uint16_t *src = bitmap + (row - y) * w + (x0 - x);
+        memcpy(m_buffer + row * _width + x0, src, rowBytes);
+    }
+    markDamage(x0, y0, x1, y1);
+}
+
+/**
+ * @brief Reads back from the panel the stale bands of rows y0 to y1 - 1, before they are drawn.
+ */
+void FrameBufferCanvas::syncRows(int32_t y0, int32_t y1) {
+    if (!m_anyStale) {
+        return;
+    }
+    uint16_t lastBand = (y1 - 1) / DFK_FB_BAND_HEIGHT;
+    for (uint16_t b = y0 / DFK_FB_BAND_HEIGHT; b <= lastBand && b < m_bandCount; b++) {
+        if (m_stale[b]) {
+            copyBand(b);
+            m_stale[b] = false;
+        }
+    }
+}
+
+/**
+ * @brief Copies one band from the panel framebuffer, undoing the rotation of the panel display.
+ * @details Follows the Arduino_GFX rotation: logical (x, y) is panel (x, y), (W-1-y, x),
+ *          (W-1-x, H-1-y) and (y, H-1-x) for rotations 0 to 3, W x H being the panel size.
+ */
+void FrameBufferCanvas::copyBand(uint16_t band) {
+    const int32_t top = static_cast<int32_t>(band) * DFK_FB_BAND_HEIGHT;
+    const int32_t bottom = top + DFK_FB_BAND_HEIGHT < _height ? top + DFK_FB_BAND_HEIGHT : _height;
+    if (m_panelRotation == 0) {
+        memcpy(m_buffer + top * _width, m_panel + top * _width,
+               static_cast<size_t>(bottom - top) * _width * sizeof(uint16_t));
+        return;
+    }
+    const int32_t panelWidth = (m_panelRotation & 1) ? _height : _width;
+    const int32_t panelHeight = (m_panelRotation & 1) ? _width : _height;
+    for (int32_t y = top; y < bottom; y++) {
+        uint16_t *dst = m_buffer + y * _width;
+        for (int32_t x = 0; x < _width; x++) {
+            int32_t px, py;
+            switch (m_panelRotation) {
+                case 1: px = panelWidth - 1 - y; py = x; break;
+                case 2: px = panelWidth - 1 - x; py = panelHeight - 1 - y; break;
+                default: px = y; py = panelHeight - 1 - x; break;
+            }
+            dst[x] = m_panel[py * panelWidth + px];
+        }
+    }
+}
+
+/**
+ * @brief Adds an area (end coordinates exclusive, already clipped) to the damaged bands.
+ */
+void FrameBufferCanvas::markDamage(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    uint16_t firstBand = y0 / DFK_FB_BAND_HEIGHT;
+    uint16_t lastBand = (y1 - 1) / DFK_FB_BAND_HEIGHT;
+    for (uint16_t b = firstBand; b <= lastBand && b < m_bandCount; b++) {
+        int32_t bandTop = static_cast<int32_t>(b) * DFK_FB_BAND_HEIGHT;
+        int32_t by0 = y0 > bandTop ? y0 : bandTop;
+        int32_t by1 = y1 < bandTop + DFK_FB_BAND_HEIGHT ? y1 : bandTop + DFK_FB_BAND_HEIGHT;
+        Rect_t &r = m_bands[b];
+        if (r.width == 0) {
+            r.x = x0;
+            r.y = by0;
+            r.width = x1 - x0;
+            r.height = by1 - by0;
+            continue;
+        }
+        int32_t rx1 = r.x + r.width;
+        int32_t ry1 = r.y + r.height;
+        if (x0 < r.x) { r.x = x0; }
+        if (by0 < r.y) { r.y = by0; }
+        r.width = (x1 > rx1 ? x1 : rx1) - r.x;
+        r.height = (by1 > ry1 ? by1 : ry1) - r.y;
+    }
+    m_damaged = true;
+}
+
+/**
+ * @brief Marks every band as clean.
+ */
+void FrameBufferCanvas::clearDamage() {
+    for (uint16_t b = 0; b < m_bandCount; b++) {
+        m_bands[b] = {0, 0, 0, 0};
+    }
+    m_damaged = false;
+}
+
+#endif // DISP_DEFAULT
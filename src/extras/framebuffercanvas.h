@@ -0,0 +1,63 @@
+// framebuffercanvas.h
+#ifndef FRAMEBUFFERCANVAS_H
+#define FRAMEBUFFERCANVAS_H
+
+#include <stdint.h>
+#include "../widgets/widgetsetup.h"
+#include "baseTypes.h"
+
+#if defined(DISP_DEFAULT)
+#include <Arduino_GFX_Library.h>
+
+#ifndef DFK_FB_BAND_HEIGHT
+#define DFK_FB_BAND_HEIGHT 16 ///< Rows per damage band of the shadow buffer.
+#endif
+
+/// @brief Full screen RGB565 shadow of the panel framebuffer (PSRAM), with damage tracking.
+/// @details Every write is done in memory, in the logical (rotated) orientation, and marks the
+///          touched area in horizontal bands of DFK_FB_BAND_HEIGHT rows (one bounding box per
+///          band, O(1) per write). present() sends only the damaged part of each band to the
+///          real display, so the panel never shows a widget half erased.
+///          This is not double buffering: present() writes into the framebuffer the panel is
+///          scanning, without waiting for vsync, so a band being copied can still tear.
+///          After the panel is drawn directly, markStale() flags every band; a stale band is
+///          copied back from the panel framebuffer only when it is drawn again.
+class FrameBufferCanvas : public Arduino_GFX {
+public:
+    FrameBufferCanvas(int16_t width, int16_t height);
+    ~FrameBufferCanvas();
+
+    bool begin(int32_t speed = GFX_NOT_DEFINED) override;
+    void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
+    void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    using Arduino_GFX::draw16bitRGBBitmap;
+    void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+
+    bool isReady() const;
+    bool hasDamage() const;
+    void markStale(const uint16_t *panel, uint8_t rotation);
+    uint32_t present(Arduino_GFX *output);
+    uint16_t *getBuffer();
+
+private:
+    static const char *TAG; ///< Tag estática para identificação em logs.
+    uint16_t *m_buffer;     ///< Pixel storage, width x height pixels.
+    Rect_t *m_bands;        ///< Damaged area of each band (width 0 = clean).
+    uint16_t m_bandCount;   ///< Number of entries in m_bands.
+    bool m_damaged;         ///< True if any band is damaged.
+    bool *m_stale;          ///< Bands older than the panel framebuffer.
+    bool m_anyStale;        ///< True if any entry of m_stale is set.
+    const uint16_t *m_panel; ///< Panel framebuffer (rotation 0 layout) the stale bands are read from.
+    uint8_t m_panelRotation; ///< Rotation of the display that draws on m_panel.
+
+    void syncRows(int32_t y0, int32_t y1);
+    void copyBand(uint16_t band);
+    void markDamage(int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+    void clearDamage();
+};
+
+#endif // DISP_DEFAULT
+
+#endif // FRAMEBUFFERCANVAS_H
@@ -0,0 +1,160 @@
+// framescheduler.cpp
+#include "framescheduler.h"
+
+/**
+ * @brief Constructor. Starts unpaced, without budget.
+ */
+FrameScheduler::FrameScheduler()
+    : m_targetFps(0),
+      m_periodUs(0),
+      m_budgetUs(0),
+      m_periodTicks(1),
+      m_periodRemainder(0),
+      m_remainderSum(0),
+      m_lastWake(0),
+      m_frameStartUs(0),
+      m_stats{}
+{
+}
+
+/**
+ * @brief Sets the target frame rate.
+ * @param fps Frames per second. 0 disables pacing (1 tick between loop iterations).
+ * @details The period rarely is a whole number of ticks (60 FPS at 1000 Hz is 16.67 ticks).
+ *          The whole part is used on every frame and the fraction is accumulated, adding
+ *          one tick when it reaches a full tick, so the average rate is the target.
+ */
+void FrameScheduler::setTargetFps(uint8_t fps) {
+    m_targetFps = fps;
+    if (fps == 0) {
+        m_periodUs = 0;
+        m_periodTicks = 1;
+        m_periodRemainder = 0;
+        return;
+    }
+    m_periodUs = 1000000UL / fps;
+    m_periodTicks = configTICK_RATE_HZ / fps;
+    m_periodRemainder = configTICK_RATE_HZ % fps;
+    if (m_periodTicks == 0) {
+        m_periodTicks = 1;
+        m_periodRemainder = 0;
+    }
+    m_remainderSum = 0;
+    m_lastWake = xTaskGetTickCount();
+}
+
+/**
+ * @brief Gets the target frame rate (0 = unpaced).
+ */
+uint8_t FrameScheduler::getTargetFps() const {
+    return m_targetFps;
+}
+
+/**
+ * @brief Sets the time each frame may spend drawing.
+ * @param budgetUs Budget in microseconds. 0 uses the whole frame period.
+ */
+void FrameScheduler::setBudget(uint32_t budgetUs) {
+    m_budgetUs = budgetUs;
+}
+
+/**
+ * @brief Gets the budget set by the user (0 = whole frame period).
+ */
+uint32_t FrameScheduler::getBudget() const {
+    return m_budgetUs;
+}
+
+/**
+ * @brief Marks the start of a frame.
+ */
+void FrameScheduler::beginFrame() {
+    m_frameStartUs = micros();
+}
+
+/**
+ * @brief Checks if the current frame still has time left.
+ * @return true if there is no budget or it was not spent yet.
+ */
+bool FrameScheduler::hasBudget() const {
+    uint32_t budget = effectiveBudget();
+    if (budget == 0) {
+        return true;
+    }
+    return (micros() - m_frameStartUs) < budget;
+}
+
+/**
+ * @brief Marks the end of a frame and updates the statistics.
+ */
+void FrameScheduler::endFrame() {
+    uint32_t elapsed = micros() - m_frameStartUs;
+    m_stats.frames++;
+    m_stats.lastFrameUs = elapsed;
+    if (elapsed > m_stats.maxFrameUs) {
+        m_stats.maxFrameUs = elapsed;
+    }
+
+    uint32_t budget = effectiveBudget();
+    if (budget > 0 && elapsed > budget) {
+        m_stats.budgetOverruns++;
+    }
+    if (m_periodUs > 0 && elapsed > m_periodUs) {
+        m_stats.droppedFrames += elapsed / m_periodUs;
+    }
+}
+
+/**
+ * @brief Blocks until the next frame slot.
+ * @details When the frame is late the schedule restarts from now, with one tick of delay
+ *          so lower priority tasks (and the idle task watchdog) still run.
+ */
+void FrameScheduler::waitNextFrame() {
+    if (m_periodUs == 0) {
+        vTaskDelay(1);
+        return;
+    }
+
+    TickType_t period = m_periodTicks;
+    m_remainderSum += m_periodRemainder;
+    if (m_remainderSum >= m_targetFps) {
+        m_remainderSum -= m_targetFps;
+        period++;
+    }
+
+    TickType_t now = xTaskGetTickCount();
+    if ((TickType_t)(now - m_lastWake) >= period) {
+        vTaskDelay(1);
+        m_lastWake = xTaskGetTickCount();
+        return;
+    }
+    vTaskDelayUntil(&m_lastWake, period);
+}
+
+/**
+ * @brief Counts a redraw that was postponed to a later frame.
+ */
+void FrameScheduler::countDeferred() {
+    m_stats.deferredRedraws++;
+}
+
+/**
+ * @brief Gets the collected statistics.
+ */
+const FrameStats_t &FrameScheduler::getStats() const {
+    return m_stats;
+}
+
+/**
+ * @brief Clears the statistics.
+ */
+void FrameScheduler::resetStats() {
+    m_stats = FrameStats_t{};
+}
+
+/**
+ * @brief Gets the budget in use: the user budget, or the frame period when none was set.
+ */
+uint32_t FrameScheduler::effectiveBudget() const {
+    return m_budgetUs > 0 ? m_budgetUs : m_periodUs;
+}
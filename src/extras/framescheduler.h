@@ -0,0 +1,54 @@
+// framescheduler.h
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/// @brief Frame statistics collected by FrameScheduler.
+typedef struct {
+  uint32_t frames;          ///< Frames run since the last reset.
+  uint32_t droppedFrames;   ///< Frame slots missed because a frame took longer than the period.
+  uint32_t budgetOverruns;  ///< Frames that used more time than the budget.
+  uint32_t deferredRedraws; ///< Deferrable widget redraws moved to a later frame.
+  uint32_t lastFrameUs;     ///< Duration of the last frame in microseconds.
+  uint32_t maxFrameUs;      ///< Longest frame in microseconds.
+} FrameStats_t;
+
+/// @brief Paces the UI task at a target frame rate and tracks a time budget per frame.
+/// @details With a target of 0 FPS the scheduler keeps the old behaviour (1 tick between
+///          iterations). Otherwise each frame starts on a fixed period with vTaskDelayUntil();
+///          if a frame is late the schedule is re-anchored instead of running catch-up frames.
+class FrameScheduler {
+public:
+  FrameScheduler();
+
+  void setTargetFps(uint8_t fps);
+  uint8_t getTargetFps() const;
+  void setBudget(uint32_t budgetUs);
+  uint32_t getBudget() const;
+
+  void beginFrame();
+  bool hasBudget() const;
+  void endFrame();
+  void waitNextFrame();
+
+  void countDeferred();
+  const FrameStats_t &getStats() const;
+  void resetStats();
+
+private:
+  uint8_t m_targetFps;       ///< Target frame rate, 0 = unpaced.
+  uint32_t m_periodUs;       ///< Frame period in microseconds (0 when unpaced).
+  uint32_t m_budgetUs;       ///< Budget set by the user, 0 = whole period.
+  TickType_t m_periodTicks;  ///< Whole RTOS ticks of the frame period.
+  uint8_t m_periodRemainder; ///< Fraction of a tick in the period, in 1/m_targetFps ticks.
+  uint16_t m_remainderSum;   ///< Accumulated fraction, one tick is added when it reaches m_targetFps.
+  TickType_t m_lastWake;     ///< Tick where the current frame was scheduled.
+  uint32_t m_frameStartUs;   ///< micros() at beginFrame().
+  FrameStats_t m_stats;      ///< Collected statistics.
+
+  uint32_t effectiveBudget() const;
+};
+
+#endif // FRAMESCHEDULER_H
@@ -0,0 +1,27 @@
+// gfxtextstate.h
+#ifndef GFXTEXTSTATE_H
+#define GFXTEXTSTATE_H
+
+#include <stdint.h>
+#include "../widgets/widgetsetup.h"
+
+#if defined(DISP_DEFAULT)
+#include <Arduino_GFX_Library.h>
+
+/// @brief Reads the text state that Arduino_GFX keeps in protected members.
+/// @details Only pointers to members are formed here; the class is never instantiated.
+struct GfxTextState : public Arduino_GFX {
+    static const GFXfont *font(const Arduino_GFX *gfx) { return gfx->*(&GfxTextState::gfxFont); }
+    static int16_t cursorX(const Arduino_GFX *gfx) { return gfx->*(&GfxTextState::cursor_x); }
+    static int16_t cursorY(const Arduino_GFX *gfx) { return gfx->*(&GfxTextState::cursor_y); }
+    static uint16_t color(const Arduino_GFX *gfx) { return gfx->*(&GfxTextState::textcolor); }
+    static uint16_t background(const Arduino_GFX *gfx) { return gfx->*(&GfxTextState::textbgcolor); }
+    static uint8_t sizeX(const Arduino_GFX *gfx) { return gfx->*(&GfxTextState::textsize_x); }
+    static uint8_t sizeY(const Arduino_GFX *gfx) { return gfx->*(&GfxTextState::textsize_y); }
+    static bool unscaled(const Arduino_GFX *gfx) { return sizeX(gfx) == 1 && sizeY(gfx) == 1; }
+    static bool wraps(const Arduino_GFX *gfx) { return gfx->*(&GfxTextState::wrap); }
+};
+
+#endif // DISP_DEFAULT
+
+#endif // GFXTEXTSTATE_H
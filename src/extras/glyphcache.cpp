@@ -0,0 +1,381 @@
+// glyphcache.cpp
+#include "glyphcache.h"
+
+#if defined(DISP_DEFAULT)
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+#include <new>
+#include "gfxtextstate.h"
+#include "compressedfont.h"
+
+const char *GlyphCache::TAG = "GlyphCache";
+
+namespace {
+
+/**
+ * @brief Walks the set pixels of a glyph bitmap row by row and reports each horizontal run.
+ * @param font Font that owns the glyph.
+ * @param glyph Glyph to decode.
+ * @param onRun Called with (row, x, length) for every run of set pixels.
+ */
+template <typename Fn>
+void forEachRun(const GFXfont *font, const GFXglyph *glyph, Fn onRun) {
+    const uint8_t *bitmap = font->bitmap;
+    uint32_t offset = glyph->bitmapOffset;
+    uint8_t bits = 0;
+    uint8_t bit = 0;
+    for (uint8_t row = 0; row < glyph->height; row++) {
+        int16_t start = -1;
+        for (uint8_t x = 0; x < glyph->width; x++) {
+            if (!(bit++ & 7)) {
+                bits = bitmap[offset++];
+            }
+            if (bits & 0x80) {
+                if (start < 0) {
+                    start = x;
+                }
+            } else if (start >= 0) {
+                onRun(row, static_cast<uint8_t>(start), static_cast<uint8_t>(x - start));
+                start = -1;
+            }
+            bits <<= 1;
+        }
+        if (start >= 0) {
+            onRun(row, static_cast<uint8_t>(start), static_cast<uint8_t>(glyph->width - start));
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Constructor.
+ * @param maxBytes Memory cap for rasterized glyphs.
+ * @param maxEntries Number of glyphs that can be cached at the same time.
+ * @details The tables are only allocated in begin().
+ */
+GlyphCache::GlyphCache(uint32_t maxBytes, uint16_t maxEntries)
+    : m_entries(nullptr),
+      m_buckets(nullptr),
+      m_maxBytes(maxBytes),
+      m_maxEntries(maxEntries),
+      m_bucketCount(1),
+      m_clock(0),
+      m_stats{0, 0, 0, 0, 0}
+{
+    while (m_bucketCount < m_maxEntries && m_bucketCount < 0x4000) {
+        m_bucketCount <<= 1;
+    }
+}
+
+/**
+ * @brief Destructor. Frees every glyph and the tables.
+ */
+GlyphCache::~GlyphCache() {
+    clear();
+    delete[] m_entries;
+    delete[] m_buckets;
+}
+
+/**
+ * @brief Allocates the entry table and the hash buckets.
+ * @return true if the cache can be used.
+ */
+bool GlyphCache::begin() {
+    if (m_entries) {
+        return true;
+    }
+    if (m_maxEntries == 0 || m_maxEntries > 0x7FFF || m_maxBytes == 0) {
+        ESP_LOGE(TAG, "Invalid glyph cache size");
+        return false;
+    }
+    m_entries = new (std::nothrow) GlyphEntry_t[m_maxEntries];
+    m_buckets = new (std::nothrow) int16_t[m_bucketCount];
+    if (!m_entries || !m_buckets) {
+        ESP_LOGE(TAG, "Can't allocate glyph cache tables");
+        delete[] m_entries;
+        delete[] m_buckets;
+        m_entries = nullptr;
+        m_buckets = nullptr;
+        return false;
+    }
+    for (uint16_t i = 0; i < m_maxEntries; i++) {
+        m_entries[i] = {nullptr, nullptr, 0, 0, 0, -1};
+    }
+    for (uint16_t i = 0; i < m_bucketCount; i++) {
+        m_buckets[i] = -1;
+    }
+    ESP_LOGD(TAG, "Glyph cache ready: %u entries, %u bytes", m_maxEntries, (unsigned)m_maxBytes);
+    return true;
+}
+
+/**
+ * @brief Checks if the tables were allocated.
+ */
+bool GlyphCache::isReady() const {
+    return m_entries != nullptr;
+}
+
+/**
+ * @brief Prints a string at the cursor of a display, like Arduino_GFX::print().
+ * @param gfx Display (or canvas) to draw on. Its font, color, cursor and wrap are used.
+ * @param text Text to print.
+ * @return false if nothing was drawn because the text state is not supported (no GFXfont,
+ *         text size other than 1, opaque background or non-ASCII bytes). The caller must
+ *         then print with Arduino_GFX.
+ * @details The cursor is advanced exactly as Arduino_GFX does. Glyphs that can't be cached
+ *          (allocation failure or larger than the cap) are drawn with drawChar(), or decoded
+ *          directly for a compressed font. Compressed fonts are always drawn (by
+ *          CompressedFont::print() when the text state is not supported).
+ */
+bool GlyphCache::print(Arduino_GFX *gfx, const char *text) {
+    if (!m_entries || !gfx || !text) {
+        return false;
+    }
+    const GFXfont *font = GfxTextState::font(gfx);
+    uint16_t color = GfxTextState::color(gfx);
+    const bool compressed = CompressedFont::contains(font);
+    if (!font || !GfxTextState::unscaled(gfx) || GfxTextState::background(gfx) != color) {
+        return compressed && CompressedFont::print(gfx, text);
+    }
+    for (const char *p = text; *p; p++) {
+        if (static_cast<uint8_t>(*p) >= 0x80) {
+            return compressed && CompressedFont::print(gfx, text);
+        }
+    }
+
+    int16_t x = GfxTextState::cursorX(gfx);
+    int16_t y = GfxTextState::cursorY(gfx);
+    const bool wrap = GfxTextState::wraps(gfx);
+    const int16_t width = gfx->width();
+    m_clock++;
+
+    gfx->startWrite();
+    for (const char *p = text; *p; p++) {
+        uint8_t c = static_cast<uint8_t>(*p);
+        if (c == '\n') {
+            x = 0;
+            y += font->yAdvance;
+            continue;
+        }
+        if (c == '\r' || c < font->first || c > font->last) {
+            continue;
+        }
+        const GFXglyph *glyph = &font->glyph[c - font->first];
+        if (glyph->width > 0 && glyph->height > 0) {
+            if (wrap && (x + glyph->xOffset + glyph->width) > width) {
+                x = 0;
+                y += font->yAdvance;
+            }
+            const GlyphEntry_t *entry = get(font, c);
+            const int16_t gx = x + glyph->xOffset;
+            const int16_t gy = y + glyph->yOffset;
+            if (entry) {
+                const uint8_t *run = entry->runs;
+                for (uint16_t i = 0; i < entry->runCount; i++, run += 3) {
+                    gfx->writeFastHLine(gx + run[1], gy + run[0], run[2], color);
+                }
+            } else if (compressed) {
+                CompressedFont::forEachRun(font, glyph, [&](uint8_t row, uint8_t runX, uint8_t length) {
+                    gfx->writeFastHLine(gx + runX, gy + row, length, color);
+                });
+            } else {
+                gfx->drawChar(x, y, c, color, color);
+            }
+        }
+        x += glyph->xAdvance;
+    }
+    gfx->endWrite();
+
+    gfx->setCursor(x, y);
+    return true;
+}
+
+/**
+ * @brief Rasterizes glyphs ahead of time.
+ * @param font Font of the glyphs.
+ * @param chars Characters to rasterize (e.g. "0123456789.-").
+ */
+void GlyphCache::preload(const GFXfont *font, const char *chars) {
+    if (!m_entries || !font || !chars) {
+        return;
+    }
+    m_clock++;
+    for (const char *p = chars; *p; p++) {
+        uint8_t c = static_cast<uint8_t>(*p);
+        if (c < font->first || c > font->last) {
+            continue;
+        }
+        const GFXglyph *glyph = &font->glyph[c - font->first];
+        if (glyph->width > 0 && glyph->height > 0 && !find(font, c)) {
+            rasterize(font, c);
+        }
+    }
+}
+
+/**
+ * @brief Drops every cached glyph. The tables are kept.
+ * @details Call after changing a font in place (e.g. a font loaded into RAM).
+ */
+void GlyphCache::clear() {
+    if (!m_entries) {
+        return;
+    }
+    for (uint16_t i = 0; i < m_maxEntries; i++) {
+        if (m_entries[i].font) {
+            release(i);
+        }
+    }
+}
+
+/**
+ * @brief Gets the hit, miss and memory counters.
+ */
+const GlyphCacheStats_t &GlyphCache::getStats() const {
+    return m_stats;
+}
+
+/**
+ * @brief Resets the hit, miss and eviction counters. Memory counters are kept.
+ */
+void GlyphCache::resetStats() {
+    m_stats.hits = 0;
+    m_stats.misses = 0;
+    m_stats.evictions = 0;
+}
+
+uint16_t GlyphCache::bucketOf(const GFXfont *font, uint16_t code) const {
+    uint32_t h = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(font) >> 2) * 2654435761u;
+    return static_cast<uint16_t>((h ^ (code * 40503u)) & (m_bucketCount - 1));
+}
+
+GlyphCache::GlyphEntry_t *GlyphCache::find(const GFXfont *font, uint16_t code) {
+    for (int16_t i = m_buckets[bucketOf(font, code)]; i >= 0; i = m_entries[i].next) {
+        if (m_entries[i].font == font && m_entries[i].code == code) {
+            return &m_entries[i];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Gets a glyph, rasterizing it on a miss, and marks it as recently used.
+ * @return The entry, or nullptr if the glyph can't be cached.
+ */
+GlyphCache::GlyphEntry_t *GlyphCache::get(const GFXfont *font, uint16_t code) {
+    GlyphEntry_t *entry = find(font, code);
+    if (entry) {
+        m_stats.hits++;
+        entry->lastUse = m_clock;
+        return entry;
+    }
+    m_stats.misses++;
+    return rasterize(font, code);
+}
+
+/**
+ * @brief Decodes a glyph into runs and stores it, evicting old glyphs if needed.
+ */
+GlyphCache::GlyphEntry_t *GlyphCache::rasterize(const GFXfont *font, uint16_t code) {
+    const GFXglyph *glyph = &font->glyph[code - font->first];
+
+    const bool compressed = CompressedFont::contains(font);
+    uint16_t runCount = 0;
+    auto count = [&](uint8_t, uint8_t, uint8_t) { runCount++; };
+    if (compressed) {
+        CompressedFont::forEachRun(font, glyph, count);
+    } else {
+        forEachRun(font, glyph, count);
+    }
+    uint32_t bytes = static_cast<uint32_t>(runCount) * 3;
+    if (bytes > m_maxBytes) {
+        return nullptr;
+    }
+
+    while (m_stats.entries > 0 && (m_stats.entries >= m_maxEntries || m_stats.bytesUsed + bytes > m_maxBytes)) {
+        evictOldest();
+    }
+
+    uint8_t *runs = nullptr;
+    if (bytes > 0) {
+        runs = static_cast<uint8_t *>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM));
+        if (!runs) {
+            runs = static_cast<uint8_t *>(heap_caps_malloc(bytes, MALLOC_CAP_8BIT));
+        }
+        if (!runs) {
+            ESP_LOGW(TAG, "Can't allocate %u bytes for glyph %u", (unsigned)bytes, code);
+            return nullptr;
+        }
+        uint8_t *out = runs;
+        auto store = [&](uint8_t row, uint8_t x, uint8_t length) {
+            *out++ = row;
+            *out++ = x;
+            *out++ = length;
+        };
+        if (compressed) {
+            CompressedFont::forEachRun(font, glyph, store);
+        } else {
+            forEachRun(font, glyph, store);
+        }
+    }
+
+    int16_t index = -1;
+    for (uint16_t i = 0; i < m_maxEntries; i++) {
+        if (!m_entries[i].font) {
+            index = static_cast<int16_t>(i);
+            break;
+        }
+    }
+    uint16_t bucket = bucketOf(font, code);
+    GlyphEntry_t &entry = m_entries[index];
+    entry.font = font;
+    entry.code = code;
+    entry.runs = runs;
+    entry.runCount = runCount;
+    entry.lastUse = m_clock;
+    entry.next = m_buckets[bucket];
+    m_buckets[bucket] = index;
+
+    m_stats.entries++;
+    m_stats.bytesUsed += bytes;
+    return &entry;
+}
+
+/**
+ * @brief Drops the least recently used glyph.
+ */
+void GlyphCache::evictOldest() {
+    int16_t oldest = -1;
+    for (uint16_t i = 0; i < m_maxEntries; i++) {
+        if (m_entries[i].font && (oldest < 0 || m_entries[i].lastUse < m_entries[oldest].lastUse)) {
+            oldest = static_cast<int16_t>(i);
+        }
+    }
+    if (oldest >= 0) {
+        release(oldest);
+        m_stats.evictions++;
+    }
+}
+
+/**
+ * @brief Unlinks an entry from its bucket and frees its runs.
+ */
+void GlyphCache::release(int16_t index) {
+    GlyphEntry_t &entry = m_entries[index];
+    int16_t *link = &m_buckets[bucketOf(entry.font, entry.code)];
+    while (*link >= 0 && *link != index) {
+        link = &m_entries[*link].next;
+    }
+    if (*link == index) {
+        *link = entry.next;
+    }
+
+    if (entry.runs) {
+        heap_caps_free(entry.runs);
+    }
+    m_stats.entries--;
+    m_stats.bytesUsed -= static_cast<uint32_t>(entry.runCount) * 3;
+    entry = {nullptr, nullptr, 0, 0, 0, -1};
+}
+
+#endif // DISP_DEFAULT
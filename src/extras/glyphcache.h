@@ -0,0 +1,80 @@
+// glyphcache.h
+#ifndef GLYPHCACHE_H
+#define GLYPHCACHE_H
+
+#include <stdint.h>
+#include "../widgets/widgetsetup.h"
+
+#if defined(DISP_DEFAULT)
+#include <Arduino_GFX_Library.h>
+
+#ifndef DFK_GLYPH_CACHE_BYTES
+#define DFK_GLYPH_CACHE_BYTES 8192 ///< Default memory cap for rasterized glyphs (bytes).
+#endif
+#ifndef DFK_GLYPH_CACHE_ENTRIES
+#define DFK_GLYPH_CACHE_ENTRIES 192 ///< Default number of glyphs the cache can index.
+#endif
+
+/// @brief Counters of a GlyphCache.
+typedef struct {
+    uint32_t hits;      ///< Glyphs drawn from the cache.
+    uint32_t misses;    ///< Glyphs rasterized on first use.
+    uint32_t evictions; ///< Glyphs dropped to respect the memory cap or the entry limit.
+    uint32_t bytesUsed; ///< Bytes currently held by rasterized glyphs.
+    uint16_t entries;   ///< Glyphs currently cached.
+} GlyphCacheStats_t;
+
+/// @brief Cache of GFXfont glyphs rasterized into horizontal runs.
+/// @details Arduino_GFX draws a GFXfont glyph one pixel at a time. The cache decodes each
+///          (font, character) pair once into a list of runs (row, x, length) and later draws
+///          every run with a single writeFastHLine() inside one write transaction per string.
+///          Runs are stored in PSRAM when available. When the memory cap or the entry limit is
+///          reached the least recently used glyphs are dropped.
+///          Only the common case is handled: a GFXfont, text size 1 and a transparent
+///          background. print() returns false otherwise and the caller uses Arduino_GFX.
+///          Glyphs of compressed fonts (see CompressedFont) are decoded into the same runs.
+class GlyphCache {
+public:
+    GlyphCache(uint32_t maxBytes, uint16_t maxEntries);
+    ~GlyphCache();
+
+    bool begin();
+    bool isReady() const;
+    bool print(Arduino_GFX *gfx, const char *text);
+    void preload(const GFXfont *font, const char *chars);
+    void clear();
+    const GlyphCacheStats_t &getStats() const;
+    void resetStats();
+
+private:
+    /// @brief One rasterized glyph. Runs are 3 bytes each: row, x and length (glyph relative).
+    typedef struct {
+        const GFXfont *font; ///< Font of the glyph (nullptr = free slot).
+        uint8_t *runs;       ///< Run list, runCount * 3 bytes.
+        uint32_t lastUse;    ///< Value of m_clock at the last draw, for the LRU policy.
+        uint16_t runCount;   ///< Number of runs.
+        uint16_t code;       ///< Character code.
+        int16_t next;        ///< Next entry in the same hash bucket (-1 = end).
+    } GlyphEntry_t;
+
+    static const char *TAG; ///< Tag estática para identificação em logs.
+
+    uint16_t bucketOf(const GFXfont *font, uint16_t code) const;
+    GlyphEntry_t *find(const GFXfont *font, uint16_t code);
+    GlyphEntry_t *get(const GFXfont *font, uint16_t code);
+    GlyphEntry_t *rasterize(const GFXfont *font, uint16_t code);
+    void evictOldest();
+    void release(int16_t index);
+
+    GlyphEntry_t *m_entries;  ///< Entry table, m_maxEntries slots.
+    int16_t *m_buckets;       ///< Hash buckets, first entry of each chain (-1 = empty).
+    uint32_t m_maxBytes;      ///< Memory cap for run lists.
+    uint16_t m_maxEntries;    ///< Number of entry slots.
+    uint16_t m_bucketCount;   ///< Number of hash buckets (power of two).
+    uint32_t m_clock;         ///< Incremented on every draw; stamps GlyphEntry_t::lastUse.
+    GlyphCacheStats_t m_stats; ///< Hit, miss and memory counters.
+};
+
+#endif // DISP_DEFAULT
+
+#endif // GLYPHCACHE_H
@@ -0,0 +1,316 @@
+// imagecache.cpp
+#include "imagecache.h"
+
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+#include <new>
+#include <string.h>
+
+const char *ImageCache::TAG = "ImageCache";
+
+/**
+ * @brief Constructor.
+ * @param maxBytes Memory cap for decoded images.
+ * @param maxEntries Number of images that can be cached at the same time.
+ * @details The table and the mutex are only created in begin().
+ */
+ImageCache::ImageCache(uint32_t maxBytes, uint16_t maxEntries)
+    : m_entries(nullptr),
+      m_mutex(nullptr),
+      m_maxBytes(maxBytes),
+      m_maxEntries(maxEntries),
+      m_clock(0),
+      m_stats{0, 0, 0, 0, 0, 0}
+{
+}
+
+/**
+ * @brief Destructor. Frees every image, even those still in use.
+ */
+ImageCache::~ImageCache() {
+    if (m_entries) {
+        for (uint16_t i = 0; i < m_maxEntries; i++) {
+            if (m_entries[i].path) {
+                drop(m_entries[i]);
+            }
+        }
+        delete[] m_entries;
+    }
+    if (m_mutex) {
+        vSemaphoreDelete(m_mutex);
+    }
+}
+
+/**
+ * @brief Allocates the entry table and the mutex.
+ * @return true if the cache can be used.
+ */
+bool ImageCache::begin() {
+    if (m_entries) {
+        return true;
+    }
+    if (m_maxEntries == 0) {
+        ESP_LOGE(TAG, "Invalid image cache size");
+        return false;
+    }
+    m_entries = new (std::nothrow) ImageCacheEntry_t[m_maxEntries];
+    m_mutex = xSemaphoreCreateMutex();
+    if (!m_entries || !m_mutex) {
+        ESP_LOGE(TAG, "Can't allocate image cache table");
+        delete[] m_entries;
+        m_entries = nullptr;
+        if (m_mutex) {
+            vSemaphoreDelete(m_mutex);
+            m_mutex = nullptr;
+        }
+        return false;
+    }
+    for (uint16_t i = 0; i < m_maxEntries; i++) {
+        m_entries[i] = {nullptr, nullptr, nullptr, 0, 0, 0, 0, 0, 0};
+    }
+    ESP_LOGD(TAG, "Image cache ready: %u entries, %u bytes", m_maxEntries, (unsigned)m_maxBytes);
+    return true;
+}
+
+/**
+ * @brief Checks if new images can be cached (table allocated and a memory cap above zero).
+ */
+bool ImageCache::isEnabled() const {
+    return m_entries != nullptr && m_maxBytes > 0;
+}
+
+/**
+ * @brief Changes the memory cap. Unused images are dropped until the cache fits.
+ * @param maxBytes New cap; 0 stops caching new images and frees every unused one.
+ */
+void ImageCache::setMaxBytes(uint32_t maxBytes) {
+    if (!m_entries) {
+        m_maxBytes = maxBytes;
+        return;
+    }
+    xSemaphoreTake(m_mutex, portMAX_DELAY);
+    m_maxBytes = maxBytes;
+    makeRoom(0, false);
+    xSemaphoreGive(m_mutex);
+}
+
+/**
+ * @brief Current memory cap.
+ */
+uint32_t ImageCache::getMaxBytes() const {
+    return m_maxBytes;
+}
+
+/**
+ * @brief Takes a reference to a cached image.
+ * @param source File system of the image.
+ * @param path Path of the file.
+ * @param countMiss false when the caller already counted a miss for this load.
+ * @return The image, or nullptr if it is not cached (counted as a miss). Every image returned
+ *         must be given back with release().
+ */
+const ImageCacheEntry_t *ImageCache::acquire(uint8_t source, const char *path, bool countMiss) {
+    if (!isEnabled() || !path) {
+        return nullptr;
+    }
+    xSemaphoreTake(m_mutex, portMAX_DELAY);
+    ImageCacheEntry_t *entry = find(source, path);
+    if (entry) {
+        entry->refs++;
+        entry->lastUse = ++m_clock;
+        m_stats.hits++;
+    } else if (countMiss) {
+        m_stats.misses++;
+    }
+    xSemaphoreGive(m_mutex);
+    return entry;
+}
+
+/**
+ * @brief Adds a decoded image to the cache and takes a reference to it.
+ * @param source File system of the image.
+ * @param path Path of the file (copied).
+ * @param width Image width.
+ * @param height Image height.
+ * @param pixels Pixels allocated with allocBuffer().
+ * @param mask Mask allocated with allocBuffer(), or nullptr.
+ * @param bytes Memory held by pixels and mask.
+ * @return The cached image, or nullptr if it was not cached (the caller keeps the buffers).
+ * @details On success the cache owns the buffers. If another task cached the same file in the
+ *          meantime, the given buffers are freed and the image already cached is returned.
+ */
+const ImageCacheEntry_t *ImageCache::insert(uint8_t source, const char *path, uint16_t width, uint16_t height,
+                                            void *pixels, uint8_t *mask, uint32_t bytes) {
+    if (!isEnabled() || !path || !pixels) {
+        return nullptr;
+    }
+    xSemaphoreTake(m_mutex, portMAX_DELAY);
+    ImageCacheEntry_t *entry = find(source, path);
+    if (entry) {
+        entry->refs++;
+        entry->lastUse = ++m_clock;
+        xSemaphoreGive(m_mutex);
+        freeBuffer(pixels);
+        freeBuffer(mask);
+        return entry;
+    }
+
+    char *copy = nullptr;
+    if (bytes <= m_maxBytes && makeRoom(bytes, true)) {
+        copy = new (std::nothrow) char[strlen(path) + 1];
+    }
+    if (!copy) {
+        m_stats.rejected++;
+        xSemaphoreGive(m_mutex);
+        ESP_LOGD(TAG, "Not caching %s (%u bytes)", path, (unsigned)bytes);
+        return nullptr;
+    }
+    strcpy(copy, path);
+    for (uint16_t i = 0; i < m_maxEntries; i++) {
+        if (!m_entries[i].path) {
+            entry = &m_entries[i];
+            break;
+        }
+    }
+    *entry = {copy, pixels, mask, bytes, ++m_clock, width, height, 1, source};
+    m_stats.entries++;
+    m_stats.bytesUsed += bytes;
+    xSemaphoreGive(m_mutex);
+    ESP_LOGD(TAG, "Cached %s: %u x %u, %u bytes", path, width, height, (unsigned)bytes);
+    return entry;
+}
+
+/**
+ * @brief Gives back a reference taken by acquire() or insert().
+ * @details The image stays cached, unless the cache is over its cap, in which case unused
+ *          images are dropped right away.
+ */
+void ImageCache::release(const ImageCacheEntry_t *entry) {
+    if (!entry || !m_entries) {
+        return;
+    }
+    xSemaphoreTake(m_mutex, portMAX_DELAY);
+    ImageCacheEntry_t *slot = &m_entries[entry - m_entries];
+    if (slot->refs > 0) {
+        slot->refs--;
+    }
+    if (slot->refs == 0 && m_stats.bytesUsed > m_maxBytes) {
+        makeRoom(0, false);
+    }
+    xSemaphoreGive(m_mutex);
+}
+
+/**
+ * @brief Frees every image not in use.
+ */
+void ImageCache::clear() {
+    if (!m_entries) {
+        return;
+    }
+    xSemaphoreTake(m_mutex, portMAX_DELAY);
+    for (uint16_t i = 0; i < m_maxEntries; i++) {
+        if (m_entries[i].path && m_entries[i].refs == 0) {
+            drop(m_entries[i]);
+        }
+    }
+    xSemaphoreGive(m_mutex);
+}
+
+/**
+ * @brief Copy of the counters.
+ */
+ImageCacheStats_t ImageCache::getStats() {
+    if (!m_mutex) {
+        return m_stats;
+    }
+    xSemaphoreTake(m_mutex, portMAX_DELAY);
+    ImageCacheStats_t stats = m_stats;
+    xSemaphoreGive(m_mutex);
+    return stats;
+}
+
+/**
+ * @brief Resets the hit, miss, eviction and rejection counters. Memory counters are kept.
+ */
+void ImageCache::resetStats() {
+    if (m_mutex) {
+        xSemaphoreTake(m_mutex, portMAX_DELAY);
+    }
+    m_stats.hits = 0;
+    m_stats.misses = 0;
+    m_stats.evictions = 0;
+    m_stats.rejected = 0;
+    if (m_mutex) {
+        xSemaphoreGive(m_mutex);
+    }
+}
+
+/**
+ * @brief Allocates a buffer for decoded pixels or masks, in PSRAM when available.
+ * @return The buffer, or nullptr if there is no memory.
+ */
+void *ImageCache::allocBuffer(size_t bytes) {
+    void *buffer = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+    if (!buffer) {
+        buffer = heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+    }
+    return buffer;
+}
+
+/**
+ * @brief Frees a buffer allocated with allocBuffer() (nullptr is ignored).
+ */
+void ImageCache::freeBuffer(void *buffer) {
+    if (buffer) {
+        heap_caps_free(buffer);
+    }
+}
+
+/**
+ * @brief Looks for the entry of a file. The mutex must be held.
+ */
+ImageCacheEntry_t *ImageCache::find(uint8_t source, const char *path) {
+    for (uint16_t i = 0; i < m_maxEntries; i++) {
+        ImageCacheEntry_t &entry = m_entries[i];
+        if (entry.path && entry.source == source && strcmp(entry.path, path) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Drops unused images, least recently used first, until another one fits.
+ * @param bytes Size of the image to add (0 = only respect the cap).
+ * @param needSlot A free entry slot is also needed.
+ * @return true if the image fits. The mutex must be held.
+ */
+bool ImageCache::makeRoom(uint32_t bytes, bool needSlot) {
+    while (m_stats.bytesUsed + bytes > m_maxBytes || (needSlot && m_stats.entries >= m_maxEntries)) {
+        ImageCacheEntry_t *oldest = nullptr;
+        for (uint16_t i = 0; i < m_maxEntries; i++) {
+            ImageCacheEntry_t &entry = m_entries[i];
+            if (entry.path && entry.refs == 0 && (!oldest || entry.lastUse < oldest->lastUse)) {
+                oldest = &entry;
+            }
+        }
+        if (!oldest) {
+            return false;
+        }
+        drop(*oldest);
+        m_stats.evictions++;
+    }
+    return true;
+}
+
+/**
+ * @brief Frees the buffers and the path of an entry and marks its slot as free.
+ */
+void ImageCache::drop(ImageCacheEntry_t &entry) {
+    freeBuffer(entry.pixels);
+    freeBuffer(entry.mask);
+    delete[] entry.path;
+    m_stats.entries--;
+    m_stats.bytesUsed -= entry.bytes;
+    entry = {nullptr, nullptr, nullptr, 0, 0, 0, 0, 0, 0};
+}
@@ -0,0 +1,86 @@
+// imagecache.h
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#ifndef DFK_IMAGE_CACHE_BYTES
+#define DFK_IMAGE_CACHE_BYTES 262144 ///< Default memory cap for decoded images (bytes, PSRAM preferred).
+#endif
+#ifndef DFK_IMAGE_CACHE_ENTRIES
+#define DFK_IMAGE_CACHE_ENTRIES 32 ///< Default number of images the cache can index.
+#endif
+
+/// @brief One decoded image held by an ImageCache.
+typedef struct {
+    char *path;       ///< Copy of the file path (nullptr = free slot).
+    void *pixels;     ///< Decoded pixels, in the format of the Image widget (pixel_t).
+    uint8_t *mask;    ///< 1-bit transparency mask, (width + 7) / 8 bytes per row (nullptr = opaque).
+    uint32_t bytes;   ///< Memory held by pixels and mask.
+    uint32_t lastUse; ///< Value of the cache clock at the last acquire, for the LRU policy.
+    uint16_t width;   ///< Image width.
+    uint16_t height;  ///< Image height.
+    uint16_t refs;    ///< Widgets currently using the image.
+    uint8_t source;   ///< File system of the image (SourceFile of the Image widget).
+} ImageCacheEntry_t;
+
+/// @brief Counters of an ImageCache.
+typedef struct {
+    uint32_t hits;      ///< Images taken from the cache.
+    uint32_t misses;    ///< Images that had to be read from their file.
+    uint32_t evictions; ///< Unused images dropped to respect the memory cap or the entry limit.
+    uint32_t rejected;  ///< Images not cached because they did not fit.
+    uint32_t bytesUsed; ///< Bytes currently held by cached images.
+    uint16_t entries;   ///< Images currently cached.
+} ImageCacheStats_t;
+
+/// @brief Decoded images shared by every Image widget, keyed by (source, path).
+/// @details When the same file is shown by several widgets, or a screen is built again, the
+///          image is read and decoded once and every widget draws from the same buffers.
+///          Entries are reference counted: acquire() and insert() add a reference, release()
+///          drops it. Only entries nobody uses can be evicted, least recently used first, so
+///          the memory cap bounds what the cache keeps; an image that does not fit next to the
+///          ones in use is not cached and its widget keeps its own copy.
+///          Buffers are allocated with allocBuffer() (PSRAM when available) and freed by the
+///          cache. All methods can be called from any task.
+class ImageCache {
+public:
+    ImageCache(uint32_t maxBytes, uint16_t maxEntries);
+    ~ImageCache();
+
+    bool begin();
+    bool isEnabled() const;
+    void setMaxBytes(uint32_t maxBytes);
+    uint32_t getMaxBytes() const;
+
+    const ImageCacheEntry_t *acquire(uint8_t source, const char *path, bool countMiss = true);
+    const ImageCacheEntry_t *insert(uint8_t source, const char *path, uint16_t width, uint16_t height,
+                                    void *pixels, uint8_t *mask, uint32_t bytes);
+    void release(const ImageCacheEntry_t *entry);
+    void clear();
+
+    ImageCacheStats_t getStats();
+    void resetStats();
+
+    static void *allocBuffer(size_t bytes);
+    static void freeBuffer(void *buffer);
+
+private:
+    static const char *TAG; ///< Tag estática para identificação em logs.
+
+    ImageCacheEntry_t *find(uint8_t source, const char *path);
+    bool makeRoom(uint32_t bytes, bool needSlot);
+    void drop(ImageCacheEntry_t &entry);
+
+    ImageCacheEntry_t *m_entries; ///< Entry table, m_maxEntries slots.
+    SemaphoreHandle_t m_mutex;    ///< Guards the table and the counters.
+    uint32_t m_maxBytes;          ///< Memory cap for cached images.
+    uint16_t m_maxEntries;        ///< Number of entry slots.
+    uint32_t m_clock;             ///< Incremented on every acquire; stamps ImageCacheEntry_t::lastUse.
+    ImageCacheStats_t m_stats;    ///< Hit, miss and memory counters.
+};
+
+#endif // IMAGECACHE_H
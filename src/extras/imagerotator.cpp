@@ -0,0 +1,395 @@
+// imagerotator.cpp
+#include "imagerotator.h"
+
+#if defined(DISP_DEFAULT)
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+#include <math.h>
+#include <string.h>
+
+const char *ImageRotator::TAG = "ImageRotator";
+
+namespace {
+
+/// @brief Floor of a / b for b > 0.
+inline int64_t floorDiv(int64_t a, int64_t b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/**
+ * @brief Narrows [k0, k1) to the steps k for which 0 <= start + k * step < limit.
+ * @details Exact integer solution of the two inequalities, so the span matches the positions
+ *          the walk computes by adding step.
+ */
+inline void clipSpan(int64_t start, int32_t step, int64_t limit, int32_t &k0, int32_t &k1) {
+    int64_t lo;
+    int64_t hi;
+    if (step == 0) {
+        if (start < 0 || start >= limit) {
+            k1 = k0;
+        }
+        return;
+    }
+    if (step > 0) {
+        lo = -floorDiv(start, step);
+        hi = floorDiv(limit - 1 - start, step);
+    } else {
+        lo = floorDiv(start - limit, -step) + 1;
+        hi = floorDiv(start, -step);
+    }
+    if (lo > k0) {
+        k0 = lo > k1 ? k1 : static_cast<int32_t>(lo);
+    }
+    if (hi + 1 < k1) {
+        k1 = hi + 1 < k0 ? k0 : static_cast<int32_t>(hi + 1);
+    }
+}
+
+inline bool maskBit(const uint8_t *row, int32_t x) {
+    return row[x >> 3] & (0x80 >> (x & 7));
+}
+
+/**
+ * @brief Visits the visible source pixel of every destination pixel in an area.
+ * @param top,bottom Destination rows [top, bottom).
+ * @param left,right Destination columns [left, right).
+ * @param emit Called with (x, y, color) row by row, left to right.
+ */
+template <typename Map, typename Fn>
+void walk(const Map &map, const uint16_t *pixels, const uint8_t *mask, uint16_t width, uint16_t height,
+          int32_t top, int32_t bottom, int32_t left, int32_t right, Fn emit) {
+    const int64_t limitX = static_cast<int64_t>(width) << 16;
+    const int64_t limitY = static_cast<int64_t>(height) << 16;
+    const uint16_t maskStride = (width + 7) / 8;
+    const int64_t u = (static_cast<int64_t>(left) << 16) + 0x8000 - map.x;
+    for (int32_t y = top; y < bottom; y++) {
+        // Source position of the centre of the first pixel of the row
+        const int64_t v = (static_cast<int64_t>(y) << 16) + 0x8000 - map.y;
+        const int64_t startX = map.pivotX + ((u * map.cos + v * map.sin) >> 16);
+        const int64_t startY = map.pivotY + ((v * map.cos - u * map.sin) >> 16);
+        int32_t k0 = 0;
+        int32_t k1 = right - left;
+        clipSpan(startX, map.cos, limitX, k0, k1);
+        clipSpan(startY, -map.sin, limitY, k0, k1);
+        int32_t sx = static_cast<int32_t>(startX + static_cast<int64_t>(k0) * map.cos);
+        int32_t sy = static_cast<int32_t>(startY - static_cast<int64_t>(k0) * map.sin);
+        for (int32_t k = k0; k < k1; k++, sx += map.cos, sy -= map.sin) {
+            const int32_t px = sx >> 16;
+            const int32_t py = sy >> 16;
+            if (mask && !maskBit(mask + py * maskStride, px)) {
+                continue;
+            }
+            emit(left + k, y, pixels[py * width + px]);
+        }
+    }
+}
+
+/// @brief Gathers horizontally adjacent pixels and sends them to the display in one call.
+struct RunWriter {
+    Arduino_GFX *gfx;
+    uint16_t buffer[DFK_ROTATOR_CHUNK];
+    int32_t x = 0;
+    int32_t y = 0;
+    uint16_t count = 0;
+
+    void put(int32_t px, int32_t py, uint16_t color) {
+        if (count && (py != y || px != x + count || count == DFK_ROTATOR_CHUNK)) {
+            flush();
+        }
+        if (!count) {
+            x = px;
+            y = py;
+        }
+        buffer[count++] = color;
+    }
+
+    void flush() {
+        if (count) {
+            gfx->draw16bitRGBBitmap(x, y, buffer, count, 1);
+            count = 0;
+        }
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Constructor.
+ * @param cacheResult Keep a rotation drawn twice in a row to redraw it without rotating again.
+ */
+ImageRotator::ImageRotator(bool cacheResult)
+    : m_cacheResult(cacheResult),
+      m_runs(nullptr),
+      m_pixels(nullptr),
+      m_runCount(0),
+      m_renderFailed(false),
+      m_source(nullptr),
+      m_sourceMask(nullptr),
+      m_sourceWidth(0),
+      m_sourceHeight(0),
+      m_angle(0.0f),
+      m_pivotX(0.0f),
+      m_pivotY(0.0f),
+      m_fracX(0),
+      m_fracY(0)
+{
+}
+
+/**
+ * @brief Destructor. Frees the cached image.
+ */
+ImageRotator::~ImageRotator() {
+    clear();
+}
+
+/**
+ * @brief Screen area covered by a rotated image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param angle Angle in degrees, clockwise on the screen.
+ * @param pivotX Point of the image the rotation is around (may be fractional, e.g. the centre).
+ * @param pivotY Point of the image the rotation is around.
+ * @param x Point of the screen where the pivot is drawn.
+ * @param y Point of the screen where the pivot is drawn.
+ */
+RotatedBox_t ImageRotator::bounds(uint16_t width, uint16_t height, float angle, float pivotX, float pivotY,
+                                  float x, float y) {
+    return mapping(width, height, angle, pivotX, pivotY, x, y).box;
+}
+
+/**
+ * @brief Draws an image rotated around a pivot.
+ * @param gfx Display (or canvas) to draw on; the image is clipped to its size.
+ * @param pixels Image pixels, RGB565.
+ * @param mask 1-bit mask of the image, or nullptr if every pixel is visible.
+ * @param width Image width.
+ * @param height Image height.
+ * @param angle Angle in degrees, clockwise on the screen.
+ * @param pivotX Point of the image the rotation is around.
+ * @param pivotY Point of the image the rotation is around.
+ * @param x Point of the screen where the pivot is drawn.
+ * @param y Point of the screen where the pivot is drawn.
+ * @details Pixels outside the rotated image are not touched.
+ */
+void ImageRotator::draw(Arduino_GFX *gfx, const uint16_t *pixels, const uint8_t *mask, uint16_t width,
+                        uint16_t height, float angle, float pivotX, float pivotY, float x, float y) {
+    if (!gfx || !pixels || width == 0 || height == 0) {
+        return;
+    }
+    const Mapping_t map = mapping(width, height, angle, pivotX, pivotY, x, y);
+    if (map.box.width == 0 || map.box.height == 0) {
+        return;
+    }
+
+    if (m_cacheResult) {
+        const int32_t fracX = map.x & 0xFFFF;
+        const int32_t fracY = map.y & 0xFFFF;
+        if (!sameKey(pixels, mask, width, height, angle, pivotX, pivotY, fracX, fracY)) {
+            // New rotation: drawn on the fly, cached only if the next draw repeats it
+            clear();
+            m_source = pixels;
+            m_sourceMask = mask;
+            m_sourceWidth = width;
+            m_sourceHeight = height;
+            m_angle = angle;
+            m_pivotX = pivotX;
+            m_pivotY = pivotY;
+            m_fracX = fracX;
+            m_fracY = fracY;
+        } else if (!m_runs && !m_renderFailed) {
+            m_renderFailed = !render(map, pixels, mask, width, height);
+        }
+        if (m_runs) {
+            drawCached(gfx, static_cast<int16_t>(map.x >> 16), static_cast<int16_t>(map.y >> 16));
+            return;
+        }
+    }
+
+    const int32_t left = max<int32_t>(map.box.x, 0);
+    const int32_t top = max<int32_t>(map.box.y, 0);
+    const int32_t right = min<int32_t>(map.box.x + map.box.width, gfx->width());
+    const int32_t bottom = min<int32_t>(map.box.y + map.box.height, gfx->height());
+    if (left >= right || top >= bottom) {
+        return;
+    }
+    RunWriter writer;
+    writer.gfx = gfx;
+    walk(map, pixels, mask, width, height, top, bottom, left, right,
+         [&](int32_t px, int32_t py, uint16_t color) { writer.put(px, py, color); });
+    writer.flush();
+}
+
+/**
+ * @brief Frees the cached image and forgets the last rotation.
+ */
+void ImageRotator::clear() {
+    if (m_runs) {
+        heap_caps_free(m_runs);
+        m_runs = nullptr;
+        m_pixels = nullptr;
+    }
+    m_runCount = 0;
+    m_renderFailed = false;
+    m_source = nullptr;
+}
+
+/**
+ * @brief Checks if a rotated image is cached.
+ */
+bool ImageRotator::isCached() const {
+    return m_runs != nullptr;
+}
+
+/**
+ * @brief Converts a rotation to Q16 and computes its destination box.
+ * @details The box has every pixel whose centre can fall inside the rotated image.
+ */
+ImageRotator::Mapping_t ImageRotator::mapping(uint16_t width, uint16_t height, float angle, float pivotX,
+                                              float pivotY, float x, float y) {
+    const float radians = angle * DEG_TO_RAD;
+    const float cosA = cosf(radians);
+    const float sinA = sinf(radians);
+
+    Mapping_t map;
+    map.cos = static_cast<int32_t>(lroundf(cosA * 65536.0f));
+    map.sin = static_cast<int32_t>(lroundf(sinA * 65536.0f));
+    map.pivotX = static_cast<int32_t>(lroundf(pivotX * 65536.0f));
+    map.pivotY = static_cast<int32_t>(lroundf(pivotY * 65536.0f));
+    map.x = static_cast<int32_t>(lroundf(x * 65536.0f));
+    map.y = static_cast<int32_t>(lroundf(y * 65536.0f));
+
+    // Corners of the image, relative to the pivot, rotated onto the screen
+    const float cornersX[4] = {-pivotX, width - pivotX, -pivotX, width - pivotX};
+    const float cornersY[4] = {-pivotY, -pivotY, height - pivotY, height - pivotY};
+    float minX = INFINITY, maxX = -INFINITY, minY = INFINITY, maxY = -INFINITY;
+    for (uint8_t i = 0; i < 4; i++) {
+        const float sx = cornersX[i] * cosA - cornersY[i] * sinA + x;
+        const float sy = cornersX[i] * sinA + cornersY[i] * cosA + y;
+        minX = min(minX, sx);
+        maxX = max(maxX, sx);
+        minY = min(minY, sy);
+        maxY = max(maxY, sy);
+    }
+    // The margin keeps rounding noise from adding an empty row or column
+    const int32_t left = static_cast<int32_t>(floorf(minX + 1e-3f));
+    const int32_t top = static_cast<int32_t>(floorf(minY + 1e-3f));
+    const int32_t right = static_cast<int32_t>(ceilf(maxX - 1e-3f));
+    const int32_t bottom = static_cast<int32_t>(ceilf(maxY - 1e-3f));
+    map.box = {static_cast<int16_t>(left), static_cast<int16_t>(top),
+               static_cast<uint16_t>(max<int32_t>(right - left, 0)), static_cast<uint16_t>(max<int32_t>(bottom - top, 0))};
+    return map;
+}
+
+/**
+ * @brief Checks if a rotation is the one drawn last.
+ */
+bool ImageRotator::sameKey(const uint16_t *pixels, const uint8_t *mask, uint16_t width, uint16_t height,
+                           float angle, float pivotX, float pivotY, int32_t fracX, int32_t fracY) const {
+    return m_source && m_source == pixels && m_sourceMask == mask && m_sourceWidth == width &&
+           m_sourceHeight == height && m_angle == angle && m_pivotX == pivotX && m_pivotY == pivotY &&
+           m_fracX == fracX && m_fracY == fracY;
+}
+
+/**
+ * @brief Allocates the cache block: PSRAM, or a small block of internal RAM without PSRAM.
+ */
+void *ImageRotator::allocCache(uint32_t bytes) {
+    if (bytes <= DFK_ROTATOR_CACHE_BYTES) {
+        void *block = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+        if (block) {
+            return block;
+        }
+    }
+    if (bytes <= DFK_ROTATOR_CACHE_INTERNAL_BYTES) {
+        return heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Rotates the image into the cache as runs of visible pixels.
+ * @details The runs are counted first, so the cache is one block of the exact size: the run
+ *          table followed by the pixels of every run.
+ * @return false if the image does not fit the cache limits or there is no memory.
+ */
+bool ImageRotator::render(const Mapping_t &map, const uint16_t *pixels, const uint8_t *mask, uint16_t width,
+                          uint16_t height) {
+    const int32_t boxX = map.box.x;
+    const int32_t boxY = map.box.y;
+    const int32_t boxRight = boxX + map.box.width;
+    const int32_t boxBottom = boxY + map.box.height;
+
+    uint32_t runs = 0;
+    uint32_t count = 0;
+    int32_t lastX = 0;
+    int32_t lastY = 0;
+    walk(map, pixels, mask, width, height, boxY, boxBottom, boxX, boxRight,
+         [&](int32_t px, int32_t py, uint16_t color) {
+             (void)color;
+             if (!count || py != lastY || px != lastX + 1) {
+                 runs++;
+             }
+             lastX = px;
+             lastY = py;
+             count++;
+         });
+    if (!runs) {
+        return false;
+    }
+    const uint32_t runBytes = runs * sizeof(Run_t);
+    const uint32_t bytes = runBytes + count * sizeof(uint16_t);
+    m_runs = static_cast<Run_t *>(allocCache(bytes));
+    if (!m_runs) {
+        ESP_LOGD(TAG, "Rotated image not cached (%u bytes)", (unsigned)bytes);
+        return false;
+    }
+    m_pixels = reinterpret_cast<uint16_t *>(reinterpret_cast<uint8_t *>(m_runs) + runBytes);
+
+    const int32_t originX = map.x >> 16;
+    const int32_t originY = map.y >> 16;
+    Run_t *run = m_runs - 1;
+    uint16_t *out = m_pixels;
+    count = 0;
+    walk(map, pixels, mask, width, height, boxY, boxBottom, boxX, boxRight,
+         [&](int32_t px, int32_t py, uint16_t color) {
+             if (!count || py != lastY || px != lastX + 1) {
+                 ++run;
+                 *run = {static_cast<int16_t>(px - originX), static_cast<int16_t>(py - originY), 0};
+             }
+             run->length++;
+             *out++ = color;
+             lastX = px;
+             lastY = py;
+             count++;
+         });
+    m_runCount = runs;
+    return true;
+}
+
+/**
+ * @brief Sends the cached runs to the display, clipped to its size.
+ * @param x Integer part of the point where the pivot is drawn.
+ * @param y Integer part of the point where the pivot is drawn.
+ */
+void ImageRotator::drawCached(Arduino_GFX *gfx, int16_t x, int16_t y) {
+    const int32_t screenWidth = gfx->width();
+    const int32_t screenHeight = gfx->height();
+    uint16_t *pixels = m_pixels;
+    for (uint32_t i = 0; i < m_runCount; i++) {
+        const Run_t &run = m_runs[i];
+        uint16_t *data = pixels;
+        pixels += run.length;
+        const int32_t row = y + run.y;
+        if (row < 0 || row >= screenHeight) {
+            continue;
+        }
+        const int32_t start = x + run.x;
+        const int32_t left = max<int32_t>(start, 0);
+        const int32_t right = min<int32_t>(start + run.length, screenWidth);
+        if (left < right) {
+            gfx->draw16bitRGBBitmap(left, row, data + (left - start), right - left, 1);
+        }
+    }
+}
+
+#endif // DISP_DEFAULT
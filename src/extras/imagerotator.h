@@ -0,0 +1,101 @@
+// imagerotator.h
+#ifndef IMAGEROTATOR_H
+#define IMAGEROTATOR_H
+
+#include <stdint.h>
+#include "../widgets/widgetsetup.h"
+
+#if defined(DISP_DEFAULT)
+#include <Arduino_GFX_Library.h>
+
+#ifndef DFK_ROTATOR_CHUNK
+#define DFK_ROTATOR_CHUNK 128 ///< Pixels per display call when an image is rotated without the cache.
+#endif
+#ifndef DFK_ROTATOR_CACHE_BYTES
+#define DFK_ROTATOR_CACHE_BYTES 131072 ///< Largest rotated image (pixels and runs, bytes) an ImageRotator keeps in PSRAM.
+#endif
+#ifndef DFK_ROTATOR_CACHE_INTERNAL_BYTES
+#define DFK_ROTATOR_CACHE_INTERNAL_BYTES 4096 ///< Largest rotated image kept in internal RAM when there is no PSRAM (0 = never).
+#endif
+
+/// @brief Screen area covered by a rotated image (may start left of or above the screen).
+typedef struct {
+    int16_t x;       ///< Left column.
+    int16_t y;       ///< Top row.
+    uint16_t width;  ///< Columns.
+    uint16_t height; ///< Rows.
+} RotatedBox_t;
+
+/// @brief Draws RGB565 images rotated by any angle around a pivot.
+/// @details Every pixel of the destination box is mapped back to the source (inverse mapping),
+///          so the result has no holes. Coordinates are Q16 fixed point: for each destination
+///          row the range of columns that falls inside the source is solved exactly, and the
+///          source position advances by (cos, -sin) per column. Visible pixels are gathered
+///          into row buffers and sent with draw16bitRGBBitmap(), one call per run.
+///          The source may have a 1-bit mask ((width + 7) / 8 bytes per row, set = visible).
+///          With the cache, a rotation drawn twice in a row (same image, angle, pivot and
+///          sub-pixel offset) is kept as its runs of visible pixels, and later draws only send
+///          the stored runs. A rotation that changes on every draw (a moving needle) is always
+///          rotated on the fly and never allocates. The cache holds one image, in PSRAM up to
+///          DFK_ROTATOR_CACHE_BYTES, or in internal RAM up to DFK_ROTATOR_CACHE_INTERNAL_BYTES;
+///          larger images are rotated on the fly.
+///          The source buffers must not change while cached; call clear() when they do.
+class ImageRotator {
+public:
+    explicit ImageRotator(bool cacheResult = true);
+    ~ImageRotator();
+
+    static RotatedBox_t bounds(uint16_t width, uint16_t height, float angle, float pivotX, float pivotY,
+                               float x, float y);
+    void draw(Arduino_GFX *gfx, const uint16_t *pixels, const uint8_t *mask, uint16_t width, uint16_t height,
+              float angle, float pivotX, float pivotY, float x, float y);
+    void clear();
+    bool isCached() const;
+
+private:
+    static const char *TAG; ///< Tag estática para identificação em logs.
+
+    /// @brief Horizontal run of visible pixels of the cached image.
+    typedef struct {
+        int16_t x;       ///< First column, relative to the integer part of the pivot point.
+        int16_t y;       ///< Row, relative to the integer part of the pivot point.
+        uint16_t length; ///< Pixels in the run.
+    } Run_t;
+
+    /// @brief Q16 parameters of one rotation.
+    typedef struct {
+        int32_t cos;      ///< Cosine of the angle.
+        int32_t sin;      ///< Sine of the angle.
+        int32_t pivotX;   ///< Pivot in the source.
+        int32_t pivotY;   ///< Pivot in the source.
+        int32_t x;        ///< Point of the screen where the pivot lands.
+        int32_t y;        ///< Point of the screen where the pivot lands.
+        RotatedBox_t box; ///< Destination box.
+    } Mapping_t;
+
+    static Mapping_t mapping(uint16_t width, uint16_t height, float angle, float pivotX, float pivotY, float x, float y);
+    bool sameKey(const uint16_t *pixels, const uint8_t *mask, uint16_t width, uint16_t height, float angle,
+                 float pivotX, float pivotY, int32_t fracX, int32_t fracY) const;
+    bool render(const Mapping_t &map, const uint16_t *pixels, const uint8_t *mask, uint16_t width, uint16_t height);
+    void drawCached(Arduino_GFX *gfx, int16_t x, int16_t y);
+    static void *allocCache(uint32_t bytes);
+
+    bool m_cacheResult;         ///< Keep a rotation drawn twice in a row.
+    Run_t *m_runs;              ///< Runs of the cached image, row by row (nullptr = empty cache).
+    uint16_t *m_pixels;         ///< Pixels of the runs, one after the other (same block as m_runs).
+    uint32_t m_runCount;        ///< Number of runs.
+    bool m_renderFailed;        ///< The rotation of the key does not fit the cache; don't retry.
+    const uint16_t *m_source;   ///< Source of the last rotation (nullptr = no key).
+    const uint8_t *m_sourceMask; ///< Mask of the source.
+    uint16_t m_sourceWidth;     ///< Source width.
+    uint16_t m_sourceHeight;    ///< Source height.
+    float m_angle;              ///< Angle of the last rotation.
+    float m_pivotX;             ///< Pivot of the last rotation.
+    float m_pivotY;             ///< Pivot of the last rotation.
+    int32_t m_fracX;            ///< Sub-pixel part of the pivot point (Q16).
+    int32_t m_fracY;            ///< Sub-pixel part of the pivot point (Q16).
+};
+
+#endif // DISP_DEFAULT
+
+#endif // IMAGEROTATOR_H
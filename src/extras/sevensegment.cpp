@@ -0,0 +1,310 @@
+// sevensegment.cpp
+#include "sevensegment.h"
+
+#if defined(DISP_DEFAULT)
+#include "sparsefont.h"
+
+namespace {
+
+// Segment bits: a (top), b (top right), c (bottom right), d (bottom), e (bottom left),
+// f (top left), g (middle), then the dots of the narrow cells.
+constexpr uint16_t SEG_A = 0x001, SEG_B = 0x002, SEG_C = 0x004, SEG_D = 0x008;
+constexpr uint16_t SEG_E = 0x010, SEG_F = 0x020, SEG_G = 0x040;
+constexpr uint16_t SEG_DOT = 0x080;   ///< Dot on the baseline ('.').
+constexpr uint16_t SEG_COLON = 0x100; ///< Two dots at 1/3 and 2/3 of the height (':').
+constexpr uint16_t SEG_ALL = 0x07F;
+constexpr uint16_t SEG_NARROW = SEG_DOT | SEG_COLON;
+constexpr uint16_t SEG_WIDE = 0x8000; ///< Marks a full cell that has no lit segment (' ').
+
+uint8_t thicknessOf(const SevenSegmentStyle_t *style) {
+    if (style->thickness) {
+        return style->thickness;
+    }
+    const uint16_t t = style->digitHeight / 10;
+    return t < 2 ? 2 : (t > 255 ? 255 : t);
+}
+
+uint8_t gapOf(const SevenSegmentStyle_t *style, uint8_t thickness) {
+    if (style->gap) {
+        return style->gap;
+    }
+    return thickness < 8 ? 1 : thickness / 4;
+}
+
+/// @brief Bar with pointed ends along one axis.
+/// @param horizontal true for a horizontal bar.
+/// @param center Y (horizontal) or X (vertical) of the bar axis.
+/// @param from First pixel of the bar along its axis (tip).
+/// @param to Last pixel of the bar along its axis (tip).
+void drawBar(Arduino_GFX *gfx, bool horizontal, int16_t center, int16_t from, int16_t to,
+             uint8_t thickness, uint16_t color) {
+    if (to < from) {
+        return;
+    }
+    const int16_t half = thickness / 2;
+    const int16_t side0 = center - half;
+    const int16_t side1 = side0 + thickness - 1;
+    if (to - from < 2 * half + 1) {
+        if (horizontal) {
+            gfx->fillRect(from, side0, to - from + 1, thickness, color);
+        } else {
+            gfx->fillRect(side0, from, thickness, to - from + 1, color);
+        }
+        return;
+    }
+    if (horizontal) {
+        gfx->fillRect(from + half, side0, to - from - 2 * half + 1, thickness, color);
+        if (half > 0) {
+            gfx->fillTriangle(from, center, from + half, side0, from + half, side1, color);
+            gfx->fillTriangle(to, center, to - half, side0, to - half, side1, color);
+        }
+    } else {
+        gfx->fillRect(side0, from + half, thickness, to - from - 2 * half + 1, color);
+        if (half > 0) {
+            gfx->fillTriangle(center, from, side0, from + half, side1, from + half, color);
+            gfx->fillTriangle(center, to, side0, to - half, side1, to - half, color);
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Gets the segments of a character.
+ * @param code Codepoint (the degree sign is U+00B0).
+ * @return Segment bits; 0 if the character has no seven-segment form (it is skipped).
+ */
+uint16_t SevenSegmentRenderer::segments(uint16_t code) {
+    switch (code) {
+        case '0': case 'O': case 'D': return SEG_ALL & ~SEG_G;
+        case '1': case 'I': case 'l': return SEG_B | SEG_C;
+        case '2': case 'Z': case 'z': return SEG_A | SEG_B | SEG_D | SEG_E | SEG_G;
+        case '3': return SEG_A | SEG_B | SEG_C | SEG_D | SEG_G;
+        case '4': return SEG_B | SEG_C | SEG_F | SEG_G;
+        case '5': case 'S': case 's': return SEG_A | SEG_C | SEG_D | SEG_F | SEG_G;
+        case '6': return SEG_ALL & ~SEG_B;
+        case '7': return SEG_A | SEG_B | SEG_C;
+        case '8': case 'B': return SEG_ALL;
+        case '9': case 'g': return SEG_ALL & ~SEG_E;
+        case 'A': case 'a': case 'R': return SEG_ALL & ~SEG_D;
+        case 'b': return SEG_C | SEG_D | SEG_E | SEG_F | SEG_G;
+        case 'C': case '[': return SEG_A | SEG_D | SEG_E | SEG_F;
+        case 'c': return SEG_D | SEG_E | SEG_G;
+        case 'd': return SEG_B | SEG_C | SEG_D | SEG_E | SEG_G;
+        case 'E': case 'e': return SEG_A | SEG_D | SEG_E | SEG_F | SEG_G;
+        case 'F': case 'f': return SEG_A | SEG_E | SEG_F | SEG_G;
+        case 'G': return SEG_A | SEG_C | SEG_D | SEG_E | SEG_F;
+        case 'H': case 'X': case 'x': return SEG_B | SEG_C | SEG_E | SEG_F | SEG_G;
+        case 'h': return SEG_C | SEG_E | SEG_F | SEG_G;
+        case 'i': return SEG_E;
+        case 'J': case 'j': return SEG_B | SEG_C | SEG_D | SEG_E;
+        case 'L': return SEG_D | SEG_E | SEG_F;
+        case 'N': case 'n': return SEG_C | SEG_E | SEG_G;
+        case 'o': return SEG_C | SEG_D | SEG_E | SEG_G;
+        case 'P': case 'p': return SEG_A | SEG_B | SEG_E | SEG_F | SEG_G;
+        case 'q': case 'Q': return SEG_A | SEG_B | SEG_C | SEG_F | SEG_G;
+        case 'r': return SEG_E | SEG_G;
+        case 't': case 'T': return SEG_D | SEG_E | SEG_F | SEG_G;
+        case 'U': case 'V': return SEG_B | SEG_C | SEG_D | SEG_E | SEG_F;
+        case 'u': case 'v': return SEG_C | SEG_D | SEG_E;
+        case 'Y': case 'y': return SEG_B | SEG_C | SEG_D | SEG_F | SEG_G;
+        case ']': return SEG_A | SEG_B | SEG_C | SEG_D;
+        case '-': return SEG_G;
+        case '_': return SEG_D;
+        case '=': return SEG_D | SEG_G;
+        case '\'': return SEG_B;
+        case '"': return SEG_B | SEG_F;
+        case 0x00B0: case '*': return SEG_A | SEG_B | SEG_F | SEG_G;
+        case ' ': return SEG_WIDE;
+        case '.': case ',': return SEG_DOT;
+        case ':': return SEG_COLON;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Checks if a character uses the narrow cell of the dots.
+ */
+bool SevenSegmentRenderer::isNarrow(uint16_t mask) {
+    return (mask & SEG_NARROW) != 0;
+}
+
+/**
+ * @brief Distance from a cell to the next one.
+ */
+int16_t SevenSegmentRenderer::advance(const SevenSegmentStyle_t *style, uint16_t mask) {
+    return (isNarrow(mask) ? thicknessOf(style) : style->digitWidth) + style->spacing;
+}
+
+/**
+ * @brief Gets the box of a string.
+ * @param style Readout style.
+ * @param text String (UTF-8 for the degree sign).
+ * @param x Cursor X.
+ * @param y Baseline.
+ * @return Box of the cells; width 0 for an empty string.
+ */
+TextBound_t SevenSegmentRenderer::getTextBounds(const SevenSegmentStyle_t *style, const char *text, int16_t x, int16_t y) {
+    TextBound_t area = {x, static_cast<int16_t>(y - style->digitHeight), 0, 0};
+    int16_t width = 0;
+    for (const char *p = text; *p;) {
+        const uint16_t mask = segments(SparseFontRenderer::decode(p));
+        if (mask) {
+            width += advance(style, mask);
+        }
+    }
+    if (width > style->spacing) {
+        area.width = static_cast<uint16_t>(width - style->spacing);
+        area.height = style->digitHeight;
+    }
+    return area;
+}
+
+/**
+ * @brief Draws the segments of one cell.
+ * @param mask Lit segments of the character.
+ * @param changed Segments to paint: lit ones with color, the others with offColor.
+ */
+void SevenSegmentRenderer::drawCell(Arduino_GFX *gfx, const SevenSegmentStyle_t *style, int16_t x, int16_t y,
+                                    uint16_t mask, uint16_t changed, uint16_t color, uint16_t offColor) {
+    const uint8_t t = thicknessOf(style);
+    const uint8_t g = gapOf(style, t);
+    const int16_t half = t / 2;
+    const int16_t h = style->digitHeight;
+    const int16_t top = y - h;
+
+    if (isNarrow(mask | changed)) {
+        if (changed & SEG_DOT) {
+            gfx->fillRect(x, y - t, t, t, (mask & SEG_DOT) ? color : offColor);
+        }
+        if (changed & SEG_COLON) {
+            const uint16_t c = (mask & SEG_COLON) ? color : offColor;
+            gfx->fillRect(x, top + h / 3 - half, t, t, c);
+            gfx->fillRect(x, top + (2 * h) / 3 - half, t, t, c);
+        }
+        return;
+    }
+
+    // Axis of the bars: vertical ones on the cell edges, horizontal ones at top, middle, bottom
+    const int16_t left = x + half;
+    const int16_t right = x + style->digitWidth - t + half;
+    const int16_t upper = top + half;
+    const int16_t middle = top + (h - t) / 2 + half;
+    const int16_t lower = top + h - t + half;
+
+    auto bar = [&](uint16_t bit, bool horizontal, int16_t center, int16_t from, int16_t to) {
+        if (changed & bit) {
+            drawBar(gfx, horizontal, center, from + g, to - g, t, (mask & bit) ? color : offColor);
+        }
+    };
+    bar(SEG_A, true, upper, left, right);
+    bar(SEG_B, false, right, upper, middle);
+    bar(SEG_C, false, right, middle, lower);
+    bar(SEG_D, true, lower, left, right);
+    bar(SEG_E, false, left, middle, lower);
+    bar(SEG_F, false, left, upper, middle);
+    bar(SEG_G, true, middle, left, right);
+}
+
+/**
+ * @brief Draws a string.
+ * @param gfx Display (or canvas) to draw on.
+ * @param style Readout style.
+ * @param x Cursor X.
+ * @param y Baseline.
+ * @param text String to draw.
+ * @param color Color of the lit segments.
+ * @param bgColor Color already painted behind the text; unlit segments are skipped when
+ *                style->offColor is the same.
+ * @return Cursor X after the last cell.
+ */
+int16_t SevenSegmentRenderer::drawText(Arduino_GFX *gfx, const SevenSegmentStyle_t *style, int16_t x, int16_t y,
+                                       const char *text, uint16_t color, uint16_t bgColor) {
+    if (!gfx || !style || !text) {
+        return x;
+    }
+    const bool drawOff = style->offColor != bgColor;
+    gfx->startWrite();
+    for (const char *p = text; *p;) {
+        const uint16_t mask = segments(SparseFontRenderer::decode(p));
+        if (!mask) {
+            continue;
+        }
+        const uint16_t cell = isNarrow(mask) ? (mask & SEG_NARROW) : SEG_ALL;
+        drawCell(gfx, style, x, y, mask, drawOff ? cell : (mask & cell), color, style->offColor);
+        x += advance(style, mask);
+    }
+    gfx->endWrite();
+    return x;
+}
+
+/**
+ * @brief Checks if drawChanges() can turn one string into the other.
+ * @return true if both have the same sequence of full and narrow cells.
+ */
+bool SevenSegmentRenderer::sameLayout(const char *oldText, const char *newText) {
+    const char *a = oldText;
+    const char *b = newText;
+    while (true) {
+        uint16_t maskA = 0, maskB = 0;
+        while (*a && !(maskA = segments(SparseFontRenderer::decode(a)))) {}
+        while (*b && !(maskB = segments(SparseFontRenderer::decode(b)))) {}
+        if (!maskA || !maskB) {
+            return !maskA && !maskB;
+        }
+        if (isNarrow(maskA) != isNarrow(maskB)) {
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief Checks if two styles draw the same pixels.
+ * @param a First style.
+ * @param b Second style.
+ * @return true if every field is equal (both nullptr counts as equal).
+ */
+bool SevenSegmentRenderer::sameStyle(const SevenSegmentStyle_t *a, const SevenSegmentStyle_t *b) {
+    if (!a || !b) {
+        return a == b;
+    }
+    return a->digitWidth == b->digitWidth && a->digitHeight == b->digitHeight && a->thickness == b->thickness &&
+           a->gap == b->gap && a->spacing == b->spacing && a->offColor == b->offColor;
+}
+
+/**
+ * @brief Repaints only the segments that differ between the drawn string and a new one.
+ * @param gfx Display to draw on.
+ * @param style Readout style the old string was drawn with.
+ * @param x Cursor X of the old string.
+ * @param y Baseline of the old string.
+ * @param oldText String on the panel.
+ * @param newText String to show; must have the layout of oldText (sameLayout()).
+ * @param color Color of the lit segments.
+ * @details Segments that turn off are painted with style->offColor.
+ */
+void SevenSegmentRenderer::drawChanges(Arduino_GFX *gfx, const SevenSegmentStyle_t *style, int16_t x, int16_t y,
+                                       const char *oldText, const char *newText, uint16_t color) {
+    if (!gfx || !style || !oldText || !newText) {
+        return;
+    }
+    const char *a = oldText;
+    const char *b = newText;
+    gfx->startWrite();
+    while (true) {
+        uint16_t maskA = 0, maskB = 0;
+        while (*a && !(maskA = segments(SparseFontRenderer::decode(a)))) {}
+        while (*b && !(maskB = segments(SparseFontRenderer::decode(b)))) {}
+        if (!maskA || !maskB) {
+            break;
+        }
+        const uint16_t changed = (maskA ^ maskB) & (SEG_ALL | SEG_NARROW);
+        if (changed) {
+            drawCell(gfx, style, x, y, maskB, changed, color, style->offColor);
+        }
+        x += advance(style, maskB);
+    }
+    gfx->endWrite();
+}
+
+#endif // DISP_DEFAULT
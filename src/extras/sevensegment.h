@@ -0,0 +1,50 @@
+// sevensegment.h
+#ifndef SEVENSEGMENT_H
+#define SEVENSEGMENT_H
+
+#include <stdint.h>
+#include "../widgets/widgetsetup.h"
+#include "baseTypes.h"
+
+#if defined(DISP_DEFAULT)
+#include <Arduino_GFX_Library.h>
+
+/// @brief Size and look of a seven-segment readout.
+typedef struct {
+    uint16_t digitWidth;  ///< Width of a digit cell in pixels.
+    uint16_t digitHeight; ///< Height of a digit in pixels (from the top to the baseline).
+    uint8_t thickness;    ///< Segment thickness; 0 = digitHeight / 10 (at least 2).
+    uint8_t gap;          ///< Space between neighbouring segments; 0 = thickness / 4 (at least 1).
+    uint8_t spacing;      ///< Space between cells.
+    uint16_t offColor;    ///< Color of unlit segments; use the background color to hide them.
+} SevenSegmentStyle_t;
+
+/// @brief Draws text as seven-segment digits built from fillRect/fillTriangle primitives.
+/// @details Each segment is a bar with pointed ends: one rectangle and two triangles, so the
+///          digits are sharp at any size and need no font data. Digits, '-', '_', ' ', the
+///          degree sign and the letters that have a seven-segment form (A b C d E F H L n o P
+///          r t U ...) use a full cell; '.' and ':' use a narrow cell as wide as a segment.
+///          Segments do not overlap, so a string can be turned into another with the same
+///          layout by painting only the segments whose state changed (drawChanges()).
+///          The cursor is the left end of the baseline, like GFXfont text.
+class SevenSegmentRenderer {
+public:
+    static uint16_t segments(uint16_t code);
+    static TextBound_t getTextBounds(const SevenSegmentStyle_t *style, const char *text, int16_t x, int16_t y);
+    static int16_t drawText(Arduino_GFX *gfx, const SevenSegmentStyle_t *style, int16_t x, int16_t y,
+                            const char *text, uint16_t color, uint16_t bgColor);
+    static bool sameLayout(const char *oldText, const char *newText);
+    static bool sameStyle(const SevenSegmentStyle_t *a, const SevenSegmentStyle_t *b);
+    static void drawChanges(Arduino_GFX *gfx, const SevenSegmentStyle_t *style, int16_t x, int16_t y,
+                            const char *oldText, const char *newText, uint16_t color);
+
+private:
+    static bool isNarrow(uint16_t mask);
+    static int16_t advance(const SevenSegmentStyle_t *style, uint16_t mask);
+    static void drawCell(Arduino_GFX *gfx, const SevenSegmentStyle_t *style, int16_t x, int16_t y,
+                         uint16_t mask, uint16_t changed, uint16_t color, uint16_t offColor);
+};
+
+#endif // DISP_DEFAULT
+
+#endif // SEVENSEGMENT_H
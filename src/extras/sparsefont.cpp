@@ -0,0 +1,297 @@
+// sparsefont.cpp
+#include "sparsefont.h"
+
+#if defined(DISP_DEFAULT)
+#include <esp_log.h>
+#include "gfxtextstate.h"
+#include "compressedfont.h"
+
+const char *SparseFontRenderer::TAG = "SparseFont";
+
+const SparseFont *SparseFontRenderer::m_fonts[DFK_SPARSE_FONTS_MAX] = {};
+
+/**
+ * @brief Registers a font generated by sparsefontconvert.py.
+ * @param font Sparse font (its GFXfont is what widgets use).
+ * @return false if the table is full.
+ */
+bool SparseFontRenderer::add(const SparseFont *font) {
+    if (!font || !font->font || find(font->font)) {
+        return font != nullptr && font->font != nullptr;
+    }
+    for (uint8_t i = 0; i < DFK_SPARSE_FONTS_MAX; i++) {
+        if (!m_fonts[i]) {
+            m_fonts[i] = font;
+            return true;
+        }
+    }
+    ESP_LOGE(TAG, "Too many sparse fonts (DFK_SPARSE_FONTS_MAX = %d)", DFK_SPARSE_FONTS_MAX);
+    return false;
+}
+
+/**
+ * @brief Unregisters a font.
+ */
+void SparseFontRenderer::remove(const SparseFont *font) {
+    for (uint8_t i = 0; i < DFK_SPARSE_FONTS_MAX; i++) {
+        if (m_fonts[i] == font) {
+            m_fonts[i] = nullptr;
+        }
+    }
+}
+
+/**
+ * @brief Gets the registered sparse font built on a GFXfont.
+ * @return nullptr if the font was not registered.
+ */
+const SparseFont *SparseFontRenderer::find(const GFXfont *font) {
+    if (!font) {
+        return nullptr;
+    }
+    for (uint8_t i = 0; i < DFK_SPARSE_FONTS_MAX; i++) {
+        if (m_fonts[i] && m_fonts[i]->font == font) {
+            return m_fonts[i];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Reads one character of a UTF-8 string.
+ * @param p Position in the string; moved past the character.
+ * @return Codepoint. A byte that does not start a valid sequence is returned as is (Latin-1);
+ *         sequences beyond the Basic Multilingual Plane return 0xFFFD.
+ */
+uint16_t SparseFontRenderer::decode(const char *&p) {
+    const uint8_t lead = static_cast<uint8_t>(*p++);
+    if (lead < 0x80) {
+        return lead;
+    }
+    uint8_t extra;
+    uint32_t code;
+    if ((lead & 0xE0) == 0xC0) {
+        extra = 1;
+        code = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        extra = 2;
+        code = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        extra = 3;
+        code = lead & 0x07;
+    } else {
+        return lead;
+    }
+    for (uint8_t i = 0; i < extra; i++) {
+        if ((static_cast<uint8_t>(p[i]) & 0xC0) != 0x80) {
+            return lead;
+        }
+    }
+    for (uint8_t i = 0; i < extra; i++) {
+        code = (code << 6) | (static_cast<uint8_t>(*p++) & 0x3F);
+    }
+    return code > 0xFFFF ? 0xFFFD : static_cast<uint16_t>(code);
+}
+
+/**
+ * @brief Gets the glyph of a codepoint.
+ * @param font Font being printed.
+ * @param sparse Sparse table of the font (nullptr = contiguous range only).
+ * @param code Codepoint.
+ * @return Glyph record, or nullptr if the font has no glyph for the codepoint.
+ */
+const GFXglyph *SparseFontRenderer::glyph(const GFXfont *font, const SparseFont *sparse, uint16_t code) {
+    if (code >= font->first && code <= font->last) {
+        return &font->glyph[code - font->first];
+    }
+    if (!sparse) {
+        return nullptr;
+    }
+    uint16_t lo = 0;
+    uint16_t hi = sparse->rangeCount;
+    while (lo < hi) {
+        const uint16_t mid = (lo + hi) / 2;
+        const SparseRange_t &range = sparse->ranges[mid];
+        if (code < range.first) {
+            hi = mid;
+        } else if (code > range.last) {
+            lo = mid + 1;
+        } else {
+            return &font->glyph[range.index + (code - range.first)];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Checks if a string has bytes outside 7-bit ASCII.
+ */
+bool SparseFontRenderer::needsDecoding(const char *text) {
+    for (const char *p = text; *p; p++) {
+        if (static_cast<uint8_t>(*p) >= 0x80) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Prints a UTF-8 string at the cursor of a display.
+ * @param gfx Display (or canvas) whose font must be a registered sparse font.
+ * @param text Text to print.
+ * @return false if the font is not sparse or the text is plain ASCII (nothing is drawn).
+ * @details Follows Arduino_GFX for the cursor, text size and wrap. Like compressed fonts, the
+ *          background color is not painted. Glyph bitmaps may also be compressed (the font
+ *          registered with CompressedFont::add() as well).
+ */
+bool SparseFontRenderer::print(Arduino_GFX *gfx, const char *text) {
+    if (!gfx || !text || !needsDecoding(text)) {
+        return false;
+    }
+    const GFXfont *font = GfxTextState::font(gfx);
+    const SparseFont *sparse = find(font);
+    if (!sparse) {
+        return false;
+    }
+    const bool compressed = CompressedFont::contains(font);
+    const uint16_t color = GfxTextState::color(gfx);
+    const int16_t sizeX = GfxTextState::sizeX(gfx);
+    const int16_t sizeY = GfxTextState::sizeY(gfx);
+    const bool wrap = GfxTextState::wraps(gfx);
+    const int16_t width = gfx->width();
+    int16_t x = GfxTextState::cursorX(gfx);
+    int16_t y = GfxTextState::cursorY(gfx);
+
+    auto drawRun = [&](int16_t gx, int16_t gy, uint8_t row, uint8_t runX, uint8_t length) {
+        if (sizeX == 1 && sizeY == 1) {
+            gfx->writeFastHLine(gx + runX, gy + row, length, color);
+        } else {
+            gfx->writeFillRect(gx + runX * sizeX, gy + row * sizeY, length * sizeX, sizeY, color);
+        }
+    };
+
+    gfx->startWrite();
+    for (const char *p = text; *p;) {
+        const uint16_t code = decode(p);
+        if (code == '\n') {
+            x = 0;
+            y += font->yAdvance * sizeY;
+            continue;
+        }
+        const GFXglyph *g = code == '\r' ? nullptr : glyph(font, sparse, code);
+        if (!g) {
+            continue;
+        }
+        if (g->width > 0 && g->height > 0) {
+            if (wrap && (x + sizeX * (g->xOffset + g->width)) > width) {
+                x = 0;
+                y += font->yAdvance * sizeY;
+            }
+            const int16_t gx = x + g->xOffset * sizeX;
+            const int16_t gy = y + g->yOffset * sizeY;
+            if (compressed) {
+                CompressedFont::forEachRun(font, g, [&](uint8_t row, uint8_t runX, uint8_t length) {
+                    drawRun(gx, gy, row, runX, length);
+                });
+            } else {
+                const uint8_t *bits = font->bitmap + g->bitmapOffset;
+                uint16_t bit = 0;
+                for (uint8_t row = 0; row < g->height; row++) {
+                    int16_t start = -1;
+                    for (uint8_t col = 0; col <= g->width; col++) {
+                        const bool on = col < g->width && (bits[bit >> 3] & (0x80 >> (bit & 7)));
+                        if (col < g->width) {
+                            bit++;
+                        }
+                        if (on && start < 0) {
+                            start = col;
+                        } else if (!on && start >= 0) {
+                            drawRun(gx, gy, row, static_cast<uint8_t>(start), static_cast<uint8_t>(col - start));
+                            start = -1;
+                        }
+                    }
+                }
+            }
+        }
+        x += g->xAdvance * sizeX;
+    }
+    gfx->endWrite();
+
+    gfx->setCursor(x, y);
+    return true;
+}
+
+/**
+ * @brief Gets the bounding box of a UTF-8 string printed with the current state of a display.
+ * @param gfx Display whose font must be a registered sparse font.
+ * @param text Text to measure.
+ * @param x X position of the cursor.
+ * @param y Y position of the cursor.
+ * @param area Receives the box, same rules as Arduino_GFX::getTextBounds().
+ * @return false if the font is not sparse or the text is plain ASCII (area is untouched).
+ */
+bool SparseFontRenderer::getTextBounds(Arduino_GFX *gfx, const char *text, int16_t x, int16_t y, TextBound_t &area) {
+    if (!gfx || !text || !needsDecoding(text)) {
+        return false;
+    }
+    const SparseFont *sparse = find(GfxTextState::font(gfx));
+    if (!sparse) {
+        return false;
+    }
+    area = bounds(sparse, text, x, y, GfxTextState::sizeX(gfx), GfxTextState::sizeY(gfx),
+                  GfxTextState::wraps(gfx) ? gfx->width() : 0);
+    return true;
+}
+
+/**
+ * @brief Measures a UTF-8 string at text size 1 without wrap, like FontMetrics::measure().
+ */
+TextBound_t SparseFontRenderer::measure(const SparseFont *sparse, const char *text) {
+    return bounds(sparse, text, 0, 0, 1, 1, 0);
+}
+
+/**
+ * @brief Bounding box of a string; wrapWidth 0 disables wrapping.
+ */
+TextBound_t SparseFontRenderer::bounds(const SparseFont *sparse, const char *text, int16_t x, int16_t y,
+                                       uint8_t sizeX, uint8_t sizeY, int16_t wrapWidth) {
+    TextBound_t result = {x, y, 0, 0};
+    const GFXfont *font = sparse->font;
+    // Same inverted start as getTextBounds(): the box always reaches the cursor row/column -1.
+    int16_t minX = 0x7FFF, minY = 0x7FFF, maxX = -1, maxY = -1;
+    for (const char *p = text; *p;) {
+        const uint16_t code = decode(p);
+        if (code == '\n') {
+            x = 0;
+            y += font->yAdvance * sizeY;
+            continue;
+        }
+        const GFXglyph *g = code == '\r' ? nullptr : glyph(font, sparse, code);
+        if (!g) {
+            continue;
+        }
+        if (wrapWidth > 0 && (x + (g->xOffset + g->width) * sizeX - 1) > wrapWidth - 1) {
+            x = 0;
+            y += font->yAdvance * sizeY;
+        }
+        const int16_t x1 = x + g->xOffset * sizeX;
+        const int16_t y1 = y + g->yOffset * sizeY;
+        const int16_t x2 = x1 + g->width * sizeX - 1;
+        const int16_t y2 = y1 + g->height * sizeY - 1;
+        if (x1 < minX) minX = x1;
+        if (y1 < minY) minY = y1;
+        if (x2 > maxX) maxX = x2;
+        if (y2 > maxY) maxY = y2;
+        x += g->xAdvance * sizeX;
+    }
+    if (maxX >= minX) {
+        result.x = minX;
+        result.width = static_cast<uint16_t>(maxX - minX + 1);
+    }
+    if (maxY >= minY) {
+        result.y = minY;
+        result.height = static_cast<uint16_t>(maxY - minY + 1);
+    }
+    return result;
+}
+
+#endif // DISP_DEFAULT
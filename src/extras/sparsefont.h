@@ -0,0 +1,66 @@
+// sparsefont.h
+#ifndef SPARSEFONT_H
+#define SPARSEFONT_H
+
+#include <stdint.h>
+#include "../widgets/widgetsetup.h"
+#include "baseTypes.h"
+
+#if defined(DISP_DEFAULT)
+#include <Arduino_GFX_Library.h>
+
+#ifndef DFK_SPARSE_FONTS_MAX
+#define DFK_SPARSE_FONTS_MAX 16 ///< Number of sparse fonts that can be registered.
+#endif
+
+/// @brief Run of consecutive codepoints stored after the contiguous range of a font.
+typedef struct {
+    uint16_t first; ///< First codepoint of the run.
+    uint16_t last;  ///< Last codepoint of the run (inclusive).
+    uint16_t index; ///< Index in GFXfont::glyph of the glyph for @ref first.
+} SparseRange_t;
+
+/// @brief GFXfont extended with glyphs for codepoints outside its first..last range.
+/// @details The glyph array of @ref font holds first..last as usual, followed by the glyphs
+///          of every range. Arduino_GFX only sees the contiguous part, so the font works
+///          anywhere a GFXfont does; the extra glyphs are reached through SparseFontRenderer.
+typedef struct {
+    const GFXfont *font;         ///< Font with the contiguous range (usually 0x20-0x7E).
+    const SparseRange_t *ranges; ///< Extra codepoints, sorted and not overlapping.
+    uint16_t rangeCount;         ///< Number of ranges.
+} SparseFont;
+
+/// @brief Prints and measures UTF-8 text with sparse fonts.
+/// @details Fonts are generated by src/fonts/sparsefontconvert.py and registered with add().
+///          Widgets keep using the GFXfont member; WidgetBase::writeText() and measureText()
+///          hand strings with bytes >= 0x80 to this class when the current font is registered,
+///          so pure ASCII text still takes the usual paths (glyph cache, text metrics cache).
+///          A codepoint inside first..last is a direct index like in a GFXfont; the others
+///          are found by binary search over the ranges. Bytes that are not valid UTF-8 are
+///          read as Latin-1, so strings encoded that way still print.
+class SparseFontRenderer {
+public:
+    static bool add(const SparseFont *font);
+    static void remove(const SparseFont *font);
+    static const SparseFont *find(const GFXfont *font);
+
+    static uint16_t decode(const char *&p);
+    static const GFXglyph *glyph(const GFXfont *font, const SparseFont *sparse, uint16_t code);
+    static bool needsDecoding(const char *text);
+
+    static bool print(Arduino_GFX *gfx, const char *text);
+    static bool getTextBounds(Arduino_GFX *gfx, const char *text, int16_t x, int16_t y, TextBound_t &area);
+    static TextBound_t measure(const SparseFont *sparse, const char *text);
+
+private:
+    static const char *TAG; ///< Tag estática para identificação em logs.
+
+    static const SparseFont *m_fonts[DFK_SPARSE_FONTS_MAX]; ///< Registered fonts (nullptr = free).
+
+    static TextBound_t bounds(const SparseFont *sparse, const char *text, int16_t x, int16_t y,
+                              uint8_t sizeX, uint8_t sizeY, int16_t wrapWidth);
+};
+
+#endif // DISP_DEFAULT
+
+#endif // SPARSEFONT_H
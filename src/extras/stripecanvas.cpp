@@ -0,0 +1,207 @@
+// stripecanvas.cpp
+#include "stripecanvas.h"
+
+#if defined(DISP_DEFAULT)
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+
+const char *StripeCanvas::TAG = "StripeCanvas";
+
+/**
+ * @brief Constructor.
+ * @param screenWidth Width of the real display (clipping limit).
+ * @param screenHeight Height of the real display (clipping limit).
+ * @param maxWidth Width used to size the buffer.
+ * @param maxHeight Height used to size the buffer.
+ * @details The buffer is only allocated in begin().
+ */
+StripeCanvas::StripeCanvas(int16_t screenWidth, int16_t screenHeight, uint16_t maxWidth, uint16_t maxHeight)
+    : Arduino_GFX(screenWidth, screenHeight),
+      m_buffer(nullptr),
+      m_capacity(static_cast<uint32_t>(maxWidth) * maxHeight),
+      m_window{0, 0, 0, 0}
+{
+}
+
+/**
+ * @brief Destructor. Frees the pixel buffer.
+ */
+StripeCanvas::~StripeCanvas() {
+    if (m_buffer) {
+        heap_caps_free(m_buffer);
+        m_buffer = nullptr;
+    }
+}
+
+/**
+ * @brief Allocates the pixel buffer.
+ * @param speed Unused, kept for the Arduino_GFX interface.
+ * @return true if the buffer is available.
+ * @details Internal DMA capable RAM is preferred so the flush can be sent without a copy.
+ *          PSRAM is used as a fallback.
+ */
+bool StripeCanvas::begin(int32_t speed) {
+    (void)speed;
+    if (m_buffer) {
+        return true;
+    }
+    if (m_capacity == 0) {
+        ESP_LOGE(TAG, "Invalid stripe size");
+        return false;
+    }
+    size_t bytes = m_capacity * sizeof(uint16_t);
+    m_buffer = static_cast<uint16_t *>(heap_caps_malloc(bytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL));
+    if (!m_buffer) {
+        m_buffer = static_cast<uint16_t *>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM));
+    }
+    if (!m_buffer) {
+        ESP_LOGE(TAG, "Can't allocate %u bytes for stripe buffer", (unsigned)bytes);
+        return false;
+    }
+    ESP_LOGD(TAG, "Stripe buffer with %u pixels allocated", (unsigned)m_capacity);
+    return true;
+}
+
+/**
+ * @brief Checks if the buffer was allocated.
+ */
+bool StripeCanvas::isReady() const {
+    return m_buffer != nullptr;
+}
+
+/**
+ * @brief Gets the number of pixels the buffer can hold.
+ */
+uint32_t StripeCanvas::capacity() const {
+    return m_capacity;
+}
+
+/**
+ * @brief Gets how many rows fit in the buffer for a given window width.
+ * @param windowWidth Width of the window.
+ * @return Number of rows, 0 if not even one row fits.
+ */
+uint16_t StripeCanvas::rowsFor(uint16_t windowWidth) const {
+    if (windowWidth == 0) {
+        return 0;
+    }
+    uint32_t rows = m_capacity / windowWidth;
+    return rows > 0xFFFF ? 0xFFFF : static_cast<uint16_t>(rows);
+}
+
+/**
+ * @brief Maps a screen area to the buffer.
+ * @param window Area in screen coordinates.
+ * @return false if the buffer is missing or the area does not fit.
+ */
+bool StripeCanvas::setWindow(const Rect_t &window) {
+    if (!m_buffer || window.width == 0 || window.height == 0) {
+        return false;
+    }
+    if (static_cast<uint32_t>(window.width) * window.height > m_capacity) {
+        return false;
+    }
+    m_window = window;
+    return true;
+}
+
+/**
+ * @brief Gets the area currently mapped to the buffer.
+ */
+const Rect_t &StripeCanvas::getWindow() const {
+    return m_window;
+}
+
+/**
+ * @brief Fills the whole window with a color.
+ * @param color RGB565 color.
+ */
+void StripeCanvas::clearWindow(uint16_t color) {
+    if (!m_buffer) {
+        return;
+    }
+    uint32_t total = static_cast<uint32_t>(m_window.width) * m_window.height;
+    for (uint32_t i = 0; i < total; i++) {
+        m_buffer[i] = color;
+    }
+}
+
+/**
+ * @brief Sends the window to a display with a single block transfer.
+ * @param output Display that receives the pixels.
+ */
+void StripeCanvas::pushTo(Arduino_GFX *output) {
+    if (!output || !m_buffer || m_window.width == 0 || m_window.height == 0) {
+        return;
+    }
+    output->draw16bitRGBBitmap(m_window.x, m_window.y, m_buffer, m_window.width, m_window.height);
+}
+
+/**
+ * @brief Gets the raw pixel buffer (row-major, window width pixels per row).
+ */
+uint16_t *StripeCanvas::getBuffer() {
+    return m_buffer;
+}
+
+/**
+ * @brief Stores a pixel if it is inside the window.
+ */
+void StripeCanvas::writePixelPreclipped(int16_t x, int16_t y, uint16_t color) {
+    int32_t lx = x - m_window.x;
+    int32_t ly = y - m_window.y;
+    if (lx < 0 || ly < 0 || lx >= m_window.width || ly >= m_window.height) {
+        return;
+    }
+    m_buffer[ly * m_window.width + lx] = color;
+}
+
+/**
+ * @brief Draws a vertical line clipped to the window.
+ */
+void StripeCanvas::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    if (h < 0) {
+        y += h + 1;
+        h = -h;
+    }
+    writeFillRectPreclipped(x, y, 1, h, color);
+}
+
+/**
+ * @brief Draws a horizontal line clipped to the window.
+ */
+void StripeCanvas::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    if (w < 0) {
+        x += w + 1;
+        w = -w;
+    }
+    writeFillRectPreclipped(x, y, w, 1, color);
+}
+
+/**
+ * @brief Fills a rectangle clipped to the window.
+ */
+void StripeCanvas::writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (!m_buffer) {
+        return;
+    }
+    int32_t x0 = x > m_window.x ? x : m_window.x;
+    int32_t y0 = y > m_window.y ? y : m_window.y;
+    int32_t x1 = x + w;
+    int32_t y1 = y + h;
+    int32_t wx1 = m_window.x + m_window.width;
+    int32_t wy1 = m_window.y + m_window.height;
+    if (x1 > wx1) { x1 = wx1; }
+    if (y1 > wy1) { y1 = wy1; }
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    for (int32_t row = y0; row < y1; row++) {
+        uint16_t *dst = m_buffer + (row - m_window.y) * m_window.width + (x0 - m_window.x);
+        for (int32_t col = x0; col < x1; col++) {
+            *dst++ = color;
+        }
+    }
+}
+
+#endif // DISP_DEFAULT
@@ -0,0 +1,64 @@
+// stripecanvas.h
+#ifndef STRIPECANVAS_H
+#define STRIPECANVAS_H
+
+#include <stdint.h>
+#include "../widgets/widgetsetup.h"
+#include "baseTypes.h"
+
+#if defined(DISP_DEFAULT)
+#include <Arduino_GFX_Library.h>
+
+#ifndef DFK_STRIPE_WIDTH
+#define DFK_STRIPE_WIDTH 480 ///< Default stripe width in pixels.
+#endif
+#ifndef DFK_STRIPE_HEIGHT
+#define DFK_STRIPE_HEIGHT 40 ///< Default stripe height in pixels.
+#endif
+
+/// @brief State of an off-screen pass that walks an area stripe by stripe.
+typedef struct {
+    Arduino_GFX *output; ///< Display that receives each finished stripe.
+    Rect_t area;         ///< Whole area being composed, in screen coordinates.
+    uint16_t nextRow;    ///< First row (relative to area.y) of the next stripe.
+    uint16_t rows;       ///< Rows per stripe for this area width.
+    uint16_t fillColor;  ///< Color used to clear each stripe before drawing.
+} OffscreenPass_t;
+
+/// @brief Small RGB565 off-screen buffer that mirrors a window of the screen.
+/// @details The canvas reports the full screen size to Arduino_GFX, so widgets keep drawing
+///          with screen coordinates. Only pixels inside the current window are stored; the rest
+///          is discarded. When the window is finished it is sent to the real display with a
+///          single draw16bitRGBBitmap() call. The buffer holds maxWidth x maxHeight pixels and a
+///          window may have any shape that fits in that amount of pixels (a narrow area uses
+///          taller stripes).
+class StripeCanvas : public Arduino_GFX {
+public:
+    StripeCanvas(int16_t screenWidth, int16_t screenHeight, uint16_t maxWidth, uint16_t maxHeight);
+    ~StripeCanvas();
+
+    bool begin(int32_t speed = GFX_NOT_DEFINED) override;
+    void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
+    void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+
+    bool isReady() const;
+    uint32_t capacity() const;
+    uint16_t rowsFor(uint16_t windowWidth) const;
+    bool setWindow(const Rect_t &window);
+    const Rect_t &getWindow() const;
+    void clearWindow(uint16_t color);
+    void pushTo(Arduino_GFX *output);
+    uint16_t *getBuffer();
+
+private:
+    static const char *TAG; ///< Tag estática para identificação em logs.
+    uint16_t *m_buffer;     ///< Pixel storage, m_capacity pixels.
+    uint32_t m_capacity;    ///< Number of pixels the buffer can hold.
+    Rect_t m_window;        ///< Screen area currently mapped to the buffer.
+};
+
+#endif // DISP_DEFAULT
+
+#endif // STRIPECANVAS_H
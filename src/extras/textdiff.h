@@ -0,0 +1,36 @@
+// textdiff.h
+#ifndef TEXTDIFF_H
+#define TEXTDIFF_H
+
+#include <stdint.h>
+#include "../widgets/widgetsetup.h"
+
+#if defined(DISP_DEFAULT)
+#include <Arduino_GFX_Library.h>
+#include "sevensegment.h"
+
+#ifndef DFK_TEXT_DIFF_MAX_LEN
+#define DFK_TEXT_DIFF_MAX_LEN 31 ///< Longest string (bytes) whose drawn state is kept for glyph-level redraw.
+#endif
+
+/// @brief What a widget last printed, so the next string can be redrawn glyph by glyph.
+/// @details Filled by WidgetBase::printTextDiff(). The state only describes the panel while
+///          nothing else draws over the text, so widgets clear @ref valid whenever they are
+///          redrawn in full (forceUpdate, show, hide, screen load). The frame loop asks for a
+///          full redraw of any widget reached by what was painted below it in the same frame,
+///          so a diff never runs over text that was just painted over.
+typedef struct {
+    char text[DFK_TEXT_DIFF_MAX_LEN + 1]; ///< String on the panel.
+    const GFXfont *font;                  ///< Font it was printed with.
+    const SevenSegmentStyle_t *style;     ///< Seven-segment style it was printed with (nullptr for fonts).
+    SevenSegmentStyle_t styleValues;      ///< Copy of *style, so a style edited in place is noticed.
+    int16_t x;                            ///< Cursor X (left of the first glyph advance).
+    int16_t y;                            ///< Cursor Y (baseline).
+    uint16_t color;                       ///< Text color.
+    uint16_t background;                  ///< Color behind the text.
+    uint8_t size;                         ///< Text size multiplier.
+    bool valid;                           ///< False until a string has been drawn with known state.
+} DrawnText_t;
+
+#endif
+#endif
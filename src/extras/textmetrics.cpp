@@ -0,0 +1,224 @@
+// textmetrics.cpp
+#include "textmetrics.h"
+
+#if defined(DISP_DEFAULT)
+#include <esp_log.h>
+#include <string.h>
+#include <new>
+#include "gfxtextstate.h"
+
+const char *TextMetricsCache::TAG = "TextMetricsCache";
+
+/**
+ * @brief Constructor.
+ * @param slots Number of strings kept (rounded up to an even power of two).
+ * @details The table is only allocated in begin().
+ */
+TextMetricsCache::TextMetricsCache(uint16_t slots)
+    : m_entries(nullptr),
+      m_slots(2),
+      m_clock(0),
+      m_stats{0, 0}
+{
+    while (m_slots < slots && m_slots < 0x4000) {
+        m_slots <<= 1;
+    }
+}
+
+/**
+ * @brief Destructor. Frees the table.
+ */
+TextMetricsCache::~TextMetricsCache() {
+    delete[] m_entries;
+}
+
+/**
+ * @brief Allocates the table.
+ * @return true if the cache can be used.
+ */
+bool TextMetricsCache::begin() {
+    if (m_entries) {
+        return true;
+    }
+    m_entries = new (std::nothrow) MetricsEntry_t[m_slots];
+    if (!m_entries) {
+        ESP_LOGE(TAG, "Can't allocate text metrics table");
+        return false;
+    }
+    clear();
+    ESP_LOGD(TAG, "Text metrics cache ready: %u slots", m_slots);
+    return true;
+}
+
+/**
+ * @brief Checks if the table was allocated.
+ */
+bool TextMetricsCache::isReady() const {
+    return m_entries != nullptr;
+}
+
+/**
+ * @brief Gets the size of a string with the current text state of a display.
+ * @param gfx Display whose font, text size and wrap are used.
+ * @param text String to measure.
+ * @return Bounding box relative to a cursor at (0, 0) and the advance of the last line.
+ */
+TextMetrics_t TextMetricsCache::measure(Arduino_GFX *gfx, const char *text) {
+    if (!m_entries || !gfx || !text) {
+        return gfx && text ? compute(gfx, text) : TextMetrics_t{0, 0, 0, 0, 0};
+    }
+
+    size_t length = strlen(text);
+    if (length > DFK_TEXT_METRICS_MAX_LEN) {
+        m_stats.misses++;
+        return compute(gfx, text);
+    }
+
+    const GFXfont *font = GfxTextState::font(gfx);
+    const uint8_t sizeX = GfxTextState::sizeX(gfx);
+    const uint8_t sizeY = GfxTextState::sizeY(gfx);
+    const bool wrap = GfxTextState::wraps(gfx);
+    const uint16_t screenWidth = gfx->width();
+
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ static_cast<uint8_t>(text[i])) * 16777619u;
+    }
+
+    uint32_t fontHash = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(font) >> 2) * 2654435761u;
+    uint16_t set = static_cast<uint16_t>(((hash ^ fontHash) & ((m_slots >> 1) - 1)) << 1);
+    m_clock++;
+
+    for (uint16_t i = set; i < set + 2; i++) {
+        MetricsEntry_t &entry = m_entries[i];
+        if (entry.used && entry.hash == hash && entry.font == font && entry.length == length &&
+            entry.sizeX == sizeX && entry.sizeY == sizeY && entry.wrap == wrap &&
+            entry.screenWidth == screenWidth && memcmp(entry.text, text, length) == 0) {
+            entry.lastUse = m_clock;
+            m_stats.hits++;
+            return entry.metrics;
+        }
+    }
+
+    m_stats.misses++;
+    MetricsEntry_t &entry = (!m_entries[set].used || (m_entries[set + 1].used &&
+                             m_entries[set].lastUse <= m_entries[set + 1].lastUse))
+                                ? m_entries[set]
+                                : m_entries[set + 1];
+    entry.metrics = compute(gfx, text);
+    entry.font = font;
+    entry.hash = hash;
+    entry.lastUse = m_clock;
+    entry.screenWidth = screenWidth;
+    entry.sizeX = sizeX;
+    entry.sizeY = sizeY;
+    entry.length = static_cast<uint8_t>(length);
+    entry.wrap = wrap;
+    entry.used = true;
+    memcpy(entry.text, text, length + 1);
+    return entry.metrics;
+}
+
+/**
+ * @brief Gets the bounding box of a string printed at a cursor position.
+ * @param gfx Display whose text state is used.
+ * @param text String to measure.
+ * @param x Cursor X.
+ * @param y Cursor Y (baseline for GFX fonts).
+ * @return Same result as Arduino_GFX::getTextBounds(text, x, y, ...).
+ */
+TextBound_t TextMetricsCache::bounds(Arduino_GFX *gfx, const char *text, int16_t x, int16_t y) {
+    TextBound_t result = {x, y, 0, 0};
+    if (!gfx || !text) {
+        return result;
+    }
+    // A line break or a wrap sends the cursor back to X = 0, not to x
+    if (!m_entries || (x != 0 && (GfxTextState::wraps(gfx) || strchr(text, '\n')))) {
+        gfx->getTextBounds(text, x, y, &result.x, &result.y, &result.width, &result.height);
+        return result;
+    }
+
+    // getTextBounds() starts from an inverted box and may clamp it to the screen. A stored box
+    // is only moved when it overlaps the screen, where no backend clamps it.
+    const TextMetrics_t m = measure(gfx, text);
+    const int32_t minX = static_cast<int32_t>(x) + m.x;
+    const int32_t maxX = minX + m.width - 1;
+    const int32_t minY = static_cast<int32_t>(y) + m.y;
+    const int32_t maxY = minY + m.height - 1;
+    if (m.width == 0 || m.height == 0 || minX >= gfx->width() || maxX < 0 || minY >= gfx->height() || maxY < 0) {
+        gfx->getTextBounds(text, x, y, &result.x, &result.y, &result.width, &result.height);
+        return result;
+    }
+    result.x = static_cast<int16_t>(minX);
+    result.y = static_cast<int16_t>(minY);
+    result.width = m.width;
+    result.height = m.height;
+    return result;
+}
+
+/**
+ * @brief Drops every cached string.
+ */
+void TextMetricsCache::clear() {
+    if (!m_entries) {
+        return;
+    }
+    for (uint16_t i = 0; i < m_slots; i++) {
+        m_entries[i].used = false;
+        m_entries[i].font = nullptr;
+    }
+}
+
+/**
+ * @brief Gets the hit and miss counters.
+ */
+const TextMetricsStats_t &TextMetricsCache::getStats() const {
+    return m_stats;
+}
+
+/**
+ * @brief Resets the hit and miss counters.
+ */
+void TextMetricsCache::resetStats() {
+    m_stats.hits = 0;
+    m_stats.misses = 0;
+}
+
+/**
+ * @brief Measures a string with Arduino_GFX.
+ * @details The cursor is placed at mid height. If the box found there doesn't overlap the
+ *          screen, the backend may have clamped it; the size is then left at 0 and bounds()
+ *          asks Arduino_GFX for every position.
+ */
+TextMetrics_t TextMetricsCache::compute(Arduino_GFX *gfx, const char *text) {
+    const int16_t reference = gfx->height() / 2;
+    TextBound_t box = {0, 0, 0, 0};
+    gfx->getTextBounds(text, 0, reference, &box.x, &box.y, &box.width, &box.height);
+
+    TextMetrics_t m = {0, 0, 0, 0, 0};
+    if (box.width > 0 && box.height > 0 && box.x < gfx->width() && box.x + box.width > 0 &&
+        box.y < gfx->height() && box.y + box.height > 0) {
+        m.x = box.x;
+        m.y = static_cast<int16_t>(box.y - reference);
+        m.width = box.width;
+        m.height = box.height;
+    }
+
+    const GFXfont *font = GfxTextState::font(gfx);
+    const int16_t sizeX = GfxTextState::sizeX(gfx);
+    for (const char *p = text; *p; p++) {
+        uint8_t c = static_cast<uint8_t>(*p);
+        if (c == '\n') {
+            m.advance = 0;
+        } else if (c == '\r') {
+            continue;
+        } else if (!font) {
+            m.advance += 6 * sizeX;
+        } else if (c >= font->first && c <= font->last) {
+            m.advance += font->glyph[c - font->first].xAdvance * sizeX;
+        }
+    }
+    return m;
+}
+
+#endif // DISP_DEFAULT
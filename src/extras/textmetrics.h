@@ -0,0 +1,84 @@
+// textmetrics.h
+#ifndef TEXTMETRICS_H
+#define TEXTMETRICS_H
+
+#include <stdint.h>
+#include "../widgets/widgetsetup.h"
+#include "baseTypes.h"
+
+#if defined(DISP_DEFAULT)
+#include <Arduino_GFX_Library.h>
+
+#ifndef DFK_TEXT_METRICS_SLOTS
+#define DFK_TEXT_METRICS_SLOTS 64 ///< Default number of strings kept by the text metrics cache.
+#endif
+#ifndef DFK_TEXT_METRICS_MAX_LEN
+#define DFK_TEXT_METRICS_MAX_LEN 31 ///< Longest string (bytes) that is cached; longer ones are measured every time.
+#endif
+
+/// @brief Measured size of a string, relative to a cursor at (0, 0).
+typedef struct {
+    int16_t x;       ///< Left of the bounding box.
+    int16_t y;       ///< Top of the bounding box (negative above the baseline).
+    uint16_t width;  ///< Width of the bounding box (0 = empty or unknown).
+    uint16_t height; ///< Height of the bounding box (0 = empty or unknown).
+    int16_t advance; ///< Cursor X after printing the string (last line).
+} TextMetrics_t;
+
+/// @brief Counters of a TextMetricsCache.
+typedef struct {
+    uint32_t hits;   ///< Measurements answered from the cache.
+    uint32_t misses; ///< Measurements done with Arduino_GFX.
+} TextMetricsStats_t;
+
+/// @brief Cache of getTextBounds() results shared by all widgets.
+/// @details Entries are keyed by font, text size, wrap flag, screen width and string (FNV-1a
+///          hash plus a copy of the bytes, so a hash collision can't return wrong bounds). The
+///          table is two-way set associative: a string lives in one of two slots and the least
+///          recently used one is replaced. The bounds of a string only move with the cursor, so
+///          one entry serves every position where the text overlaps the screen. Elsewhere, and
+///          for X != 0 when the text has line breaks or wrap is enabled (a new line starts at
+///          X = 0, not at the cursor), bounds() calls Arduino_GFX::getTextBounds(). Results are
+///          the same as without the cache.
+class TextMetricsCache {
+public:
+    explicit TextMetricsCache(uint16_t slots);
+    ~TextMetricsCache();
+
+    bool begin();
+    bool isReady() const;
+    TextMetrics_t measure(Arduino_GFX *gfx, const char *text);
+    TextBound_t bounds(Arduino_GFX *gfx, const char *text, int16_t x, int16_t y);
+    void clear();
+    const TextMetricsStats_t &getStats() const;
+    void resetStats();
+
+private:
+    /// @brief One cached string.
+    typedef struct {
+        const GFXfont *font;                      ///< Font of the entry (with used = false the slot is free).
+        uint32_t hash;                            ///< FNV-1a hash of the string.
+        uint32_t lastUse;                         ///< Value of m_clock at the last hit.
+        TextMetrics_t metrics;                    ///< Measured size.
+        uint16_t screenWidth;                     ///< Width of the display used to measure.
+        uint8_t sizeX;                            ///< Horizontal text size.
+        uint8_t sizeY;                            ///< Vertical text size.
+        uint8_t length;                           ///< String length.
+        bool wrap;                                ///< Wrap flag used to measure.
+        bool used;                                ///< Slot holds an entry.
+        char text[DFK_TEXT_METRICS_MAX_LEN + 1];  ///< Copy of the string.
+    } MetricsEntry_t;
+
+    static const char *TAG; ///< Tag estática para identificação em logs.
+
+    static TextMetrics_t compute(Arduino_GFX *gfx, const char *text);
+
+    MetricsEntry_t *m_entries; ///< Entry table, m_slots slots.
+    uint16_t m_slots;          ///< Number of slots (even power of two).
+    uint32_t m_clock;          ///< Incremented on every lookup; stamps MetricsEntry_t::lastUse.
+    TextMetricsStats_t m_stats; ///< Hit and miss counters.
+};
+
+#endif // DISP_DEFAULT
+
+#endif // TEXTMETRICS_H
@@ -0,0 +1,99 @@
+"""Converts a TTF/OTF font into an anti-aliased AAFont header (4 bits per pixel).
+
+Usage:
+    python aafontconvert.py Roboto-Bold.ttf 12 [first] [last] [--name RobotoBold] [--dpi 141]
+
+The header is written to stdout, like Adafruit's fontconvert. Sizes are in points at the same
+141 DPI used by fontconvert, so RobotoBold12pt7bAA has the height of RobotoBold12pt7b.
+Requires Pillow (pip install pillow).
+"""
+import argparse
+import os
+import re
+import sys
+
+from PIL import ImageFont
+
+
+def glyph_data(font, char):
+    """Returns (levels, width, height, xAdvance, xOffset, yOffset) for one character."""
+    ascent, _ = font.getmetrics()
+    advance = int(round(font.getlength(char)))
+    mask, (ox, oy) = font.getmask2(char, mode='L')
+    width, height = mask.size
+    box = mask.getbbox() if width and height else None
+    if not box:
+        return [], 0, 0, advance, 0, 0
+    left, top, right, bottom = box
+    levels = []
+    for y in range(top, bottom):
+        for x in range(left, right):
+            levels.append((mask.getpixel((x, y)) * 15 + 127) // 255)
+    return levels, right - left, bottom - top, advance, ox + left, oy + top - ascent
+
+
+def pack(levels):
+    """Packs coverage levels two per byte, high nibble first."""
+    data = []
+    for i in range(0, len(levels), 2):
+        high = levels[i]
+        low = levels[i + 1] if i + 1 < len(levels) else 0
+        data.append((high << 4) | low)
+    return data
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generates an AAFont header from a TrueType font.')
+    parser.add_argument('font', help='TTF or OTF file')
+    parser.add_argument('size', type=int, help='size in points')
+    parser.add_argument('first', type=lambda v: int(v, 0), nargs='?', default=0x20)
+    parser.add_argument('last', type=lambda v: int(v, 0), nargs='?', default=0x7E)
+    parser.add_argument('--name', help='font name (default: file name without symbols)')
+    parser.add_argument('--dpi', type=int, default=141)
+    args = parser.parse_args()
+
+    if not 0 <= args.first <= args.last <= 0xFF:
+        sys.exit('Character range must be inside 0x00-0xFF')
+
+    pixels = int(round(args.size * args.dpi / 72.0))
+    font = ImageFont.truetype(args.font, pixels)
+    base = args.name or re.sub(r'[^A-Za-z0-9]', '', os.path.splitext(os.path.basename(args.font))[0])
+    name = '%s%dpt%dbAA' % (base, args.size, 8 if args.last > 0x7F else 7)
+    ascent, descent = font.getmetrics()
+
+    bitmap = []
+    glyphs = []
+    for code in range(args.first, args.last + 1):
+        levels, width, height, advance, xo, yo = glyph_data(font, chr(code))
+        if width > 255 or height > 255 or advance > 255 or not -128 <= xo <= 127 or not -128 <= yo <= 127:
+            sys.exit('Glyph 0x%02X does not fit GFXglyph fields; use a smaller size' % code)
+        glyphs.append((len(bitmap), width, height, advance, xo, yo, code))
+        bitmap.extend(pack(levels))
+
+    out = sys.stdout
+    guard = re.sub(r'[^A-Z0-9]', '_', name.upper()) + '_H'
+    out.write('#ifndef %s\n#define %s\n' % (guard, guard))
+    out.write('// Generated by aafontconvert.py from %s, %d pt (4 bits per pixel)\n' % (os.path.basename(args.font), args.size))
+    out.write('const uint8_t %sBitmaps[] PROGMEM = {\n' % name)
+    for i in range(0, len(bitmap), 12):
+        out.write('  ' + ', '.join('0x%02X' % b for b in bitmap[i:i + 12]))
+        out.write(',\n' if i + 12 < len(bitmap) else ' };\n\n')
+    if not bitmap:
+        out.write('  0x00 };\n\n')
+
+    out.write('const GFXglyph %sGlyphs[] PROGMEM = {\n' % name)
+    for i, (offset, width, height, advance, xo, yo, code) in enumerate(glyphs):
+        last = i == len(glyphs) - 1
+        label = chr(code) if 0x20 <= code < 0x7F else ''
+        out.write('  { %5d, %3d, %3d, %3d, %4d, %4d }%s   // 0x%02X %s\n'
+                  % (offset, width, height, advance, xo, yo, ' };' if last else ', ', code, repr(label) if label else ''))
+
+    out.write('\nconst AAFont %s PROGMEM = {\n' % name)
+    out.write('  (uint8_t  *)%sBitmaps,\n' % name)
+    out.write('  (GFXglyph *)%sGlyphs,\n' % name)
+    out.write('  0x%02X, 0x%02X, %d };\n\n' % (args.first, args.last, ascent + descent))
+    out.write('// Approx. %d bytes\n#endif\n' % (len(bitmap) + len(glyphs) * 7 + 7))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,146 @@
+"""Compresses a GFXfont header (Adafruit fontconvert output) into the CompressedFont format.
+
+Usage:
+    python fontcompress.py RobotoBold/RobotoBold50pt7b.h > RobotoBold50pt7bZ.h [--stats]
+
+The glyph records and metrics are kept; every glyph bitmap is replaced by row tokens (format in
+src/extras/compressedfont.h). It pays off from about 15 pt up; small sizes grow, keep them as
+they are. Register the result with CompressedFont::add() before using it.
+"""
+import argparse
+import re
+import sys
+
+
+def parse_header(text):
+    """Returns (name, bitmap bytes, glyph tuples, first, last, yAdvance) of a GFXfont header."""
+    bitmap_match = re.search(r'(\w+)Bitmaps\[\]\s*PROGMEM\s*=\s*\{(.*?)\};', text, re.S)
+    glyph_match = re.search(r'(\w+)Glyphs\[\]\s*PROGMEM\s*=\s*\{(.*?)\}\s*\};', text, re.S)
+    font_match = re.search(r'const\s+GFXfont\s+(\w+)\s+PROGMEM\s*=\s*\{(.*?)\};', text, re.S)
+    if not bitmap_match or not glyph_match or not font_match:
+        sys.exit('Not a GFXfont header')
+    bitmap = [int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]+', bitmap_match.group(2))]
+    body = re.sub(r'//[^\n]*', '', glyph_match.group(2) + '}')
+    glyphs = [tuple(int(v) for v in g.split(','))
+              for g in re.findall(r'\{([^{}]*)\}', body)]
+    fields = re.sub(r'\([^)]*\)', '', font_match.group(2)).split(',')
+    first, last, y_advance = (int(v.strip(), 0) for v in fields[2:5])
+    return font_match.group(1), bitmap, glyphs, first, last, y_advance
+
+
+def glyph_rows(bitmap, offset, width, height):
+    """Returns the runs (start, end) of every row of a 1-bit glyph, end exclusive."""
+    rows = []
+    bit = 0
+    for _ in range(height):
+        runs = []
+        start = None
+        for x in range(width + 1):
+            on = False
+            if x < width:
+                on = bool(bitmap[offset + (bit >> 3)] & (0x80 >> (bit & 7)))
+                bit += 1
+            if on and start is None:
+                start = x
+            elif not on and start is not None:
+                runs.append((start, x))
+                start = None
+        if len(runs) > 0x7F:
+            sys.exit('Row with more than 127 runs')
+        rows.append(runs)
+    return rows
+
+
+def delta(previous, runs):
+    """Returns the nibbles of a delta row, or None if the row can't be coded as one."""
+    if previous is None or len(previous) != len(runs) or not runs:
+        return None
+    nibbles = []
+    for (old_start, old_end), (start, end) in zip(previous, runs):
+        ds, de = start - old_start, end - old_end
+        if not -2 <= ds <= 1 or not -2 <= de <= 1:
+            return None
+        nibbles.append(((ds + 2) << 2) | (de + 2))
+    return nibbles
+
+
+def encode(rows):
+    """Encodes the rows of a glyph as tokens."""
+    out = []
+    previous = None
+    repeat = 0
+    for runs in rows + [None]:
+        if runs is not None and runs == previous and repeat < 64:
+            repeat += 1
+            continue
+        if repeat:
+            out.append(0x80 + repeat - 1)
+            repeat = 0
+        if runs is None:
+            break
+        if runs == previous:
+            repeat = 1
+            continue
+        nibbles = delta(previous, runs)
+        if nibbles is not None:
+            out.append(0xC0)
+            nibbles.append(0)
+            out.extend((nibbles[i] << 4) | nibbles[i + 1] for i in range(0, len(nibbles) - 1, 2))
+        else:
+            out.append(len(runs))
+            x = 0
+            for start, end in runs:
+                out.extend((start - x, end - start))
+                x = end
+        previous = runs
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compresses a GFXfont header.')
+    parser.add_argument('header', help='GFXfont header generated by fontconvert')
+    parser.add_argument('--name', help='name of the new font (default: original name + Z)')
+    parser.add_argument('--stats', action='store_true', help='print sizes to stderr')
+    args = parser.parse_args()
+
+    with open(args.header, encoding='utf-8', errors='ignore') as f:
+        name, bitmap, glyphs, first, last, y_advance = parse_header(f.read())
+    new_name = args.name or name + 'Z'
+
+    data = []
+    records = []
+    for offset, width, height, advance, xo, yo in glyphs:
+        records.append((len(data), width, height, advance, xo, yo))
+        data.extend(encode(glyph_rows(bitmap, offset, width, height)))
+
+    out = sys.stdout
+    guard = re.sub(r'[^A-Z0-9]', '_', new_name.upper()) + '_H'
+    out.write('#ifndef %s\n#define %s\n' % (guard, guard))
+    out.write('// Compressed by fontcompress.py from %s (register with CompressedFont::add())\n' % name)
+    out.write('const uint8_t %sBitmaps[] PROGMEM = {\n' % new_name)
+    for i in range(0, max(len(data), 1), 12):
+        chunk = data[i:i + 12] or [0]
+        out.write('  ' + ', '.join('0x%02X' % b for b in chunk))
+        out.write(',\n' if i + 12 < len(data) else ' };\n\n')
+
+    out.write('const GFXglyph %sGlyphs[] PROGMEM = {\n' % new_name)
+    for i, record in enumerate(records):
+        code = first + i
+        label = "'%s'" % chr(code) if 0x20 <= code < 0x7F and chr(code) != '\\' else ''
+        out.write('  { %5d, %3d, %3d, %3d, %4d, %4d }%s // 0x%02X %s\n'
+                  % (record + (' };' if i == len(records) - 1 else ',  ', code, label)))
+
+    out.write('\nconst GFXfont %s PROGMEM = {\n' % new_name)
+    out.write('  (uint8_t  *)%sBitmaps,\n' % new_name)
+    out.write('  (GFXglyph *)%sGlyphs,\n' % new_name)
+    out.write('  0x%02X, 0x%02X, %d };\n\n' % (first, last, y_advance))
+    out.write('// Approx. %d bytes (bitmap %d -> %d)\n#endif\n'
+              % (len(data) + len(records) * 7 + 7, len(bitmap), len(data)))
+
+    if args.stats:
+        sys.stderr.write('%s: bitmap %d bytes, compressed %d bytes (%.1fx)\n'
+                         % (name, len(bitmap), len(data), len(bitmap) / max(len(data), 1)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,192 @@
+"""Emits only the fonts (and glyphs) an application uses, instead of every size of each family.
+
+Usage:
+    python fontsubset.py path/to/sketch [more files or folders] [--chars RobotoBold50pt7b=0123456789.-]
+
+widgetbase.h includes every size of the enabled families (FONT_ROBOTO, FONT_SEGMENT7, ...).
+Each translation unit that references one of those fonts keeps its own copy of the arrays,
+since the headers define them as const (internal linkage). This script scans the application
+and the library sources for the font names, and writes src/fonts/subset/dfk_fonts.h (extern
+declarations) and dfk_fonts.cpp (one definition of each referenced font). Then add
+
+    #define DFK_FONT_SUBSET
+
+to user_setup.h: widgetbase.h includes the subset instead of the families. Run the script
+again whenever the application starts using another font.
+
+--chars keeps only the given characters of a font used by the application (fonts used by the
+library itself are always complete). The font range shrinks to the lowest..highest kept
+character; glyphs in between that were not asked for keep their advance but no bitmap, and
+characters outside the range are skipped when printed. A report of the bytes before and after
+is printed to stderr and written at the top of dfk_fonts.h.
+"""
+import argparse
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from fontcompress import parse_header  # noqa: E402
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SRC = os.path.dirname(HERE)
+SOURCE_EXTENSIONS = ('.ino', '.cpp', '.c', '.h', '.hpp')
+
+
+def strip_comments(text):
+    """Removes comments and #include lines (string literals are kept as they are)."""
+    text = re.sub(r'//[^\n]*|/\*.*?\*/', '', text, flags=re.S)
+    return re.sub(r'^\s*#\s*include[^\n]*', '', text, flags=re.M)
+
+
+def family_fonts():
+    """Returns {font name: header path} of every header widgetbase.h includes for the families."""
+    with open(os.path.join(SRC, 'widgets', 'widgetbase.h'), encoding='utf-8', errors='ignore') as f:
+        includes = re.findall(r'^#include\s+"\.\./fonts/([^"]+\.h)"', f.read(), re.M)
+    fonts = {}
+    for include in includes:
+        path = os.path.join(HERE, include)
+        if include.startswith('subset/') or not os.path.isfile(path):
+            continue
+        with open(path, encoding='utf-8', errors='ignore') as f:
+            match = re.search(r'const\s+GFXfont\s+(\w+)\s+PROGMEM', f.read())
+        if match:
+            fonts[match.group(1)] = path
+    return fonts
+
+
+def source_files(paths):
+    """Lists the source files under the given files and folders."""
+    for path in paths:
+        if os.path.isfile(path):
+            yield path
+            continue
+        for root, dirs, files in os.walk(path):
+            dirs[:] = [d for d in dirs if os.path.join(root, d) != HERE]
+            for name in sorted(files):
+                if name.endswith(SOURCE_EXTENSIONS):
+                    yield os.path.join(root, name)
+
+
+def references(paths, names):
+    """Returns {font name: set of files that reference it}."""
+    pattern = re.compile(r'\b(' + '|'.join(sorted(names, key=len, reverse=True)) + r')\b')
+    found = {}
+    for path in source_files(paths):
+        with open(path, encoding='utf-8', errors='ignore') as f:
+            for name in set(pattern.findall(strip_comments(f.read()))):
+                found.setdefault(name, set()).add(os.path.abspath(path))
+    return found
+
+
+def subset(font, chars):
+    """Returns (bitmap, glyphs, first, last) keeping only the glyphs of chars (None = all)."""
+    _, bitmap, glyphs, first, last, _ = font
+    if chars is None:
+        return bitmap, glyphs, first, last
+    codes = sorted({ord(c) for c in chars if first <= ord(c) <= last})
+    if not codes:
+        sys.exit('None of the characters is in the font')
+    new_bitmap = []
+    new_glyphs = []
+    for code in range(codes[0], codes[-1] + 1):
+        offset, width, height, advance, xo, yo = glyphs[code - first]
+        if code not in codes:
+            new_glyphs.append((0, 0, 0, advance, 0, 0))
+            continue
+        size = (width * height + 7) // 8
+        new_glyphs.append((len(new_bitmap), width, height, advance, xo, yo))
+        new_bitmap.extend(bitmap[offset:offset + size])
+    return new_bitmap, new_glyphs, codes[0], codes[-1]
+
+
+def font_bytes(bitmap, glyphs):
+    """Flash used by a font: bitmap, 7-byte glyph records and the GFXfont record."""
+    return len(bitmap) + len(glyphs) * 7 + 10
+
+
+def write_font(out, name, bitmap, glyphs, first, last, y_advance):
+    out.write('static const uint8_t %sBitmaps[] PROGMEM = {\n' % name)
+    data = bitmap or [0]
+    for i in range(0, len(data), 12):
+        out.write('  ' + ', '.join('0x%02X' % b for b in data[i:i + 12]))
+        out.write(',\n' if i + 12 < len(data) else ' };\n\n')
+    out.write('static const GFXglyph %sGlyphs[] PROGMEM = {\n' % name)
+    for i, glyph in enumerate(glyphs):
+        end = ' };' if i == len(glyphs) - 1 else ', '
+        out.write('  { %5d, %3d, %3d, %3d, %4d, %4d }%s // 0x%02X\n' % (glyph + (end, first + i)))
+    out.write('\nconst GFXfont %s PROGMEM = {\n' % name)
+    out.write('  (uint8_t  *)%sBitmaps,\n' % name)
+    out.write('  (GFXglyph *)%sGlyphs,\n' % name)
+    out.write('  0x%02X, 0x%02X, %d };\n\n' % (first, last, y_advance))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Emits the fonts referenced by an application.')
+    parser.add_argument('app', nargs='+', help='sketch folder(s) or source files of the application')
+    parser.add_argument('--chars', action='append', default=[], metavar='FONT=CHARS',
+                        help='keep only these characters of a font used by the application')
+    parser.add_argument('--out', default=os.path.join(HERE, 'subset'), help='output folder')
+    args = parser.parse_args()
+
+    fonts = family_fonts()
+    wanted = {}
+    for spec in args.chars:
+        name, _, chars = spec.partition('=')
+        if name not in fonts or not chars:
+            sys.exit('Invalid --chars %s (font not in the families of widgetbase.h?)' % spec)
+        wanted[name] = chars
+
+    library = [p for p in (os.path.join(SRC, d) for d in os.listdir(SRC)) if p != HERE]
+    library_refs = references(library, fonts)
+    app_refs = references(args.app, fonts)
+    used = sorted(set(library_refs) | set(app_refs))
+
+    rows = []
+    total_before = 0
+    total_after = 0
+    os.makedirs(args.out, exist_ok=True)
+    with open(os.path.join(args.out, 'dfk_fonts.cpp'), 'w') as cpp:
+        cpp.write('// Generated by fontsubset.py; do not edit.\n#include "dfk_fonts.h"\n\n')
+        cpp.write('#if defined(DFK_FONT_SUBSET) && defined(USING_GRAPHIC_LIB)\n\n')
+        for name in used:
+            with open(fonts[name], encoding='utf-8', errors='ignore') as f:
+                font = parse_header(f.read())
+            chars = None if name in library_refs else wanted.get(name)
+            if name in library_refs and name in wanted:
+                sys.stderr.write('%s is used by the library; kept complete\n' % name)
+            bitmap, glyphs, first, last = subset(font, chars)
+            write_font(cpp, name, bitmap, glyphs, first, last, font[5])
+            copies = len([p for p in library_refs.get(name, set()) | app_refs.get(name, set())
+                          if not p.endswith(('.h', '.hpp'))]) or 1
+            before = font_bytes(font[1], font[2]) * copies
+            after = font_bytes(bitmap, glyphs)
+            total_before += before
+            total_after += after
+            rows.append('%-20s %-16s %6d x %d -> %6d' % (
+                name, 'all' if chars is None else 'chars 0x%02X-0x%02X' % (first, last),
+                font_bytes(font[1], font[2]), copies, after))
+        cpp.write('#endif\n')
+
+    report = ['%d of %d family fonts referenced (bytes x translation units that reference it -> bytes)'
+              % (len(used), len(fonts))]
+    report += rows
+    report.append('Total: %d bytes before, %d bytes after, %d bytes saved'
+                  % (total_before, total_after, total_before - total_after))
+
+    with open(os.path.join(args.out, 'dfk_fonts.h'), 'w') as h:
+        h.write('// Generated by fontsubset.py; do not edit. Enabled by DFK_FONT_SUBSET (user_setup.h).\n')
+        h.write('//\n' + ''.join('// %s\n' % line for line in report) + '\n')
+        h.write('#ifndef DFK_FONTS_SUBSET_H\n#define DFK_FONTS_SUBSET_H\n\n')
+        h.write('#include "../../widgets/widgetsetup.h"\n\n')
+        h.write('#if defined(USING_GRAPHIC_LIB)\n#if defined(DISP_DEFAULT)\n#include <Arduino_GFX_Library.h>\n')
+        h.write('#else\n#include <Adafruit_GFX.h>\n#endif\n\n')
+        for name in used:
+            h.write('extern const GFXfont %s;\n' % name)
+        h.write('\n#endif\n\n#endif\n')
+
+    sys.stderr.write('\n'.join(report) + '\n')
+
+
+if __name__ == '__main__':
+    main()
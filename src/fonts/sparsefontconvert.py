@@ -0,0 +1,130 @@
+"""Converts a TTF/OTF font into a sparse GFXfont header with extra (non ASCII) characters.
+
+Usage:
+    python sparsefontconvert.py Roboto-Regular.ttf 10 [--chars "°ãé"] [--latin1] [--name RobotoRegular]
+
+The header is written to stdout, like Adafruit's fontconvert. It holds a normal 1-bit GFXfont
+for 0x20-0x7E (<Name><size>pt7bU) followed by the extra glyphs, and a SparseFont table
+(<Name><size>pt7bUSparse) with the extra codepoints grouped in ranges. Register the table with
+SparseFontRenderer::add() and use the GFXfont in the widgets; strings are UTF-8.
+By default the extra characters are the ones of Portuguese text plus the degree and ordinal
+signs. Sizes are in points at the same 141 DPI used by fontconvert. Requires Pillow.
+"""
+import argparse
+import os
+import re
+import sys
+
+from PIL import ImageFont
+
+PORTUGUESE = '°ºªÀÁÂÃÇÉÊÍÓÔÕÚÜàáâãçéêíóôõúü'
+
+
+def glyph_data(font, char):
+    """Returns (bits, width, height, xAdvance, xOffset, yOffset) for one character, 1 bit per pixel."""
+    ascent, _ = font.getmetrics()
+    advance = int(round(font.getlength(char)))
+    mask, (ox, oy) = font.getmask2(char, mode='1')
+    width, height = mask.size
+    box = mask.getbbox() if width and height else None
+    if not box:
+        return [], 0, 0, advance, 0, 0
+    left, top, right, bottom = box
+    bits = [1 if mask.getpixel((x, y)) else 0 for y in range(top, bottom) for x in range(left, right)]
+    return bits, right - left, bottom - top, advance, ox + left, oy + top - ascent
+
+
+def pack(bits):
+    """Packs pixels eight per byte, most significant bit first (a glyph starts on a byte)."""
+    data = []
+    for i in range(0, len(bits), 8):
+        chunk = bits[i:i + 8] + [0] * (8 - len(bits[i:i + 8]))
+        data.append(sum(b << (7 - n) for n, b in enumerate(chunk)))
+    return data
+
+
+def ranges(codes, first_index):
+    """Groups sorted codepoints into (first, last, glyph index) runs."""
+    result = []
+    index = first_index
+    for code in codes:
+        if result and result[-1][1] == code - 1:
+            result[-1][1] = code
+        else:
+            result.append([code, code, index])
+        index += 1
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generates a sparse GFXfont header from a TrueType font.')
+    parser.add_argument('font', help='TTF or OTF file')
+    parser.add_argument('size', type=int, help='size in points')
+    parser.add_argument('--chars', default=PORTUGUESE, help='extra characters (default: Portuguese set)')
+    parser.add_argument('--latin1', action='store_true', help='add every printable character of 0xA0-0xFF')
+    parser.add_argument('--name', help='font name (default: file name without symbols)')
+    parser.add_argument('--dpi', type=int, default=141)
+    args = parser.parse_args()
+
+    extra = {ord(c) for c in args.chars if ord(c) > 0x7E}
+    if args.latin1:
+        extra.update(range(0xA1, 0x100))
+        extra.discard(0xAD)
+    if any(code > 0xFFFF for code in extra):
+        sys.exit('Only characters of the Basic Multilingual Plane (up to U+FFFF) are supported')
+    extra = sorted(extra)
+
+    pixels = int(round(args.size * args.dpi / 72.0))
+    font = ImageFont.truetype(args.font, pixels)
+    base = args.name or re.sub(r'[^A-Za-z0-9]', '', os.path.splitext(os.path.basename(args.font))[0])
+    name = '%s%dpt7bU' % (base, args.size)
+    ascent, descent = font.getmetrics()
+    first, last = 0x20, 0x7E
+
+    bitmap = []
+    glyphs = []
+    for code in list(range(first, last + 1)) + extra:
+        bits, width, height, advance, xo, yo = glyph_data(font, chr(code))
+        if width > 255 or height > 255 or advance > 255 or not -128 <= xo <= 127 or not -128 <= yo <= 127:
+            sys.exit('Glyph U+%04X does not fit GFXglyph fields; use a smaller size' % code)
+        glyphs.append((len(bitmap), width, height, advance, xo, yo, code))
+        bitmap.extend(pack(bits))
+    table = ranges(extra, last - first + 1)
+
+    out = sys.stdout
+    guard = re.sub(r'[^A-Z0-9]', '_', name.upper()) + '_H'
+    out.write('#ifndef %s\n#define %s\n' % (guard, guard))
+    out.write('// Generated by sparsefontconvert.py from %s, %d pt (register %sSparse with SparseFontRenderer::add())\n'
+              % (os.path.basename(args.font), args.size, name))
+    out.write('const uint8_t %sBitmaps[] PROGMEM = {\n' % name)
+    for i in range(0, len(bitmap), 12):
+        out.write('  ' + ', '.join('0x%02X' % b for b in bitmap[i:i + 12]))
+        out.write(',\n' if i + 12 < len(bitmap) else ' };\n\n')
+
+    out.write('const GFXglyph %sGlyphs[] PROGMEM = {\n' % name)
+    for i, (offset, width, height, advance, xo, yo, code) in enumerate(glyphs):
+        end = ' };' if i == len(glyphs) - 1 else ', '
+        label = chr(code) if 0x20 <= code < 0x7F and chr(code) != '\\' else ''
+        out.write('  { %5d, %3d, %3d, %3d, %4d, %4d }%s   // U+%04X %s\n'
+                  % (offset, width, height, advance, xo, yo, end, code, repr(label) if label else ''))
+
+    out.write('\nconst GFXfont %s PROGMEM = {\n' % name)
+    out.write('  (uint8_t  *)%sBitmaps,\n' % name)
+    out.write('  (GFXglyph *)%sGlyphs,\n' % name)
+    out.write('  0x%02X, 0x%02X, %d };\n\n' % (first, last, ascent + descent))
+
+    out.write('const SparseRange_t %sRanges[] PROGMEM = {\n' % name)
+    for i, (lo, hi, index) in enumerate(table):
+        out.write('  { 0x%04X, 0x%04X, %3d }%s\n' % (lo, hi, index, ' };' if i == len(table) - 1 else ','))
+    if not table:
+        out.write('  { 0xFFFF, 0x0000, 0 } };\n')
+
+    out.write('\nconst SparseFont %sSparse PROGMEM = { &%s, %sRanges, %d };\n\n' % (name, name, name, len(table)))
+    extra_bytes = sum(len(pack([0] * (g[1] * g[2]))) for g in glyphs[last - first + 1:])
+    out.write('// Approx. %d bytes; extra characters: %d glyphs, %d bytes (bitmaps %d, records %d, ranges %d)\n#endif\n'
+              % (len(bitmap) + len(glyphs) * 7 + 7 + len(table) * 6 + 8, len(extra),
+                 extra_bytes + len(extra) * 7 + len(table) * 6 + 8, extra_bytes, len(extra) * 7, len(table) * 6 + 8))
+
+
+if __name__ == '__main__':
+    main()
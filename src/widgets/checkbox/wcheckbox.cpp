@@ -43,7 +43,7 @@ CheckBox::~CheckBox() {
  *          no estado ou configuração sejam visíveis imediatamente.
  */
 void CheckBox::forceUpdate() { 
-  m_shouldRedraw = true; 
+  invalidate(); 
   ESP_LOGD(TAG, "CheckBox force update requested");
 }
 
@@ -75,11 +75,10 @@ bool CheckBox::detectTouch(uint16_t *_xTouch, uint16_t *_yTouch) {
   CHECK_POINTER_TOUCH_NULL_BOOL
 
   // Check if touch is within bounds (with some tolerance for better UX)
-  const uint8_t touchTolerance = 2;
-  int xDetect = m_xPos - touchTolerance;
-  int yDetect = m_yPos - touchTolerance;
-  int widthDetect = m_config.size + touchTolerance;
-  int heightDetect = m_config.size + touchTolerance;
+  int xDetect = m_xPos - m_touchTolerance;
+  int yDetect = m_yPos - m_touchTolerance;
+  int widthDetect = m_config.size + m_touchTolerance;
+  int heightDetect = m_config.size + m_touchTolerance;
 
   bool inBouds = POINT_IN_RECT(*_xTouch, *_yTouch, xDetect, yDetect, widthDetect, heightDetect);
 
@@ -87,7 +86,7 @@ bool CheckBox::detectTouch(uint16_t *_xTouch, uint16_t *_yTouch) {
     m_myTime = millis();
     setPressed(true);  // Mark widget as pressed
     changeState();
-    m_shouldRedraw = true;
+    invalidate();
     ESP_LOGD(TAG, "CheckBox touched at (%d, %d), new status: %s", 
                   *_xTouch, *_yTouch, m_status ? "checked" : "unchecked");
     return true;
@@ -192,6 +191,8 @@ void CheckBox::setup(const CheckBoxConfig &config) {
   m_bottomCenterPoint = {.x = (uint16_t)(m_xPos + m_config.size / 2), .y = (uint16_t)(m_yPos + (m_config.size * 0.666 ))};
   m_middleLeftPoint = {.x = (uint16_t)(m_xPos + offsetCheckMark), .y = (uint16_t)(m_yPos + m_config.size / 2)};
 
+  setBounds(m_xPos, m_yPos, m_config.size, m_config.size);
+
 
   
   // Set callback and mark as initialized
@@ -223,7 +224,7 @@ void CheckBox::setStatus(bool status) {
   CHECK_LOADED_VOID
   
   m_status = status;
-  m_shouldRedraw = true;
+  invalidate();
   
   if (m_callback != nullptr) {
     WidgetBase::addCallback(m_callback, WidgetBase::CallbackOrigin::SELF);
@@ -239,7 +240,7 @@ void CheckBox::setStatus(bool status) {
  */
 void CheckBox::show() {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
   ESP_LOGD(TAG, "CheckBox shown at (%d, %d)", m_xPos, m_yPos);
 }
 
@@ -250,7 +251,7 @@ void CheckBox::show() {
  */
 void CheckBox::hide() {
   m_visible = false;
-  m_shouldRedraw = true;
+  invalidate();
   ESP_LOGD(TAG, "CheckBox hidden at (%d, %d)", m_xPos, m_yPos);
 }
 
@@ -348,7 +349,7 @@ void CheckBox::setSize(uint16_t newSize) {
   }
   
   m_config.size = newSize;
-  m_shouldRedraw = true;
+  invalidate();
   
   ESP_LOGD(TAG, "CheckBox size changed to: %d", newSize);
 }
@@ -373,8 +374,23 @@ void CheckBox::setColors(uint16_t checkedColor, uint16_t uncheckedColor) {
   
   m_config.checkedColor = checkedColor;
   m_config.uncheckedColor = uncheckedColor;
-  m_shouldRedraw = true;
+  invalidate();
   
   ESP_LOGD(TAG, "CheckBox colors updated: checked=0x%04X, unchecked=0x%04X", 
                checkedColor, uncheckedColor);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Área aceita por detectTouch(), incluindo a tolerância de toque.
+ */
+Rect_t CheckBox::getTouchBounds() const {
+  return clipRect(m_xPos - m_touchTolerance, m_yPos - m_touchTolerance,
+                  m_config.size + m_touchTolerance, m_config.size + m_touchTolerance);
+}
+
+/**
+ * @brief Indica que o CheckBox responde ao toque.
+ */
+bool CheckBox::isTouchable() const {
+  return true;
+}
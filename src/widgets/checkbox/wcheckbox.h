@@ -35,6 +35,8 @@ public:
   functionCB_t getCallbackFunc() override;
   void redraw() override;
   void forceUpdate() override;
+  bool isTouchable() const override;
+  Rect_t getTouchBounds() const override;
   void setup(const CheckBoxConfig& config);
   bool getStatus() const;
   void setStatus(bool status);
@@ -46,6 +48,7 @@ public:
 
 private:
   static const char *TAG; ///< Tag estática para identificação em logs do ESP32.
+  static constexpr uint8_t m_touchTolerance = 2; ///< Margem extra (px) aceita no toque, acima e à esquerda.
   bool m_status; ///< Status atual do checkbox: true = marcado, false = desmarcado.
   uint8_t m_borderWidth; ///< Largura da borda do checkbox em pixels.
   uint8_t m_borderRadius; ///< Raio dos cantos arredondados do checkbox em pixels.
@@ -63,7 +63,7 @@ bool CircleButton::detectTouch(uint16_t *_xTouch, uint16_t *_yTouch) {
     m_myTime = millis();
     setPressed(true);  // Mark widget as pressed
     changeState();
-    m_shouldRedraw = true;
+    invalidate();
     ESP_LOGD(TAG, "CircleButton touched at (%d, %d), new status: %s", 
                   *_xTouch, *_yTouch, m_status ? "pressed" : "released");
     return true;
@@ -89,7 +89,7 @@ functionCB_t CircleButton::getCallbackFunc() { return m_config.callback; }
  *          no estado ou configuração sejam visíveis imediatamente.
  */
 void CircleButton::forceUpdate() { 
-  m_shouldRedraw = true; 
+  invalidate(); 
   ESP_LOGD(TAG, "CircleButton force update requested");
 }
 
@@ -169,6 +169,8 @@ void CircleButton::setup(const CircleButtonConfig &config) {
   
   m_config = config;
   start();
+  setBounds(m_xPos - m_config.radius, m_yPos - m_config.radius,
+            2 * m_config.radius + 1, 2 * m_config.radius + 1);
   // redraw();
 
   m_loaded = true;
@@ -204,7 +206,7 @@ void CircleButton::setStatus(bool _status) {
   }
 
   m_status = _status;
-  m_shouldRedraw = true;
+  invalidate();
 
   if (m_config.callback != nullptr) {
     WidgetBase::addCallback(m_config.callback, WidgetBase::CallbackOrigin::SELF);
@@ -219,7 +221,7 @@ void CircleButton::setStatus(bool _status) {
  */
 void CircleButton::show() {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
   ESP_LOGD(TAG, "CircleButton shown at (%d, %d)", m_xPos, m_yPos);
 }
 
@@ -230,6 +232,13 @@ void CircleButton::show() {
  */
 void CircleButton::hide() {
   m_visible = false;
-  m_shouldRedraw = true;
+  invalidate();
   ESP_LOGD(TAG, "CircleButton hidden at (%d, %d)", m_xPos, m_yPos);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Indica que o CircleButton responde ao toque.
+ */
+bool CircleButton::isTouchable() const {
+  return true;
+}
@@ -27,6 +27,7 @@ public:
   functionCB_t getCallbackFunc() override;
   void redraw() override;
   void forceUpdate() override;
+  bool isTouchable() const override;
   void show() override;
   void hide() override;
   void setup(const CircleButtonConfig& config);
@@ -65,7 +65,7 @@ void CircularBar::drawBackground() {
               m_config.startAngle, m_config.endAngle, m_config.backgroundColor);
   
   m_lastValue = m_config.minValue; // Reseta referência de desenho
-  m_shouldRedraw = true;
+  invalidate();
   redraw();
 }
 
@@ -81,21 +81,21 @@ void CircularBar::setScale(int newMinValue, int newMaxValue) {
   sortValues();
   m_value = constrain(m_value, m_config.minValue, m_config.maxValue);
   m_changedScale = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 void CircularBar::setMinValue(int newValue) {
   m_config.minValue = newValue;
   sortValues();
   m_changedScale = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 void CircularBar::setMaxValue(int newValue) {
   m_config.maxValue = newValue;
   sortValues();
   m_changedScale = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 int CircularBar::getMinValue() { return m_config.minValue; }
@@ -105,7 +105,7 @@ void CircularBar::setValue(int newValue) {
   int constrained = constrain(newValue, m_config.minValue, m_config.maxValue);
   if (m_value != constrained) {
     m_value = constrained;
-    m_shouldRedraw = true;
+    invalidate();
   }
 }
 
@@ -190,7 +190,7 @@ void CircularBar::redraw() {
 }
 
 void CircularBar::forceUpdate() {
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 void CircularBar::setup(const CircularBarConfig &config) {
@@ -205,17 +205,29 @@ void CircularBar::setup(const CircularBarConfig &config) {
     m_config.showValue = false;
   }
 
+  setBounds(m_xPos - m_config.radius, m_yPos - m_config.radius,
+            2 * m_config.radius + 1, 2 * m_config.radius + 1);
+
   m_loaded = true;
   m_initialized = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 void CircularBar::show() {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 void CircularBar::hide() {
   m_visible = false;
-  m_shouldRedraw = true;
-}
\ No newline at end of file
+  invalidate();
+}
+
+/**
+ * @brief Desenha o CircularBar completo ao carregar a tela.
+ * @details Desenha o fundo estático; a parte dinâmica é desenhada no próximo frame.
+ */
+void CircularBar::fullRedraw() {
+  forceUpdate();
+  drawBackground();
+}
@@ -4,8 +4,10 @@
 #include "../widgetbase.h"
 
 #if defined(DISP_DEFAULT)
+#if !defined(DFK_FONT_SUBSET)
 #include "../../fonts/RobotoRegular/RobotoRegular10pt7b.h"
 #endif
+#endif
 
 /// @brief Estrutura de configuração para o CircularBar.
 struct CircularBarConfig {
@@ -34,6 +36,7 @@ public:
 
   void redraw() override;
   void forceUpdate() override;
+  void fullRedraw() override;
   void show() override;
   void hide() override;
 
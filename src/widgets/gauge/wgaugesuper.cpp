@@ -174,7 +174,7 @@ void GaugeSuper::start()
   m_availableWidth = m_config.width - (2 * m_borderSize);
   m_availableHeight = m_height - (2 * m_borderSize);
 
-  m_shouldRedraw = true;
+  invalidate();
   
   // Configuration is now directly accessible through m_config
   #endif
@@ -206,18 +206,37 @@ void GaugeSuper::drawBackground()
     }
   }
 
+  ESP_LOGD(TAG, "Draw background GaugeSuper");
+
+  m_ltx = 0;                // last x position of needle base
+  m_lastPointNeedle.x = m_origem.x;
+  m_lastPointNeedle.y = m_origem.y; // needle positions
+
+  paintDial();
+
+  m_isFirstDraw = true;
+
+  #endif
+
+  // WidgetBase::objTFT->fillCircle(m_origem.x, m_origem.y, 2, CFK_RED);
+  // WidgetBase::objTFT->drawCircle(m_origem.x, m_origem.y, m_radius, CFK_RED);
+}
+
+/**
+ * @brief Pinta o mostrador estático do gauge (bordas, fundo, faixa colorida, rótulos e marcadores).
+ * @details Não altera o estado da agulha, então pode ser chamado novamente para
+ *          recompor uma área do mostrador no buffer de faixa (ver drawNeedleOffscreen()).
+ */
+void GaugeSuper::paintDial()
+{
+  #if defined(DISP_DEFAULT)
   uint16_t baseBorder = WidgetBase::lightMode ? CFK_BLACK : CFK_WHITE;
 
   // updateFont(FontType::NORMAL);
   WidgetBase::objTFT->setFont(m_usedFont);
 
-  ESP_LOGD(TAG, "Draw background GaugeSuper");
-
   m_indexCurrentStrip = 0;  // Index of first color to paint the strip background
   m_stripColor = CFK_WHITE; // the beginning of the strip is white
-  m_ltx = 0;                // last x position of needle base
-  m_lastPointNeedle.x = m_origem.x;
-  m_lastPointNeedle.y = m_origem.y; // needle positions
 
   for (auto i = 0; i < m_borderSize; ++i)
   {
@@ -387,13 +406,7 @@ void GaugeSuper::drawBackground()
     if (i < 2 * m_maxAngle)
       WidgetBase::objTFT->drawLine(x0, y0, x1, y1, m_config.markersColor);
   }
-
-  m_isFirstDraw = true;
-
   #endif
-
-  // WidgetBase::objTFT->fillCircle(m_origem.x, m_origem.y, 2, CFK_RED);
-  // WidgetBase::objTFT->drawCircle(m_origem.x, m_origem.y, m_radius, CFK_RED);
 }
 
 /**
@@ -417,7 +430,7 @@ void GaugeSuper::setValue(int newValue)
 
   if (m_lastValue != m_currentValue)
   {
-    m_shouldRedraw = true;
+    invalidate();
     ESP_LOGD(TAG, "Set GaugeSuper value to %d", m_currentValue);
   }
   else
@@ -478,13 +491,9 @@ void GaugeSuper::redraw()
   // The -90 is to simulate that total opening angle is rotated 90 degrees for correct tangent calculation (from -90 to 90)
   float tx = fastTan(angulo - 90);
 
-  // Erase old needle
-  if (!m_isFirstDraw)
-  {
-    WidgetBase::objTFT->drawLine(m_origem.x - 1 + round(m_ltx * m_offsetYAgulha), m_origem.y - m_offsetYAgulha - m_borderSize - 2, m_lastPointNeedle.x - 1, m_lastPointNeedle.y, m_config.backgroundColor); // -1 is to not draw on top of thin border line
-    WidgetBase::objTFT->drawLine(m_origem.x + 0 + round(m_ltx * m_offsetYAgulha), m_origem.y - m_offsetYAgulha - m_borderSize - 2, m_lastPointNeedle.x + 0, m_lastPointNeedle.y, m_config.backgroundColor); // -1 is to not draw on top of thin border line
-    WidgetBase::objTFT->drawLine(m_origem.x + 1 + round(m_ltx * m_offsetYAgulha), m_origem.y - m_offsetYAgulha - m_borderSize - 2, m_lastPointNeedle.x + 1, m_lastPointNeedle.y, m_config.backgroundColor); // -1 is to not draw on top of thin border line
-  }
+  CoordPoint_t tip;
+  tip.x = sx * (m_radius - m_distanceAgulhaArco) + m_origem.x; //-2 is the distance between needle end and arc
+  tip.y = sy * (m_radius - m_distanceAgulhaArco) + m_origem.y;
 
   WidgetBase::objTFT->setTextColor(m_config.textColor);
   if (isLabelsVisible())
@@ -495,28 +504,23 @@ void GaugeSuper::redraw()
     //TextBound_t tb_value = getTextBounds(buf, auxX, auxY);
     //printText(buf, auxX, auxY, BL_DATUM, m_textBoundForValue, m_bkColor); //Mostrar valor do gauge
   }
-  if (isTitleVisible())
-  {
-    // Redraw texts
-    // updateFont(FontType::BOLD);
-    WidgetBase::objTFT->setTextColor(m_config.titleColor);
-    WidgetBase::objTFT->setFont(m_usedFont);
 
-    //TextBound_t tb_title = getTextBounds(m_title, m_xPos, m_yPos - (m_borderSize * 2));
-    printText(m_title, m_xPos, m_yPos - (m_borderSize * 2), BC_DATUM);
-    updateFont(FontType::UNLOAD);
+  // With the stripe canvas the old and new needles are composed off-screen in one pass
+  if (m_isFirstDraw || !drawNeedleOffscreen(tx, tip))
+  {
+    // Erase old needle
+    if (!m_isFirstDraw)
+    {
+      drawNeedle(m_ltx, m_lastPointNeedle, m_config.backgroundColor);
+    }
+    drawTitle();
+    // Draw new line
+    drawNeedle(tx, tip, m_config.needleColor);
   }
+
   // store line values to erase later
   m_ltx = tx;
-  m_lastPointNeedle.x = sx * (m_radius - m_distanceAgulhaArco) + m_origem.x; //-2 is the distance between needle end and arc
-  m_lastPointNeedle.y = sy * (m_radius - m_distanceAgulhaArco) + m_origem.y;
-
-  // Draw new line
-  // Draw 3 lines to increase thickness
-
-  WidgetBase::objTFT->drawLine(m_origem.x - 1 + round(m_ltx * m_offsetYAgulha), m_origem.y - m_offsetYAgulha - m_borderSize - 2, m_lastPointNeedle.x - 1, m_lastPointNeedle.y, m_config.needleColor);     // -1 is to not draw on top of thin border line
-  WidgetBase::objTFT->drawLine(m_origem.x + 0 + round(m_ltx * m_offsetYAgulha), m_origem.y - m_offsetYAgulha - m_borderSize - 2, m_lastPointNeedle.x + 0, m_lastPointNeedle.y, m_config.needleColor); // -1 is to not draw on top of thin border line
-  WidgetBase::objTFT->drawLine(m_origem.x + 1 + round(m_ltx * m_offsetYAgulha), m_origem.y - m_offsetYAgulha - m_borderSize - 2, m_lastPointNeedle.x + 1, m_lastPointNeedle.y, m_config.needleColor);     // -1 is to not draw on top of thin border line
+  m_lastPointNeedle = tip;
 
   m_shouldRedraw = false;
   m_isFirstDraw = false;
@@ -532,10 +536,97 @@ void GaugeSuper::redraw()
  */
 void GaugeSuper::forceUpdate()
 {
-  m_shouldRedraw = true;
+  invalidate();
   ESP_LOGD(TAG, "GaugeSuper force update requested");
 }
 
+/**
+ * @brief Desenha a agulha com 3 linhas para aumentar a espessura.
+ * @param ltx Tangente usada para posicionar a base da agulha.
+ * @param tip Ponto final da agulha.
+ * @param color Cor da agulha (a cor de fundo apaga a agulha).
+ */
+void GaugeSuper::drawNeedle(float ltx, const CoordPoint_t &tip, uint16_t color)
+{
+  #if defined(DISP_DEFAULT)
+  int baseX = m_origem.x + round(ltx * m_offsetYAgulha);
+  int baseY = m_origem.y - m_offsetYAgulha - m_borderSize - 2;
+  WidgetBase::objTFT->drawLine(baseX - 1, baseY, tip.x - 1, tip.y, color); // -1 is to not draw on top of thin border line
+  WidgetBase::objTFT->drawLine(baseX + 0, baseY, tip.x + 0, tip.y, color);
+  WidgetBase::objTFT->drawLine(baseX + 1, baseY, tip.x + 1, tip.y, color);
+  #endif
+}
+
+/**
+ * @brief Desenha o título do gauge, se visível.
+ */
+void GaugeSuper::drawTitle()
+{
+  #if defined(DISP_DEFAULT)
+  if (isTitleVisible())
+  {
+    // Redraw texts
+    // updateFont(FontType::BOLD);
+    WidgetBase::objTFT->setTextColor(m_config.titleColor);
+    WidgetBase::objTFT->setFont(m_usedFont);
+
+    //TextBound_t tb_title = getTextBounds(m_title, m_xPos, m_yPos - (m_borderSize * 2));
+    printText(m_title, m_xPos, m_yPos - (m_borderSize * 2), BC_DATUM);
+    updateFont(FontType::UNLOAD);
+  }
+  #endif
+}
+
+/**
+ * @brief Move a agulha compondo a área afetada no buffer de faixa.
+ * @param tx Tangente da nova agulha.
+ * @param tip Ponto final da nova agulha.
+ * @return true se a agulha foi desenhada; false se o buffer de faixa não está disponível.
+ * @details A área que cobre a agulha antiga e a nova é recomposta com o mostrador, o título
+ *          e a nova agulha, e enviada ao display em blocos. A agulha antiga nunca é apagada
+ *          na tela, evitando o efeito de cintilação.
+ */
+bool GaugeSuper::drawNeedleOffscreen(float tx, const CoordPoint_t &tip)
+{
+  #if defined(DISP_DEFAULT)
+  int32_t baseY = m_origem.y - m_offsetYAgulha - m_borderSize - 2;
+  int32_t oldBaseX = m_origem.x + round(m_ltx * m_offsetYAgulha);
+  int32_t newBaseX = m_origem.x + round(tx * m_offsetYAgulha);
+
+  int32_t x0 = min(min(oldBaseX, newBaseX), min((int32_t)m_lastPointNeedle.x, (int32_t)tip.x)) - 2;
+  int32_t x1 = max(max(oldBaseX, newBaseX), max((int32_t)m_lastPointNeedle.x, (int32_t)tip.x)) + 3;
+  int32_t y0 = min(baseY, min((int32_t)m_lastPointNeedle.y, (int32_t)tip.y)) - 1;
+  int32_t y1 = max(baseY, max((int32_t)m_lastPointNeedle.y, (int32_t)tip.y)) + 2;
+
+  // Never compose outside the widget
+  x0 = max(x0, (int32_t)m_bounds.x);
+  y0 = max(y0, (int32_t)m_bounds.y);
+  x1 = min(x1, (int32_t)(m_bounds.x + m_bounds.width));
+  y1 = min(y1, (int32_t)(m_bounds.y + m_bounds.height));
+  if (x1 <= x0 || y1 <= y0)
+  {
+    return false;
+  }
+
+  Rect_t area = {static_cast<uint16_t>(x0), static_cast<uint16_t>(y0),
+                 static_cast<uint16_t>(x1 - x0), static_cast<uint16_t>(y1 - y0)};
+  OffscreenPass_t pass;
+  if (!beginOffscreen(area, m_config.backgroundColor, pass))
+  {
+    return false;
+  }
+  do
+  {
+    paintDial();
+    drawTitle();
+    drawNeedle(tx, tip, m_config.needleColor);
+  } while (nextOffscreenStripe(pass));
+  return true;
+  #else
+  return false;
+  #endif
+}
+
 
 /**
  * @brief Configura o GaugeSuper com parâmetros definidos em uma estrutura de configuração.
@@ -643,6 +734,7 @@ void GaugeSuper::setup(const GaugeConfig& config)
   }
   // Initialize gauge
   start();
+  setBounds(m_xPos - (m_config.width / 2), m_yPos - m_height, m_config.width, m_height);
 
   m_loaded = true;
   m_initialized = true;
@@ -659,7 +751,7 @@ void GaugeSuper::setup(const GaugeConfig& config)
 void GaugeSuper::show()
 {
     m_visible = true;
-    m_shouldRedraw = true;
+    invalidate();
     ESP_LOGD(TAG, "GaugeSuper shown at (%d, %d)", m_xPos, m_yPos);
 }
 
@@ -671,7 +763,7 @@ void GaugeSuper::show()
 void GaugeSuper::hide()
 {
     m_visible = false;
-    m_shouldRedraw = true;
+    invalidate();
     ESP_LOGD(TAG, "GaugeSuper hidden at (%d, %d)", m_xPos, m_yPos);
 }
 
@@ -767,4 +859,13 @@ bool GaugeSuper::validateConfig(const GaugeConfig& config)
   }
   
   return true;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Desenha o GaugeSuper completo ao carregar a tela.
+ * @details Desenha o fundo estático; a parte dinâmica é desenhada no próximo frame.
+ */
+void GaugeSuper::fullRedraw() {
+  forceUpdate();
+  drawBackground();
+}
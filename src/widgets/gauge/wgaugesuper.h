@@ -3,8 +3,10 @@
 
 #include "../widgetbase.h"
 #if defined(USING_GRAPHIC_LIB)
+#if !defined(DFK_FONT_SUBSET)
 #include "../../fonts/RobotoRegular/RobotoRegular10pt7b.h"
 #endif
+#endif
 
 /// @brief Estrutura de configuração para o GaugeSuper.
 /// @details Esta estrutura contém todos os parâmetros necessários para configurar um gauge super.
@@ -49,6 +51,7 @@ public:
   functionCB_t getCallbackFunc() override;
   void redraw() override;
   void forceUpdate() override;
+  void fullRedraw() override;
   void show() override;
   void hide() override;
   
@@ -105,6 +108,10 @@ private:
   CoordPoint_t m_origem; ///< Centro do relógio do gauge.
   
   void start();
+  void paintDial();
+  void drawNeedle(float ltx, const CoordPoint_t &tip, uint16_t color);
+  void drawTitle();
+  bool drawNeedleOffscreen(float tx, const CoordPoint_t &tip);
   void cleanupMemory();
   bool validateConfig(const GaugeConfig& config);
   bool isTitleVisible() const;
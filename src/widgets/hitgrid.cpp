@@ -0,0 +1,218 @@
+// hitgrid.cpp
+#include "hitgrid.h"
+#include <esp_log.h>
+#include <new>
+
+const char *HitGrid::TAG = "HitGrid";
+
+/**
+ * @brief Default constructor. The grid is empty until build() is called.
+ */
+HitGrid::HitGrid()
+    : m_cols(0), m_rows(0),
+      m_cellStart(nullptr), m_cellSlots(0),
+      m_entries(nullptr), m_entrySlots(0),
+      m_always(nullptr), m_alwaysCount(0), m_alwaysSlots(0),
+      m_built(false)
+{
+}
+
+/**
+ * @brief Destructor. Frees the index arrays.
+ */
+HitGrid::~HitGrid() {
+    delete[] m_cellStart;
+    delete[] m_entries;
+    delete[] m_always;
+}
+
+/**
+ * @brief Indexes the touchable widgets of a screen.
+ * @param span Widgets of the screen, in paint order.
+ * @param width Screen width in pixels.
+ * @param height Screen height in pixels.
+ * @return false if there is no memory or the grid would be too large; queries then fail and
+ *         the caller must scan the span.
+ * @details Two passes over the span: the first counts the widgets of each cell, the second
+ *          writes their indexes. Buffers are reused between builds and only grow.
+ */
+bool HitGrid::build(const WidgetSpan_t &span, uint16_t width, uint16_t height) {
+    m_built = false;
+    if (width == 0 || height == 0) {
+        return false;
+    }
+
+    m_cols = (width + DFK_HIT_GRID_CELL - 1) / DFK_HIT_GRID_CELL;
+    m_rows = (height + DFK_HIT_GRID_CELL - 1) / DFK_HIT_GRID_CELL;
+    uint32_t cells = static_cast<uint32_t>(m_cols) * m_rows;
+    if (!ensure(m_cellStart, m_cellSlots, cells + 1)) {
+        ESP_LOGE(TAG, "Can't allocate %u cells", (unsigned)cells);
+        return false;
+    }
+    for (uint32_t c = 0; c <= cells; c++) {
+        m_cellStart[c] = 0;
+    }
+
+    // Pass 1: count the entries of each cell (stored one slot ahead)
+    uint32_t total = 0;
+    uint32_t always = 0;
+    for (uint16_t i = 0; i < span.count; i++) {
+        if (!span.widgets[i]->isTouchable()) continue;
+        Rect_t r = span.widgets[i]->getTouchBounds();
+        if (r.width == 0 || r.height == 0) {
+            always++;
+            continue;
+        }
+        uint16_t c0, r0, c1, r1;
+        if (!cellRange(r, c0, r0, c1, r1)) continue;
+        for (uint16_t row = r0; row <= r1; row++) {
+            for (uint16_t col = c0; col <= c1; col++) {
+                m_cellStart[row * m_cols + col + 1]++;
+            }
+        }
+        total += static_cast<uint32_t>(c1 - c0 + 1) * (r1 - r0 + 1);
+    }
+    if (total > UINT16_MAX) {
+        ESP_LOGW(TAG, "Too many grid entries (%u)", (unsigned)total);
+        return false;
+    }
+    if (!ensure(m_entries, m_entrySlots, total) || !ensure(m_always, m_alwaysSlots, always)) {
+        ESP_LOGE(TAG, "Can't allocate %u grid entries", (unsigned)total);
+        return false;
+    }
+
+    // Counts to offsets: m_cellStart[c] is now the first entry of cell c
+    for (uint32_t c = 1; c <= cells; c++) {
+        m_cellStart[c] += m_cellStart[c - 1];
+    }
+
+    // Pass 2: write the indexes, using m_cellStart[c] as the write cursor of cell c
+    m_alwaysCount = 0;
+    for (uint16_t i = 0; i < span.count; i++) {
+        if (!span.widgets[i]->isTouchable()) continue;
+        Rect_t r = span.widgets[i]->getTouchBounds();
+        if (r.width == 0 || r.height == 0) {
+            m_always[m_alwaysCount++] = i;
+            continue;
+        }
+        uint16_t c0, r0, c1, r1;
+        if (!cellRange(r, c0, r0, c1, r1)) continue;
+        for (uint16_t row = r0; row <= r1; row++) {
+            for (uint16_t col = c0; col <= c1; col++) {
+                m_entries[m_cellStart[row * m_cols + col]++] = i;
+            }
+        }
+    }
+
+    // Each cursor stopped at the start of the next cell; shift them back
+    for (uint32_t c = cells; c > 0; c--) {
+        m_cellStart[c] = m_cellStart[c - 1];
+    }
+    m_cellStart[0] = 0;
+
+    m_built = true;
+    ESP_LOGD(TAG, "Grid %ux%u built with %u entries", m_cols, m_rows, (unsigned)total);
+    return true;
+}
+
+/**
+ * @brief Marks the grid as empty. Memory is kept for the next build().
+ */
+void HitGrid::clear() {
+    m_built = false;
+    m_alwaysCount = 0;
+}
+
+/**
+ * @brief Checks if the grid can answer queries.
+ */
+bool HitGrid::isBuilt() const {
+    return m_built;
+}
+
+/**
+ * @brief Gets the widgets that may accept a touch at a point.
+ * @param x Touch X position.
+ * @param y Touch Y position.
+ * @param out Receives the span indexes in paint order (bottom first).
+ * @return false if the grid is not built or the point has more than DFK_HIT_MAX_CANDIDATES
+ *         candidates; the caller must scan the whole span.
+ */
+bool HitGrid::query(uint16_t x, uint16_t y, HitCandidates_t &out) const {
+    out.count = 0;
+    if (!m_built) {
+        return false;
+    }
+
+    const uint16_t *cell = nullptr;
+    uint16_t cellCount = 0;
+    uint16_t col = x / DFK_HIT_GRID_CELL;
+    uint16_t row = y / DFK_HIT_GRID_CELL;
+    if (col < m_cols && row < m_rows) {
+        uint32_t c = static_cast<uint32_t>(row) * m_cols + col;
+        cell = m_entries + m_cellStart[c];
+        cellCount = m_cellStart[c + 1] - m_cellStart[c];
+    }
+
+    if (static_cast<uint32_t>(cellCount) + m_alwaysCount > DFK_HIT_MAX_CANDIDATES) {
+        return false;
+    }
+
+    // Merge the cell list and the always list, both sorted by paint order
+    uint16_t a = 0;
+    uint16_t b = 0;
+    while (a < cellCount || b < m_alwaysCount) {
+        if (b >= m_alwaysCount || (a < cellCount && cell[a] < m_always[b])) {
+            out.index[out.count++] = cell[a++];
+        } else {
+            out.index[out.count++] = m_always[b++];
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the number of bytes allocated by the grid.
+ */
+uint32_t HitGrid::memoryUsage() const {
+    return (m_cellSlots + m_entrySlots + m_alwaysSlots) * sizeof(uint16_t);
+}
+
+/**
+ * @brief Converts a rectangle to the range of cells it overlaps.
+ * @return false if the rectangle is outside the grid.
+ */
+bool HitGrid::cellRange(const Rect_t &r, uint16_t &c0, uint16_t &r0, uint16_t &c1, uint16_t &r1) const {
+    c0 = r.x / DFK_HIT_GRID_CELL;
+    r0 = r.y / DFK_HIT_GRID_CELL;
+    if (c0 >= m_cols || r0 >= m_rows) {
+        return false;
+    }
+    uint32_t lastCol = (static_cast<uint32_t>(r.x) + r.width - 1) / DFK_HIT_GRID_CELL;
+    uint32_t lastRow = (static_cast<uint32_t>(r.y) + r.height - 1) / DFK_HIT_GRID_CELL;
+    c1 = lastCol < m_cols ? lastCol : m_cols - 1;
+    r1 = lastRow < m_rows ? lastRow : m_rows - 1;
+    return true;
+}
+
+/**
+ * @brief Grows a buffer to hold at least the given number of entries.
+ * @return false if the memory could not be allocated (the old buffer is kept).
+ */
+template <typename T>
+bool HitGrid::ensure(T *&buffer, uint32_t &slots, uint32_t needed) {
+    if (needed <= slots && buffer != nullptr) {
+        return true;
+    }
+    if (needed == 0) {
+        needed = 1;
+    }
+    T *grown = new (std::nothrow) T[needed];
+    if (!grown) {
+        return false;
+    }
+    delete[] buffer;
+    buffer = grown;
+    slots = needed;
+    return true;
+}
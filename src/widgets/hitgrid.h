@@ -0,0 +1,60 @@
+// hitgrid.h
+#ifndef HITGRID_H
+#define HITGRID_H
+
+#include <stdint.h>
+#include "widgetregistry.h"
+
+#ifndef DFK_HIT_GRID_CELL
+#define DFK_HIT_GRID_CELL 32 ///< Side of a grid cell in pixels.
+#endif
+
+#ifndef DFK_HIT_MAX_CANDIDATES
+#define DFK_HIT_MAX_CANDIDATES 16 ///< Most widgets returned for one point before falling back to a full scan.
+#endif
+
+/// @brief Widgets that may accept a touch at one point.
+typedef struct {
+    uint16_t index[DFK_HIT_MAX_CANDIDATES]; ///< Indexes into the screen span, in paint order.
+    uint8_t count;                          ///< Number of valid entries.
+} HitCandidates_t;
+
+/// @brief Uniform grid of the touch areas of the widgets of one screen.
+/// @details The screen is split in square cells of DFK_HIT_GRID_CELL pixels. Each cell keeps the
+///          span indexes of the touchable widgets whose getTouchBounds() overlaps it, in paint
+///          order, packed in a single array with one offset per cell. A query reads one cell,
+///          so its cost depends on how many widgets overlap that cell and not on how many
+///          widgets the screen has. Widgets without a touch area (zero size) are kept in a
+///          separate list and returned for every point. The grid stores indexes, so it must be
+///          rebuilt whenever the span changes.
+class HitGrid {
+public:
+    HitGrid();
+    ~HitGrid();
+
+    bool build(const WidgetSpan_t &span, uint16_t width, uint16_t height);
+    void clear();
+    bool isBuilt() const;
+    bool query(uint16_t x, uint16_t y, HitCandidates_t &out) const;
+    uint32_t memoryUsage() const;
+
+private:
+    static const char *TAG; ///< Tag estática para identificação em logs.
+
+    uint16_t m_cols;        ///< Number of cell columns.
+    uint16_t m_rows;        ///< Number of cell rows.
+    uint16_t *m_cellStart;  ///< First entry of each cell; cell c spans [c, c + 1). Has m_cols * m_rows + 1 entries.
+    uint32_t m_cellSlots;   ///< Number of entries allocated in m_cellStart.
+    uint16_t *m_entries;    ///< Span indexes of every cell, packed.
+    uint32_t m_entrySlots;  ///< Number of entries allocated in m_entries.
+    uint16_t *m_always;     ///< Span indexes of touchable widgets without a touch area.
+    uint16_t m_alwaysCount; ///< Number of entries in m_always.
+    uint32_t m_alwaysSlots; ///< Number of entries allocated in m_always.
+    bool m_built;           ///< True after a successful build().
+
+    bool cellRange(const Rect_t &r, uint16_t &c0, uint16_t &r0, uint16_t &c1, uint16_t &r1) const;
+    template <typename T>
+    static bool ensure(T *&buffer, uint32_t &slots, uint32_t needed);
+};
+
+#endif // HITGRID_H
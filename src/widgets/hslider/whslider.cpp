@@ -80,7 +80,7 @@ bool HSlider::detectTouch(uint16_t *_xTouch, uint16_t *_yTouch) {
     m_currentPos = (*_xTouch);
     m_currentPos = constrain(m_currentPos, m_minX, m_maxX);
     updateValue();
-    m_shouldRedraw = true;
+    invalidate();
   }
   #else
   if(POINT_IN_RECT(*_xTouch, *_yTouch, m_minX, m_yPos, (m_config.width), m_height)) {
@@ -89,7 +89,7 @@ bool HSlider::detectTouch(uint16_t *_xTouch, uint16_t *_yTouch) {
     m_currentPos = (*_xTouch);
     m_currentPos = constrain(m_currentPos, m_minX, m_maxX);
     updateValue();
-    m_shouldRedraw = true;
+    invalidate();
   }
   #endif
 
@@ -170,7 +170,7 @@ void HSlider::updateDimensions() {
  */
 void HSlider::start() {
   updateDimensions();
-  m_shouldRedraw = true;
+  invalidate();
   ESP_LOGD(TAG, "HSlider initialized at (%d, %d)", m_xPos, m_yPos);
 }
 
@@ -201,10 +201,6 @@ void HSlider::redraw() {
   m_shouldRedraw = false;
 
   #if defined(USING_GRAPHIC_LIB)
-
-
-  Serial.println("HSlider redraw");
-
   uint16_t lightBg = WidgetBase::lightMode ? CFK_GREY11 : CFK_GREY3;
 
   // Clear previous position
@@ -302,6 +298,7 @@ void HSlider::setup(const HSliderConfig &config) {
 
   m_currentPos = m_minX;
   m_lastPos = m_currentPos;
+  setBounds(m_xPos, m_yPos, m_config.width, m_height);
 
   updateValue();
 
@@ -336,7 +333,7 @@ void HSlider::setValue(int newValue) {
   // Update position based on value
   m_currentPos = map(m_value, m_config.minValue, m_config.maxValue, m_minX, m_maxX);
   
-  m_shouldRedraw = true;
+  invalidate();
   
   if (m_callback != nullptr) {
     WidgetBase::addCallback(m_callback, WidgetBase::CallbackOrigin::SELF);
@@ -351,7 +348,7 @@ void HSlider::setValue(int newValue) {
  *          seja redesenhado na próxima oportunidade.
  */
 void HSlider::forceUpdate() { 
-  m_shouldRedraw = true; 
+  invalidate(); 
   ESP_LOGD(TAG, "HSlider force update requested");
 }
 
@@ -361,7 +358,7 @@ void HSlider::forceUpdate() {
  */
 void HSlider::show() {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
   ESP_LOGD(TAG, "HSlider shown at (%d, %d)", m_xPos, m_yPos);
 }
 
@@ -371,6 +368,38 @@ void HSlider::show() {
  */
 void HSlider::hide() {
   m_visible = false;
-  m_shouldRedraw = true;
+  invalidate();
   ESP_LOGD(TAG, "HSlider hidden at (%d, %d)", m_xPos, m_yPos);
 }
+
+/**
+ * @brief Desenha o HSlider completo ao carregar a tela.
+ * @details Desenha o fundo estático; a parte dinâmica é desenhada no próximo frame.
+ */
+void HSlider::fullRedraw() {
+  forceUpdate();
+  drawBackground();
+}
+
+/**
+ * @brief Área aceita por detectTouch().
+ * @details A faixa de toque começa em m_minX e tem a largura total do slider, passando do fim
+ *          da área desenhada. Com DETECT_ON_HANDLER o toque é aceito ao redor do controle, em
+ *          qualquer posição entre m_minX e m_maxX.
+ */
+Rect_t HSlider::getTouchBounds() const {
+  #if defined(DETECT_ON_HANDLER)
+  int32_t radiusToDetect = m_config.radius + 10;
+  return clipRect(m_minX - radiusToDetect, m_yPos, (m_maxX - m_minX) + 2 * radiusToDetect, 2 * radiusToDetect);
+  #else
+  int32_t right = max((int32_t)m_xPos + m_config.width, (int32_t)m_minX + m_config.width);
+  return clipRect(m_xPos, m_yPos, right - m_xPos, m_height);
+  #endif
+}
+
+/**
+ * @brief Indica que o HSlider responde ao toque.
+ */
+bool HSlider::isTouchable() const {
+  return true;
+}
@@ -37,6 +37,9 @@ public:
   functionCB_t getCallbackFunc() override;
   void redraw() override;
   void forceUpdate() override;
+  void fullRedraw() override;
+  bool isTouchable() const override;
+  Rect_t getTouchBounds() const override;
   void show() override;
   void hide() override;
   
@@ -0,0 +1,144 @@
+"""Compresses images for the Image widget into the .fkz format (see src/extras/fkzimage.h).
+
+Usage:
+    python imagecompress.py icon.fki icon.fkz [--stats]
+    python imagecompress.py icon.png icon.fkz [--stats]
+
+The input is an .fki image (big-endian RGB565 followed by a 1-bit mask) or any image Pillow
+can open (pixels with alpha below 128 become transparent; Pillow is only needed for these).
+The Image widget tells both formats apart by the first bytes of the file, so a compressed
+file can replace the original one under any name. --stats prints the sizes and the share of
+each operation to stderr.
+"""
+import argparse
+import struct
+import sys
+
+RUN, INDEX, DIFF, SKIP, LUMA, RGB = 'run', 'index', 'diff', 'skip', 'luma', 'rgb'
+
+
+def read_fki(data):
+    """Returns (width, height, pixels, visible) of an .fki file."""
+    width, height = struct.unpack('>HH', data[:4])
+    count = width * height
+    pixels = list(struct.unpack('>%dH' % count, data[4:4 + count * 2]))
+    if len(pixels) != count:
+        sys.exit('Truncated .fki file')
+    mask_at = 4 + count * 2
+    byte_width = (width + 7) // 8
+    visible = [True] * count
+    if len(data) >= mask_at + 2:
+        mask_len = struct.unpack('>H', data[mask_at:mask_at + 2])[0]
+        mask = data[mask_at + 2:mask_at + 2 + mask_len]
+        if len(mask) >= byte_width * height:
+            visible = [bool(mask[y * byte_width + (x >> 3)] & (0x80 >> (x & 7)))
+                       for y in range(height) for x in range(width)]
+    return width, height, pixels, visible
+
+
+def read_picture(path):
+    """Returns (width, height, pixels, visible) of a PNG, BMP, JPEG..."""
+    from PIL import Image
+    image = Image.open(path).convert('RGBA')
+    width, height = image.size
+    pixels = []
+    visible = []
+    for r, g, b, a in image.getdata():
+        pixels.append(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+        visible.append(a >= 128)
+    return width, height, pixels, visible
+
+
+def color_hash(color):
+    return ((color >> 11) * 3 + ((color >> 5) & 0x3F) * 5 + (color & 0x1F) * 7) & 63
+
+
+def wrap(value, bits):
+    """Signed difference of two channel values that wrap at 2**bits."""
+    half = 1 << (bits - 1)
+    return (value + half) % (1 << bits) - half
+
+
+def encode(width, height, pixels, visible):
+    """Returns (file bytes, {operation: count})."""
+    out = bytearray(b'FKZ1')
+    has_mask = not all(visible)
+    out += struct.pack('>HHBB', width, height, 1 if has_mask else 0, 0)
+    index = [0] * 64
+    previous = 0
+    ops = dict.fromkeys((RUN, INDEX, DIFF, SKIP, LUMA, RGB), 0)
+    for y in range(height):
+        row = y * width
+        x = 0
+        while x < width:
+            if not visible[row + x]:
+                n = 1
+                while x + n < width and n < 62 and not visible[row + x + n]:
+                    n += 1
+                out.append(0xC0 + n - 1)
+                ops[SKIP] += 1
+                x += n
+                continue
+            color = pixels[row + x]
+            if color == previous:
+                n = 1
+                while (x + n < width and n < 64 and visible[row + x + n]
+                       and pixels[row + x + n] == previous):
+                    n += 1
+                out.append(n - 1)
+                ops[RUN] += 1
+                x += n
+                continue
+            slot = color_hash(color)
+            if index[slot] == color:
+                out.append(0x40 | slot)
+                ops[INDEX] += 1
+            else:
+                dr = wrap((color >> 11) - (previous >> 11), 5)
+                dg = wrap(((color >> 5) & 0x3F) - ((previous >> 5) & 0x3F), 6)
+                db = wrap((color & 0x1F) - (previous & 0x1F), 5)
+                if -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+                    out.append(0x80 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2))
+                    ops[DIFF] += 1
+                elif -8 <= dg <= 7 and -2 <= dr - dg <= 1 and -2 <= db - dg <= 1:
+                    out += bytes((0xFE, ((dg + 8) << 4) | ((dr - dg + 2) << 2) | (db - dg + 2)))
+                    ops[LUMA] += 1
+                else:
+                    out += bytes((0xFF, color >> 8, color & 0xFF))
+                    ops[RGB] += 1
+                index[slot] = color
+            previous = color
+            x += 1
+    return bytes(out), ops
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compresses an image for the Image widget (.fkz).')
+    parser.add_argument('input', help='.fki file or picture (PNG, BMP, ...)')
+    parser.add_argument('output', help='.fkz file to write')
+    parser.add_argument('--stats', action='store_true', help='print sizes and operation counts')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+    if args.input.lower().endswith('.fki'):
+        width, height, pixels, visible = read_fki(data)
+    else:
+        width, height, pixels, visible = read_picture(args.input)
+    if not 0 < width <= 4096 or not 0 < height <= 4096:
+        sys.exit('Invalid image size %dx%d' % (width, height))
+
+    encoded, ops = encode(width, height, pixels, visible)
+    with open(args.output, 'wb') as f:
+        f.write(encoded)
+
+    if args.stats:
+        raw = 4 + width * height * 2 + 2 + (width + 7) // 8 * height
+        total = sum(ops.values()) or 1
+        sys.stderr.write('%dx%d: %d bytes as .fki, %d bytes as .fkz (%.2fx)\n'
+                         % (width, height, raw, len(encoded), raw / len(encoded)))
+        sys.stderr.write(', '.join('%s %.1f%%' % (k, 100.0 * v / total) for k, v in ops.items()) + '\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,221 @@
+#include "imageloader.h"
+#include <esp_log.h>
+
+const char *ImageLoader::TAG = "ImageLoader";
+
+ImageLoader::LoadRequest_t ImageLoader::m_requests[DFK_IMAGE_LOADER_SLOTS];
+SemaphoreHandle_t ImageLoader::m_mutex = nullptr;
+TaskHandle_t ImageLoader::m_task = nullptr;
+uint32_t ImageLoader::m_order = 0;
+
+/**
+ * @brief Cria o mutex e a task de carregamento, no primeiro pedido.
+ * @return True se a task está rodando.
+ */
+bool ImageLoader::begin() {
+  if (m_task) {
+    return true;
+  }
+  if (!m_mutex) {
+    m_mutex = xSemaphoreCreateMutex();
+    if (!m_mutex) {
+      ESP_LOGE(TAG, "Failed to create image loader mutex");
+      return false;
+    }
+  }
+  if (xTaskCreatePinnedToCore(ImageLoader::task, "ImageLoader", DFK_IMAGE_LOADER_STACK, nullptr,
+                              DFK_IMAGE_LOADER_PRIORITY, &m_task, DFK_IMAGE_LOADER_CORE) != pdPASS) {
+    ESP_LOGE(TAG, "Failed to create image loader task");
+    m_task = nullptr;
+    return false;
+  }
+  ESP_LOGD(TAG, "Image loader started");
+  return true;
+}
+
+/**
+ * @brief Pede a leitura de um arquivo para um widget.
+ * @param image Widget que receberá a imagem.
+ * @param fs Sistema de arquivos.
+ * @param source Fonte do arquivo (SourceFile), chave do cache.
+ * @param path Caminho do arquivo.
+ * @param screen Tela do widget, para a prioridade.
+ * @return False se a task não pôde ser criada ou a fila está cheia; o widget lê o arquivo na hora.
+ */
+bool ImageLoader::request(Image *image, fs::FS *fs, uint8_t source, const char *path, uint8_t screen) {
+  if (!image || !fs || !path || !begin()) {
+    return false;
+  }
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+  LoadRequest_t *slot = nullptr;
+  for (uint8_t i = 0; i < DFK_IMAGE_LOADER_SLOTS; i++) {
+    if (m_requests[i].state == SlotState::FREE) {
+      slot = &m_requests[i];
+      break;
+    }
+  }
+  if (slot) {
+    *slot = {image, fs, path, {nullptr, nullptr, 0, 0, 0, 0, nullptr}, ++m_order, source, screen, SlotState::PENDING};
+  }
+  xSemaphoreGive(m_mutex);
+  if (!slot) {
+    ESP_LOGW(TAG, "Image loader queue is full (%d requests)", DFK_IMAGE_LOADER_SLOTS);
+    return false;
+  }
+  xTaskNotifyGive(m_task);
+  return true;
+}
+
+/**
+ * @brief Entrega ao widget a imagem lida, se já estiver pronta.
+ * @param image Widget que fez o pedido.
+ * @param data Recebe a imagem; o widget passa a ser dono dos buffers ou da referência do cache.
+ * @param failed Recebe true se a leitura falhou.
+ * @return False se a imagem ainda está na fila ou sendo lida.
+ */
+bool ImageLoader::collect(Image *image, ImageFileData_t &data, bool &failed) {
+  if (!m_mutex) {
+    return false;
+  }
+  bool ready = false;
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+  for (uint8_t i = 0; i < DFK_IMAGE_LOADER_SLOTS; i++) {
+    LoadRequest_t &request = m_requests[i];
+    if (request.image == image && (request.state == SlotState::DONE || request.state == SlotState::FAILED)) {
+      data = request.data;
+      failed = request.state == SlotState::FAILED;
+      request.image = nullptr;
+      request.state = SlotState::FREE;
+      ready = true;
+      break;
+    }
+  }
+  xSemaphoreGive(m_mutex);
+  return ready;
+}
+
+/**
+ * @brief Cancela o pedido de um widget que vai ser destruído ou reconfigurado.
+ * @details Um pedido em leitura é marcado como cancelado e a task libera a imagem ao terminar;
+ *          uma imagem já pronta é liberada aqui.
+ */
+void ImageLoader::cancel(Image *image) {
+  if (!m_mutex) {
+    return;
+  }
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+  for (uint8_t i = 0; i < DFK_IMAGE_LOADER_SLOTS; i++) {
+    LoadRequest_t &request = m_requests[i];
+    if (request.image != image || request.state == SlotState::FREE) {
+      continue;
+    }
+    if (request.state == SlotState::DONE) {
+      Image::freeFileData(request.data);
+    }
+    request.image = nullptr;
+    if (request.state != SlotState::LOADING) {
+      request.state = SlotState::FREE;
+    }
+  }
+  xSemaphoreGive(m_mutex);
+}
+
+/**
+ * @brief Número de pedidos aguardando ou sendo lidos.
+ */
+uint8_t ImageLoader::pending() {
+  if (!m_mutex) {
+    return 0;
+  }
+  uint8_t count = 0;
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+  for (uint8_t i = 0; i < DFK_IMAGE_LOADER_SLOTS; i++) {
+    if (m_requests[i].state == SlotState::PENDING || m_requests[i].state == SlotState::LOADING) {
+      count++;
+    }
+  }
+  xSemaphoreGive(m_mutex);
+  return count;
+}
+
+/**
+ * @brief Escolhe o próximo pedido: o mais antigo da tela visível, senão o mais antigo de todos.
+ * @return Índice do pedido, -1 se não há pedidos. O mutex deve estar tomado.
+ */
+int8_t ImageLoader::next() {
+  int8_t best = -1;
+  bool bestVisible = false;
+  for (uint8_t i = 0; i < DFK_IMAGE_LOADER_SLOTS; i++) {
+    const LoadRequest_t &request = m_requests[i];
+    if (request.state != SlotState::PENDING) {
+      continue;
+    }
+    const bool visible = request.screen == WidgetBase::currentScreen;
+    if (best < 0 || (visible && !bestVisible) ||
+        (visible == bestVisible && request.order < m_requests[best].order)) {
+      best = static_cast<int8_t>(i);
+      bestVisible = visible;
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Obtém a imagem de um arquivo: do cache, se outro widget já a carregou, ou do arquivo.
+ * @return True se a imagem foi obtida.
+ */
+bool ImageLoader::load(fs::FS *fs, uint8_t source, const char *path, ImageFileData_t &data) {
+  ImageCache *cache = WidgetBase::imageCache;
+  const ImageCacheEntry_t *entry = cache ? cache->acquire(source, path, false) : nullptr;
+  if (entry) {
+    data = {static_cast<pixel_t *>(entry->pixels), entry->mask, 0, 0, entry->width, entry->height, entry};
+    return true;
+  }
+  if (!Image::decodeFile(fs, path, data)) {
+    return false;
+  }
+  Image::cacheFileData(source, path, data);
+  return true;
+}
+
+/**
+ * @brief Laço da task: atende os pedidos até a fila esvaziar e espera o próximo aviso.
+ * @details O arquivo é lido sem o mutex; a imagem é entregue com o mutex tomado, para que o
+ *          widget não seja destruído enquanto é invalidado.
+ */
+void ImageLoader::task(void *params) {
+  (void)params;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    for (;;) {
+      xSemaphoreTake(m_mutex, portMAX_DELAY);
+      const int8_t index = next();
+      if (index < 0) {
+        xSemaphoreGive(m_mutex);
+        break;
+      }
+      LoadRequest_t &request = m_requests[index];
+      request.state = SlotState::LOADING;
+      fs::FS *fs = request.fs;
+      const char *path = request.path;
+      const uint8_t source = request.source;
+      xSemaphoreGive(m_mutex);
+
+      ImageFileData_t data;
+      const bool loaded = load(fs, source, path, data);
+
+      xSemaphoreTake(m_mutex, portMAX_DELAY);
+      if (request.image) {
+        request.data = data;
+        request.state = loaded ? SlotState::DONE : SlotState::FAILED;
+        request.image->invalidate();
+      } else {
+        if (loaded) {
+          Image::freeFileData(data);
+        }
+        request.state = SlotState::FREE;
+      }
+      xSemaphoreGive(m_mutex);
+    }
+  }
+}
@@ -0,0 +1,72 @@
+#ifndef WIMAGELOADER
+#define WIMAGELOADER
+
+#include "wimage.h"
+
+#ifndef DFK_IMAGE_LOADER_SLOTS
+#define DFK_IMAGE_LOADER_SLOTS 16 ///< Imagens que podem aguardar leitura em segundo plano ao mesmo tempo.
+#endif
+#ifndef DFK_IMAGE_LOADER_STACK
+#define DFK_IMAGE_LOADER_STACK 4096 ///< Pilha da task de carregamento (bytes).
+#endif
+#ifndef DFK_IMAGE_LOADER_PRIORITY
+#define DFK_IMAGE_LOADER_PRIORITY 1 ///< Prioridade da task de carregamento.
+#endif
+#ifndef DFK_IMAGE_LOADER_CORE
+#define DFK_IMAGE_LOADER_CORE 0 ///< Núcleo da task de carregamento.
+#endif
+
+/// @brief Task que lê arquivos de imagem em segundo plano para os widgets Image.
+/// @details Usado por Image::setupFromFile() com ImageFromFileConfig::async. A função que monta
+///          a tela só lê o cabeçalho de cada arquivo e segue; a task, criada no primeiro pedido,
+///          decodifica os arquivos, entrega as imagens ao cache compartilhado
+///          (WidgetBase::imageCache) e invalida cada widget quando a sua imagem fica pronta.
+///          Os pedidos da tela visível (WidgetBase::currentScreen) são atendidos primeiro; os
+///          outros na ordem em que chegaram. Um arquivo já presente no cache quando chega a sua
+///          vez não é lido de novo.
+///          O caminho do arquivo não é copiado e deve existir até a imagem ser carregada, como
+///          em Image. Se o cartão SD divide o barramento SPI com o display, o driver do
+///          barramento deve serializar os acessos.
+class ImageLoader {
+public:
+  static bool request(Image *image, fs::FS *fs, uint8_t source, const char *path, uint8_t screen);
+  static bool collect(Image *image, ImageFileData_t &data, bool &failed);
+  static void cancel(Image *image);
+  static uint8_t pending();
+
+private:
+  /// @brief Estado de uma posição da fila de pedidos.
+  enum class SlotState : uint8_t {
+    FREE = 0, ///< Posição livre.
+    PENDING,  ///< Aguardando a task.
+    LOADING,  ///< Arquivo sendo lido pela task.
+    DONE,     ///< Imagem pronta, aguardando o widget.
+    FAILED    ///< Leitura falhou, aguardando o widget.
+  };
+
+  /// @brief Pedido de leitura de um widget.
+  typedef struct {
+    Image *image;         ///< Widget que pediu a imagem (nullptr = cancelado durante a leitura).
+    fs::FS *fs;           ///< Sistema de arquivos.
+    const char *path;     ///< Caminho do arquivo.
+    ImageFileData_t data; ///< Imagem lida (DONE).
+    uint32_t order;       ///< Ordem de chegada.
+    uint8_t source;       ///< Fonte do arquivo (SourceFile), chave do cache.
+    uint8_t screen;       ///< Tela do widget.
+    SlotState state;      ///< Estado da posição.
+  } LoadRequest_t;
+
+  static const char *TAG; ///< Tag estática para identificação em logs.
+
+  static LoadRequest_t m_requests[DFK_IMAGE_LOADER_SLOTS]; ///< Fila de pedidos.
+  static SemaphoreHandle_t m_mutex; ///< Protege a fila e a entrega das imagens.
+  static TaskHandle_t m_task;       ///< Task de carregamento (nullptr = ainda não criada).
+  static uint32_t m_order;          ///< Contador da ordem de chegada.
+
+  static bool begin();
+  static int8_t next();
+  static bool load(fs::FS *fs, uint8_t source, const char *path, ImageFileData_t &data);
+  static void task(void *params);
+};
+
+#endif
@@ -1,8 +1,14 @@
 #include "wimage.h"
+#include "imageloader.h"
 #include <esp_log.h>
+#include <new>
 
 const char* Image::TAG = "Image";
 
+#if defined(DISP_DEFAULT)
+alignas(4) uint8_t Image::m_streamBuffer[DFK_IMAGE_STREAM_BUFFER];
+#endif
+
 /**
  * @brief Construtor da classe Image.
  * @param _x Posição X da imagem.
@@ -47,7 +53,7 @@ Image::~Image() { clearBuffers(); }
  *          - Verifica que a imagem está na tela atual
  *          - Aplica debounce para evitar múltiplos cliques
  *          - Verifica se o widget não está bloqueado
- *          - Verifica se o toque está dentro dos limites da imagem
+ *          - Verifica se o toque está dentro de getTouchBounds() (caixa rotacionada incluída)
  *          Se todas as validações passarem, marca o widget para redesenho.
  */
 bool Image::detectTouch(uint16_t *_xTouch, uint16_t *_yTouch) {
@@ -65,7 +71,10 @@ bool Image::detectTouch(uint16_t *_xTouch, uint16_t *_yTouch) {
   
 
 
-  bool detected = POINT_IN_RECT(*_xTouch, *_yTouch, m_xPos, m_yPos, m_config.width, m_config.height);
+  // Mesma área indexada no HitGrid (getTouchBounds() já inclui a borda direita e inferior)
+  const Rect_t area = getTouchBounds();
+  bool detected = area.width > 0 && area.height > 0 &&
+                  POINT_IN_RECT(*_xTouch, *_yTouch, area.x, area.y, area.width - 1, area.height - 1);
 if(detected) {
   m_myTime = millis();
   setPressed(true);  // Mark widget as pressed
@@ -82,16 +91,138 @@ if(detected) {
  */
 functionCB_t Image::getCallbackFunc() { return m_callback; }
 
+/**
+ * @brief Usa a imagem do cache compartilhado, se ela já estiver decodificada.
+ * @return True se a imagem foi encontrada no cache (acerto), False caso contrário.
+ * @details Acertos e faltas são contados nas métricas. Sem cache ativo retorna False sem contar.
+ */
+bool Image::takeFromCache() {
+  ImageCache *cache = WidgetBase::imageCache;
+  if (!cache || !cache->isEnabled()) {
+    return false;
+  }
+  const ImageCacheEntry_t *entry = cache->acquire(static_cast<uint8_t>(m_source), m_path);
+  if (!entry) {
+    m_metrics.cacheMisses++;
+    return false;
+  }
+  m_metrics.cacheHits++;
+  useCacheEntry(entry);
+  ESP_LOGD(TAG, "Image %s taken from cache", m_path);
+  return true;
+}
+
+/**
+ * @brief Carrega a imagem do arquivo, passando pelo cache de imagens compartilhado.
+ * @return True se a imagem foi carregada, False caso contrário.
+ * @details Com WidgetBase::imageCache ativo, uma imagem já decodificada com a mesma fonte e
+ *          caminho é usada sem ler o arquivo. Senão o arquivo é lido com readFileFromDisk() e
+ *          os buffers são entregues ao cache para os próximos widgets; se a imagem não couber
+ *          no cache o widget fica com os seus próprios buffers.
+ */
+bool Image::loadFile() {
+  return takeFromCache() || readFileFromDisk();
+}
+
+/**
+ * @brief Pede a leitura do arquivo à task de carregamento em segundo plano (@ref ImageLoader).
+ * @return True se a imagem já está pronta ou foi pedida, False se o arquivo é inválido.
+ * @details Uma imagem que está no cache é usada na hora. Senão só o cabeçalho é lido aqui, para
+ *          conhecer o tamanho; até o arquivo ser decodificado o widget desenha um retângulo no
+ *          lugar da imagem. Se não há espaço na fila de pedidos a imagem é lida agora.
+ */
+bool Image::requestFileLoad() {
+  if (takeFromCache()) {
+    return true;
+  }
+  if (!readFileHeader()) {
+    return false;
+  }
+  // Only used when streaming
+  m_compressed = false;
+  m_streamMask = false;
+  if (!ImageLoader::request(this, m_fs, static_cast<uint8_t>(m_source), m_path, m_screen)) {
+    ESP_LOGW(TAG, "Image loader unavailable; loading %s now", m_path);
+    return readFileFromDisk();
+  }
+  m_loading = true;
+  return true;
+}
+
+/**
+ * @brief Recebe a imagem lida pela task de carregamento, se já estiver pronta.
+ * @return True se a imagem pode ser desenhada, False se ainda está sendo lida ou falhou.
+ * @details Chamado pelo desenho, na task da interface. Se a leitura falhou o widget deixa de
+ *          estar carregado e o retângulo de espera fica na tela.
+ */
+bool Image::collectFileLoad() {
+  ImageFileData_t data;
+  bool failed = false;
+  if (!ImageLoader::collect(this, data, failed)) {
+    return false;
+  }
+  m_loading = false;
+  if (failed) {
+    ESP_LOGE(TAG, "Failed to load image from file: %s", m_path);
+    m_loaded = false;
+    return false;
+  }
+  m_metrics.fileLoadCount++;
+  adoptFileData(data);
+  m_config.pixels = m_pixels;
+  m_config.maskAlpha = m_maskAlpha;
+  updateBounds();
+  return true;
+}
+
+/**
+ * @brief Desenha o retângulo mostrado enquanto a imagem é lida em segundo plano.
+ */
+void Image::drawPlaceholder() {
+#if defined(USING_GRAPHIC_LIB)
+  WidgetBase::objTFT->fillRect(m_xPos, m_yPos, m_config.width, m_config.height, m_config.backgroundColor);
+  WidgetBase::objTFT->drawRect(m_xPos, m_yPos, m_config.width, m_config.height,
+                               WidgetBase::lightMode ? CFK_GREY11 : CFK_GREY3);
+#else
+  WidgetBase::objTFT->drawFrame(m_xPos, m_yPos, m_config.width, m_config.height);
+#endif
+}
+
+/**
+ * @brief Passa a desenhar a partir de uma imagem do cache.
+ * @param entry Imagem com uma referência já tomada; devolvida em clearBuffers().
+ */
+void Image::useCacheEntry(const ImageCacheEntry_t *entry) {
+  m_cacheEntry = entry;
+  m_pixels = static_cast<pixel_t *>(entry->pixels);
+  m_maskAlpha = entry->mask;
+  m_config.width = entry->width;
+  m_config.height = entry->height;
+  m_ownsMemory = false;
+}
+
+/**
+ * @brief Passa a desenhar uma imagem lida do arquivo.
+ * @param data Imagem lida por decodeFile(), já entregue ao cache ou com buffers próprios.
+ */
+void Image::adoptFileData(const ImageFileData_t &data) {
+  if (data.entry) {
+    useCacheEntry(data.entry);
+  } else {
+    m_pixels = data.pixels;
+    m_maskAlpha = data.mask;
+    m_config.width = data.width;
+    m_config.height = data.height;
+    m_ownsMemory = true;
+  }
+  recordFileLoadTime(data.loadTime);
+}
+
 /**
  * @brief Lê o arquivo de imagem do disco (SD, SPIFFS ou FATFS).
  * @return True se o arquivo foi lido com sucesso, False caso contrário.
- * @details Este método lê um arquivo de imagem do sistema de arquivos:
- *          - Abre o arquivo e valida suas dimensões
- *          - Lê dados de pixels no formato apropriado (RGB565 ou monocromático)
- *          - Lê a máscara de transparência se disponível
- *          - Aloca memória dinamicamente para os dados
- *          - Registra métricas de desempenho para otimização
- *          - Suporta leitura otimizada por linhas completas
+ * @details Decodifica o arquivo com decodeFile(), entrega os buffers ao cache de imagens
+ *          (cacheFileData()) e registra métricas de desempenho para otimização.
  */
 bool Image::readFileFromDisk() {
   if (m_source == SourceFile::EMBED) {
@@ -104,13 +235,36 @@ bool Image::readFileFromDisk() {
     return false;
   }
 
-  ESP_LOGD(TAG, "Looking for file: %s", m_path);
-
-  // Start file load performance timing
-  uint32_t fileLoadStartTime = micros();
   m_metrics.fileLoadCount++;
 
-  fs::File file = m_fs->open(m_path, "r");
+  ImageFileData_t data;
+  if (!decodeFile(m_fs, m_path, data)) {
+    return false;
+  }
+  cacheFileData(static_cast<uint8_t>(m_source), m_path, data);
+  adoptFileData(data);
+  return true;
+}
+
+/**
+ * @brief Lê e decodifica um arquivo de imagem (.fki ou .fkz).
+ * @param fs Sistema de arquivos.
+ * @param path Caminho do arquivo.
+ * @param out Recebe a imagem; os buffers são alocados com ImageCache::allocBuffer().
+ * @return True se o arquivo foi lido com sucesso, False caso contrário (nada fica alocado).
+ * @details Não usa nenhum membro do widget, para poder ser chamado pela task de carregamento:
+ *          - Abre o arquivo e valida suas dimensões
+ *          - Lê dados de pixels no formato apropriado (RGB565 ou monocromático)
+ *          - Lê a máscara de transparência se disponível
+ *          - Suporta leitura otimizada por linhas completas
+ */
+bool Image::decodeFile(fs::FS *fs, const char *path, ImageFileData_t &out) {
+  out = {nullptr, nullptr, 0, 0, 0, 0, nullptr};
+  const uint32_t fileLoadStartTime = micros();
+
+  ESP_LOGD(TAG, "Looking for file: %s", path);
+
+  fs::File file = fs->open(path, "r");
   if (!file) {
     ESP_LOGE(TAG, "Cant open file");
     return false;
@@ -135,10 +289,30 @@ bool Image::readFileFromDisk() {
     return false;
   }
 
-  // Get width
-  uint16_t arqWidth = ((file.read()) << 8) | file.read();
-  // Get height
-  uint16_t arqHeight = ((file.read()) << 8) | file.read();
+  uint8_t header[4];
+  if (file.read(header, sizeof(header)) != sizeof(header)) {
+    ESP_LOGE(TAG, "Cant read image header");
+    file.close();
+    return false;
+  }
+
+#if defined(DISP_DEFAULT)
+  // Compressed image (.fkz)
+  if (FkzDecoder::isFkz(header)) {
+    const bool decoded = file.seek(0) && decodeFkz(file, out);
+    file.close();
+    if (!decoded) {
+      freeFileData(out);
+      return false;
+    }
+    out.loadTime = micros() - fileLoadStartTime;
+    return true;
+  }
+#endif
+
+  // Get width and height
+  uint16_t arqWidth = (header[0] << 8) | header[1];
+  uint16_t arqHeight = (header[2] << 8) | header[3];
 
   if (arqWidth == 0 || arqHeight == 0) {
     ESP_LOGE(TAG, "Invalid image size");
@@ -148,21 +322,20 @@ bool Image::readFileFromDisk() {
 
   ESP_LOGD(TAG, "Image size: %d x %d", arqWidth, arqHeight);
 
-  // Store dimensions in m_config
-  m_config.width = arqWidth;
-  m_config.height = arqHeight;
+  out.width = arqWidth;
+  out.height = arqHeight;
 
   uint32_t bytesOfColor = arqWidth * arqHeight;
 
-  m_pixels = new pixel_t[bytesOfColor];
+  out.pixels = static_cast<pixel_t *>(ImageCache::allocBuffer(bytesOfColor * sizeof(pixel_t)));
 
-  if (!m_pixels) {
+  if (!out.pixels) {
     ESP_LOGE(TAG, "Failed to allocate memory for image pixels");
     file.close();
     return false;
   }
 
-  memset(m_pixels, 0, bytesOfColor * sizeof(uint16_t));
+  memset(out.pixels, 0, bytesOfColor * sizeof(pixel_t));
 
 #if defined(DISP_DEFAULT)
   const uint8_t read_pixels = 2;
@@ -172,12 +345,12 @@ bool Image::readFileFromDisk() {
 
   // Optimized reading: read entire lines at once
   const uint32_t lineSize = arqWidth * read_pixels;
-  uint8_t *lineBuffer = new uint8_t[lineSize];
+  uint8_t *lineBuffer = new (std::nothrow) uint8_t[lineSize];
   
   if (!lineBuffer) {
     ESP_LOGE(TAG, "Failed to allocate line buffer");
     file.close();
-    clearBuffers();
+    freeFileData(out);
     return false;
   }
 
@@ -187,7 +360,7 @@ bool Image::readFileFromDisk() {
       ESP_LOGE(TAG, "Error reading line %d", y);
       delete[] lineBuffer;
       file.close();
-      clearBuffers();
+      freeFileData(out);
       return false;
     }
     
@@ -195,10 +368,10 @@ bool Image::readFileFromDisk() {
     for (int x = 0; x < arqWidth; x++) {
 #if defined(DISP_DEFAULT)
       uint16_t color = (lineBuffer[x * 2] << 8) | lineBuffer[x * 2 + 1];
-      m_pixels[y * arqWidth + x] = color;
+      out.pixels[y * arqWidth + x] = color;
 #elif defined(DISP_PCD8544) || defined(DISP_SSD1306) || defined(DISP_U8G2)
       uint8_t color = lineBuffer[x];
-      m_pixels[y * arqWidth + x] = color;
+      out.pixels[y * arqWidth + x] = color;
 #endif
     }
   }
@@ -210,35 +383,342 @@ bool Image::readFileFromDisk() {
   if (maskLen == 0) {
     ESP_LOGE(TAG, "Invalid mask length");
     file.close();
-    clearBuffers();
+    freeFileData(out);
     return false;
   }
 
-  m_maskAlpha = new uint8_t[maskLen];
+  out.mask = static_cast<uint8_t *>(ImageCache::allocBuffer(maskLen));
 
-  if (!m_maskAlpha) {
+  if (!out.mask) {
     ESP_LOGE(TAG, "Failed to allocate memory for image mask");
     file.close();
+    freeFileData(out);
+    return false;
+  }
+
+  memset(out.mask, 0, maskLen);
+  file.read(out.mask, maskLen);
+  out.maskBytes = maskLen;
+
+  file.close();
+  
+  out.loadTime = micros() - fileLoadStartTime;
+  return true;
+}
+
+/**
+ * @brief Entrega ao cache de imagens os buffers de uma imagem lida do arquivo.
+ * @param source Fonte do arquivo.
+ * @param path Caminho do arquivo.
+ * @param data Imagem lida; se foi aceita pelo cache, passa a apontar para a imagem do cache.
+ * @details Sem cache ativo, ou se a imagem não couber nele, os buffers continuam com o chamador.
+ */
+void Image::cacheFileData(uint8_t source, const char *path, ImageFileData_t &data) {
+  ImageCache *cache = WidgetBase::imageCache;
+  if (!cache || !cache->isEnabled()) {
+    return;
+  }
+  const uint32_t pixelBytes = static_cast<uint32_t>(data.width) * data.height * sizeof(pixel_t);
+  const ImageCacheEntry_t *entry =
+      cache->insert(source, path, data.width, data.height, data.pixels, data.mask, pixelBytes + data.maskBytes);
+  if (entry) {
+    data.entry = entry;
+    data.pixels = static_cast<pixel_t *>(entry->pixels);
+    data.mask = entry->mask;
+  }
+}
+
+/**
+ * @brief Libera uma imagem lida do arquivo que não será usada.
+ * @details Devolve a referência ao cache ou libera os buffers próprios.
+ */
+void Image::freeFileData(ImageFileData_t &data) {
+  if (data.entry) {
+    if (WidgetBase::imageCache) {
+      WidgetBase::imageCache->release(data.entry);
+    }
+  } else {
+    ImageCache::freeBuffer(data.pixels);
+    ImageCache::freeBuffer(data.mask);
+  }
+  data.entry = nullptr;
+  data.pixels = nullptr;
+  data.mask = nullptr;
+}
+
+/**
+ * @brief Lê só o cabeçalho do arquivo de imagem, para desenho em streaming.
+ * @return True se o arquivo é válido, False caso contrário.
+ * @details Guarda as dimensões em m_config. Para arquivos .fki verifica se o arquivo tem todos
+ *          os pixels e uma máscara com uma linha de bits por linha da imagem (m_streamMask); uma
+ *          máscara menor é ignorada e a imagem é desenhada opaca. Arquivos comprimidos (.fkz)
+ *          informam no cabeçalho se têm pixels transparentes.
+ */
+bool Image::readFileHeader() {
+  if (!m_fs) {
+    ESP_LOGE(TAG, "No source defined to find image");
+    return false;
+  }
+
+  fs::File file = m_fs->open(m_path, "r");
+  if (!file) {
+    ESP_LOGE(TAG, "Cant open file");
+    return false;
+  }
+
+  if (file.isDirectory()) {
+    ESP_LOGE(TAG, "Path is a directory");
+    file.close();
     return false;
   }
 
-  memset(m_maskAlpha, 0, maskLen);
+  uint8_t header[4];
+  if (file.read(header, sizeof(header)) != sizeof(header)) {
+    ESP_LOGE(TAG, "File is too small");
+    file.close();
+    return false;
+  }
 
-  for (int i = 0; i < maskLen; i++) {
-    m_maskAlpha[i] = file.read();
+#if defined(DISP_DEFAULT)
+  if (FkzDecoder::isFkz(header)) {
+    FkzDecoder decoder;
+    const bool valid = file.seek(0) && decoder.begin(file);
+    file.close();
+    if (!valid) {
+      return false;
+    }
+    m_compressed = true;
+    m_streamMask = decoder.hasMask();
+    m_config.width = decoder.width();
+    m_config.height = decoder.height();
+    ESP_LOGD(TAG, "Streaming compressed image: %d x %d", m_config.width, m_config.height);
+    return true;
+  }
+#endif
+
+  const uint16_t arqWidth = (header[0] << 8) | header[1];
+  const uint16_t arqHeight = (header[2] << 8) | header[3];
+  if (arqWidth == 0 || arqHeight == 0) {
+    ESP_LOGE(TAG, "Invalid image size");
+    file.close();
+    return false;
   }
 
+  const uint32_t fileSize = file.size();
+  const uint32_t maskOffset = 4 + static_cast<uint32_t>(arqWidth) * arqHeight * sizeof(uint16_t);
+  uint8_t maskHeader[2];
+  if (fileSize < maskOffset + 2 || !file.seek(maskOffset) ||
+      file.read(maskHeader, sizeof(maskHeader)) != sizeof(maskHeader)) {
+    ESP_LOGE(TAG, "File is truncated");
+    file.close();
+    return false;
+  }
   file.close();
-  
-  // End file load performance timing
-  uint32_t fileLoadEndTime = micros();
-  m_metrics.lastFileLoadTime = fileLoadEndTime - fileLoadStartTime;
+
+  const uint32_t maskLen = (maskHeader[0] << 8) | maskHeader[1];
+  const uint32_t maskNeeded = static_cast<uint32_t>((arqWidth + 7) / 8) * arqHeight;
+  m_streamMask = maskLen >= maskNeeded && fileSize >= maskOffset + 2 + maskNeeded;
+  if (!m_streamMask && m_streaming) {
+    ESP_LOGW(TAG, "Mask of %s has %u of %u bytes; drawing it opaque", m_path, maskLen, maskNeeded);
+  }
+
+  m_config.width = arqWidth;
+  m_config.height = arqHeight;
+  ESP_LOGD(TAG, "Streaming image: %d x %d", arqWidth, arqHeight);
+  return true;
+}
+
+#if defined(DISP_DEFAULT)
+/**
+ * @brief Decodifica um arquivo comprimido (.fkz).
+ * @param file Arquivo aberto, posicionado no início.
+ * @param out Recebe a imagem.
+ * @return True se a imagem foi decodificada, False caso contrário (buffers liberados pelo chamador).
+ * @details Cada linha é decodificada direto no seu lugar nos pixels e convertida para a ordem
+ *          de bytes nativa. A máscara só é alocada se a imagem tem pixels transparentes.
+ */
+bool Image::decodeFkz(fs::File &file, ImageFileData_t &out) {
+  FkzDecoder decoder;
+  if (!decoder.begin(file)) {
+    return false;
+  }
+  const uint16_t width = decoder.width();
+  const uint16_t height = decoder.height();
+  const uint16_t byteWidth = (width + 7) / 8;
+
+  out.width = width;
+  out.height = height;
+  out.pixels = static_cast<pixel_t *>(ImageCache::allocBuffer(static_cast<uint32_t>(width) * height * sizeof(pixel_t)));
+  if (!out.pixels) {
+    ESP_LOGE(TAG, "Failed to allocate memory for image pixels");
+    return false;
+  }
+  memset(out.pixels, 0, static_cast<uint32_t>(width) * height * sizeof(pixel_t));
+  if (decoder.hasMask()) {
+    out.maskBytes = static_cast<uint32_t>(byteWidth) * height;
+    out.mask = static_cast<uint8_t *>(ImageCache::allocBuffer(out.maskBytes));
+    if (!out.mask) {
+      ESP_LOGE(TAG, "Failed to allocate memory for image mask");
+      return false;
+    }
+  }
+
+  for (uint16_t y = 0; y < height; y++) {
+    pixel_t *row = out.pixels + static_cast<uint32_t>(y) * width;
+    uint8_t *bytes = reinterpret_cast<uint8_t *>(row);
+    if (!decoder.readRow(bytes, out.mask ? out.mask + static_cast<uint32_t>(y) * byteWidth : nullptr)) {
+      ESP_LOGE(TAG, "Error decoding line %d", y);
+      return false;
+    }
+    for (uint16_t x = 0; x < width; x++) {
+      row[x] = (bytes[x * 2] << 8) | bytes[x * 2 + 1];
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Verifica se todos os pixels de um bloco de linhas da máscara estão visíveis.
+ */
+static bool maskRowsOpaque(const uint8_t *mask, uint16_t width, uint16_t rows) {
+  const uint16_t byteWidth = (width + 7) / 8;
+  const uint8_t lastByte = (width & 7) ? static_cast<uint8_t>(0xFF << (8 - (width & 7))) : 0xFF;
+  for (uint16_t r = 0; r < rows; r++, mask += byteWidth) {
+    for (uint16_t i = 0; i + 1 < byteWidth; i++) {
+      if (mask[i] != 0xFF) {
+        return false;
+      }
+    }
+    if ((mask[byteWidth - 1] & lastByte) != lastByte) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Envia ao display um bloco de linhas lidas do arquivo.
+ * @param y Primeira linha do bloco, relativa à imagem.
+ * @param rows Número de linhas.
+ * @param pixels Pixels RGB565 big-endian, m_config.width por linha.
+ * @param mask Máscara das linhas, (largura + 7) / 8 bytes por linha; nullptr se opaca.
+ * @details Blocos sem pixels transparentes vão numa única chamada; nos outros cada linha é
+ *          enviada como trechos de pixels visíveis.
+ */
+void Image::drawStreamRows(uint16_t y, uint16_t rows, uint16_t *pixels, const uint8_t *mask) {
+  const uint16_t width = m_config.width;
+  if (!mask || maskRowsOpaque(mask, width, rows)) {
+    WidgetBase::objTFT->draw16bitBeRGBBitmap(m_xPos, m_yPos + y, pixels, width, rows);
+    return;
+  }
+  const uint16_t maskRowBytes = (width + 7) / 8;
+  for (uint16_t r = 0; r < rows; r++) {
+    const uint8_t *maskRow = mask + r * maskRowBytes;
+    uint16_t *pixelRow = pixels + r * width;
+    uint16_t x = 0;
+    while (x < width) {
+      while (x < width && !(maskRow[x >> 3] & (0x80 >> (x & 7)))) {
+        x++;
+      }
+      const uint16_t start = x;
+      while (x < width && (maskRow[x >> 3] & (0x80 >> (x & 7)))) {
+        x++;
+      }
+      if (x > start) {
+        WidgetBase::objTFT->draw16bitBeRGBBitmap(m_xPos + start, m_yPos + y + r, pixelRow + start, x - start, 1);
+      }
+    }
+  }
+}
+#endif
+
+/**
+ * @brief Desenha a imagem lendo o arquivo em blocos de linhas.
+ * @return True se a imagem foi desenhada, False se o arquivo não pôde ser lido.
+ * @details Os pixels (RGB565 big-endian, como no arquivo) e as linhas correspondentes da
+ *          máscara vão para m_streamBuffer, compartilhado por todas as imagens, e são enviados
+ *          ao display com draw16bitBeRGBBitmap(), sem conversão. Arquivos .fki são lidos como
+ *          estão; arquivos comprimidos são decodificados linha a linha por FkzDecoder.
+ *          Nenhuma memória é alocada. Não aplica rotação (validateConfig() recusa ângulo
+ *          diferente de zero com streaming).
+ */
+bool Image::streamFromDisk() {
+#if defined(DISP_DEFAULT)
+  uint32_t fileLoadStartTime = micros();
+  m_metrics.fileLoadCount++;
+
+  fs::File file = m_fs ? m_fs->open(m_path, "r") : fs::File();
+  if (!file) {
+    ESP_LOGE(TAG, "Cant open file");
+    return false;
+  }
+
+  const uint16_t width = m_config.width;
+  const uint16_t height = m_config.height;
+  const uint32_t rowBytes = static_cast<uint32_t>(width) * sizeof(uint16_t);
+  const uint16_t maskRowBytes = m_streamMask ? (width + 7) / 8 : 0;
+  const uint16_t rowsPerChunk = DFK_IMAGE_STREAM_BUFFER / (rowBytes + maskRowBytes);
+  if (rowsPerChunk == 0) {
+    ESP_LOGE(TAG, "DFK_IMAGE_STREAM_BUFFER is too small for rows of %d pixels", width);
+    file.close();
+    return false;
+  }
+  uint16_t *pixels = reinterpret_cast<uint16_t *>(m_streamBuffer);
+  uint8_t *mask = maskRowBytes ? m_streamBuffer + rowsPerChunk * rowBytes : nullptr;
+
+  bool ok;
+  if (m_compressed) {
+    FkzDecoder decoder;
+    ok = decoder.begin(file) && decoder.width() == width && decoder.height() == height;
+    for (uint16_t y = 0; ok && y < height; y += rowsPerChunk) {
+      const uint16_t rows = min(static_cast<uint16_t>(height - y), rowsPerChunk);
+      for (uint16_t r = 0; ok && r < rows; r++) {
+        ok = decoder.readRow(m_streamBuffer + r * rowBytes, mask ? mask + r * maskRowBytes : nullptr);
+      }
+      if (ok) {
+        drawStreamRows(y, rows, pixels, mask);
+      }
+    }
+  } else {
+    const uint32_t maskOffset = 4 + rowBytes * height + 2;
+    ok = file.seek(4);
+    for (uint16_t y = 0; ok && y < height; y += rowsPerChunk) {
+      const uint16_t rows = min(static_cast<uint16_t>(height - y), rowsPerChunk);
+      if (mask) {
+        const size_t maskBytes = static_cast<size_t>(rows) * maskRowBytes;
+        ok = file.seek(maskOffset + static_cast<uint32_t>(y) * maskRowBytes) &&
+             file.read(mask, maskBytes) == maskBytes &&
+             file.seek(4 + static_cast<uint32_t>(y) * rowBytes);
+      }
+      ok = ok && file.read(reinterpret_cast<uint8_t *>(pixels), rows * rowBytes) == rows * rowBytes;
+      if (ok) {
+        drawStreamRows(y, rows, pixels, mask);
+      }
+    }
+  }
+  file.close();
+  if (!ok) {
+    ESP_LOGE(TAG, "Error reading %s", m_path);
+    return false;
+  }
+
+  recordFileLoadTime(micros() - fileLoadStartTime);
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Registra nas métricas o tempo de uma leitura de arquivo.
+ * @param elapsed Duração da leitura em microssegundos.
+ */
+void Image::recordFileLoadTime(uint32_t elapsed) {
+  m_metrics.lastFileLoadTime = elapsed;
   m_metrics.totalFileLoadTime += m_metrics.lastFileLoadTime;
   if (m_metrics.lastFileLoadTime > m_metrics.maxFileLoadTime) {
     m_metrics.maxFileLoadTime = m_metrics.lastFileLoadTime;
   }
-  
-  return true;
 }
 
 /**
@@ -315,6 +795,12 @@ void Image::draw() {
     return;
   }
 
+  // Image still being read in the background: draw its placeholder
+  if (m_loading && !collectFileLoad()) {
+    drawPlaceholder();
+    return;
+  }
+
   // Start performance timing
   uint32_t startTime = micros();
   m_metrics.drawCount++;
@@ -322,15 +808,22 @@ void Image::draw() {
   ESP_LOGD(TAG, "Redraw image: %d x %d (angle: %.1f°)", m_config.width, m_config.height, m_config.angle);
 
   // Apply rotation if angle is not zero
-  if (m_config.angle != 0.0f) {
+  if (m_streaming) {
+    streamFromDisk();
+  } else if (m_config.angle != 0.0f) {
     ESP_LOGD(TAG, "Drawing rotated image");
     drawRotatedImage();
   } else {
     // Draw without rotation
 #if defined(DISP_DEFAULT)
-ESP_LOGD(TAG, "Drawing 16bit RGB bitmap with mask");
-    WidgetBase::objTFT->draw16bitRGBBitmapWithMask(
-        m_xPos, m_yPos, m_config.pixels, m_config.maskAlpha, m_config.width, m_config.height);
+    if (m_config.maskAlpha) {
+      ESP_LOGD(TAG, "Drawing 16bit RGB bitmap with mask");
+      WidgetBase::objTFT->draw16bitRGBBitmapWithMask(
+          m_xPos, m_yPos, m_config.pixels, m_config.maskAlpha, m_config.width, m_config.height);
+    } else {
+      // The mask is optional: without it every pixel is opaque
+      WidgetBase::objTFT->draw16bitRGBBitmap(m_xPos, m_yPos, m_config.pixels, m_config.width, m_config.height);
+    }
 #elif defined(DISP_PCD8544) || defined(DISP_SSD1306)
     WidgetBase::objTFT->drawBitmap(m_xPos, m_yPos, m_config.pixels, m_config.width, m_config.height,
                                    CFK_BLACK);
@@ -363,7 +856,7 @@ void Image::redraw() {
  * @details Define a flag de atualização para disparar um redesenho no próximo ciclo.
  */
 void Image::forceUpdate() { 
-  m_shouldRedraw = true; 
+  invalidate(); 
   ESP_LOGD(TAG, "Image force update requested");
 }
 
@@ -374,10 +867,14 @@ void Image::forceUpdate() {
  * @details Configura a imagem com uma fonte de arquivo, caminho, função callback e ângulo de rotação:
  *          - Limpa buffers existentes usando clearBuffers()
  *          - Define sistema de arquivos usando defineFileSystem()
- *          - Carrega arquivo do disco usando readFileFromDisk()
+ *          - Carrega arquivo do disco (ou do cache de imagens) usando loadFile()
  *          - Mapeia dados carregados para configuração unificada
  *          - Valida configuração usando validateConfig()
  *          - Marca widget como carregado e inicializado
+ *          Com config.streaming só o cabeçalho é lido aqui; cada redesenho lê o arquivo em blocos
+ *          de linhas (streamFromDisk()), sem alocar memória para os pixels.
+ *          Com config.async o arquivo é lido pela task de carregamento (requestFileLoad()) e
+ *          este método retorna depois de ler só o cabeçalho.
  *          A imagem não será exibida corretamente até que este método seja chamado.
  */
 void Image::setupFromFile(ImageFromFileConfig &config) {
@@ -416,8 +913,17 @@ void Image::setupFromFile(ImageFromFileConfig &config) {
   // Define file system
   defineFileSystem(config.source);
 
-  // Load file from disk
-  if (readFileFromDisk()) {
+#if defined(DISP_DEFAULT)
+  m_streaming = config.streaming;
+#else
+  if (config.streaming) {
+    ESP_LOGW(TAG, "Streaming needs an RGB565 display; loading %s to memory", config.path);
+  }
+  m_streaming = false;
+#endif
+
+  // Load file from disk or from the image cache (or only its header when streaming)
+  if (m_streaming ? readFileHeader() : (config.async ? requestFileLoad() : loadFile())) {
     // Map loaded data to unified configuration
     m_config.pixels = m_pixels;
     m_config.maskAlpha = m_maskAlpha;
@@ -432,8 +938,9 @@ void Image::setupFromFile(ImageFromFileConfig &config) {
       return;
     }
 
+    updateBounds();
     m_loaded = true;
-    m_shouldRedraw = true;
+    invalidate();
     m_initialized = true;
     
     ESP_LOGD(TAG, "Image setup from file completed at (%d, %d) - %dx%d from %s", 
@@ -489,9 +996,10 @@ void Image::setupFromPixels(ImageFromPixelsConfig &config) {
   m_callback = config.cb;
   //m_backgroundColor = config.backgroundColor;
   m_source = SourceFile::EMBED;
+  updateBounds();
 
   m_loaded = true;
-  m_shouldRedraw = true;
+  invalidate();
   m_initialized = true;
   
   ESP_LOGD(TAG, "Image setup from pixels completed at (%d, %d) - %dx%d", 
@@ -555,6 +1063,7 @@ void Image::printMetrics() const {
   ESP_LOGI(TAG, "Draw Operations: %u calls", m_metrics.drawCount);
   ESP_LOGI(TAG, "File Loads: %u calls", m_metrics.fileLoadCount);
   ESP_LOGI(TAG, "Rotation Draws: %u calls", m_metrics.rotationDrawCount);
+  ESP_LOGI(TAG, "Cache Hits: %u, Misses: %u", m_metrics.cacheHits, m_metrics.cacheMisses);
   ESP_LOGI(TAG, "");
   ESP_LOGI(TAG, "Draw Times (μs):");
   ESP_LOGI(TAG, "  Last: %u", m_metrics.lastDrawTime);
@@ -585,22 +1094,56 @@ void Image::printMetrics() const {
   ESP_LOGI(TAG, "=====================================");
 }
 
+/**
+ * @brief Atualiza o retângulo ocupado pela imagem na tela.
+ * @details Sem rotação usa largura x altura da imagem. Com rotação usa a caixa envolvente
+ *          da imagem rotacionada em torno do seu centro, a mesma desenhada em drawRotatedImage().
+ */
+void Image::updateBounds() {
+  if (m_config.angle == 0.0f) {
+    setBounds(m_xPos, m_yPos, m_config.width, m_config.height);
+    return;
+  }
+#if defined(DISP_DEFAULT)
+  const RotatedBox_t box = ImageRotator::bounds(m_config.width, m_config.height, m_config.angle,
+                                                m_config.width / 2.0f, m_config.height / 2.0f,
+                                                m_xPos + m_config.width / 2.0f, m_yPos + m_config.height / 2.0f);
+  setBounds(box.x, box.y, box.width, box.height);
+#else
+  float angleRad = m_config.angle * PI / 180.0f;
+  float cosAbs = fabs(cos(angleRad));
+  float sinAbs = fabs(sin(angleRad));
+  int rotatedWidth = (int)(m_config.width * cosAbs + m_config.height * sinAbs);
+  int rotatedHeight = (int)(m_config.width * sinAbs + m_config.height * cosAbs);
+  setBounds(m_xPos - rotatedWidth / 2 + m_config.width / 2,
+            m_yPos - rotatedHeight / 2 + m_config.height / 2,
+            rotatedWidth, rotatedHeight);
+#endif
+}
+
 /**
  * @brief Desenha a imagem com rotação aplicada.
- * @details Implementa rotação pixel por pixel usando cálculos trigonométricos:
- *          - Converte ângulo para radianos e calcula seno/cosseno
- *          - Calcula dimensões da caixa delimitadora rotacionada
- *          - Para cada pixel na área rotacionada, aplica rotação inversa para obter coordenadas originais
- *          - Desenha apenas se coordenadas originais estão dentro dos limites
- *          - Suporta máscara de transparência
- *          - Registra métricas de desempenho para otimização
- *          Rotação ao redor do centro da imagem.
+ * @details Rotação ao redor do centro da imagem, que fica no mesmo ponto da imagem sem rotação.
+ *          Em displays RGB565 usa m_rotator (ImageRotator): mapeamento inverso em ponto fixo,
+ *          linhas enviadas em blocos com draw16bitRGBBitmap() e a máscara de 1 bit respeitada.
+ *          A imagem rotacionada fica guardada, então redesenhar com o mesmo ângulo não refaz
+ *          a rotação. Em displays monocromáticos desenha pixel por pixel.
+ *          Registra métricas de desempenho da rotação.
  */
 void Image::drawRotatedImage() {
   // Start rotation performance timing
   uint32_t rotationStartTime = micros();
   m_metrics.rotationDrawCount++;
-  
+
+  ESP_LOGD(TAG, "Drawing rotated image: %dx%d (%.1f°)", m_config.width, m_config.height, m_config.angle);
+
+#if defined(DISP_DEFAULT)
+  WidgetBase::objTFT->startWrite();
+  m_rotator.draw(WidgetBase::objTFT, m_config.pixels, m_config.maskAlpha, m_config.width, m_config.height,
+                 m_config.angle, m_config.width / 2.0f, m_config.height / 2.0f,
+                 m_xPos + m_config.width / 2.0f, m_yPos + m_config.height / 2.0f);
+  WidgetBase::objTFT->endWrite();
+#elif defined(DISP_PCD8544) || defined(DISP_SSD1306) || defined(DISP_U8G2)
   // Convert angle to radians
   float angleRad = m_config.angle * PI / 180.0f;
   float cosAngle = cos(angleRad);
@@ -616,9 +1159,6 @@ void Image::drawRotatedImage() {
   int rotatedWidth = (int)(m_config.width * cosAbs + m_config.height * sinAbs);
   int rotatedHeight = (int)(m_config.width * sinAbs + m_config.height * cosAbs);
   
-  ESP_LOGD(TAG, "Drawing rotated image: %dx%d -> %dx%d (%.1f°)", 
-           m_config.width, m_config.height, rotatedWidth, rotatedHeight, m_config.angle);
-  
   // Draw rotated image pixel by pixel
   for (int y = 0; y < rotatedHeight; y++) {
     for (int x = 0; x < rotatedWidth; x++) {
@@ -641,25 +1181,12 @@ void Image::drawRotatedImage() {
         int screenY = m_yPos + y - rotatedHeight / 2 + m_config.height / 2;
 
         #if defined(USING_GRAPHIC_LIB)
-
         bool inBounds = screenX >= 0 && screenX < WidgetBase::objTFT->width() &&  screenY >= 0 && screenY < WidgetBase::objTFT->height();
         #else
         bool inBounds = screenX >= 0 && screenX < WidgetBase::objTFT->getDisplayWidth() &&  screenY >= 0 && screenY < WidgetBase::objTFT->getDisplayHeight();
         #endif
         
         if (inBounds) {
-
-
-          
-#if defined(DISP_DEFAULT)
-          uint16_t color = m_config.pixels[pixelIndex];
-          // Apply alpha mask if available
-          if (m_config.maskAlpha && m_config.maskAlpha[pixelIndex] < 255) {
-            // Skip transparent pixels
-            continue;
-          }
-          WidgetBase::objTFT->drawPixel(screenX, screenY, color);
-#elif defined(DISP_PCD8544) || defined(DISP_SSD1306) || defined(DISP_U8G2)
           uint8_t color = m_config.pixels[pixelIndex];
           if (color != 0) { // Only draw non-transparent pixels
 
@@ -669,11 +1196,11 @@ void Image::drawRotatedImage() {
             WidgetBase::objTFT->drawPixel(screenX, screenY, color);
             #endif
           }
-#endif
         }
       }
     }
   }
+#endif
   
   // End rotation performance timing
   uint32_t rotationEndTime = micros();
@@ -694,6 +1221,7 @@ void Image::drawRotatedImage() {
  *          - Valida dimensões não-zero e dentro de limites razoáveis (max 4096x4096)
  *          - Valida contagem de pixels não-overflow
  *          - Normaliza ângulo para faixa 0-360°
+ *          - Recusa ângulo diferente de zero em imagens em streaming
  *          - Verifica se display está inicializado
  *          - Valida posição dentro dos limites do display
  *          - Considera bounding box para imagens rotacionadas
@@ -701,8 +1229,8 @@ void Image::drawRotatedImage() {
 bool Image::validateConfig() {
 
   #if defined(USING_GRAPHIC_LIB)
-  // Validate basic configuration
-  if (m_config.pixels == nullptr) {
+  // Validate basic configuration (streamed images keep no pixels, nor images still loading)
+  if (m_config.pixels == nullptr && !m_streaming && !m_loading) {
     ESP_LOGE(TAG, "Image pixels are null");
     return false;
   }
@@ -733,6 +1261,12 @@ bool Image::validateConfig() {
     while (m_config.angle < 0.0f) m_config.angle += 360.0f;
     while (m_config.angle >= 360.0f) m_config.angle -= 360.0f;
   }
+
+  // Imagens em streaming são desenhadas linha a linha do arquivo, sem rotação
+  if (m_streaming && m_config.angle != 0.0f) {
+    ESP_LOGE(TAG, "Streamed images can't be rotated (angle: %.1f°)", m_config.angle);
+    return false;
+  }
   
   // Validate display compatibility
   if (!WidgetBase::objTFT) {
@@ -785,6 +1319,7 @@ bool Image::validateConfig() {
  * @details Gerencia limpeza de memória baseada se a imagem é embutida ou carregada de arquivo:
  *          - Limpa configuração unificada
  *          - Para imagens embutidas: apenas limpa referências
+ *          - Para imagens do cache: devolve a referência (os buffers ficam no cache)
  *          - Para imagens de arquivo: desaloca memória se m_ownsMemory é true
  *          - Limpa referências de sistema de arquivos
  *          - Reseta flags de estado (m_ownsMemory, m_loaded, m_shouldRedraw)
@@ -800,11 +1335,30 @@ void Image::clearBuffers() {
   m_config.backgroundColor = 0x0000;
   m_config.angle = 0.0f;
   
+  // Drop a pending background load
+  if (m_loading) {
+    ImageLoader::cancel(this);
+    m_loading = false;
+  }
+
+  #if defined(DISP_DEFAULT)
+  // The rotated copy refers to the pixels about to be released
+  m_rotator.clear();
+  #endif
+
+  // Give back the cached image (its buffers belong to the cache)
+  if (m_cacheEntry) {
+    if (WidgetBase::imageCache) {
+      WidgetBase::imageCache->release(m_cacheEntry);
+    }
+    m_cacheEntry = nullptr;
+  }
+
   // Clear legacy variables
   if (m_pixels) {
     // Only delete if we own the memory
     if (m_ownsMemory) {
-      delete[] m_pixels;
+      ImageCache::freeBuffer(m_pixels);
     }
     m_pixels = nullptr;
   }
@@ -812,7 +1366,7 @@ void Image::clearBuffers() {
   if (m_maskAlpha) {
     // Only delete if we own the memory
     if (m_ownsMemory) {
-      delete[] m_maskAlpha;
+      ImageCache::freeBuffer(m_maskAlpha);
     }
     m_maskAlpha = nullptr;
   }
@@ -827,6 +1381,9 @@ void Image::clearBuffers() {
   
   
   // Reset state
+  m_streaming = false;
+  m_streamMask = false;
+  m_compressed = false;
   m_ownsMemory = false;
   m_loaded = false;
   m_shouldRedraw = false;
@@ -845,7 +1402,7 @@ void Image::show() {
   }
   
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
   ESP_LOGD(TAG, "Image shown at (%d, %d)", m_xPos, m_yPos);
 }
 
@@ -861,6 +1418,44 @@ void Image::hide() {
   }
   
   m_visible = false;
-  m_shouldRedraw = true;
+  invalidate();
   ESP_LOGD(TAG, "Image hidden at (%d, %d)", m_xPos, m_yPos);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Desenha o Image completo ao carregar a tela.
+ * @details Desenha o fundo e a imagem.
+ */
+void Image::fullRedraw() {
+  forceUpdate();
+  drawBackground();
+  draw();
+}
+
+/**
+ * @brief Redesenho por frame: fundo seguido da imagem.
+ * @details Ambos retornam cedo se a imagem não precisa ser redesenhada.
+ */
+void Image::refresh() {
+  drawBackground();
+  draw();
+}
+
+/**
+ * @brief Indica que o Image responde ao toque.
+ */
+bool Image::isTouchable() const {
+  return true;
+}
+
+/**
+ * @brief Área aceita por detectTouch(): a caixa da imagem rotacionada unida ao retângulo sem rotação.
+ * @details Inclui um pixel à direita e abaixo, porque POINT_IN_RECT aceita a borda.
+ */
+Rect_t Image::getTouchBounds() const {
+  int32_t x0 = min(static_cast<int32_t>(m_bounds.x), static_cast<int32_t>(m_xPos));
+  int32_t y0 = min(static_cast<int32_t>(m_bounds.y), static_cast<int32_t>(m_yPos));
+  int32_t x1 = max(static_cast<int32_t>(m_bounds.x + m_bounds.width), static_cast<int32_t>(m_xPos + m_config.width));
+  int32_t y1 = max(static_cast<int32_t>(m_bounds.y + m_bounds.height), static_cast<int32_t>(m_yPos + m_config.height));
+  return clipRect(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+}
@@ -14,6 +14,11 @@
 #endif
 
 #include <FS.h>
+#include "../../extras/fkzimage.h"
+
+#ifndef DFK_IMAGE_STREAM_BUFFER
+#define DFK_IMAGE_STREAM_BUFFER 8192 ///< Bytes of the buffer shared by images drawn straight from their file.
+#endif
 
 /// @brief Enum for specifying the source file location of the image.
 enum class SourceFile {
@@ -33,14 +38,16 @@ enum class SourceFile {
  *
  * This structure defines the configuration for loading an image from a file.
  * It includes the source file location, the path to the image file,
- * the callback function to be called when the image is touched,
- * and the rotation angle of the image.
+ * and the callback function to be called when the image is touched.
+ * Images loaded from files are drawn without rotation.
  */
 struct ImageFromFileConfig {
   const char *path;  ///< Path to the image file.
   functionCB_t cb; ///< Callback function to be called when the image is touched.
   SourceFile source; ///< Source of the image file.
   uint16_t backgroundColor; ///< Background color of the image.
+  bool streaming; ///< Draw from the file a few rows at a time on every redraw, keeping no pixels in the heap (RGB565 displays).
+  bool async; ///< Read the file in a background task (ImageLoader); a placeholder rectangle is drawn until it is ready.
   String toString(){
     return String((int)source) + " " + path;
   }
@@ -84,6 +91,17 @@ struct ImageFromPixelsConfig {
     return static_cast<uint32_t>(width) * static_cast<uint32_t>(height);
   }
 };
+/// @brief Imagem lida de um arquivo, antes de ser entregue a um widget.
+typedef struct {
+  pixel_t *pixels;                ///< Pixels decodificados (alocados com ImageCache::allocBuffer()).
+  uint8_t *mask;                  ///< Máscara de 1 bit por pixel (nullptr = opaca).
+  uint32_t maskBytes;             ///< Tamanho da máscara em bytes.
+  uint32_t loadTime;              ///< Duração da leitura do arquivo (microssegundos).
+  uint16_t width;                 ///< Largura da imagem.
+  uint16_t height;                ///< Altura da imagem.
+  const ImageCacheEntry_t *entry; ///< Imagem do cache que contém os buffers (nullptr = buffers próprios).
+} ImageFileData_t;
+
 typedef struct  {
   uint32_t drawCount = 0;           ///< Number of times draw() was called
   uint32_t fileLoadCount = 0;       ///< Number of times file was loaded
@@ -97,6 +115,8 @@ typedef struct  {
   uint32_t lastDrawTime = 0;        ///< Last draw time (microseconds)
   uint32_t lastFileLoadTime = 0;    ///< Last file load time (microseconds)
   uint32_t lastRotationTime = 0;    ///< Last rotation time (microseconds)
+  uint32_t cacheHits = 0;           ///< File images taken from the shared image cache
+  uint32_t cacheMisses = 0;         ///< File images not cached yet (read from the file)
   
   void reset() {
     drawCount = 0;
@@ -111,6 +131,8 @@ typedef struct  {
     lastDrawTime = 0;
     lastFileLoadTime = 0;
     lastRotationTime = 0;
+    cacheHits = 0;
+    cacheMisses = 0;
   }
   
   float getAverageDrawTime() const {
@@ -152,6 +174,10 @@ public:
   void hide() override;
 
   void forceUpdate() override;
+  void fullRedraw() override;
+  void refresh() override;
+  bool isTouchable() const override;
+  Rect_t getTouchBounds() const override;
 
   void setupFromFile(ImageFromFileConfig &config);
   void setupFromPixels(ImageFromPixelsConfig &config);
@@ -171,10 +197,39 @@ private:
   fs::FS *m_fs; ///< Ponteiro para sistema de arquivos (legacy para compatibilidade).
   const char *m_path; ///< Caminho para o arquivo de imagem (legacy para compatibilidade).
   PerformanceMetrics_t m_metrics; ///< Métricas de desempenho para otimização.
+  bool m_streaming = false; ///< Imagem desenhada direto do arquivo (sem pixels na memória).
+  bool m_streamMask = false; ///< O arquivo tem máscara completa (uma linha de bits por linha de pixels).
+  bool m_compressed = false; ///< Arquivo no formato comprimido (.fkz), desenhado em streaming.
+  const ImageCacheEntry_t *m_cacheEntry = nullptr; ///< Imagem do cache compartilhado em uso (nullptr = buffers próprios ou externos).
+  bool m_loading = false; ///< Arquivo sendo lido pela task de carregamento; desenha o retângulo de espera.
+  #if defined(DISP_DEFAULT)
+  alignas(4) static uint8_t m_streamBuffer[DFK_IMAGE_STREAM_BUFFER]; ///< Linhas de pixels e máscara lidas do arquivo, compartilhado.
+  ImageRotator m_rotator; ///< Desenha a imagem rotacionada e guarda o último resultado.
+  #endif
   
+  friend class ImageLoader;
+
+  bool takeFromCache();
+  bool loadFile();
+  bool requestFileLoad();
+  bool collectFileLoad();
+  void drawPlaceholder();
+  void useCacheEntry(const ImageCacheEntry_t *entry);
+  void adoptFileData(const ImageFileData_t &data);
   bool readFileFromDisk();
+  bool readFileHeader();
+  bool streamFromDisk();
+  void recordFileLoadTime(uint32_t elapsed);
+  static bool decodeFile(fs::FS *fs, const char *path, ImageFileData_t &out);
+  static void cacheFileData(uint8_t source, const char *path, ImageFileData_t &data);
+  static void freeFileData(ImageFileData_t &data);
+  #if defined(DISP_DEFAULT)
+  static bool decodeFkz(fs::File &file, ImageFileData_t &out);
+  void drawStreamRows(uint16_t y, uint16_t rows, uint16_t *pixels, const uint8_t *mask);
+  #endif
   void defineFileSystem(SourceFile source);
   void drawRotatedImage();
+  void updateBounds();
   bool validateConfig();
   void clearBuffers();
 };
@@ -29,7 +29,7 @@ void Label::setPrefix(const char* str)
 
   strncpy(m_prefix, str, LABEL_MAX_PREFIX_LENGTH - 1);
   m_prefix[LABEL_MAX_PREFIX_LENGTH - 1] = '\0';
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 void Label::setSuffix(const char* str)
@@ -41,7 +41,7 @@ void Label::setSuffix(const char* str)
 
   strncpy(m_suffix, str, LABEL_MAX_SUFFIX_LENGTH - 1);
   m_suffix[LABEL_MAX_SUFFIX_LENGTH - 1] = '\0';
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 void Label::buildFinalText(const char* coreText)
@@ -56,7 +56,7 @@ void Label::buildFinalText(const char* coreText)
   strncat(m_text, m_suffix,
           LABEL_MAX_TEXT_LENGTH - strlen(m_text) - 1);
 
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 void Label::setText(const char* str)
@@ -97,12 +97,24 @@ void Label::redraw()
   CHECK_LOADED_VOID
   CHECK_SHOULDREDRAW_VOID
 
-  WidgetBase::objTFT->setTextColor(m_config.fontColor);
-  WidgetBase::objTFT->setFont(m_config.fontFamily);
-  WidgetBase::objTFT->setTextSize(m_fontSize);
-
+  #if defined(DISP_DEFAULT)
+  if (m_sevenSegment) {
+    printSevenSegment(m_text, m_xPos, m_yPos, m_config.datum,
+                      m_lastArea, m_config.backgroundColor,
+                      m_sevenSegment, m_config.fontColor, m_drawnText);
+  } else if (m_aaFont) {
+    m_drawnText.valid = false;
+    printAAText(m_text, m_xPos, m_yPos, m_config.datum,
+                m_lastArea, m_config.backgroundColor,
+                m_aaFont, m_config.fontColor);
+  } else if (!printTextDiff(m_text, m_xPos, m_yPos, m_config.datum,
+                            m_lastArea, m_config.backgroundColor,
+                            m_config.fontFamily, m_config.fontColor, m_fontSize, m_drawnText))
+  #endif
   printText(m_text, m_xPos, m_yPos, m_config.datum,
-            m_lastArea, m_config.backgroundColor);
+            m_lastArea, m_config.backgroundColor,
+            m_config.fontFamily, m_config.fontColor, m_fontSize);
+  setBounds(m_lastArea.x, m_lastArea.y, m_lastArea.width, m_lastArea.height);
 
   WidgetBase::objTFT->setTextSize(1);
   WidgetBase::setFontNull();
@@ -113,7 +125,10 @@ void Label::redraw()
 
 void Label::forceUpdate()
 {
-  m_shouldRedraw = true;
+  #if defined(DISP_DEFAULT)
+  m_drawnText.valid = false;
+  #endif
+  invalidate();
 }
 
 void Label::setDecimalPlaces(uint8_t places)
@@ -126,6 +141,21 @@ void Label::setFontSize(uint8_t newSize)
   m_fontSize = newSize;
 }
 
+#if defined(DISP_DEFAULT)
+void Label::setAAFont(const AAFont* font)
+{
+  m_aaFont = font;
+  invalidate();
+}
+
+void Label::setSevenSegment(const SevenSegmentStyle_t* style)
+{
+  m_sevenSegment = style;
+  m_drawnText.valid = false;
+  invalidate();
+}
+#endif
+
 void Label::setup(const LabelConfig& config)
 {
   CHECK_TFT_VOID
@@ -143,17 +173,23 @@ void Label::setup(const LabelConfig& config)
 
   m_lastArea = {0, 0, 0, 0};
   m_loaded = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 void Label::show()
 {
+  #if defined(DISP_DEFAULT)
+  m_drawnText.valid = false;
+  #endif
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 void Label::hide()
 {
+  #if defined(DISP_DEFAULT)
+  m_drawnText.valid = false;
+  #endif
   m_visible = false;
-  m_shouldRedraw = true;
+  invalidate();
 }
\ No newline at end of file
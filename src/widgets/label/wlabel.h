@@ -39,6 +39,10 @@ public:
   void forceUpdate() override;
   void setDecimalPlaces(uint8_t places);
   void setFontSize(uint8_t newSize);
+  #if defined(DISP_DEFAULT)
+  void setAAFont(const AAFont* font);
+  void setSevenSegment(const SevenSegmentStyle_t* style);
+  #endif
   void setup(const LabelConfig& config);
   void show() override;
   void hide() override;
@@ -50,13 +54,17 @@ private:
   char m_prefix[LABEL_MAX_PREFIX_LENGTH];
   char m_suffix[LABEL_MAX_SUFFIX_LENGTH];
 
-  bool m_shouldRedraw = false;
   TextBound_t m_lastArea = {0, 0, 0, 0};
 
   uint8_t m_fontSize = 1;
   uint8_t m_decimalPlaces = 1;
 
   LabelConfig m_config;
+  #if defined(DISP_DEFAULT)
+  const AAFont* m_aaFont = nullptr; ///< Fonte suavizada; se definida, substitui fontFamily.
+  const SevenSegmentStyle_t* m_sevenSegment = nullptr; ///< Estilo de sete segmentos; se definido, substitui as fontes.
+  DrawnText_t m_drawnText = {}; ///< Texto no painel, para redesenhar só os glifos que mudaram.
+  #endif
 
   void buildFinalText(const char* coreText);
 };
@@ -14,9 +14,9 @@ Led::Led(uint16_t _x, uint16_t _y, uint8_t _screen)
     : WidgetBase(_x, _y, _screen),
       m_lastStatus(false),
       m_status(false),
-      m_shouldRedraw(true),
       m_initialized(false)
 {
+  invalidate();
   // Initialize with default config
   m_config = {.radius = 10, .colorOn = CFK_RED, .colorOff = 0, .initialState = false};
   
@@ -101,7 +101,7 @@ void Led::setState(bool newValue) {
   
   if (m_status != newValue) {
     m_status = newValue;
-    m_shouldRedraw = true;
+    invalidate();
     
     // Update gradient if needed
     if (m_status) {
@@ -266,7 +266,7 @@ void Led::redraw() {
  */
 void Led::forceUpdate()
 {
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -304,8 +304,11 @@ void Led::setup(const LedConfig& config) {
   // Update gradient if needed
   updateGradient();
   
+  setBounds(m_xPos - m_config.radius, m_yPos - m_config.radius,
+            2 * m_config.radius + 1, 2 * m_config.radius + 1);
+
   // Initialize LED
-  m_shouldRedraw = true;
+  invalidate();
   m_loaded = true;
   m_initialized = true;
   
@@ -318,7 +321,7 @@ void Led::setup(const LedConfig& config) {
  */
 void Led::show() {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
   ESP_LOGD(TAG, "Led shown at (%d, %d)", m_xPos, m_yPos);
 }
 
@@ -328,12 +331,22 @@ void Led::show() {
  */
 void Led::hide() {
   m_visible = false;
-  m_shouldRedraw = true;
+  invalidate();
   ESP_LOGD(TAG, "Led hidden at (%d, %d)", m_xPos, m_yPos);
 }
 
 void Led::setColor(uint16_t color) {
   m_config.colorOn = color;
   updateGradient();
-  m_shouldRedraw = true;
-}
\ No newline at end of file
+  invalidate();
+}
+
+/**
+ * @brief Desenha o Led completo ao carregar a tela.
+ * @details Desenha o fundo e o estado atual.
+ */
+void Led::fullRedraw() {
+  forceUpdate();
+  drawBackground();
+  redraw();
+}
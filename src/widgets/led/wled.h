@@ -31,6 +31,7 @@ public:
   functionCB_t getCallbackFunc() override;
   void redraw() override;
   void forceUpdate() override;
+  void fullRedraw() override;
   void show() override;
   void hide() override;
   
@@ -46,7 +47,6 @@ private:
   
   bool m_lastStatus; ///< Armazena o último status do LED para comparação.
   bool m_status; ///< Status atual do LED (ligado/desligado).
-  bool m_shouldRedraw; ///< Flag indicando se o LED deve ser redesenhado.
   bool m_initialized; ///< Flag para rastrear se o widget foi adequadamente inicializado.
   LedConfig m_config; ///< Estrutura contendo configuração completa do LED (raio, cores).
   uint16_t m_colorLightGradient[5]; ///< Gradiente de cor para o efeito de luz.
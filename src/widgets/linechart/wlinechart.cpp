@@ -93,9 +93,9 @@ LineChart::LineChart(uint16_t _x, uint16_t _y, uint8_t _screen)
     m_borderSize(2),
     m_dotRadius(2), m_minSpaceToShowDot(10),
     m_topBottomPadding(0),
-    m_dataVersion(0),
-    m_shouldRedraw(true)
+    m_dataVersion(0)
 {
+  invalidate();
   memset(&m_config, 0, sizeof(LineChartConfig));
   memset(m_colorsSeries, 0, sizeof(m_colorsSeries));
   memset(m_subtitles, 0, sizeof(m_subtitles));
@@ -198,7 +198,7 @@ void LineChart::start()
   freeBuffers();
   allocBuffers();
   m_dataVersion = 0;
-  m_shouldRedraw = true;
+  invalidate();
   if (m_mutex) xSemaphoreGive(m_mutex);
 
   ESP_LOGD(TAG, "LineChart started: %dx%d, %d series, %d points",
@@ -223,9 +223,10 @@ void LineChart::setup(const LineChartConfig& config)
   m_config.subtitles = config.subtitles ? m_subtitles : nullptr;
 
   m_topBottomPadding = 5;
-  m_shouldRedraw = true;
+  invalidate();
 
   start();
+  setBounds(m_xPos, m_yPos, m_config.width, m_config.height);
   m_loaded = true;
 }
 
@@ -247,7 +248,7 @@ bool LineChart::push(uint16_t serieIndex, int newValue)
     (uint16_t)((m_headBySeries[serieIndex] + 1) % m_amountPoints);
 
   m_dataVersion++;
-  m_shouldRedraw = true;
+  invalidate();
 
   if (m_mutex) xSemaphoreGive(m_mutex);
   return true;
@@ -477,11 +478,20 @@ void LineChart::redraw()
 void LineChart::show()
 {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 void LineChart::hide()
 {
   m_visible = false;
   m_shouldRedraw = false;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Desenha o LineChart completo ao carregar a tela.
+ * @details Desenha o fundo estático; a parte dinâmica é desenhada no próximo frame.
+ */
+void LineChart::fullRedraw() {
+  forceUpdate();
+  drawBackground();
+}
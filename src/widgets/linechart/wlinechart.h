@@ -3,8 +3,10 @@
 
 #include "../widgetbase.h"
 #if defined(USING_GRAPHIC_LIB)
+#if !defined(DFK_FONT_SUBSET)
 #include "../../fonts/RobotoRegular/RobotoRegular10pt7b.h"
 #endif
+#endif
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "../label/wlabel.h"
@@ -47,7 +49,8 @@ public:
   void drawBackground();
   bool push(uint16_t serieIndex, int newValue);
   void redraw() override;
-  void forceUpdate() override { m_shouldRedraw = true; }
+  void forceUpdate() override { invalidate(); }
+  void fullRedraw() override;
   void setup(const LineChartConfig& config);
   void show() override;
   void hide() override;
@@ -87,7 +90,6 @@ private:
   // --- Estado ---
   volatile uint32_t m_dataVersion;
   uint16_t m_headBySeries[MAX_SERIES];
-  volatile bool m_shouldRedraw;
 
   // Lifecycle
   void initMutex();
@@ -575,7 +575,7 @@ void Numpad::insertChar(char c)
 void Numpad::show()
 {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -585,14 +585,14 @@ void Numpad::show()
 void Numpad::hide()
 {
   m_visible = false;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
  * @brief Força o Numpad a atualizar.
  * @details Define a flag de atualização para disparar um redesenho no próximo ciclo.
  */
-void Numpad::forceUpdate() { m_shouldRedraw = true; }
+void Numpad::forceUpdate() { invalidate(); }
 
 /**
  * @brief Redesenha o Numpad na tela.
@@ -5,8 +5,10 @@
 #include "wnumberbox.h"
 #include "../../extras/charstring.h"
 #if defined(USING_GRAPHIC_LIB)
+#if !defined(DFK_FONT_SUBSET)
 #include "../../fonts/RobotoRegular/RobotoRegular10pt7b.h"
 #endif
+#endif
 
 /// @brief Número de linhas na grade do teclado numérico
 #define NROWS 4
@@ -87,7 +89,6 @@ private:
   uint32_t m_keyW; ///< Largura de teclas individuais no Numpad.
   uint32_t m_keyH; ///< Altura de teclas individuais no Numpad.
   unsigned long m_myTime; ///< Timestamp para manipulação de funções relacionadas a tempo.
-  bool m_shouldRedraw; ///< Flag indicando se o numpad deve ser redesenhado.
   static const Key_t m_pad[4][4]; ///< Array 2D definindo os caracteres exibidos nas teclas do Numpad.
   int32_t m_screenW; ///< Largura de tela disponível para o Numpad.
   int32_t m_screenH; ///< Altura de tela disponível para o Numpad.
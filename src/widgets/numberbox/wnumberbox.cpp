@@ -25,7 +25,8 @@ void NumberBox::convertoToString(double f, char* buf, size_t bufSize) {
  *          O NumberBox não será funcional até que setup() seja chamado.
  */
 NumberBox::NumberBox(uint16_t _x, uint16_t _y, uint8_t _screen)
-    : WidgetBase(_x, _y, _screen), m_padding(3), m_shouldRedraw(true) {
+    : WidgetBase(_x, _y, _screen), m_padding(3) {
+      invalidate();
       #if defined(USING_GRAPHIC_LIB)
       m_config = {.funcPtr = nullptr, .callback = nullptr, .font = nullptr, .startValue = 0, .width = 0, .height = 0, .letterColor = 0, .backgroundColor = 0, .decimalPlaces = 2};
       #endif
@@ -35,7 +36,7 @@ NumberBox::NumberBox(uint16_t _x, uint16_t _y, uint8_t _screen)
  * @brief Construtor padrão para o NumberBox.
  * @details Cria um NumberBox na posição (0,0) na tela 0.
  */
-NumberBox::NumberBox() : WidgetBase(0, 0, 0), m_padding(3), m_shouldRedraw(true), m_config{} {}
+NumberBox::NumberBox() : WidgetBase(0, 0, 0), m_padding(3), m_config{} { invalidate(); }
 
 /**
  * @brief Destrutor da classe NumberBox.
@@ -124,10 +125,6 @@ void NumberBox::redraw() {
   // uint16_t baseBorder = WidgetBase::lightMode ? CFK_BLACK : CFK_WHITE;
 
   ESP_LOGD(TAG, "Redraw numberbox with value %s", m_value.getString());
-  WidgetBase::objTFT->fillRect(m_xPos, m_yPos, m_config.width, m_config.height,
-                               m_config.backgroundColor);
-  WidgetBase::objTFT->drawRect(m_xPos, m_yPos, m_config.width, m_config.height, m_config.letterColor);
-  WidgetBase::objTFT->setTextColor(m_config.letterColor);
 
   // TextBound_t area;
   // WidgetBase::objTFT->getTextBounds("M", m_xPos, m_yPos, &area.x, &area.y,
@@ -137,8 +134,33 @@ void NumberBox::redraw() {
   char conteudo[256];
 
   int n = getFirstLettersForSpace(m_value.getString(), m_config.width * 0.9, m_config.height * 0.9, conteudo, sizeof(conteudo));
-  if( n > 0){
-    printText(conteudo, m_xPos + m_padding, m_yPos + m_config.height / 2, ML_DATUM);
+  if (n <= 0) {
+    conteudo[0] = '\0';
+  }
+
+  // Se só alguns dígitos mudaram (mesma posição e largura), apenas eles são repintados.
+  // Caso contrário, com o buffer de faixa, fundo, borda e texto são compostos fora da tela e
+  // enviados em um bloco, sem apagar o valor antigo no painel antes do novo aparecer.
+  #if defined(DISP_DEFAULT)
+  TextBound_t textArea = {0, 0, 0, 0};
+  if (printTextDiff(conteudo, m_xPos + m_padding, m_yPos + m_config.height / 2, ML_DATUM,
+                    textArea, m_config.backgroundColor, m_font ? m_font : WidgetBase::fontNormal,
+                    m_config.letterColor, 1, m_drawnText)) {
+    updateFont(FontType::UNLOAD);
+    return;
+  }
+  OffscreenPass_t pass;
+  Rect_t area = {static_cast<uint16_t>(m_xPos), static_cast<uint16_t>(m_yPos), m_config.width, m_config.height};
+  if (beginOffscreen(area, m_config.backgroundColor, pass)) {
+    do {
+      drawContent(conteudo);
+    } while (nextOffscreenStripe(pass));
+  } else
+  #endif
+  {
+    WidgetBase::objTFT->fillRect(m_xPos, m_yPos, m_config.width, m_config.height,
+                                 m_config.backgroundColor);
+    drawContent(conteudo);
   }
 
   // log_d("Draw %d letters from %s in space %d", qtdLetrasMax, conteudo,
@@ -150,11 +172,37 @@ void NumberBox::redraw() {
   #endif
 }
 
+/**
+ * @brief Desenha a borda e o texto do NumberBox sobre o fundo já pintado.
+ * @param conteudo Texto que cabe na caixa (pode ser vazio).
+ * @details A fonte e a cor são definidas aqui porque o buffer de faixa tem seu próprio estado de texto.
+ */
+void NumberBox::drawContent(const char* conteudo) {
+  #if defined(USING_GRAPHIC_LIB)
+  WidgetBase::objTFT->setTextSize(1);
+  if (m_font) {
+    WidgetBase::objTFT->setFont(m_font);
+  } else {
+    updateFont(FontType::NORMAL);
+  }
+  WidgetBase::objTFT->drawRect(m_xPos, m_yPos, m_config.width, m_config.height, m_config.letterColor);
+  WidgetBase::objTFT->setTextColor(m_config.letterColor);
+  if (conteudo[0] != '\0') {
+    printText(conteudo, m_xPos + m_padding, m_yPos + m_config.height / 2, ML_DATUM);
+  }
+  #endif
+}
+
 /**
  * @brief Força o NumberBox a atualizar.
  * @details Define a flag de atualização para disparar um redesenho no próximo ciclo.
  */
-void NumberBox::forceUpdate() { m_shouldRedraw = true; }
+void NumberBox::forceUpdate() {
+  #if defined(DISP_DEFAULT)
+  m_drawnText.valid = false;
+  #endif
+  invalidate();
+}
 
 #if defined(USING_GRAPHIC_LIB)
 /**
@@ -204,6 +252,7 @@ void NumberBox::setup(uint16_t _width, uint16_t _height, uint16_t _letterColor,
   m_config.letterColor = _letterColor;
   m_config.backgroundColor = _backgroundColor;
   m_value.setStringDouble(_startValue, m_config.decimalPlaces);
+  setBounds(m_xPos, m_yPos, m_config.width, m_config.height);
 
   m_loaded = true;
 }
@@ -252,6 +301,7 @@ void NumberBox::setup(const NumberBoxConfig &config) {
   
   // Set initial value
   m_value.setStringDouble(config.startValue, config.decimalPlaces);
+  setBounds(m_xPos, m_yPos, m_config.width, m_config.height);
   
   m_loaded = true;
   ESP_LOGD(TAG, "NumberBox configured: %dx%d, value: %f", 
@@ -263,12 +313,12 @@ void NumberBox::setup(const NumberBoxConfig &config) {
  * @param str Valor numérico para definir.
  * @details Atualiza o valor exibido e marca o NumberBox para redesenho:
  *          - Converte float para string usando setString()
- *          - Marca para redesenho usando forceUpdate()
+ *          - Marca para redesenho usando invalidate(), mantendo o valor desenhado para o redesenho por dígito
  */
 void NumberBox::setValue(double str) {
   m_value.setStringDouble(str, m_config.decimalPlaces);
   ESP_LOGD(TAG, "Set value for numberbox: %s", m_value.getString());
-  forceUpdate();
+  invalidate();
 }
 
 /**
@@ -290,8 +340,11 @@ const char *NumberBox::getValueChar() { return m_value.getString(); }
  * @details Define o widget como visível e marca para redesenho.
  */
 void NumberBox::show() {
+  #if defined(DISP_DEFAULT)
+  m_drawnText.valid = false;
+  #endif
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -299,6 +352,16 @@ void NumberBox::show() {
  * @details Define o widget como invisível e marca para redesenho.
  */
 void NumberBox::hide() {
+  #if defined(DISP_DEFAULT)
+  m_drawnText.valid = false;
+  #endif
   m_visible = false;
-  m_shouldRedraw = true;
-}
\ No newline at end of file
+  invalidate();
+}
+
+/**
+ * @brief Indica que o NumberBox responde ao toque.
+ */
+bool NumberBox::isTouchable() const {
+  return true;
+}
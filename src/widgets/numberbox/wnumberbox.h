@@ -41,6 +41,7 @@ public:
   functionCB_t getCallbackFunc() override;
   void redraw() override;
   void forceUpdate() override;
+  bool isTouchable() const override;
   
   void setup(const NumberBoxConfig& config);
   void setValue(double str);
@@ -61,10 +62,13 @@ private:
   const GFXfont* m_font; ///< Fonte para usar no texto.
   #endif
   uint8_t m_padding; ///< Preenchimento da caixa de número.
-  bool m_shouldRedraw; ///< Flag para indicar se a caixa de número deve ser redesenhada.
   NumberBoxConfig m_config; ///< Estrutura contendo configuração da caixa de número.
+  #if defined(DISP_DEFAULT)
+  DrawnText_t m_drawnText = {}; ///< Valor no painel, para redesenhar só os dígitos que mudaram.
+  #endif
   
   void cleanupMemory();
+  void drawContent(const char* conteudo);
   #if defined(USING_GRAPHIC_LIB)
   void setup(uint16_t _width, uint16_t _height, uint16_t _letterColor, uint16_t _backgroundColor, float _startValue, const GFXfont* _font, functionLoadScreen_t _funcPtr, functionCB_t _cb);
   #endif
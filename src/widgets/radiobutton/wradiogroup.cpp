@@ -10,7 +10,8 @@ const char* RadioGroup::TAG = "RadioGroup";
  *          O RadioGroup não será funcional até que setup() seja chamado.
  */
 RadioGroup::RadioGroup(uint8_t _screen)
-    : WidgetBase(0, 0, _screen), m_shouldRedraw(true), m_config{} {
+    : WidgetBase(0, 0, _screen), m_buttons(nullptr), m_clickedId(0), m_config{} {
+      invalidate();
       m_config = {
         .buttons = nullptr,
         .callback = nullptr,
@@ -32,18 +33,12 @@ RadioGroup::~RadioGroup() {
 /**
  * @brief Limpa memória usada pelo RadioGroup.
  * @details Desaloca arrays dinâmicos de botões e limpa referências:
- *          - Libera m_config.buttons se alocado
- *          - Libera m_buttons se alocado
+ *          - Libera m_buttons se alocado (m_config.buttons aponta para a mesma cópia)
  */
 void RadioGroup::cleanupMemory() {
-  if (m_config.buttons) {
-    delete[] m_config.buttons;
-    m_config.buttons = nullptr;
-  }
-  if (m_buttons) {
-    delete[] m_buttons;
-    m_buttons = nullptr;
-  }
+  delete[] m_buttons;
+  m_buttons = nullptr;
+  m_config.buttons = nullptr;
   ESP_LOGD(TAG, "RadioGroup memory cleanup completed");
 }
 
@@ -51,7 +46,7 @@ void RadioGroup::cleanupMemory() {
  * @brief Força o RadioGroup a atualizar.
  * @details Define a flag de atualização para disparar um redesenho no próximo ciclo.
  */
-void RadioGroup::forceUpdate() { m_shouldRedraw = true; }
+void RadioGroup::forceUpdate() { invalidate(); }
 
 /**
  * @brief Detecta se algum botão de rádio dentro do grupo foi tocado.
@@ -71,15 +66,13 @@ bool RadioGroup::detectTouch(uint16_t *_xTouch, uint16_t *_yTouch) {
   CHECK_LOADED_BOOL
   CHECK_DEBOUNCE_CLICK_BOOL
 
-  int offset_radius = 5;
-
   for (int16_t i = 0; i < m_config.amount; i++) {
     radio_t r = m_buttons[i];
-    bool inBounds = POINT_IN_CIRCLE(*_xTouch, *_yTouch, r.x, r.y, m_config.radius + offset_radius);
+    bool inBounds = POINT_IN_CIRCLE(*_xTouch, *_yTouch, r.x, r.y, m_config.radius + m_touchOffsetRadius);
     if(inBounds) {
       m_clickedId = r.id;
       setPressed(true);  // Mark widget as pressed
-      m_shouldRedraw = true;
+      invalidate();
       m_myTime = millis();
       return true;
     } 
@@ -159,7 +152,7 @@ void RadioGroup::setSelected(uint16_t clickedId) {
     radio_t r = (m_buttons[i]);
     if (r.id == clickedId) {
       m_clickedId = r.id;
-      m_shouldRedraw = true;
+      invalidate();
       if (m_callback != nullptr) {
         WidgetBase::addCallback(m_callback, WidgetBase::CallbackOrigin::SELF);
       }
@@ -225,6 +218,7 @@ void RadioGroup::setup(const RadioGroupConfig &config) {
   
   m_clickedId = config.defaultClickedId;
   m_callback = config.callback;
+  updateBounds();
   m_loaded = true;
   
   ESP_LOGD(TAG, "RadioGroup configured: group=%d, radius=%d, amount=%d", 
@@ -238,6 +232,30 @@ void RadioGroup::setup(const RadioGroupConfig &config) {
  */
 uint16_t RadioGroup::getSelected() { return m_clickedId; }
 
+/**
+ * @brief Calcula o retângulo que envolve todos os botões do grupo.
+ * @details Os botões podem estar espalhados pela tela; a área registrada é a caixa envolvente
+ *          dos círculos, usada no rastreamento de áreas sujas.
+ */
+void RadioGroup::updateBounds() {
+  if (m_buttons == nullptr || m_config.amount == 0) {
+    setBounds(0, 0, 0, 0);
+    return;
+  }
+  int32_t r = m_config.radius;
+  int32_t minX = m_buttons[0].x - r;
+  int32_t minY = m_buttons[0].y - r;
+  int32_t maxX = m_buttons[0].x + r;
+  int32_t maxY = m_buttons[0].y + r;
+  for (uint8_t i = 1; i < m_config.amount; i++) {
+    minX = min(minX, (int32_t)m_buttons[i].x - r);
+    minY = min(minY, (int32_t)m_buttons[i].y - r);
+    maxX = max(maxX, (int32_t)m_buttons[i].x + r);
+    maxY = max(maxY, (int32_t)m_buttons[i].y + r);
+  }
+  setBounds(minX, minY, maxX - minX + 1, maxY - minY + 1);
+}
+
 /**
  * @brief Recupera o ID do grupo do RadioGroup.
  * @return Identificador do grupo para o RadioGroup.
@@ -251,7 +269,7 @@ uint16_t RadioGroup::getGroupId() { return m_config.group; }
  */
 void RadioGroup::show() {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -260,5 +278,23 @@ void RadioGroup::show() {
  */
 void RadioGroup::hide() {
   m_visible = false;
-  m_shouldRedraw = true;
-}
\ No newline at end of file
+  invalidate();
+}
+
+/**
+ * @brief Área aceita por detectTouch(): a caixa dos botões com a margem de toque.
+ */
+Rect_t RadioGroup::getTouchBounds() const {
+  if (m_bounds.width == 0 || m_bounds.height == 0) {
+    return m_bounds;
+  }
+  return clipRect(m_bounds.x - m_touchOffsetRadius, m_bounds.y - m_touchOffsetRadius,
+                  m_bounds.width + 2 * m_touchOffsetRadius, m_bounds.height + 2 * m_touchOffsetRadius);
+}
+
+/**
+ * @brief Indica que o RadioGroup responde ao toque.
+ */
+bool RadioGroup::isTouchable() const {
+  return true;
+}
@@ -41,6 +41,8 @@ public:
   functionCB_t getCallbackFunc() override;
   void redraw() override;
   void forceUpdate() override;
+  bool isTouchable() const override;
+  Rect_t getTouchBounds() const override;
   
   void setup(const RadioGroupConfig& config);
   void setSelected(uint16_t clickedId);
@@ -52,13 +54,14 @@ public:
 
 private:
   static const char* TAG; ///< Tag estática para identificação em logs do ESP32.
+  static constexpr int16_t m_touchOffsetRadius = 5; ///< Margem (px) somada ao raio no teste de toque.
   
   radio_t *m_buttons; ///< Ponteiro para um array de definições de botões de rádio.
   uint8_t m_clickedId; ///< ID do botão de rádio atualmente selecionado.
-  bool m_shouldRedraw; ///< Flag para indicar se os botões de rádio devem ser redesenhados.
   RadioGroupConfig m_config; ///< Estrutura contendo configuração do grupo de botões de rádio.
   
   void cleanupMemory();
+  void updateBounds();
 };
 
 #endif
\ No newline at end of file
@@ -62,7 +62,7 @@ bool RectButton::detectTouch(uint16_t *_xTouch, uint16_t *_yTouch) {
     m_myTime = millis();
     setPressed(true);  // Mark widget as pressed
     changeState();
-    m_shouldRedraw = true;
+    invalidate();
     return true;
   }
   return false;
@@ -99,7 +99,7 @@ void RectButton::changeState() { m_status = !m_status; }
  * @brief Força o botão a atualizar.
  * @details Define a flag de atualização para disparar um redesenho no próximo ciclo.
  */
-void RectButton::forceUpdate() { m_shouldRedraw = true; }
+void RectButton::forceUpdate() { invalidate(); }
 
 /**
  * @brief Redesenha o botão na tela, atualizando sua aparência.
@@ -181,6 +181,7 @@ void RectButton::setup(const RectButtonConfig &config) {
   
   // Set member variables from config
   m_callback = config.callback;
+  setBounds(m_xPos, m_yPos, m_config.width, m_config.height);
   
   m_loaded = true;
   
@@ -211,7 +212,7 @@ void RectButton::setStatus(bool _status) {
   }
 
   m_status = _status;
-  m_shouldRedraw = true;
+  invalidate();
   if (m_callback != nullptr) {
     WidgetBase::addCallback(m_callback, WidgetBase::CallbackOrigin::SELF);
   }
@@ -223,7 +224,7 @@ void RectButton::setStatus(bool _status) {
  */
 void RectButton::show() {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -232,5 +233,12 @@ void RectButton::show() {
  */
 void RectButton::hide() {
   m_visible = false;
-  m_shouldRedraw = true;
-}
\ No newline at end of file
+  invalidate();
+}
+
+/**
+ * @brief Indica que o RectButton responde ao toque.
+ */
+bool RectButton::isTouchable() const {
+  return true;
+}
@@ -30,6 +30,7 @@ public:
   functionCB_t getCallbackFunc() override;
   void redraw() override;
   void forceUpdate() override;
+  bool isTouchable() const override;
   
   void setup(const RectButtonConfig& config);
   void changeState();
@@ -101,7 +101,7 @@ bool SpinBox::detectTouch(uint16_t *_xTouch, uint16_t *_yTouch) {
 
   setPressed(true);  // Mark widget as pressed
   m_myTime = millis();
-  m_shouldRedraw = true;
+  invalidate();
 
   return true;
 }
@@ -144,14 +144,28 @@ void SpinBox::redraw() {
   WidgetBase::objTFT->setTextColor(m_config.textColor);
 
   //WidgetBase::objTFT->fillRoundRect(m_xPos + (2 * m_offset) + btnW, m_yPos + m_offset,m_config.width - (4 * m_offset + 2 * btnW), btnH, m_radius, m_config.color);
-  WidgetBase::objTFT->fillRect(m_textAreaSize.x, m_textAreaSize.y, m_textAreaSize.width, m_textAreaSize.height, m_config.color);
-
-
   //uint16_t offsetFont = 10;
   //WidgetBase::objTFT->setFont(getBestRobotoBold( availableW - offsetFont, availableH - offsetFont, String(m_currentValue).c_str()));
-  WidgetBase::objTFT->setFont(m_font);
-  printText(String(m_currentValue).c_str(), m_xPos + m_config.width / 2,
-            m_yPos + (m_config.height / 2) - 3, MC_DATUM, m_lastArea, m_config.color);
+  String valor(m_currentValue);
+
+  // Com o buffer de faixa, a área do texto é composta fora da tela e enviada em um bloco.
+  #if defined(DISP_DEFAULT)
+  OffscreenPass_t pass;
+  if (beginOffscreen(m_textAreaSize, m_config.color, pass)) {
+    do {
+      WidgetBase::objTFT->setFont(m_font);
+      WidgetBase::objTFT->setTextColor(m_config.textColor);
+      printText(valor.c_str(), m_xPos + m_config.width / 2,
+                m_yPos + (m_config.height / 2) - 3, MC_DATUM, m_lastArea, m_config.color);
+    } while (nextOffscreenStripe(pass));
+  } else
+  #endif
+  {
+    WidgetBase::objTFT->fillRect(m_textAreaSize.x, m_textAreaSize.y, m_textAreaSize.width, m_textAreaSize.height, m_config.color);
+    WidgetBase::objTFT->setFont(m_font);
+    printText(valor.c_str(), m_xPos + m_config.width / 2,
+              m_yPos + (m_config.height / 2) - 3, MC_DATUM, m_lastArea, m_config.color);
+  }
   updateFont(FontType::UNLOAD);
 
   #endif
@@ -217,7 +231,7 @@ void SpinBox::drawBackground() {
                                signalSize,
                                m_config.textColor);
 
-  m_shouldRedraw = true;
+  invalidate();
 
   #endif
 
@@ -284,6 +298,7 @@ void SpinBox::setup(const SpinBoxConfig &config) {
 
   m_currentValue = constrain(m_config.startValue, m_config.minValue, m_config.maxValue);
   m_callback = config.callback;
+  setBounds(m_xPos, m_yPos, m_config.width, m_config.height);
   m_loaded = true;
 }
 
@@ -311,7 +326,7 @@ void SpinBox::setValue(int _value) {
   }
 
   m_currentValue = constrain(_value, m_config.minValue, m_config.maxValue);
-  m_shouldRedraw = true;
+  invalidate();
 
   if (m_callback != nullptr) {
     WidgetBase::addCallback(m_callback, WidgetBase::CallbackOrigin::SELF);
@@ -324,7 +339,7 @@ void SpinBox::setValue(int _value) {
  */
 void SpinBox::show() {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -333,11 +348,27 @@ void SpinBox::show() {
  */
 void SpinBox::hide() {
   m_visible = false;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
  * @brief Força o SpinBox a atualizar.
  * @details Define a flag de atualização para disparar um redesenho no próximo ciclo.
  */
-void SpinBox::forceUpdate() { m_shouldRedraw = true; }
\ No newline at end of file
+void SpinBox::forceUpdate() { invalidate(); }
+
+/**
+ * @brief Desenha o SpinBox completo ao carregar a tela.
+ * @details Desenha o fundo e o valor atual.
+ */
+void SpinBox::fullRedraw() {
+  drawBackground();
+  redraw();
+}
+
+/**
+ * @brief Indica que o SpinBox responde ao toque.
+ */
+bool SpinBox::isTouchable() const {
+  return true;
+}
@@ -35,6 +35,8 @@ public:
   functionCB_t getCallbackFunc() override;
   void redraw() override;
   void forceUpdate() override;
+  void fullRedraw() override;
+  bool isTouchable() const override;
   
   void drawBackground();
   void setup(const SpinBoxConfig& config);
@@ -515,7 +515,7 @@ void WKeyboard::insertChar(char c)
 void WKeyboard::show()
 {
     m_visible = true;
-    m_shouldRedraw = true;
+    invalidate();
 }
 
 /**
@@ -525,7 +525,7 @@ void WKeyboard::show()
 void WKeyboard::hide()
 {
     m_visible = false;
-    m_shouldRedraw = true;
+    invalidate();
 }
 
 /**
@@ -541,4 +541,4 @@ void WKeyboard::redraw()
  * @brief Força o WKeyboard a atualizar.
  * @details Define a flag de atualização para disparar um redesenho no próximo ciclo.
  */
-void WKeyboard::forceUpdate() { m_shouldRedraw = true; }
\ No newline at end of file
+void WKeyboard::forceUpdate() { invalidate(); }
\ No newline at end of file
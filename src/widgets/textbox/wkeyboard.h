@@ -5,8 +5,10 @@
 #include "wtextbox.h"
 #include "../../extras/charstring.h"
 #if defined(USING_GRAPHIC_LIB)
+#if !defined(DFK_FONT_SUBSET)
 #include "../../fonts/RobotoRegular/RobotoRegular10pt7b.h"
 #endif
+#endif
 
 /// @brief Número de linhas na grade do teclado
 #define AROWS 5
@@ -81,7 +83,6 @@ private:
   CharString m_content; ///< Armazena o conteúdo atual inserido pelo usuário.
   TextBound_t lastArea; ///< Última área calculada para o texto.
   Rect_t m_pontoPreview; ///< Retângulo de preview para o ponto de toque.
-  bool m_shouldRedraw; ///< Flag indicando se o WKeyboard deve ser redesenhado.
   CoordPoint_t m_backKeyPos = {0,0}; ///< Posição da tecla de retorno.
 
   void drawBackKey(uint16_t x, uint16_t y);
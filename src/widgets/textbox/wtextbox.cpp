@@ -11,7 +11,7 @@ const char* TextBox::TAG = "[TextBox]";
  *          A caixa de texto não será funcional até que setup() seja chamado.
  */
 TextBox::TextBox(uint16_t _x, uint16_t _y, uint8_t _screen)
-    : WidgetBase(_x, _y, _screen), m_padding(3), m_shouldRedraw(true) {}
+    : WidgetBase(_x, _y, _screen), m_padding(3) { invalidate(); }
 
 /**
  * @brief Construtor padrão para o TextBox.
@@ -114,17 +114,25 @@ void TextBox::redraw() {
   // WidgetBase::objTFT->getTextBounds("M", m_xPos, m_yPos, &area.x, &area.y,
   // &area.width, &area.height);
 
-  WidgetBase::objTFT->fillRect(m_xPos, m_yPos, m_width, m_height,
-                               m_backgroundColor);
-  WidgetBase::objTFT->drawRect(m_xPos, m_yPos, m_width, m_height, m_letterColor);
-  WidgetBase::objTFT->setTextColor(m_letterColor);
-
   // uint16_t qtdLetrasMax = m_width / area.width;
   // const char *conteudo = m_value.getFirstChars(qtdLetrasMax);
   char conteudo[256];
   int n = getFirstLettersForSpace(m_value.getString(), m_width * 0.9, m_height * 0.9, conteudo, sizeof(conteudo));
-  if(n > 0){
-    printText(conteudo, m_xPos + m_padding, m_yPos + m_height / 2, ML_DATUM);
+  if (n <= 0) {
+    conteudo[0] = '\0';
+  }
+
+  // Com o buffer de faixa, fundo, borda e texto são compostos fora da tela e enviados em um bloco.
+  OffscreenPass_t pass;
+  Rect_t area = {static_cast<uint16_t>(m_xPos), static_cast<uint16_t>(m_yPos), m_width, m_height};
+  if (beginOffscreen(area, m_backgroundColor, pass)) {
+    do {
+      drawContent(conteudo);
+    } while (nextOffscreenStripe(pass));
+  } else {
+    WidgetBase::objTFT->fillRect(m_xPos, m_yPos, m_width, m_height,
+                                 m_backgroundColor);
+    drawContent(conteudo);
   }
   // log_d("Draw %d letters from %s in space %d", qtdLetrasMax, conteudo,
   // m_width);
@@ -134,6 +142,27 @@ void TextBox::redraw() {
 #endif
 }
 
+/**
+ * @brief Desenha a borda e o texto do TextBox sobre o fundo já pintado.
+ * @param conteudo Texto que cabe na caixa (pode ser vazio).
+ * @details A fonte e a cor são definidas aqui porque o buffer de faixa tem seu próprio estado de texto.
+ */
+void TextBox::drawContent(const char* conteudo) {
+#if defined(USING_GRAPHIC_LIB)
+  WidgetBase::objTFT->setTextSize(1);
+  if (m_font) {
+    WidgetBase::objTFT->setFont(m_font);
+  } else {
+    updateFont(FontType::NORMAL);
+  }
+  WidgetBase::objTFT->drawRect(m_xPos, m_yPos, m_width, m_height, m_letterColor);
+  WidgetBase::objTFT->setTextColor(m_letterColor);
+  if (conteudo[0] != '\0') {
+    printText(conteudo, m_xPos + m_padding, m_yPos + m_height / 2, ML_DATUM);
+  }
+#endif
+}
+
 /**
  * @brief Configura o widget TextBox com parâmetros específicos de uma estrutura de configuração.
  * @param config A estrutura de configuração contendo todos os parâmetros de setup.
@@ -188,6 +217,7 @@ void TextBox::setup(uint16_t _width, uint16_t _height, uint16_t _letterColor,
   m_value.setString(_startValue, true);
   m_font = _font;
   m_callback = _cb;
+  setBounds(m_xPos, m_yPos, m_width, m_height);
 
   m_loaded = true;
 }
@@ -210,7 +240,7 @@ void TextBox::setValue(const char *str) {
  * @brief Força o TextBox a atualizar.
  * @details Define a flag de atualização para disparar um redesenho no próximo ciclo.
  */
-void TextBox::forceUpdate() { m_shouldRedraw = true; }
+void TextBox::forceUpdate() { invalidate(); }
 
 /**
  * @brief Recupera o valor de texto atual do TextBox.
@@ -225,7 +255,7 @@ const char *TextBox::getValue() { return m_value.getString(); }
  */
 void TextBox::show() {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -234,5 +264,12 @@ void TextBox::show() {
  */
 void TextBox::hide() {
   m_visible = false;
-  m_shouldRedraw = true;
-}
\ No newline at end of file
+  invalidate();
+}
+
+/**
+ * @brief Indica que o TextBox responde ao toque.
+ */
+bool TextBox::isTouchable() const {
+  return true;
+}
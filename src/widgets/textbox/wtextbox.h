@@ -40,6 +40,7 @@ public:
   functionCB_t getCallbackFunc() override;
   void redraw() override;
   void forceUpdate() override;
+  bool isTouchable() const override;
   
   void setup(const TextBoxConfig& config);
   void setValue(const char* str);
@@ -61,8 +62,8 @@ private:
   const GFXfont *m_font; ///< Fonte para usar no texto.
   #endif
   uint8_t m_padding; ///< Preenchimento da caixa de texto.
-  bool m_shouldRedraw; ///< Flag para indicar se o TextBox deve ser redesenhado.
   
+  void drawContent(const char* conteudo);
   #if defined(USING_GRAPHIC_LIB)
   void setup(uint16_t _width, uint16_t _height, uint16_t _letterColor, uint16_t _backgroundColor, const char* _startValue, const GFXfont* _font, functionLoadScreen_t _funcPtr, functionCB_t _cb);
   #endif
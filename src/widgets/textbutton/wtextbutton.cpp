@@ -67,7 +67,7 @@ bool TextButton::detectTouch(uint16_t *_xTouch, uint16_t *_yTouch)
     m_myTime = millis();
     setPressed(true);  // Mark widget as pressed (uses m_isPressed from WidgetBase)
     // onClick();
-    m_shouldRedraw = true;
+    invalidate();
     return true;
   }
   return false;
@@ -89,7 +89,7 @@ void TextButton::onRelease() {
     
     // Mark widget for redraw to update visual appearance
     // This ensures the button border changes from white (pressed) to normal color
-    m_shouldRedraw = true;
+    invalidate();
     
     ESP_LOGD(TAG, "TextButton released at (%d, %d)", m_xPos, m_yPos);
 }
@@ -232,6 +232,7 @@ void TextButton::setup(const TextButtonConfig &config)
   m_text = config.text; // Note: This is a const pointer, no deep copy needed
   m_callback = config.callback;
   m_pressedColor = darken565(m_config.backgroundColor, 0.5);
+  setBounds(m_xPos, m_yPos, m_config.width, m_config.height);
   m_loaded = true;
   m_enabled = true;
 
@@ -246,7 +247,7 @@ void TextButton::setup(const TextButtonConfig &config)
 void TextButton::show()
 {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -256,11 +257,18 @@ void TextButton::show()
 void TextButton::hide()
 {
   m_visible = false;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
  * @brief Força o TextButton a atualizar.
  * @details Define a flag de atualização para disparar um redesenho no próximo ciclo.
  */
-void TextButton::forceUpdate() { m_shouldRedraw = true; }
\ No newline at end of file
+void TextButton::forceUpdate() { invalidate(); }
+
+/**
+ * @brief Indica que o TextButton responde ao toque.
+ */
+bool TextButton::isTouchable() const {
+  return true;
+}
@@ -37,6 +37,7 @@ public:
   functionCB_t getCallbackFunc() override;
   void redraw() override;
   void forceUpdate() override;
+  bool isTouchable() const override;
   
   void setup(const TextButtonConfig& config);
   void onClick();
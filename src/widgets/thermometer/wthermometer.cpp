@@ -61,7 +61,7 @@ void Thermometer::setScale(int newMinValue, int newMaxValue)
   sortValues();
   m_currentValue = constrain(m_currentValue, m_config.minValue, m_config.maxValue);
   m_changedScale = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 
@@ -76,7 +76,7 @@ void Thermometer::setMinValue(int newValue)
   sortValues();
   m_currentValue = constrain(m_currentValue, m_config.minValue, m_config.maxValue);
   m_changedScale = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 
@@ -91,7 +91,7 @@ void Thermometer::setMaxValue(int newValue)
   sortValues();
   m_currentValue = constrain(m_currentValue, m_config.minValue, m_config.maxValue);
   m_changedScale = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 
@@ -148,7 +148,7 @@ void Thermometer::setValue(float newValue)
 {
   m_currentValue = constrain(newValue, m_config.minValue, m_config.maxValue);
   // Serial.println("ajusta currentValue: " + String(currentValue));
-  m_shouldRedraw = true;
+  invalidate();
   // redraw();
 }
 
@@ -220,7 +220,7 @@ void Thermometer::start()
  */
 void Thermometer::forceUpdate()
 {
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -327,8 +327,9 @@ void Thermometer::setup(uint16_t _width, uint16_t _height, uint16_t _filledColor
   //m_vmin = _vmin;
   //m_vmax = _vmax;
   m_currentValue = m_config.minValue;
-  m_shouldRedraw = true;
+  invalidate();
   start();
+  setBounds(m_xPos, m_yPos, m_config.width, m_config.height);
   m_loaded = true;
 }
 
@@ -376,7 +377,7 @@ void Thermometer::setup(const ThermometerConfig& config)
 void Thermometer::show()
 {
     m_visible = true;
-    m_shouldRedraw = true;
+    invalidate();
 }
 
 /**
@@ -386,5 +387,14 @@ void Thermometer::show()
 void Thermometer::hide()
 {
     m_visible = false;
-    m_shouldRedraw = true;
+    invalidate();
+}
+
+/**
+ * @brief Desenha o Thermometer completo ao carregar a tela.
+ * @details Desenha o fundo estático; a parte dinâmica é desenhada no próximo frame.
+ */
+void Thermometer::fullRedraw() {
+  forceUpdate();
+  drawBackground();
 }
@@ -38,6 +38,7 @@ public:
   functionCB_t getCallbackFunc() override;
   void redraw() override;
   void forceUpdate() override;
+  void fullRedraw() override;
   
   void drawBackground();
   void setup(const ThermometerConfig& config);
@@ -63,7 +64,6 @@ private:
   uint16_t m_colorLightGradient[5]; ///< Gradiente de cor para o efeito de luz no bulbo.
   uint16_t m_border; ///< Tamanho da borda ao redor do termômetro.
   ThermometerConfig m_config; ///< Estrutura contendo configuração do termômetro.
-  bool m_shouldRedraw; ///< Flag indicando se o termômetro deve ser redesenhado.
   
   void cleanupMemory();
   void start();
@@ -60,7 +60,7 @@ bool ToggleButton::detectTouch(uint16_t *_xTouch, uint16_t *_yTouch)
     m_myTime = millis();
     setPressed(true);  // Mark widget as pressed
     changeState();
-    m_shouldRedraw = true;
+    invalidate();
     return true;
   }
   return false;
@@ -89,7 +89,7 @@ void ToggleButton::changeState()
  * @brief Força o ToggleButton a redesenhar.
  * @details Define a flag de atualização para disparar um redesenho no próximo ciclo.
  */
-void ToggleButton::forceUpdate() { m_shouldRedraw = true; }
+void ToggleButton::forceUpdate() { invalidate(); }
 
 /**
  * @brief Redesenha o ToggleButton na tela, atualizando sua aparência baseada no estado.
@@ -201,6 +201,7 @@ void ToggleButton::setup(const ToggleButtonConfig &config)
   m_config = config;
   m_callback = config.callback;
   start();
+  setBounds(m_xPos, m_yPos, m_config.width, m_config.height);
 
     m_loaded = true;
     m_initialized = true;
@@ -230,7 +231,7 @@ void ToggleButton::setStatus(bool status)
   }
   ESP_LOGD(TAG, "Setting status to %d", status);
   m_status = status;
-  m_shouldRedraw = true;
+  invalidate();
   if (m_callback != nullptr)
   {
     WidgetBase::addCallback(m_callback, WidgetBase::CallbackOrigin::SELF);
@@ -244,7 +245,7 @@ void ToggleButton::setStatus(bool status)
 void ToggleButton::show()
 {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -254,5 +255,12 @@ void ToggleButton::show()
 void ToggleButton::hide()
 {
   m_visible = false;
-  m_shouldRedraw = true;
+  invalidate();
+}
+
+/**
+ * @brief Indica que o ToggleButton responde ao toque.
+ */
+bool ToggleButton::isTouchable() const {
+  return true;
 }
@@ -30,6 +30,7 @@ public:
   void changeState();
   void redraw() override;
   void forceUpdate() override;
+  bool isTouchable() const override;
   void setup(const ToggleButtonConfig& config);
   bool getStatus();
   void setStatus(bool status);
@@ -105,6 +105,7 @@ void TouchArea::onClick() {
 void TouchArea::setup(const TouchAreaConfig &config) {
   m_config = config;
   m_callback = config.callback;
+  setBounds(m_xPos, m_yPos, m_config.width, m_config.height);
   m_loaded = true;
   m_initialized = true;
 }
@@ -131,7 +132,7 @@ bool TouchArea::getStatus() { return m_status; }
  */
 void TouchArea::show() {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -140,11 +141,34 @@ void TouchArea::show() {
  */
 void TouchArea::hide() {
   m_visible = false;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
  * @brief Força o TouchArea a atualizar.
  * @details Define a flag de atualização para disparar um redesenho no próximo ciclo.
  */
-void TouchArea::forceUpdate() { m_shouldRedraw = true; }
\ No newline at end of file
+void TouchArea::forceUpdate() { invalidate(); }
+
+/**
+ * @brief Desenha o TouchArea completo ao carregar a tela.
+ * @details A área de toque não tem parte visível própria; apenas chama redraw().
+ */
+void TouchArea::fullRedraw() {
+  redraw();
+}
+
+/**
+ * @brief Redesenho por frame do TouchArea.
+ * @details Não há nada a desenhar; apenas limpa a flag para a área não ficar pendente.
+ */
+void TouchArea::refresh() {
+  m_shouldRedraw = false;
+}
+
+/**
+ * @brief Indica que o TouchArea responde ao toque.
+ */
+bool TouchArea::isTouchable() const {
+  return true;
+}
@@ -29,6 +29,9 @@ public:
   void changeState();
   void redraw() override;
   void forceUpdate() override;
+  void fullRedraw() override;
+  void refresh() override;
+  bool isTouchable() const override;
   void setup(const TouchAreaConfig& config);
   bool getStatus();
   void onClick();
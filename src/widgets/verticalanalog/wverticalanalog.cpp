@@ -81,7 +81,7 @@ void VAnalog::setScale(int newMinValue, int newMaxValue)
   sortValues();
   m_currentValue = constrain(m_currentValue, m_config.minValue, m_config.maxValue);
   m_changedScale = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /** @brief Define o valor mínimo para o widget VAnalog
@@ -95,7 +95,7 @@ void VAnalog::setMinValue(int newValue)
   sortValues();
   m_currentValue = constrain(m_currentValue, m_config.minValue, m_config.maxValue);
   m_changedScale = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /** @brief Define o valor máximo para o widget VAnalog
@@ -109,7 +109,7 @@ void VAnalog::setMaxValue(int newValue)
   sortValues();
   m_currentValue = constrain(m_currentValue, m_config.minValue, m_config.maxValue);
   m_changedScale = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /** @brief Recupera o valor mínimo para o widget VAnalog
@@ -228,7 +228,7 @@ void VAnalog::setValue(int newValue, bool _viewValue)
   m_currentValue = constrain(newValue, m_config.minValue, m_config.maxValue);
   m_updateText = _viewValue;
   ////Serial.println("ajusta currentValue: " + String(currentValue));
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -278,7 +278,7 @@ void VAnalog::redraw()
  */
 void VAnalog::forceUpdate()
 {
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 
@@ -301,6 +301,7 @@ void VAnalog::setup(const VerticalAnalogConfig& config)
   }
   m_config = config;
   start();
+  setBounds(m_xPos, m_yPos, m_config.width, m_config.height);
   m_loaded = true;
   m_initialized = true;
 }
@@ -312,7 +313,7 @@ void VAnalog::setup(const VerticalAnalogConfig& config)
 void VAnalog::show()
 {
     m_visible = true;
-    m_shouldRedraw = true;
+    invalidate();
 }
 
 /**
@@ -322,7 +323,7 @@ void VAnalog::show()
 void VAnalog::hide()
 {
     m_visible = false;
-    m_shouldRedraw = true;
+    invalidate();
 }
 
 
@@ -380,4 +381,13 @@ void VAnalog::drawText()
   WidgetBase::objTFT->fillRect(m_textArea.x, m_textArea.y, m_textArea.width, m_textArea.height, m_config.backgroundColor);
   printText(String(m_currentValue).c_str(), m_textArea.x + (m_textArea.width / 2), m_textArea.y + (m_textArea.height / 2), MC_DATUM);
   #endif
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Desenha o VAnalog completo ao carregar a tela.
+ * @details Desenha o fundo estático; a parte dinâmica é desenhada no próximo frame.
+ */
+void VAnalog::fullRedraw() {
+  forceUpdate();
+  drawBackground();
+}
@@ -3,8 +3,10 @@
 
 #include "../widgetbase.h"
 #if defined(USING_GRAPHIC_LIB)
+#if !defined(DFK_FONT_SUBSET)
 #include "../../fonts/RobotoRegular/RobotoRegular10pt7b.h"
 #endif
+#endif
 
 /// @brief Estrutura de configuração para o VAnalog.
 /// @details Esta estrutura contém todos os parâmetros necessários para configurar um display analógico vertical.
@@ -37,6 +39,7 @@ public:
   void setValue(int newValue, bool _viewValue);
   void redraw() override;
   void forceUpdate() override;
+  void fullRedraw() override;
   void setup(const VerticalAnalogConfig& config);
   void show() override;
   void hide() override;
@@ -64,7 +64,7 @@ void VBar::setValue(int newValue)
 {
   m_currentValue = constrain(newValue, m_config.minValue, m_config.maxValue);
   // Serial.println("ajusta currentValue: " + String(currentValue));
-  m_shouldRedraw = true;
+  invalidate();
   // redraw();
 }
 
@@ -168,7 +168,7 @@ void VBar::setMinValue(int newValue)
   sortValues();
   m_currentValue = constrain(m_currentValue, m_config.minValue, m_config.maxValue);
   m_changedScale = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /** @brief Define o valor máximo para o widget VBar
@@ -181,7 +181,7 @@ void VBar::setMaxValue(int newValue)
   sortValues();
   m_currentValue = constrain(m_currentValue, m_config.minValue, m_config.maxValue);
   m_changedScale = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 void VBar::sortValues()
@@ -201,7 +201,7 @@ void VBar::setScale(int newMinValue, int newMaxValue)
   sortValues();
   m_currentValue = constrain(m_currentValue, m_config.minValue, m_config.maxValue);
   m_changedScale = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /** @brief Recupera o valor mínimo para o widget VBar
@@ -242,7 +242,7 @@ void VBar::start()
  */
 void VBar::forceUpdate()
 {
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -286,6 +286,7 @@ void VBar::setup(const VerticalBarConfig &config)
   }
   m_config = config;
   start();
+  setBounds(m_xPos, m_yPos, m_config.width, m_config.height);
   m_loaded = true;
   m_initialized = true;
 }
@@ -297,7 +298,7 @@ void VBar::setup(const VerticalBarConfig &config)
 void VBar::show()
 {
   m_visible = true;
-  m_shouldRedraw = true;
+  invalidate();
 }
 
 /**
@@ -307,5 +308,14 @@ void VBar::show()
 void VBar::hide()
 {
   m_visible = false;
-  m_shouldRedraw = true;
-}
\ No newline at end of file
+  invalidate();
+}
+
+/**
+ * @brief Desenha o VBar completo ao carregar a tela.
+ * @details Desenha o fundo estático; a parte dinâmica é desenhada no próximo frame.
+ */
+void VBar::fullRedraw() {
+  forceUpdate();
+  drawBackground();
+}
@@ -38,6 +38,7 @@ public:
   void setScale(int newMinValue, int newMaxValue);
   void redraw() override;
   void forceUpdate() override;
+  void fullRedraw() override;
   void drawBackground();
   void setup(const VerticalBarConfig& config);
   void show() override;
@@ -1,5 +1,8 @@
 #include "widgetbase.h"
 #include <esp_log.h>
+#if defined(DISP_DEFAULT)
+#include "../extras/gfxtextstate.h"
+#endif
 
 //#define DEBUG_TEXT_BOUND
 
@@ -10,6 +13,9 @@ uint8_t WidgetBase::currentScreen = 0;
 bool WidgetBase::showingLog = false;
 bool WidgetBase::lightMode = true;
 uint16_t WidgetBase::backgroundColor = 0xffff;
+TaskHandle_t WidgetBase::uiTask = nullptr;
+uint32_t WidgetBase::layoutRevision = 0;
+uint32_t WidgetBase::stackRevision = 0;
 #if defined(USING_GRAPHIC_LIB)
 const GFXfont *WidgetBase::fontNormal = nullptr;
 const GFXfont *WidgetBase::fontBold = nullptr;
@@ -18,6 +24,9 @@ QueueHandle_t WidgetBase::xFilaCallback;
 
 #if defined(DISP_DEFAULT)
 Arduino_GFX *WidgetBase::objTFT = nullptr;
+StripeCanvas *WidgetBase::stripeCanvas = nullptr;
+GlyphCache *WidgetBase::glyphCache = nullptr;
+TextMetricsCache *WidgetBase::textMetrics = nullptr;
 #elif defined(DISP_PCD8544)
 Adafruit_PCD8544 *WidgetBase::objTFT = nullptr;
 #elif defined(DISP_SSD1306)
@@ -35,6 +44,7 @@ functionLoadScreen_t WidgetBase::loadScreen = nullptr;
 #if defined(DFK_SD)
 fs::SDFS *WidgetBase::mySD = nullptr;
 #endif
+ImageCache *WidgetBase::imageCache = nullptr;
 
 /**
  * @brief Lightens a color by a given factor.
@@ -183,6 +193,11 @@ WidgetBase::WidgetBase(uint16_t _x, uint16_t _y, uint8_t _screen)
     , m_locked(false)
     , m_myTime(0)
     , m_callback(nullptr)
+    , m_bounds{0, 0, 0, 0}
+    , m_redrawPriority(RedrawPriority::NORMAL)
+    , m_zOrder(0)
+    , m_opaque(false)
+    , m_fullRedrawPending(false)
 {
     ESP_LOGD(TAG, "WidgetBase created at (%d, %d) on screen %d", _x, _y, _screen);
 }
@@ -240,6 +255,49 @@ void WidgetBase::onRelease() {
     ESP_LOGD(TAG, "Widget released at (%d, %d)", m_xPos, m_yPos);
 }
 
+/**
+ * @brief Draws the whole widget when its screen is loaded
+ * @details Default implementation forces an update and redraws. Widgets with a static
+ *          background drawn apart from the dynamic part override it.
+ */
+void WidgetBase::fullRedraw() {
+    forceUpdate();
+    redraw();
+}
+
+/**
+ * @brief Redraws the widget from the frame loop
+ * @details Called once per frame for every widget of the current screen. redraw() returns
+ *          early when the widget is not dirty.
+ */
+void WidgetBase::refresh() {
+    redraw();
+}
+
+/**
+ * @brief Tells if the widget takes part in the touch hit test
+ * @return false by default (output widgets)
+ */
+bool WidgetBase::isTouchable() const {
+    return false;
+}
+
+/**
+ * @brief Gets the area where detectTouch() may accept a touch
+ * @return The widget bounds by default. Widgets with a touch tolerance return a larger area.
+ * @details Used to index touchable widgets; a touch outside this area is never tested.
+ */
+Rect_t WidgetBase::getTouchBounds() const {
+    return m_bounds;
+}
+
+/**
+ * @brief Gets the screen index of the widget
+ */
+uint8_t WidgetBase::getScreen() const {
+    return m_screen;
+}
+
 /**
  * @brief Adds a callback to the callback queue
  * @param callback Callback to be added
@@ -256,6 +314,7 @@ void WidgetBase::addCallback(functionCB_t callback, CallbackOrigin origin){
         if(uxQueueSpacesAvailable(WidgetBase::xFilaCallback) > 0){
             if(xQueueSend(WidgetBase::xFilaCallback, &callback, pdMS_TO_TICKS(50)) == pdPASS){
                 ESP_LOGD(TAG, "Callback added to queue. Origin: %d", (int)origin);
+                requestFrame();
             }else{
                 ESP_LOGE(TAG, "Can't add callback. Queue send failed");
             }
@@ -269,6 +328,19 @@ void WidgetBase::addCallback(functionCB_t callback, CallbackOrigin origin){
 
 
 #if defined(USING_GRAPHIC_LIB)
+// True se cortar o texto em pos divide um caractere UTF-8 de uma fonte esparsa.
+static bool splitsCharacter(const char* texto, size_t pos)
+{
+#if defined(DISP_DEFAULT)
+  return (static_cast<uint8_t>(texto[pos]) & 0xC0) == 0x80 &&
+         SparseFontRenderer::find(GfxTextState::font(WidgetBase::objTFT)) != nullptr;
+#else
+  (void)texto;
+  (void)pos;
+  return false;
+#endif
+}
+
 int WidgetBase::getLastLettersForSpace(const char* textoCompleto, uint16_t width, uint16_t height,
                                        char* out, size_t outSize)
 {
@@ -284,23 +356,21 @@ int WidgetBase::getLastLettersForSpace(const char* textoCompleto, uint16_t width
     len++;
   }
 
-  int16_t x1, y1;
-  uint16_t w, h;
-
   // Testa do comprimento total até 1, pegando do final
   for (size_t testLen = len; testLen > 0; --testLen) {
     size_t startPos = len - testLen;
 
     if (testLen >= outSize) continue;
+    if (splitsCharacter(textoCompleto, startPos)) continue;
 
     for (size_t i = 0; i < testLen; ++i) {
       out[i] = textoCompleto[startPos + i];
     }
     out[testLen] = '\0';
 
-    objTFT->getTextBounds(out, 0, 0, &x1, &y1, &w, &h);
+    TextBound_t box = measureText(out, 0, 0);
 
-    if (w <= width && h <= height) {
+    if (box.width <= width && box.height <= height) {
       return (int)testLen;
     }
   }
@@ -325,21 +395,19 @@ int WidgetBase::getFirstLettersForSpace(const char* textoCompleto, uint16_t widt
     len++;
   }
 
-  int16_t x1, y1;
-  uint16_t w, h;
-
   // Testa do comprimento total até 1, pegando do início
   for (size_t testLen = len; testLen > 0; --testLen) {
     if (testLen >= outSize) continue;
+    if (splitsCharacter(textoCompleto, testLen)) continue;
 
     for (size_t i = 0; i < testLen; ++i) {
       out[i] = textoCompleto[i];
     }
     out[testLen] = '\0';
 
-    objTFT->getTextBounds(out, 0, 0, &x1, &y1, &w, &h);
+    TextBound_t box = measureText(out, 0, 0);
 
-    if (w <= width && h <= height) {
+    if (box.width <= width && box.height <= height) {
       return (int)testLen;
     }
   }
@@ -360,42 +428,9 @@ int WidgetBase::getFirstLettersForSpace(const char* textoCompleto, uint16_t widt
  */
 const GFXfont* WidgetBase::getBestFontForArea(const char* text, uint16_t width, uint16_t height, const GFXfont* const fonts[], size_t fontCount)
 {
-  if (!objTFT || !fonts || fontCount == 0) {
-    return nullptr;
-  }
-
-  // Se texto for nulo, considere como string vazia (largura/altura 0) -> primeira fonte serve.
-  if (!text) {
-    return fonts[0];
-  }
-
-  // Se string vazia, cabe em qualquer fonte -> retorne a primeira para evitar medições desnecessárias.
-  if (*text == '\0') {
-    return fonts[0];
-  }
-
-  // Varíaveis reutilizadas para evitar re-declarações em loop.
-  int16_t x1, y1;
-  uint16_t w, h;
-
-  // Tente cada fonte, na ordem.
-  for (size_t i = 0; i < fontCount; ++i) {
-    const GFXfont* f = fonts[i];
-    if (!f) {
-      continue; // ignora entradas nulas
-    }
-
-    objTFT->setFont(f);
-    // Posição de referência pode ser 0,0 pois o que importa é w e h
-    objTFT->getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
-
-    // Verifica se cabe.
-    if (w <= width && h <= height) {
-      return f; // primeira que couber
-    }
-  }
-
-  return nullptr; // nenhuma coube
+  // Medição feita com a tabela de glifos de cada fonte, sem setFont()/getTextBounds() no display.
+  // Listas ordenadas da maior para a menor fonte usam busca binária.
+  return FontMetrics::bestFit(text, width, height, fonts, fontCount);
 }
 
 /**
@@ -480,11 +515,10 @@ void WidgetBase::printText(const char* _texto, uint16_t _x, uint16_t _y, uint8_t
     //int ox = _x, oy = _y;
     WidgetBase::recalculateTextPosition(_texto, &_x, &_y, _datum);
 
-    TextBound_t areaAux;
-    objTFT->getTextBounds(_texto, _x, _y, &areaAux.x, &areaAux.y, &areaAux.width, &areaAux.height);
+    TextBound_t areaAux = measureText(_texto, _x, _y);
 
     objTFT->setCursor(_x, _y);
-    objTFT->print(_texto);
+    writeText(_texto);
 
     #ifdef DEBUG_TEXT_BOUND
         objTFT->drawRect(areaAux.x, areaAux.y, areaAux.width, areaAux.height, CFK_FUCHSIA);
@@ -508,8 +542,7 @@ void WidgetBase::printText(const char* _texto, uint16_t _x, uint16_t _y, uint8_t
     //int ox = _x, oy = _y;
     WidgetBase::recalculateTextPosition(_texto, &_x, &_y, _datum);
 
-    TextBound_t areaAux;
-    objTFT->getTextBounds(_texto, _x, _y, &areaAux.x, &areaAux.y, &areaAux.width, &areaAux.height);
+    TextBound_t areaAux = measureText(_texto, _x, _y);
 
     lastTextBoud.x = areaAux.x;
     lastTextBoud.y = areaAux.y;
@@ -517,7 +550,7 @@ void WidgetBase::printText(const char* _texto, uint16_t _x, uint16_t _y, uint8_t
     lastTextBoud.height = areaAux.height;
 
     objTFT->setCursor(_x, _y);
-    objTFT->print(_texto);
+    writeText(_texto);
 
     #ifdef DEBUG_TEXT_BOUND
         objTFT->drawRect(lastTextBoud.x, lastTextBoud.y, lastTextBoud.width, lastTextBoud.height, CFK_DEEPPINK);
@@ -527,6 +560,481 @@ void WidgetBase::printText(const char* _texto, uint16_t _x, uint16_t _y, uint8_t
 
 }
 
+/**
+ * @brief Prints text replacing the previous one without flicker.
+ * @param _texto Text to print.
+ * @param _x X position of the text.
+ * @param _y Y position of the text.
+ * @param _datum Datum of the text.
+ * @param lastTextBoud Reference to the last text bounds (updated with the new bounds).
+ * @param _colorPadding Color of the padding.
+ * @param _font Font used to print the text.
+ * @param _colorText Color of the text.
+ * @param _size Text size multiplier.
+ * @details When the stripe canvas is enabled, the union of the old and new text areas is
+ *          composed off-screen and sent to the display in one block per stripe, so the old
+ *          text is never erased on the panel before the new one appears. Without the canvas
+ *          (or if the area does not fit) it falls back to the erase-then-print path.
+ */
+void WidgetBase::printText(const char* _texto, uint16_t _x, uint16_t _y, uint8_t _datum, TextBound_t &lastTextBoud, uint16_t _colorPadding, const GFXfont* _font, uint16_t _colorText, uint8_t _size){
+    objTFT->setFont(_font);
+    objTFT->setTextSize(_size);
+    objTFT->setTextColor(_colorText);
+
+#if defined(DISP_DEFAULT)
+    uint16_t px = _x, py = _y;
+    objTFT->setTextWrap(false);
+    WidgetBase::recalculateTextPosition(_texto, &px, &py, _datum);
+
+    TextBound_t areaAux = measureText(_texto, px, py);
+
+    int32_t x0 = areaAux.x, y0 = areaAux.y;
+    int32_t x1 = areaAux.x + areaAux.width, y1 = areaAux.y + areaAux.height;
+    if (lastTextBoud.width > 0 && lastTextBoud.height > 0) {
+        if (areaAux.width == 0 || areaAux.height == 0) {
+            x0 = lastTextBoud.x; y0 = lastTextBoud.y;
+            x1 = lastTextBoud.x + lastTextBoud.width; y1 = lastTextBoud.y + lastTextBoud.height;
+        } else {
+            x0 = min(x0, (int32_t)lastTextBoud.x);
+            y0 = min(y0, (int32_t)lastTextBoud.y);
+            x1 = max(x1, (int32_t)(lastTextBoud.x + lastTextBoud.width));
+            y1 = max(y1, (int32_t)(lastTextBoud.y + lastTextBoud.height));
+        }
+    }
+    if (x0 < 0) { x0 = 0; }
+    if (y0 < 0) { y0 = 0; }
+
+    OffscreenPass_t pass;
+    Rect_t area = {static_cast<uint16_t>(x0), static_cast<uint16_t>(y0),
+                   static_cast<uint16_t>(x1 > x0 ? x1 - x0 : 0), static_cast<uint16_t>(y1 > y0 ? y1 - y0 : 0)};
+    if (beginOffscreen(area, _colorPadding, pass)) {
+        do {
+            // objTFT now points to the canvas, which has its own text state
+            objTFT->setFont(_font);
+            objTFT->setTextSize(_size);
+            objTFT->setTextColor(_colorText);
+            objTFT->setTextWrap(false);
+            objTFT->setCursor(px, py);
+            writeText(_texto);
+        } while (nextOffscreenStripe(pass));
+
+        lastTextBoud = areaAux;
+        return;
+    }
+#endif
+
+    printText(_texto, _x, _y, _datum, lastTextBoud, _colorPadding);
+}
+
+#if defined(DISP_DEFAULT)
+/**
+ * @brief Prints text with an anti-aliased font, replacing the previous one.
+ * @param _texto Text to print.
+ * @param _x X position of the text.
+ * @param _y Y position of the text.
+ * @param _datum Datum of the text.
+ * @param lastTextBoud Reference to the last text bounds (updated with the new bounds).
+ * @param _colorPadding Background color; the glyph edges are blended against it.
+ * @param _font Anti-aliased font.
+ * @param _colorText Color of the text.
+ * @details Composed off-screen like the GFXfont version when the stripe canvas is enabled.
+ */
+void WidgetBase::printAAText(const char* _texto, uint16_t _x, uint16_t _y, uint8_t _datum, TextBound_t &lastTextBoud, uint16_t _colorPadding, const AAFont* _font, uint16_t _colorText){
+    if (!_font || !_texto) {
+        return;
+    }
+    alignToDatum(AAFontRenderer::getTextBounds(_font, _texto, 0, 0), &_x, &_y, _datum);
+    TextBound_t areaAux = AAFontRenderer::getTextBounds(_font, _texto, _x, _y);
+
+    int32_t x0 = areaAux.x, y0 = areaAux.y;
+    int32_t x1 = areaAux.x + areaAux.width, y1 = areaAux.y + areaAux.height;
+    if (lastTextBoud.width > 0 && lastTextBoud.height > 0) {
+        if (areaAux.width == 0 || areaAux.height == 0) {
+            x0 = lastTextBoud.x; y0 = lastTextBoud.y;
+            x1 = lastTextBoud.x + lastTextBoud.width; y1 = lastTextBoud.y + lastTextBoud.height;
+        } else {
+            x0 = min(x0, (int32_t)lastTextBoud.x);
+            y0 = min(y0, (int32_t)lastTextBoud.y);
+            x1 = max(x1, (int32_t)(lastTextBoud.x + lastTextBoud.width));
+            y1 = max(y1, (int32_t)(lastTextBoud.y + lastTextBoud.height));
+        }
+    }
+    if (x0 < 0) { x0 = 0; }
+    if (y0 < 0) { y0 = 0; }
+
+    OffscreenPass_t pass;
+    Rect_t area = {static_cast<uint16_t>(x0), static_cast<uint16_t>(y0),
+                   static_cast<uint16_t>(x1 > x0 ? x1 - x0 : 0), static_cast<uint16_t>(y1 > y0 ? y1 - y0 : 0)};
+    if (beginOffscreen(area, _colorPadding, pass)) {
+        do {
+            AAFontRenderer::drawText(objTFT, _font, _x, _y, _texto, _colorText, _colorPadding);
+        } while (nextOffscreenStripe(pass));
+    } else {
+        objTFT->fillRect(lastTextBoud.x, lastTextBoud.y, lastTextBoud.width, lastTextBoud.height, _colorPadding);
+        AAFontRenderer::drawText(objTFT, _font, _x, _y, _texto, _colorText, _colorPadding);
+    }
+    lastTextBoud = areaAux;
+
+    #ifdef DEBUG_TEXT_BOUND
+        objTFT->drawRect(lastTextBoud.x, lastTextBoud.y, lastTextBoud.width, lastTextBoud.height, CFK_DEEPPINK);
+    #endif
+}
+
+/**
+ * @brief Prints text as seven-segment digits, repainting only the segments that changed.
+ * @param _texto Text to print.
+ * @param _x X position of the text.
+ * @param _y Y position of the text.
+ * @param _datum Datum of the text.
+ * @param lastTextBoud Reference to the last text bounds (updated with the new bounds).
+ * @param _colorPadding Color behind the text.
+ * @param _style Size and look of the digits.
+ * @param _colorText Color of the lit segments.
+ * @param drawn State of the text on the panel, kept by the widget (its font is left nullptr).
+ * @details When the new string has the cells of the drawn one at the same position, with the
+ *          same colors and style (pointer and values, offColor included), only the segments
+ *          that turned on or off are painted, straight on the display. Otherwise the old box is cleared and the string is drawn in full,
+ *          composed off-screen when the stripe canvas is enabled.
+ */
+void WidgetBase::printSevenSegment(const char* _texto, uint16_t _x, uint16_t _y, uint8_t _datum, TextBound_t &lastTextBoud, uint16_t _colorPadding, const SevenSegmentStyle_t* _style, uint16_t _colorText, DrawnText_t &drawn){
+    if (!_style || !_texto) {
+        return;
+    }
+    alignToDatum(SevenSegmentRenderer::getTextBounds(_style, _texto, 0, 0), &_x, &_y, _datum);
+    TextBound_t areaAux = SevenSegmentRenderer::getTextBounds(_style, _texto, _x, _y);
+    const size_t len = strlen(_texto);
+
+    if (drawn.valid && !drawn.font && drawn.style == _style && SevenSegmentRenderer::sameStyle(&drawn.styleValues, _style) &&
+        drawn.x == static_cast<int16_t>(_x) && drawn.y == static_cast<int16_t>(_y) &&
+        drawn.color == _colorText && drawn.background == _colorPadding &&
+        len <= DFK_TEXT_DIFF_MAX_LEN && SevenSegmentRenderer::sameLayout(drawn.text, _texto)) {
+        SevenSegmentRenderer::drawChanges(objTFT, _style, _x, _y, drawn.text, _texto, _colorText);
+        memcpy(drawn.text, _texto, len + 1);
+        lastTextBoud = areaAux;
+        return;
+    }
+
+    int32_t x0 = areaAux.x, y0 = areaAux.y;
+    int32_t x1 = areaAux.x + areaAux.width, y1 = areaAux.y + areaAux.height;
+    if (lastTextBoud.width > 0 && lastTextBoud.height > 0) {
+        if (areaAux.width == 0 || areaAux.height == 0) {
+            x0 = lastTextBoud.x; y0 = lastTextBoud.y;
+            x1 = lastTextBoud.x + lastTextBoud.width; y1 = lastTextBoud.y + lastTextBoud.height;
+        } else {
+            x0 = min(x0, (int32_t)lastTextBoud.x);
+            y0 = min(y0, (int32_t)lastTextBoud.y);
+            x1 = max(x1, (int32_t)(lastTextBoud.x + lastTextBoud.width));
+            y1 = max(y1, (int32_t)(lastTextBoud.y + lastTextBoud.height));
+        }
+    }
+    if (x0 < 0) { x0 = 0; }
+    if (y0 < 0) { y0 = 0; }
+
+    OffscreenPass_t pass;
+    Rect_t area = {static_cast<uint16_t>(x0), static_cast<uint16_t>(y0),
+                   static_cast<uint16_t>(x1 > x0 ? x1 - x0 : 0), static_cast<uint16_t>(y1 > y0 ? y1 - y0 : 0)};
+    if (beginOffscreen(area, _colorPadding, pass)) {
+        do {
+            SevenSegmentRenderer::drawText(objTFT, _style, _x, _y, _texto, _colorText, _colorPadding);
+        } while (nextOffscreenStripe(pass));
+    } else {
+        objTFT->fillRect(lastTextBoud.x, lastTextBoud.y, lastTextBoud.width, lastTextBoud.height, _colorPadding);
+        SevenSegmentRenderer::drawText(objTFT, _style, _x, _y, _texto, _colorText, _colorPadding);
+    }
+    lastTextBoud = areaAux;
+
+    drawn.valid = len <= DFK_TEXT_DIFF_MAX_LEN;
+    if (drawn.valid) {
+        memcpy(drawn.text, _texto, len + 1);
+        drawn.font = nullptr;
+        drawn.style = _style;
+        drawn.styleValues = *_style;
+        drawn.x = _x;
+        drawn.y = _y;
+        drawn.color = _colorText;
+        drawn.background = _colorPadding;
+        drawn.size = 1;
+    }
+}
+
+namespace {
+
+/// @brief Reads a string character by character; UTF-8 is decoded when the font is sparse.
+struct GlyphReader {
+    const GFXfont *font;
+    const SparseFont *sparse;
+    const char *p;
+
+    bool done() const { return *p == '\0'; }
+    uint16_t next() { return sparse ? SparseFontRenderer::decode(p) : static_cast<uint8_t>(*p++); }
+    const GFXglyph *glyph(uint16_t code) const { return SparseFontRenderer::glyph(font, sparse, code); }
+};
+
+/// @brief Cursor advance of a glyph in pixels (0 when the font has no glyph).
+int16_t glyphAdvance(const GFXglyph *glyph, uint8_t size) {
+    return glyph ? glyph->xAdvance * size : 0;
+}
+
+/// @brief Grows [x0, x1) x [y0, y1) by the box of a glyph drawn with the cursor at (x, y).
+void addGlyphBox(const GFXglyph *glyph, int32_t x, int32_t y, uint8_t size,
+                 int32_t &x0, int32_t &y0, int32_t &x1, int32_t &y1) {
+    if (!glyph || glyph->width == 0 || glyph->height == 0) {
+        return;
+    }
+    const int32_t gx = x + glyph->xOffset * size, gy = y + glyph->yOffset * size;
+    x0 = min(x0, gx);
+    y0 = min(y0, gy);
+    x1 = max(x1, gx + glyph->width * size);
+    y1 = max(y1, gy + glyph->height * size);
+}
+
+} // namespace
+
+/**
+ * @brief Prints text by repainting only the glyphs that changed since the last call.
+ * @param _texto Text to print.
+ * @param _x X position of the text.
+ * @param _y Y position of the text.
+ * @param _datum Datum of the text.
+ * @param lastTextBoud Reference to the last text bounds (updated with the new bounds).
+ * @param _colorPadding Color behind the text.
+ * @param _font Font used to print the text.
+ * @param _colorText Color of the text.
+ * @param _size Text size multiplier.
+ * @param drawn State of the text on the panel, kept by the widget.
+ * @return True if the text is on the panel; false if the caller must print it in full.
+ * @details Works when the new string keeps the layout of the drawn one: same font, colors,
+ *          cursor and number of characters, and every changed character has the advance of
+ *          the one it replaces (digits of most fonts are tabular). Each run of changed
+ *          characters is a cell covering the old and the new glyphs; the cell is cleared and
+ *          every glyph that touches it is printed again, composed off-screen when the stripe
+ *          canvas is enabled. When the layout changed, @p drawn is set to the new string and
+ *          false is returned, so the next call can diff against what the caller draws.
+ */
+bool WidgetBase::printTextDiff(const char* _texto, uint16_t _x, uint16_t _y, uint8_t _datum, TextBound_t &lastTextBoud, uint16_t _colorPadding, const GFXfont* _font, uint16_t _colorText, uint8_t _size, DrawnText_t &drawn){
+    objTFT->setFont(_font);
+    objTFT->setTextSize(_size);
+    objTFT->setTextColor(_colorText);
+    objTFT->setTextWrap(false);
+    uint16_t px = _x, py = _y;
+    WidgetBase::recalculateTextPosition(_texto, &px, &py, _datum);
+
+    const size_t len = strlen(_texto);
+    const SparseFont *sparse = SparseFontRenderer::find(_font);
+    // UTF-8 characters of the same advance may differ in bytes, so the length is checked here too
+    bool sameLayout = drawn.valid && _font && len <= DFK_TEXT_DIFF_MAX_LEN && drawn.font == _font && drawn.size == _size &&
+                      drawn.color == _colorText && drawn.background == _colorPadding &&
+                      drawn.x == static_cast<int16_t>(px) && drawn.y == static_cast<int16_t>(py);
+    GlyphReader oldText = {_font, sparse, drawn.text};
+    GlyphReader newText = {_font, sparse, _texto};
+    while (sameLayout && !(oldText.done() && newText.done())) {
+        if (oldText.done() || newText.done()) {
+            sameLayout = false;
+            break;
+        }
+        const uint16_t a = oldText.next(), b = newText.next();
+        sameLayout = a != '\n' && b != '\n' &&
+                     (a == b || glyphAdvance(oldText.glyph(a), _size) == glyphAdvance(newText.glyph(b), _size));
+    }
+    if (!sameLayout) {
+        drawn.valid = _font && len <= DFK_TEXT_DIFF_MAX_LEN;
+        if (drawn.valid) {
+            memcpy(drawn.text, _texto, len + 1);
+            drawn.font = _font;
+            drawn.style = nullptr;
+            drawn.x = px;
+            drawn.y = py;
+            drawn.color = _colorText;
+            drawn.background = _colorPadding;
+            drawn.size = _size;
+        }
+        return false;
+    }
+
+    // Prints every glyph of the new string whose box touches [x0, x1) x [y0, y1)
+    auto printGlyphsIn = [&](int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+        char glyph[5];
+        int32_t gx = px;
+        GlyphReader reader = {_font, sparse, _texto};
+        while (!reader.done()) {
+            const char *start = reader.p;
+            const GFXglyph *g = reader.glyph(reader.next());
+            int32_t bx0 = INT32_MAX, by0 = INT32_MAX, bx1 = INT32_MIN, by1 = INT32_MIN;
+            addGlyphBox(g, gx, py, _size, bx0, by0, bx1, by1);
+            if (bx0 < x1 && bx1 > x0 && by0 < y1 && by1 > y0) {
+                const size_t bytes = reader.p - start;
+                memcpy(glyph, start, bytes);
+                glyph[bytes] = '\0';
+                objTFT->setCursor(gx, py);
+                writeText(glyph);
+            }
+            gx += glyphAdvance(g, _size);
+        }
+    };
+
+    int32_t cursor = px;
+    oldText.p = drawn.text;
+    newText.p = _texto;
+    while (!newText.done()) {
+        const uint16_t a = oldText.next(), b = newText.next();
+        if (a == b) {
+            cursor += glyphAdvance(newText.glyph(b), _size);
+            continue;
+        }
+        int32_t x0 = INT32_MAX, y0 = INT32_MAX, x1 = INT32_MIN, y1 = INT32_MIN;
+        addGlyphBox(oldText.glyph(a), cursor, py, _size, x0, y0, x1, y1);
+        addGlyphBox(newText.glyph(b), cursor, py, _size, x0, y0, x1, y1);
+        cursor += glyphAdvance(newText.glyph(b), _size);
+        // Extends the cell over the following changed characters
+        while (!newText.done()) {
+            GlyphReader oldNext = oldText, newNext = newText;
+            const uint16_t c = oldNext.next(), d = newNext.next();
+            if (c == d) {
+                break;
+            }
+            oldText = oldNext;
+            newText = newNext;
+            addGlyphBox(oldText.glyph(c), cursor, py, _size, x0, y0, x1, y1);
+            addGlyphBox(newText.glyph(d), cursor, py, _size, x0, y0, x1, y1);
+            cursor += glyphAdvance(newText.glyph(d), _size);
+        }
+        if (x0 < 0) { x0 = 0; }
+        if (y0 < 0) { y0 = 0; }
+        if (x1 <= x0 || y1 <= y0) {
+            continue;
+        }
+
+        OffscreenPass_t pass;
+        Rect_t area = {static_cast<uint16_t>(x0), static_cast<uint16_t>(y0),
+                       static_cast<uint16_t>(x1 - x0), static_cast<uint16_t>(y1 - y0)};
+        if (beginOffscreen(area, _colorPadding, pass)) {
+            do {
+                objTFT->setFont(_font);
+                objTFT->setTextSize(_size);
+                objTFT->setTextColor(_colorText);
+                objTFT->setTextWrap(false);
+                printGlyphsIn(x0, y0, x1, y1);
+            } while (nextOffscreenStripe(pass));
+        } else {
+            objTFT->fillRect(area.x, area.y, area.width, area.height, _colorPadding);
+            printGlyphsIn(x0, y0, x1, y1);
+        }
+    }
+
+    memcpy(drawn.text, _texto, len + 1);
+    lastTextBoud = measureText(_texto, px, py);
+    return true;
+}
+#endif
+
+/**
+ * @brief Prints text at the current cursor of objTFT.
+ * @param _texto Text to print.
+ * @details Uses the glyph cache when it is enabled and supports the current text state;
+ *          otherwise the text is printed by Arduino_GFX. Compressed fonts are decoded by
+ *          CompressedFont, since Arduino_GFX can't read their bitmaps, and UTF-8 text in a
+ *          sparse font is printed by SparseFontRenderer.
+ */
+void WidgetBase::writeText(const char* _texto){
+#if defined(DISP_DEFAULT)
+    if (SparseFontRenderer::print(objTFT, _texto)) {
+        return;
+    }
+    if (glyphCache && glyphCache->print(objTFT, _texto)) {
+        return;
+    }
+    if (CompressedFont::print(objTFT, _texto)) {
+        return;
+    }
+#endif
+    objTFT->print(_texto);
+}
+
+/**
+ * @brief Gets the bounding box of a text printed at a position with the current font of objTFT.
+ * @param _texto Text to measure.
+ * @param _x X position of the cursor.
+ * @param _y Y position of the cursor.
+ * @return Same result as objTFT->getTextBounds(), served by the text metrics cache when it is enabled.
+ *         UTF-8 text in a sparse font is measured by SparseFontRenderer.
+ */
+TextBound_t WidgetBase::measureText(const char* _texto, int16_t _x, int16_t _y){
+    TextBound_t area = {_x, _y, 0, 0};
+#if defined(DISP_DEFAULT)
+    if (SparseFontRenderer::getTextBounds(objTFT, _texto, _x, _y, area)) {
+        return area;
+    }
+    if (textMetrics) {
+        return textMetrics->bounds(objTFT, _texto, _x, _y);
+    }
+#endif
+    objTFT->getTextBounds(_texto, _x, _y, &area.x, &area.y, &area.width, &area.height);
+    return area;
+}
+
+/**
+ * @brief Starts an off-screen pass over an area.
+ * @param area Area to compose, in screen coordinates.
+ * @param fillColor Color used to clear each stripe.
+ * @param pass Pass state, filled by this method.
+ * @return true if objTFT now points to the stripe canvas. In that case the caller must draw
+ *         the area and call nextOffscreenStripe() until it returns false.
+ * @details Returns false (and nothing changes) when the canvas is disabled, already in use or
+ *          too small for one row of the area. The caller then draws directly on the display.
+ */
+bool WidgetBase::beginOffscreen(const Rect_t &area, uint16_t fillColor, OffscreenPass_t &pass){
+    if (!stripeCanvas || !stripeCanvas->isReady() || !objTFT || objTFT == stripeCanvas) {
+        return false;
+    }
+
+    int32_t width = area.width;
+    int32_t height = area.height;
+    if (area.x + width > objTFT->width()) { width = objTFT->width() - area.x; }
+    if (area.y + height > objTFT->height()) { height = objTFT->height() - area.y; }
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    uint16_t rows = stripeCanvas->rowsFor(width);
+    if (rows == 0) {
+        return false;
+    }
+
+    pass.output = objTFT;
+    pass.area = {area.x, area.y, static_cast<uint16_t>(width), static_cast<uint16_t>(height)};
+    pass.rows = rows;
+    pass.fillColor = fillColor;
+    pass.nextRow = min(rows, pass.area.height);
+
+    Rect_t stripe = {pass.area.x, pass.area.y, pass.area.width, pass.nextRow};
+    stripeCanvas->setWindow(stripe);
+    stripeCanvas->clearWindow(fillColor);
+    objTFT = stripeCanvas;
+    return true;
+}
+
+/**
+ * @brief Sends the current stripe to the display and prepares the next one.
+ * @param pass Pass state created by beginOffscreen().
+ * @return true if there is another stripe to draw, false when the pass is finished
+ *         (objTFT is restored to the real display).
+ */
+bool WidgetBase::nextOffscreenStripe(OffscreenPass_t &pass){
+    stripeCanvas->pushTo(pass.output);
+
+    if (pass.nextRow >= pass.area.height) {
+        objTFT = pass.output;
+        return false;
+    }
+
+    uint16_t rows = min(pass.rows, static_cast<uint16_t>(pass.area.height - pass.nextRow));
+    Rect_t stripe = {pass.area.x, static_cast<uint16_t>(pass.area.y + pass.nextRow), pass.area.width, rows};
+    pass.nextRow += rows;
+    stripeCanvas->setWindow(stripe);
+    stripeCanvas->clearWindow(pass.fillColor);
+    return true;
+}
+
 /**
  * @brief Recalculates the position of text on the screen.
  * @param _texto Text to recalculate position for.
@@ -589,9 +1097,18 @@ void WidgetBase::recalculateTextPosition(const char *_texto, uint16_t *_x, uint1
     *_x += xOffset;
     *_y += yOffset;*/
     // Pega a área real ocupada pelo texto
-    TextBound_t a;
-    objTFT->getTextBounds(_texto, 0, 0, &a.x, &a.y, &a.width, &a.height);
+    alignToDatum(measureText(_texto, 0, 0), _x, _y, _datum);
+}
 
+/**
+ * @brief Moves a cursor position so that a text box lands on a datum.
+ * @param a Box of the text measured with the cursor at (0, 0).
+ * @param _x X of the datum; replaced by the cursor X.
+ * @param _y Y of the datum; replaced by the cursor Y (baseline).
+ * @param _datum Datum of the text.
+ */
+void WidgetBase::alignToDatum(const TextBound_t &a, uint16_t *_x, uint16_t *_y, uint8_t _datum)
+{
     int16_t xo = *_x; 
     int16_t yo = *_y;
 
@@ -643,9 +1160,7 @@ void WidgetBase::recalculateTextPosition(const char *_texto, uint16_t *_x, uint1
  */
 TextBound_t WidgetBase::getTextBounds(const char *str, int16_t x, int16_t y)
 {
-    TextBound_t retorno;
-    WidgetBase::objTFT->getTextBounds(str, x, y, &retorno.x, &retorno.y, &retorno.width, &retorno.height);
-    return retorno;
+    return measureText(str, x, y);
 }
 
 /**
@@ -658,10 +1173,21 @@ TextBound_t WidgetBase::getTextBounds(const char *str, int16_t x, int16_t y)
  * @param pivotY The Y position of the pivot.
  * @param drawX The X position to draw the image.
  * @param drawY The Y position to draw the image.
+ * @details The pivot stays at (drawX + pivotX, drawY + pivotY). On RGB565 displays the image is
+ *          rotated by ImageRotator, without keeping the result.
  */
 void WidgetBase::drawRotatedImageOptimized(uint16_t *image, int16_t width, int16_t height, float angle, int16_t pivotX, int16_t pivotY, int16_t drawX, int16_t drawY)
 {
     log_d("Drawing image with  %i x %i and angle %f at pos %i x %i", width, height, angle, drawX, drawY);
+#if defined(DISP_DEFAULT)
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    ImageRotator rotator(false);
+    objTFT->startWrite();
+    rotator.draw(objTFT, image, nullptr, width, height, angle, pivotX, pivotY, drawX + pivotX, drawY + pivotY);
+    objTFT->endWrite();
+#else
     // Converte o ângulo para radianos
     float radians = angle * DEG_TO_RAD;
 
@@ -692,6 +1218,7 @@ void WidgetBase::drawRotatedImageOptimized(uint16_t *image, int16_t width, int16
         }
     }
     objTFT->endWrite();  // Termina a transação de escrita
+#endif
 }
 
 /**
@@ -718,10 +1245,165 @@ bool WidgetBase::isEnabled() const {
 
 void WidgetBase::setEnabled(bool enabled) {
     m_enabled = enabled;
-    m_shouldRedraw = true;
+    invalidate();
     ESP_LOGD(TAG, "Widget %s at (%d, %d)", enabled ? "enabled" : "disabled", m_xPos, m_yPos);
 }
 
+/**
+ * @brief Gets the screen area covered by the widget.
+ * @return Rectangle set by the widget in setup (and updated when its size changes).
+ */
+Rect_t WidgetBase::getBounds() const {
+    return m_bounds;
+}
+
+/**
+ * @brief Checks if the widget will paint on the next update cycle.
+ * @return True if the widget is loaded, visible and flagged for redraw.
+ */
+bool WidgetBase::needsRedraw() const {
+    return m_loaded && m_visible && m_shouldRedraw;
+}
+
+/**
+ * @brief Wakes the UI task so it runs a frame.
+ * @details Does nothing until the UI task is created. Notifications are counted, so a request
+ *          made while a frame is running is not lost.
+ */
+void WidgetBase::requestFrame() {
+    if (uiTask) {
+        xTaskNotifyGive(uiTask);
+    }
+}
+
+/**
+ * @brief Wakes the UI task from an interrupt (e.g. touch controller INT pin).
+ */
+void IRAM_ATTR WidgetBase::requestFrameFromISR() {
+    if (uiTask) {
+        BaseType_t higherPriorityWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(uiTask, &higherPriorityWoken);
+        if (higherPriorityWoken) {
+            portYIELD_FROM_ISR();
+        }
+    }
+}
+
+/**
+ * @brief Sets the redraw priority of the widget.
+ * @param priority RedrawPriority::DEFERRABLE lets the frame scheduler postpone the redraw
+ *                 to the next frame when the frame budget is spent.
+ */
+void WidgetBase::setRedrawPriority(RedrawPriority priority) {
+    m_redrawPriority = priority;
+}
+
+/**
+ * @brief Gets the redraw priority of the widget.
+ */
+RedrawPriority WidgetBase::getRedrawPriority() const {
+    return m_redrawPriority;
+}
+
+/**
+ * @brief Sets the layer of the widget inside its screen.
+ * @param zOrder Layer; widgets on higher layers are painted later (on top) and receive the
+ *               touch first. Widgets on the same layer keep the kind order, then the
+ *               registration order. Default is 0.
+ * @details The widget is repainted in full on the next frame so it shows on its new layer.
+ */
+void WidgetBase::setZOrder(int8_t zOrder) {
+    if (zOrder == m_zOrder) {
+        return;
+    }
+    m_zOrder = zOrder;
+    stackRevision++;
+    requestFullRedraw();
+}
+
+/**
+ * @brief Gets the layer of the widget inside its screen.
+ */
+int8_t WidgetBase::getZOrder() const {
+    return m_zOrder;
+}
+
+/**
+ * @brief Declares that the widget paints every pixel of its bounds.
+ * @param opaque True if nothing painted below the widget can show through it (e.g. an image
+ *               without transparency or a filled panel).
+ * @details Widgets completely covered by a visible opaque widget on top are not painted.
+ *          Opacity does not change what is repainted above: any widget that repaints makes
+ *          the widgets above it that overlap its area repaint too.
+ */
+void WidgetBase::setOpaque(bool opaque) {
+    m_opaque = opaque;
+}
+
+/**
+ * @brief Checks if the widget is currently hiding what is below it.
+ * @return True if the widget is opaque, loaded and visible.
+ */
+bool WidgetBase::isOpaque() const {
+    return m_opaque && m_loaded && m_visible;
+}
+
+/**
+ * @brief Asks for a complete redraw (background and content) on the next frame.
+ * @details Used when something painted over the widget, or when its first paint was skipped
+ *          because it was covered.
+ */
+void WidgetBase::requestFullRedraw() {
+    m_fullRedrawPending = true;
+    invalidate();
+}
+
+/**
+ * @brief Gets and clears the pending complete redraw request.
+ * @return True if requestFullRedraw() was called since the last paint.
+ */
+bool WidgetBase::takeFullRedraw() {
+    bool pending = m_fullRedrawPending;
+    m_fullRedrawPending = false;
+    return pending;
+}
+
+/**
+ * @brief Sets the screen area covered by the widget.
+ * @param x X coordinate of the top-left corner (negative values are clipped to 0).
+ * @param y Y coordinate of the top-left corner (negative values are clipped to 0).
+ * @param width Width of the area.
+ * @param height Height of the area.
+ */
+void WidgetBase::setBounds(int32_t x, int32_t y, int32_t width, int32_t height) {
+    Rect_t bounds = clipRect(x, y, width, height);
+    bool changed = (bounds.x != m_bounds.x) || (bounds.y != m_bounds.y) ||
+                   (bounds.width != m_bounds.width) || (bounds.height != m_bounds.height);
+    m_bounds = bounds;
+    if (changed && isTouchable()) {
+        // Touch indexes built from the old area are stale
+        layoutRevision++;
+    }
+}
+
+/**
+ * @brief Builds a rectangle from signed coordinates.
+ * @param x X coordinate of the top-left corner (negative values are clipped to 0).
+ * @param y Y coordinate of the top-left corner (negative values are clipped to 0).
+ * @param width Width of the area.
+ * @param height Height of the area.
+ * @return Rectangle inside the unsigned coordinate space; empty if nothing is left.
+ */
+Rect_t WidgetBase::clipRect(int32_t x, int32_t y, int32_t width, int32_t height) {
+    if (x < 0) { width += x; x = 0; }
+    if (y < 0) { height += y; y = 0; }
+    if (width < 0) { width = 0; }
+    if (height < 0) { height = 0; }
+    Rect_t r = {static_cast<uint16_t>(x), static_cast<uint16_t>(y),
+                static_cast<uint16_t>(width), static_cast<uint16_t>(height)};
+    return r;
+}
+
 bool WidgetBase::isValidState() const {
     return m_initialized && m_loaded && (objTFT != nullptr);
 }
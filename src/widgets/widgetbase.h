@@ -9,18 +9,31 @@
 #include "../user_setup.h"
 #include "../extras/baseTypes.h"
 #include "../extras/wutils.h"
+#include "../extras/imagecache.h"
 #include "widgetsetup.h"
 
 #include "../extras/color.h"
 
 #if defined(DISP_DEFAULT)
 #include <Arduino_GFX_Library.h>
+#include "../extras/stripecanvas.h"
+#include "../extras/glyphcache.h"
+#include "../extras/textmetrics.h"
+#include "../extras/fontmetrics.h"
+#include "../extras/aafont.h"
+#include "../extras/compressedfont.h"
+#include "../extras/textdiff.h"
+#include "../extras/sparsefont.h"
+#include "../extras/sevensegment.h"
+#include "../extras/imagerotator.h"
 #elif defined(DISP_PCD8544)
 #include <Adafruit_GFX.h>
 #include <Adafruit_PCD8544.h>
+#include "../extras/fontmetrics.h"
 #elif defined(DISP_SSD1306)
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include "../extras/fontmetrics.h"
 #elif defined(DISP_U8G2)
 #include <Arduino.h>
 #include <U8g2lib.h>
@@ -28,6 +41,10 @@
 #error "Unsupported display type"
 #endif
 
+#if defined(DFK_FONT_SUBSET) && defined(USING_GRAPHIC_LIB)
+#include "../fonts/subset/dfk_fonts.h"
+#endif
+
 #if defined(FONT_ROBOTO)
 #include "../fonts/RobotoRegular/RobotoRegular2pt7b.h"
 #include "../fonts/RobotoRegular/RobotoRegular3pt7b.h"
@@ -416,6 +433,11 @@ public:
   static bool lightMode;                   ///< True para modo claro, False para modo escuro.
   static functionLoadScreen_t loadScreen; ///< Ponteiro para a função que carrega a tela.
   static uint16_t backgroundColor;         ///< Cor de fundo para os widgets.
+  static TaskHandle_t uiTask;              ///< Task de desenho notificada quando há trabalho (nullptr = sem notificação).
+  static void requestFrame();
+  static void requestFrameFromISR();
+  static uint32_t layoutRevision;          ///< Incrementado quando a área de toque de um widget muda.
+  static uint32_t stackRevision;           ///< Incrementado quando o z-order de um widget muda.
   
 
   //static uint16_t lightenColor565(unsigned short color, float factor);
@@ -425,6 +447,9 @@ public:
 
 #if defined(DISP_DEFAULT)
   static Arduino_GFX *objTFT; ///< Ponteiro para o objeto de display Arduino GFX.
+  static StripeCanvas *stripeCanvas; ///< Buffer de faixa para composição fora da tela (nullptr = desenho direto).
+  static GlyphCache *glyphCache;     ///< Cache de glifos rasterizados (nullptr = desenho pelo Arduino_GFX).
+  static TextMetricsCache *textMetrics; ///< Cache de medidas de texto (nullptr = getTextBounds a cada chamada).
 #elif defined(DISP_PCD8544)
   static Adafruit_PCD8544 *objTFT; ///< Ponteiro para o objeto de display PCD8544.
 #elif defined(DISP_SSD1306)
@@ -438,6 +463,7 @@ public:
 #if defined(DFK_SD)
   static fs::SDFS *mySD; ///< Ponteiro para o sistema de arquivos SD.
 #endif
+  static ImageCache *imageCache; ///< Imagens decodificadas compartilhadas pelos widgets Image (nullptr = sem cache).
 
   WidgetBase(uint16_t _x, uint16_t _y, uint8_t _screen);
 
@@ -449,8 +475,13 @@ public:
   virtual void forceUpdate() = 0;
   virtual void redraw() = 0;
   virtual void onRelease();  ///< Called when touch is released or leaves widget area
+  virtual void fullRedraw(); ///< Desenha o widget completo (fundo e conteúdo) ao carregar a tela.
+  virtual void refresh();    ///< Redesenho chamado a cada frame pelo loop de atualização.
+  virtual bool isTouchable() const; ///< True se o widget participa do teste de toque.
+  virtual Rect_t getTouchBounds() const; ///< Área que detectTouch() pode aceitar.
   
   bool showingMyScreen();
+  uint8_t getScreen() const;
   
   // State management methods
   bool isInitialized() const;
@@ -463,9 +494,26 @@ public:
   void lock();
   void unlock();
   bool isLocked() const;
+
+  // Damage tracking methods
+  Rect_t getBounds() const;
+  bool needsRedraw() const;
+  void setRedrawPriority(RedrawPriority priority);
+  RedrawPriority getRedrawPriority() const;
+
+  // Stacking methods
+  void setZOrder(int8_t zOrder);
+  int8_t getZOrder() const;
+  void setOpaque(bool opaque);
+  bool isOpaque() const;
+  void requestFullRedraw();
+  bool takeFullRedraw();
   
 #if defined(USING_GRAPHIC_LIB)
   static void recalculateTextPosition(const char* _texto, uint16_t *_x, uint16_t *_y, uint8_t _datum);
+  static void alignToDatum(const TextBound_t &a, uint16_t *_x, uint16_t *_y, uint8_t _datum);
+  static void writeText(const char* _texto);
+  static TextBound_t measureText(const char* _texto, int16_t _x, int16_t _y);
   static void setFontNull() {if (WidgetBase::objTFT) WidgetBase::objTFT->setFont((GFXfont *)0);} ///< Sets the font to null.
   #endif
 
@@ -482,6 +530,11 @@ protected:
   bool m_locked;        ///< True se o widget está bloqueado (previne interação).
   unsigned long m_myTime;   ///< Timestamp para manipulação de funções relacionadas a tempo (debounce, etc).
   functionCB_t m_callback; ///< Função callback para executar quando o widget é clicado.
+  Rect_t m_bounds;          ///< Retângulo ocupado pelo widget na tela, usado no rastreamento de áreas sujas.
+  RedrawPriority m_redrawPriority; ///< Prioridade de redesenho usada pelo escalonador de frames.
+  int8_t m_zOrder;          ///< Camada do widget na tela; camadas maiores são desenhadas por cima.
+  bool m_opaque;            ///< True se o widget pinta todos os pixels de m_bounds.
+  bool m_fullRedrawPending; ///< True se o próximo redesenho deve ser completo (fundo e conteúdo).
 
 #if defined(USING_GRAPHIC_LIB)
   const GFXfont* getBestRobotoBold(uint16_t availableWidth, uint16_t availableHeight, const char* texto);
@@ -500,14 +553,33 @@ protected:
    */
   void setPressed(bool pressed);
 
+  void setBounds(int32_t x, int32_t y, int32_t width, int32_t height);
+  static Rect_t clipRect(int32_t x, int32_t y, int32_t width, int32_t height);
+
+  /**
+   * @brief Marks the widget for redraw and wakes the UI task.
+   */
+  void invalidate() { m_shouldRedraw = true; requestFrame(); }
+
 #if defined(USING_GRAPHIC_LIB)
   void printText(const char* _texto, uint16_t _x, uint16_t _y, uint8_t _datum, TextBound_t &lastTextBoud, uint16_t _colorPadding);
+  void printText(const char* _texto, uint16_t _x, uint16_t _y, uint8_t _datum, TextBound_t &lastTextBoud, uint16_t _colorPadding, const GFXfont* _font, uint16_t _colorText, uint8_t _size = 1);
   void printText(const char* _texto, uint16_t _x, uint16_t _y, uint8_t _datum);
+#if defined(DISP_DEFAULT)
+  void printAAText(const char* _texto, uint16_t _x, uint16_t _y, uint8_t _datum, TextBound_t &lastTextBoud, uint16_t _colorPadding, const AAFont* _font, uint16_t _colorText);
+  bool printTextDiff(const char* _texto, uint16_t _x, uint16_t _y, uint8_t _datum, TextBound_t &lastTextBoud, uint16_t _colorPadding, const GFXfont* _font, uint16_t _colorText, uint8_t _size, DrawnText_t &drawn);
+  void printSevenSegment(const char* _texto, uint16_t _x, uint16_t _y, uint8_t _datum, TextBound_t &lastTextBoud, uint16_t _colorPadding, const SevenSegmentStyle_t* _style, uint16_t _colorText, DrawnText_t &drawn);
+#endif
   TextBound_t getTextBounds(const char* str, int16_t x, int16_t y);
   void drawRotatedImageOptimized(uint16_t *image, int16_t width, int16_t height, float angle, int16_t pivotX, int16_t pivotY, int16_t drawX, int16_t drawY);
 #endif
 
   void showOrigin(uint16_t color);
+
+#if defined(DISP_DEFAULT)
+  static bool beginOffscreen(const Rect_t &area, uint16_t fillColor, OffscreenPass_t &pass);
+  static bool nextOffscreenStripe(OffscreenPass_t &pass);
+#endif
 };
 
 //#endif
\ No newline at end of file
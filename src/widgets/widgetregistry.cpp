@@ -0,0 +1,189 @@
+// widgetregistry.cpp
+#include "widgetregistry.h"
+#include <esp_log.h>
+#include <new>
+
+const char *WidgetRegistry::TAG = "WidgetRegistry";
+
+/**
+ * @brief Default constructor. Creates an empty registry.
+ */
+WidgetRegistry::WidgetRegistry()
+    : m_widgets(nullptr), m_types(nullptr), m_count(0), m_capacity(0), m_revision(0), m_screenStart{}
+{
+}
+
+/**
+ * @brief Destructor. Frees the arrays (the widgets are owned by the user).
+ */
+WidgetRegistry::~WidgetRegistry() {
+    delete[] m_widgets;
+    delete[] m_types;
+}
+
+/**
+ * @brief Registers a widget.
+ * @param widget Widget to add.
+ * @param type Kind of the widget, defines its paint order inside the screen.
+ * @return false if the widget is null, already registered or there is no memory.
+ */
+bool WidgetRegistry::add(WidgetBase *widget, WidgetType type) {
+    if (!widget) {
+        ESP_LOGE(TAG, "Null widget");
+        return false;
+    }
+    if (contains(widget)) {
+        ESP_LOGW(TAG, "Widget already registered");
+        return false;
+    }
+    if (m_count == UINT16_MAX || !reserve(m_count + 1)) {
+        ESP_LOGE(TAG, "Can't register more widgets (%u)", m_count);
+        return false;
+    }
+
+    // Insert after every entry with a smaller or equal (screen, layer, type) key
+    uint8_t screen = widget->getScreen();
+    uint16_t pos = m_screenStart[screen + 1];
+    while (pos > m_screenStart[screen] && paintsAfter(m_widgets[pos - 1], m_types[pos - 1], widget, type)) {
+        pos--;
+    }
+    for (uint16_t i = m_count; i > pos; i--) {
+        m_widgets[i] = m_widgets[i - 1];
+        m_types[i] = m_types[i - 1];
+    }
+    m_widgets[pos] = widget;
+    m_types[pos] = type;
+    m_count++;
+    m_revision++;
+    rebuildScreenTable();
+    return true;
+}
+
+/**
+ * @brief Sorts the widgets again after their layers changed.
+ * @details Stable insertion sort, so widgets with the same key keep their registration order.
+ *          The arrays are almost sorted when only a few layers changed, which keeps it close
+ *          to O(n).
+ */
+void WidgetRegistry::sort() {
+    for (uint16_t i = 1; i < m_count; i++) {
+        WidgetBase *widget = m_widgets[i];
+        WidgetType type = m_types[i];
+        uint16_t pos = i;
+        while (pos > 0 && (m_widgets[pos - 1]->getScreen() > widget->getScreen() ||
+                           (m_widgets[pos - 1]->getScreen() == widget->getScreen() &&
+                            paintsAfter(m_widgets[pos - 1], m_types[pos - 1], widget, type)))) {
+            m_widgets[pos] = m_widgets[pos - 1];
+            m_types[pos] = m_types[pos - 1];
+            pos--;
+        }
+        m_widgets[pos] = widget;
+        m_types[pos] = type;
+    }
+    m_revision++;
+    rebuildScreenTable();
+}
+
+/**
+ * @brief Checks if a widget is registered.
+ */
+bool WidgetRegistry::contains(const WidgetBase *widget) const {
+    for (uint16_t i = 0; i < m_count; i++) {
+        if (m_widgets[i] == widget) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Removes every widget. The allocated arrays are kept for reuse.
+ */
+void WidgetRegistry::clear() {
+    m_count = 0;
+    m_revision++;
+    rebuildScreenTable();
+}
+
+/**
+ * @brief Gets the number of registered widgets on all screens.
+ */
+uint16_t WidgetRegistry::size() const {
+    return m_count;
+}
+
+/**
+ * @brief Gets a counter that changes whenever the registered widgets change.
+ * @details Used to invalidate data derived from the spans, like the hit-test grid.
+ */
+uint32_t WidgetRegistry::revision() const {
+    return m_revision;
+}
+
+/**
+ * @brief Gets the widgets of a screen.
+ * @param screen Screen index.
+ * @return Span in paint order. count is 0 if the screen has no widgets.
+ */
+WidgetSpan_t WidgetRegistry::onScreen(uint8_t screen) const {
+    uint16_t first = m_screenStart[screen];
+    WidgetSpan_t span = {m_widgets + first, m_types + first,
+                         static_cast<uint16_t>(m_screenStart[screen + 1] - first)};
+    return span;
+}
+
+/**
+ * @brief Grows the arrays to hold at least the given number of entries.
+ * @param needed Number of entries required.
+ * @return false if the memory could not be allocated (the old arrays are kept).
+ */
+bool WidgetRegistry::reserve(uint16_t needed) {
+    if (needed <= m_capacity) {
+        return true;
+    }
+    uint32_t grown = m_capacity ? static_cast<uint32_t>(m_capacity) * 2 : 16;
+    if (grown < needed) { grown = needed; }
+    if (grown > UINT16_MAX) { grown = UINT16_MAX; }
+
+    WidgetBase **widgets = new (std::nothrow) WidgetBase *[grown];
+    WidgetType *types = new (std::nothrow) WidgetType[grown];
+    if (!widgets || !types) {
+        delete[] widgets;
+        delete[] types;
+        return false;
+    }
+    for (uint16_t i = 0; i < m_count; i++) {
+        widgets[i] = m_widgets[i];
+        types[i] = m_types[i];
+    }
+    delete[] m_widgets;
+    delete[] m_types;
+    m_widgets = widgets;
+    m_types = types;
+    m_capacity = static_cast<uint16_t>(grown);
+    return true;
+}
+
+/**
+ * @brief Compares the paint order of two widgets of the same screen.
+ * @return True if widget a must be painted after widget b.
+ */
+bool WidgetRegistry::paintsAfter(const WidgetBase *a, WidgetType typeA, const WidgetBase *b, WidgetType typeB) {
+    if (a->getZOrder() != b->getZOrder()) {
+        return a->getZOrder() > b->getZOrder();
+    }
+    return typeA > typeB;
+}
+
+/**
+ * @brief Recomputes the first index of each screen from the sorted arrays.
+ */
+void WidgetRegistry::rebuildScreenTable() {
+    uint16_t index = 0;
+    for (uint16_t screen = 0; screen <= SCREEN_SLOTS; screen++) {
+        while (index < m_count && m_widgets[index]->getScreen() < screen) {
+            index++;
+        }
+        m_screenStart[screen] = index;
+    }
+}
@@ -0,0 +1,82 @@
+// widgetregistry.h
+#ifndef WIDGETREGISTRY_H
+#define WIDGETREGISTRY_H
+
+#include <stdint.h>
+#include "widgetbase.h"
+
+/// @brief Widget kinds known by the registry, in paint order.
+/// @details Inside a layer (WidgetBase::setZOrder()) the widgets are painted from the first to
+///          the last kind and hit-tested in the opposite order, so a kind listed later is drawn
+///          on top and receives the touch first. Widgets added with DisplayFK::addWidget() use
+///          CUSTOM.
+enum class WidgetType : uint8_t
+{
+    TOUCHAREA = 0,
+    CIRCULARBAR,
+    GAUGE,
+    LABEL,
+    LED,
+    LINECHART,
+    VBAR,
+    VANALOG,
+    CHECKBOX,
+    CIRCLEBUTTON,
+    HSLIDER,
+    RADIOGROUP,
+    RECTBUTTON,
+    TOGGLE,
+    IMAGE,
+    TEXTBUTTON,
+    SPINBOX,
+    NUMBERBOX,
+    TEXTBOX,
+    THERMOMETER,
+    CUSTOM
+};
+
+/// @brief Contiguous view of the widgets of one screen.
+typedef struct {
+    WidgetBase *const *widgets; ///< Widgets in paint order.
+    const WidgetType *types;    ///< Kind of each widget (same index as widgets).
+    uint16_t count;             ///< Number of entries.
+} WidgetSpan_t;
+
+/// @brief Stores every registered widget grouped by screen.
+/// @details Widgets live in two parallel arrays sorted by screen, then by layer, then by kind,
+///          then by registration order (the paint order). A table with the first index of each screen turns
+///          "widgets of the current screen" into a pointer and a count, so the frame loop and
+///          the hit test only visit the widgets that are showing. Insertion keeps the arrays
+///          sorted and costs O(n). The registry has no lock: add() may reallocate the arrays,
+///          so DisplayFK only registers widgets before its UI task is created.
+class WidgetRegistry {
+public:
+    WidgetRegistry();
+    ~WidgetRegistry();
+
+    bool add(WidgetBase *widget, WidgetType type);
+    bool contains(const WidgetBase *widget) const;
+    void clear();
+    void sort();
+
+    uint16_t size() const;
+    uint32_t revision() const;
+    WidgetSpan_t onScreen(uint8_t screen) const;
+
+private:
+    static const char *TAG;      ///< Tag estática para identificação em logs.
+    static constexpr uint16_t SCREEN_SLOTS = 256; ///< One slot per possible screen index.
+
+    WidgetBase **m_widgets;      ///< Widgets sorted by screen, layer, kind and registration order.
+    WidgetType *m_types;         ///< Kind of each entry of m_widgets.
+    uint16_t m_count;            ///< Number of registered widgets.
+    uint16_t m_capacity;         ///< Number of entries allocated.
+    uint32_t m_revision;         ///< Incremented on every add() and clear(); spans taken before are stale.
+    uint16_t m_screenStart[SCREEN_SLOTS + 1]; ///< First index of each screen; screen s spans [s, s + 1).
+
+    bool reserve(uint16_t needed);
+    static bool paintsAfter(const WidgetBase *a, WidgetType typeA, const WidgetBase *b, WidgetType typeB);
+    void rebuildScreenTable();
+};
+
+#endif // WIDGETREGISTRY_H
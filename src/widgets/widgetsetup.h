@@ -287,7 +287,9 @@ const uint16_t CFK_COLOR073 = process_color(0xF80F);   // #FF007F
 const uint16_t CFK_COLOR074 = process_color(0xFAB5);   // #FF55AA
 const uint16_t CFK_COLOR075 = process_color(0xFD5A);   // #FFAAD4
 
-#if defined(USING_GRAPHIC_LIB)
+// Com DFK_FONT_SUBSET as famílias não são incluídas: widgetbase.h usa as fontes geradas por
+// src/fonts/fontsubset.py (somente as referenciadas pela aplicação e pela biblioteca).
+#if defined(USING_GRAPHIC_LIB) && !defined(DFK_FONT_SUBSET)
 
 #define FONT_ROBOTO
 #define FONT_SEGMENT7